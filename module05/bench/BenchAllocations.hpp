@@ -0,0 +1,47 @@
+#ifndef BENCHALLOCATIONS_HPP
+#define BENCHALLOCATIONS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include "utils/AllocationTracker.hpp"
+
+// Heap allocations made by a benchmark's timed loop, reported per iteration
+// as the allocs/iter and bytes/iter counters (the bench binary links the
+// AllocationHooks).  Work between pause() and resume(), such as rewinding
+// to a checkpoint, is left out.
+class AllocationMeter
+{
+public:
+    AllocationMeter() : _start(AllocationTracker::total()) {}
+
+    void pause()
+    {
+        _paused = AllocationTracker::total();
+    }
+
+    void resume()
+    {
+        const AllocationTracker::Counters now = AllocationTracker::total();
+        _excluded.allocations += now.allocations - _paused.allocations;
+        _excluded.bytes       += now.bytes - _paused.bytes;
+    }
+
+    void report(benchmark::State& state) const
+    {
+        const AllocationTracker::Counters end = AllocationTracker::total();
+
+        state.counters["allocs/iter"] = benchmark::Counter(
+            static_cast<double>(end.allocations - _start.allocations - _excluded.allocations),
+            benchmark::Counter::kAvgIterations);
+        state.counters["bytes/iter"] = benchmark::Counter(
+            static_cast<double>(end.bytes - _start.bytes - _excluded.bytes),
+            benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    AllocationTracker::Counters _start;
+    AllocationTracker::Counters _paused;
+    AllocationTracker::Counters _excluded;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "BenchScenarios.hpp"
+#include "utils/Time.hpp"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+    constexpr unsigned int BENCH_SEED   = 2024;  // Fixed: results compare across releases
+    constexpr int          RUSH_MINUTES = 30;
+
+    // Rewrites the departure time (second to last field) of every train.
+    void squeezeDepartures(const std::string& trainFile)
+    {
+        std::ifstream     in(trainFile);
+        std::stringstream out;
+        std::string       line;
+        int               train = 0;
+        while (std::getline(in, line))
+        {
+            const std::size_t stop      = line.rfind(' ');
+            const std::size_t departure = (line.empty() || line[0] == '#' || stop == std::string::npos)
+                                        ? std::string::npos : line.rfind(' ', stop - 1);
+            if (departure != std::string::npos)
+            {
+                line.replace(departure + 1, stop - departure - 1, Time(0, train++ % RUSH_MINUTES).toString());
+            }
+            out << line << '\n';
+        }
+        in.close();
+
+        std::ofstream file(trainFile, std::ios::trunc);
+        file << out.str();
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write file: " + trainFile);
+        }
+    }
+
+    class ScenarioCache
+    {
+    public:
+        ScenarioCache()
+            : _dir(std::filesystem::temp_directory_path() / ("railway_bench_" + std::to_string(::getpid())))
+        {
+            std::filesystem::create_directories(_dir);
+        }
+
+        ~ScenarioCache()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(_dir, ignored);
+        }
+
+        const BenchScenario& get(const GeneratorSpec& spec, bool rush)
+        {
+            const std::string name = std::string(ScenarioGenerator::topologyName(spec.topology))
+                                   + "_" + std::to_string(spec.stations)
+                                   + "_" + std::to_string(spec.junctions)
+                                   + "_" + std::to_string(spec.trains)
+                                   + "_" + std::to_string(spec.seed)
+                                   + (rush ? "_rush" : "");
+
+            auto it = _scenarios.find(name);
+            if (it == _scenarios.end())
+            {
+                BenchScenario scenario;
+                scenario.network = (_dir / (name + "_network.txt")).string();
+                scenario.trains  = (_dir / (name + "_trains.txt")).string();
+                scenario.rails   = ScenarioGenerator(spec).writeFiles(scenario.network, scenario.trains).rails;
+                if (rush)
+                {
+                    squeezeDepartures(scenario.trains);
+                }
+                it = _scenarios.emplace(name, scenario).first;
+            }
+            return it->second;
+        }
+
+    private:
+        std::filesystem::path                _dir;
+        std::map<std::string, BenchScenario> _scenarios;
+    };
+}
+
+GeneratorSpec benchSpec(NetworkTopology topology, std::size_t stations, std::size_t trains)
+{
+    GeneratorSpec spec;
+    spec.topology = topology;
+    spec.stations = stations;
+    spec.trains   = trains;
+    spec.seed     = BENCH_SEED;
+    return spec;
+}
+
+const BenchScenario& benchScenario(const GeneratorSpec& spec, bool rush)
+{
+    static ScenarioCache cache;
+    return cache.get(spec, rush);
+}
@@ -0,0 +1,23 @@
+#ifndef BENCHSCENARIOS_HPP
+#define BENCHSCENARIOS_HPP
+
+#include "io/ScenarioGenerator.hpp"
+#include <cstddef>
+#include <string>
+
+// Generated network and train files shared by the benchmarks.  Each spec is
+// written once per process into a temporary directory removed at exit, so
+// every benchmark runs on the same inputs for a given size.  A rush
+// timetable moves every departure into the first half hour of the day, so
+// a run is over in a few simulated hours instead of lasting until night.
+struct BenchScenario
+{
+    std::string network;
+    std::string trains;
+    std::size_t rails = 0;
+};
+
+GeneratorSpec        benchSpec(NetworkTopology topology, std::size_t stations, std::size_t trains);
+const BenchScenario& benchScenario(const GeneratorSpec& spec, bool rush = false);
+
+#endif
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchAllocations.hpp"
+#include "core/Node.hpp"
+#include "event_system/EventDispatcher.hpp"
+#include "event_system/EventPool.hpp"
+#include "event_system/EventScheduler.hpp"
+#include "utils/Time.hpp"
+
+namespace
+{
+    constexpr int STATIONS = 64;
+
+    // One tick over a steady schedule: half the events are active all day,
+    // the other half wait for the evening, so every update scans both lists
+    // without activating or expiring anything.
+    void BM_EventSchedulerUpdate(benchmark::State& state)
+    {
+        const auto events = static_cast<int>(state.range(0));
+
+        std::vector<std::unique_ptr<Node>> stations;
+        for (int i = 0; i < STATIONS; ++i)
+        {
+            stations.push_back(std::make_unique<Node>("City" + std::to_string(i)));
+        }
+
+        EventDispatcher dispatcher;
+        EventPool       pool;
+        EventScheduler  scheduler(dispatcher, &pool);
+        for (int i = 0; i < events; ++i)
+        {
+            Node*      station = stations[static_cast<std::size_t>(i % STATIONS)].get();
+            const bool allDay  = (i % 2 == 0);
+            scheduler.scheduleEvent(pool.create<StationDelayEvent>(station,
+                                                                   allDay ? Time(0, i % 60) : Time(22, i % 60),
+                                                                   allDay ? Time(22, 0) : Time(1, 0),
+                                                                   Time(0, 5)));
+        }
+
+        const Time noon(12, 0);
+        scheduler.update(noon);
+
+        AllocationMeter allocations;
+        for (auto _ : state)
+        {
+            scheduler.update(noon);
+        }
+        allocations.report(state);
+
+        state.SetComplexityN(events);
+        state.SetItemsProcessed(state.iterations() * events);
+        state.counters["active"]        = static_cast<double>(scheduler.getActiveEvents().size());
+        state.counters["pool_chunks"]   = static_cast<double>(pool.stats().chunkAllocations);
+        state.counters["pool_reserved"] = benchmark::Counter(static_cast<double>(pool.stats().reservedBytes),
+                                                             benchmark::Counter::kDefaults,
+                                                             benchmark::Counter::kIs1024);
+    }
+}
+
+BENCHMARK(BM_EventSchedulerUpdate)
+    ->RangeMultiplier(8)->Range(8, 32768)->Unit(benchmark::kMicrosecond)->Complexity();
@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchScenarios.hpp"
+#include "analysis/MonteCarloRunner.hpp"
+
+namespace
+{
+    constexpr unsigned int RUNS_PER_BATCH = 2;
+    constexpr std::size_t  TRAINS         = 16;
+
+    // A full silent batch, parsing and routing included, of a rush timetable;
+    // items per second is Monte Carlo runs per second.
+    void BM_MonteCarloRuns(benchmark::State& state)
+    {
+        const auto           stations = static_cast<std::size_t>(state.range(0));
+        const BenchScenario& scenario = benchScenario(benchSpec(NetworkTopology::Grid, stations, TRAINS), true);
+
+        for (auto _ : state)
+        {
+            MonteCarloRunner runner(scenario.network, scenario.trains, 7, RUNS_PER_BATCH, "dijkstra");
+            runner.runAll();
+            benchmark::DoNotOptimize(&runner.getAggregate());
+        }
+
+        state.SetComplexityN(static_cast<benchmark::IterationCount>(stations));
+        state.SetItemsProcessed(state.iterations() * RUNS_PER_BATCH);
+    }
+}
+
+BENCHMARK(BM_MonteCarloRuns)
+    ->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond)->UseRealTime()->Complexity();
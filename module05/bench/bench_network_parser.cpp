@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+
+#include "BenchScenarios.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "io/RailNetworkParser.hpp"
+
+namespace
+{
+    // Text network file to Graph, on a scale-free network.
+    void BM_ParseNetwork(benchmark::State& state)
+    {
+        const auto           stations = static_cast<std::size_t>(state.range(0));
+        const BenchScenario& scenario = benchScenario(benchSpec(NetworkTopology::ScaleFree, stations, 1));
+        const auto           bytes    = std::filesystem::file_size(scenario.network);
+
+        std::size_t nodes = 0;
+        for (auto _ : state)
+        {
+            std::unique_ptr<Graph> graph(RailNetworkParser(scenario.network).parse());
+            nodes = graph->getNodeCount();
+        }
+
+        state.SetComplexityN(static_cast<benchmark::IterationCount>(nodes + scenario.rails));
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes + scenario.rails));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes));
+        state.counters["nodes"] = static_cast<double>(nodes);
+        state.counters["rails"] = static_cast<double>(scenario.rails);
+    }
+}
+
+BENCHMARK(BM_ParseNetwork)
+    ->RangeMultiplier(8)->Range(64, 32768)->Unit(benchmark::kMillisecond)->Complexity();
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+#include "BenchScenarios.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "patterns/behavioral/strategies/AStarStrategy.hpp"
+#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
+
+namespace
+{
+    // Corner to corner across a square grid: the route crosses the whole
+    // network, so the search visits most of it.
+    template <typename Strategy>
+    void BM_FindPath(benchmark::State& state)
+    {
+        const auto           stations = static_cast<std::size_t>(state.range(0));
+        const BenchScenario& scenario = benchScenario(benchSpec(NetworkTopology::Grid, stations, 1));
+
+        std::unique_ptr<Graph> graph(RailNetworkParser(scenario.network).parse());
+        Node*                  start = graph->getNode("City0");
+        Node*                  end   = graph->getNode("City" + std::to_string(stations - 1));
+        const Strategy         strategy;
+
+        std::size_t rails = 0;
+        for (auto _ : state)
+        {
+            const IPathfindingStrategy::Path path = strategy.findPath(graph.get(), start, end);
+            rails = path.size();
+            benchmark::DoNotOptimize(path.data());
+        }
+
+        state.SetComplexityN(static_cast<benchmark::IterationCount>(graph->getNodeCount()));
+        state.counters["nodes"]      = static_cast<double>(graph->getNodeCount());
+        state.counters["path_rails"] = static_cast<double>(rails);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_FindPath, DijkstraStrategy)
+    ->RangeMultiplier(4)->Range(64, 16384)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_FindPath, AStarStrategy)
+    ->RangeMultiplier(4)->Range(64, 16384)->Unit(benchmark::kMicrosecond)->Complexity();
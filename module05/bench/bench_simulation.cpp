@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory>
+
+#include "BenchAllocations.hpp"
+#include "BenchScenarios.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "core/Train.hpp"
+#include "patterns/behavioral/command/CommandManager.hpp"
+#include "simulation/core/SimulationCheckpoint.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationContext.hpp"
+#include "simulation/core/SimulationManager.hpp"
+
+namespace
+{
+    constexpr std::size_t NETWORK_STATIONS = 1600;
+    constexpr double      WINDOW_START     = 30.0 * 60.0;  // Every rush departure has left
+    constexpr double      WINDOW_END       = 60.0 * 60.0;
+
+    // A started simulation of the given number of trains on a fixed grid,
+    // optionally recording its commands in memory (as --record does).
+    class BenchSimulation
+    {
+    public:
+        BenchSimulation(std::size_t trains, bool rush, bool record = false)
+        {
+            const BenchScenario& files = benchScenario(benchSpec(NetworkTopology::Grid, NETWORK_STATIONS, trains), rush);
+            _scenario.reset(new PreparedScenario(files.network, files.trains, "dijkstra"));
+            _pool.reset(new ScenarioTrainPool(*_scenario));
+
+            SimulationConfig config;
+            config.network = _scenario->getNetwork();
+            config.seed    = 7;
+            _sim.configure(config);
+            if (record)
+            {
+                _commands.reset(new CommandManager());
+                _commands->startRecording();
+                _sim.setCommandManager(_commands.get());
+            }
+            for (Train* train : _pool->acquire())
+            {
+                _sim.addTrain(train);
+            }
+            _sim.start();
+        }
+
+        SimulationManager& sim()
+        {
+            return _sim;
+        }
+
+        std::size_t activeTrains() const
+        {
+            std::size_t active = 0;
+            for (const Train* train : _sim.getTrains())
+            {
+                active += _sim.getContext()->isTrainActive(train) ? 1 : 0;
+            }
+            return active;
+        }
+
+    private:
+        std::unique_ptr<PreparedScenario>  _scenario;
+        std::unique_ptr<ScenarioTrainPool> _pool;
+        std::unique_ptr<CommandManager>    _commands;
+        SimulationManager                  _sim;
+    };
+
+    // Every train waiting on its first rail, so each one is assessed against
+    // the others.
+    void BM_RefreshAllRiskData(benchmark::State& state)
+    {
+        const auto      trains = static_cast<std::size_t>(state.range(0));
+        BenchSimulation bench(trains, false);
+
+        for (auto _ : state)
+        {
+            bench.sim().getContext()->refreshAllRiskData();
+        }
+
+        state.SetComplexityN(static_cast<benchmark::IterationCount>(trains));
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(trains));
+    }
+
+    // One full tick (departures, occupancy and risk, states, physics,
+    // events) in the half hour after the rush, rewinding to its start from a
+    // checkpoint whenever the window ends.  The second argument turns command
+    // recording on, so allocs/iter shows what recording costs per tick.
+    void BM_SimulationStep(benchmark::State& state)
+    {
+        const auto      trains = static_cast<std::size_t>(state.range(0));
+        BenchSimulation bench(trains, true, state.range(1) != 0);
+        while (bench.sim().getCurrentTime() < WINDOW_START)
+        {
+            bench.sim().step();
+        }
+        const SimulationCheckpoint window = bench.sim().checkpoint();
+        const std::size_t          active = bench.activeTrains();
+
+        AllocationMeter allocations;
+        for (auto _ : state)
+        {
+            bench.sim().step();
+            if (bench.sim().getCurrentTime() >= WINDOW_END)
+            {
+                state.PauseTiming();
+                allocations.pause();
+                bench.sim().restore(window);
+                allocations.resume();
+                state.ResumeTiming();
+            }
+        }
+        allocations.report(state);
+
+        state.counters["active"]      = static_cast<double>(active);
+        state.counters["events_live"] = static_cast<double>(bench.sim().getEventPool().stats().live);
+    }
+}
+
+BENCHMARK(BM_RefreshAllRiskData)
+    ->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond)->Complexity();
+BENCHMARK(BM_SimulationStep)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}})->ArgNames({"trains", "record"})->Unit(benchmark::kMicrosecond);
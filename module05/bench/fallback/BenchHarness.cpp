@@ -0,0 +1,662 @@
+// main() of Railway_Simulator_bench when Google Benchmark is not installed.
+// Runs the registered benchmark bodies under steady_clock timing and reports
+// in Google's console table or JSON (--benchmark_format / --benchmark_out).
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace benchmark
+{
+    namespace internal
+    {
+        namespace
+        {
+            std::vector<std::unique_ptr<Benchmark>>& registry()
+            {
+                static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+                return benchmarks;
+            }
+        }
+
+        Benchmark::Benchmark(std::string name, Function function)
+            : _name(std::move(name)), _function(std::move(function))
+        {
+        }
+
+        Benchmark* Benchmark::Arg(std::int64_t value)
+        {
+            _args.push_back({value});
+            return this;
+        }
+
+        Benchmark* Benchmark::RangeMultiplier(int multiplier)
+        {
+            _multiplier = multiplier;
+            return this;
+        }
+
+        // low, the powers of the multiplier strictly between, then high.
+        Benchmark* Benchmark::Range(std::int64_t low, std::int64_t high)
+        {
+            Arg(low);
+            for (std::int64_t value = 1; value < high; value *= _multiplier)
+            {
+                if (value > low)
+                {
+                    Arg(value);
+                }
+            }
+            if (high != low)
+            {
+                Arg(high);
+            }
+            return this;
+        }
+
+        Benchmark* Benchmark::ArgsProduct(const std::vector<std::vector<std::int64_t>>& lists)
+        {
+            std::vector<std::vector<std::int64_t>> product(1);
+            for (const std::vector<std::int64_t>& list : lists)
+            {
+                std::vector<std::vector<std::int64_t>> next;
+                for (const std::vector<std::int64_t>& prefix : product)
+                {
+                    for (std::int64_t value : list)
+                    {
+                        next.push_back(prefix);
+                        next.back().push_back(value);
+                    }
+                }
+                product.swap(next);
+            }
+            _args.insert(_args.end(), product.begin(), product.end());
+            return this;
+        }
+
+        Benchmark* Benchmark::ArgNames(const std::vector<std::string>& names)
+        {
+            _argNames = names;
+            return this;
+        }
+
+        Benchmark* Benchmark::Unit(TimeUnit unit)
+        {
+            _unit = unit;
+            return this;
+        }
+
+        Benchmark* Benchmark::UseRealTime()
+        {
+            _realTime = true;
+            return this;
+        }
+
+        Benchmark* Benchmark::Complexity()
+        {
+            _complexity = true;
+            return this;
+        }
+
+        Benchmark* registerBenchmark(const std::string& name, Benchmark::Function function)
+        {
+            registry().emplace_back(new Benchmark(name, std::move(function)));
+            return registry().back().get();
+        }
+    }
+}
+
+namespace
+{
+    using benchmark::Counter;
+    using benchmark::IterationCount;
+    using benchmark::internal::Benchmark;
+
+    constexpr IterationCount MAX_ITERATIONS = 1000000000;
+
+    struct Options
+    {
+        std::string    filter    = ".";
+        double         minTime   = 0.5;
+        IterationCount fixed     = 0;  // --benchmark_min_time=<n>x
+        bool           json      = false;
+        std::string    out;
+        bool           outJson   = true;
+        bool           listTests = false;
+    };
+
+    // A user counter after the rate / per-iteration division.
+    struct CounterValue
+    {
+        std::string name;
+        double      value;
+        bool        rate;
+        bool        is1024;
+    };
+
+    // One result row: a measured run or a BigO / RMS aggregate.
+    struct Report
+    {
+        std::string               name;
+        std::string               runName;
+        std::string               aggregate;
+        IterationCount            iterations = 0;
+        double                    realTime   = 0.0;  // Per iteration, in unit
+        double                    cpuTime    = 0.0;
+        benchmark::TimeUnit       unit       = benchmark::kNanosecond;
+        std::string               bigO;
+        double                    rms        = 0.0;
+        std::vector<CounterValue> counters;
+    };
+
+    double unitScale(benchmark::TimeUnit unit)
+    {
+        switch (unit)
+        {
+            case benchmark::kSecond:      return 1.0;
+            case benchmark::kMillisecond: return 1e3;
+            case benchmark::kMicrosecond: return 1e6;
+            default:                      return 1e9;
+        }
+    }
+
+    const char* unitName(benchmark::TimeUnit unit)
+    {
+        switch (unit)
+        {
+            case benchmark::kSecond:      return "s";
+            case benchmark::kMillisecond: return "ms";
+            case benchmark::kMicrosecond: return "us";
+            default:                      return "ns";
+        }
+    }
+
+    std::string runName(const Benchmark& family, const std::vector<std::int64_t>& args)
+    {
+        std::string name = family.name();
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            name += "/";
+            if (i < family.argNames().size())
+            {
+                name += family.argNames()[i] + ":";
+            }
+            name += std::to_string(args[i]);
+        }
+        if (family.realTime())
+        {
+            name += "/real_time";
+        }
+        return name;
+    }
+
+    // Grows the iteration count until the timed loop lasts minTime, as
+    // Google Benchmark does, then keeps the last run.
+    Report runFamilyMember(const Benchmark& family, const std::vector<std::int64_t>& args,
+                           const Options& options, IterationCount& complexityN)
+    {
+        IterationCount iterations = options.fixed > 0 ? options.fixed : 1;
+
+        for (;;)
+        {
+            benchmark::State state(args, iterations);
+            family.function()(state);
+
+            const double seconds = family.realTime() ? state.realSeconds() : state.cpuSeconds();
+            const bool   done    = options.fixed > 0 || seconds >= options.minTime || iterations >= MAX_ITERATIONS;
+
+            if (!done)
+            {
+                double multiplier = options.minTime * 1.4 / std::max(seconds, 1e-9);
+                if (seconds / options.minTime <= 0.1)
+                {
+                    multiplier = 10.0;
+                }
+                const auto next = static_cast<IterationCount>(multiplier * static_cast<double>(iterations));
+                iterations = std::min(std::max(next, iterations + 1), MAX_ITERATIONS);
+                continue;
+            }
+
+            Report report;
+            report.name       = runName(family, args);
+            report.runName    = report.name;
+            report.iterations = iterations;
+            report.unit       = family.unit();
+            report.realTime   = state.realSeconds() / static_cast<double>(iterations) * unitScale(report.unit);
+            report.cpuTime    = state.cpuSeconds() / static_cast<double>(iterations) * unitScale(report.unit);
+            complexityN       = state.complexityN();
+
+            const double rateSeconds = std::max(seconds, 1e-12);
+            if (state.bytesProcessed() > 0)
+            {
+                report.counters.push_back({"bytes_per_second",
+                                           static_cast<double>(state.bytesProcessed()) / rateSeconds, true, true});
+            }
+            if (state.itemsProcessed() > 0)
+            {
+                report.counters.push_back({"items_per_second",
+                                           static_cast<double>(state.itemsProcessed()) / rateSeconds, true, false});
+            }
+            for (const auto& entry : state.counters)
+            {
+                const Counter& counter = entry.second;
+                double         value   = counter.value;
+                if (counter.flags & Counter::kIsRate)
+                {
+                    value /= rateSeconds;
+                }
+                if (counter.flags & Counter::kAvgIterations)
+                {
+                    value /= static_cast<double>(iterations);
+                }
+                report.counters.push_back({entry.first, value, (counter.flags & Counter::kIsRate) != 0,
+                                           counter.oneK == Counter::kIs1024});
+            }
+            std::sort(report.counters.begin(), report.counters.end(),
+                      [](const CounterValue& a, const CounterValue& b) { return a.name < b.name; });
+            return report;
+        }
+    }
+
+    struct Curve
+    {
+        const char* name;
+        double      (*shape)(double);
+    };
+
+    // Least-squares fit of time = coefficient * shape(N) over a family's runs,
+    // keeping the curve with the lowest normalised RMS (Google's oAuto).
+    void fitComplexity(const Benchmark& family, const std::vector<Report>& runs,
+                       const std::vector<IterationCount>& sizes, std::vector<Report>& reports)
+    {
+        static const Curve curves[] = {
+            {"(1)",  [](double) { return 1.0; }},
+            {"lgN",  [](double n) { return std::log2(n); }},
+            {"N",    [](double n) { return n; }},
+            {"NlgN", [](double n) { return n * std::log2(n); }},
+            {"N^2",  [](double n) { return n * n; }},
+            {"N^3",  [](double n) { return n * n * n; }},
+        };
+
+        const Curve* best     = nullptr;
+        double       bestRms  = 0.0;
+        double       bestCpu  = 0.0;
+        double       bestReal = 0.0;
+
+        for (const Curve& curve : curves)
+        {
+            double shapeSq = 0.0;
+            double cpuDot  = 0.0;
+            double realDot = 0.0;
+            double cpuSum  = 0.0;
+            for (std::size_t i = 0; i < runs.size(); ++i)
+            {
+                const double g = curve.shape(static_cast<double>(sizes[i]));
+                shapeSq += g * g;
+                cpuDot  += runs[i].cpuTime * g;
+                realDot += runs[i].realTime * g;
+                cpuSum  += runs[i].cpuTime;
+            }
+            if (shapeSq <= 0.0 || cpuSum <= 0.0)
+            {
+                continue;
+            }
+
+            const double cpuCoefficient = cpuDot / shapeSq;
+            double       residual       = 0.0;
+            for (std::size_t i = 0; i < runs.size(); ++i)
+            {
+                const double error = runs[i].cpuTime - cpuCoefficient * curve.shape(static_cast<double>(sizes[i]));
+                residual += error * error;
+            }
+            const double count = static_cast<double>(runs.size());
+            const double rms   = std::sqrt(residual / count) / (cpuSum / count);
+
+            if (!best || rms < bestRms)
+            {
+                best     = &curve;
+                bestRms  = rms;
+                bestCpu  = cpuCoefficient;
+                bestReal = realDot / shapeSq;
+            }
+        }
+
+        if (!best)
+        {
+            return;
+        }
+
+        Report bigO;
+        bigO.name      = family.name() + "_BigO";
+        bigO.runName   = family.name();
+        bigO.aggregate = "BigO";
+        bigO.unit      = runs.front().unit;
+        bigO.realTime  = bestReal;
+        bigO.cpuTime   = bestCpu;
+        bigO.bigO      = best->name;
+        reports.push_back(bigO);
+
+        Report rms;
+        rms.name      = family.name() + "_RMS";
+        rms.runName   = family.name();
+        rms.aggregate = "RMS";
+        rms.unit      = runs.front().unit;
+        rms.rms       = bestRms;
+        reports.push_back(rms);
+    }
+
+    // "50.9857M", "8k", "0.0138249": Google's counter humanisation.
+    std::string humanise(double value, bool is1024)
+    {
+        static const char* suffixes[] = {"", "k", "M", "G", "T", "P"};
+
+        const double base  = is1024 ? 1024.0 : 1000.0;
+        std::size_t  index = 0;
+        while (std::fabs(value) >= base && index + 1 < sizeof(suffixes) / sizeof(suffixes[0]))
+        {
+            value /= base;
+            ++index;
+        }
+
+        std::ostringstream out;
+        out << value << suffixes[index];
+        return out.str();
+    }
+
+    std::string formatTime(double value)
+    {
+        char        buffer[32];
+        const char* format = value < 1.0 ? "%.3f" : value < 10.0 ? "%.2f" : value < 100.0 ? "%.1f" : "%.0f";
+        std::snprintf(buffer, sizeof(buffer), format, value);
+        return buffer;
+    }
+
+    void writeConsole(std::ostream& out, const std::vector<Report>& reports)
+    {
+        std::size_t width = 10;
+        for (const Report& report : reports)
+        {
+            width = std::max(width, report.name.size());
+        }
+
+        const std::string header = [&] {
+            std::ostringstream line;
+            line << std::left << std::setw(static_cast<int>(width)) << "Benchmark"
+                 << std::right << std::setw(14) << "Time" << std::setw(18) << "CPU"
+                 << std::setw(13) << "Iterations" << " UserCounters...";
+            return line.str();
+        }();
+        out << header << "\n" << std::string(header.size(), '-') << "\n";
+
+        for (const Report& report : reports)
+        {
+            out << std::left << std::setw(static_cast<int>(width)) << report.name << std::right;
+
+            if (report.aggregate == "RMS")
+            {
+                out << std::setw(12) << static_cast<long>(std::lround(report.rms * 100.0)) << " % "
+                    << std::setw(14) << static_cast<long>(std::lround(report.rms * 100.0)) << " %\n";
+                continue;
+            }
+
+            const std::string unit = report.aggregate == "BigO" ? report.bigO : unitName(report.unit);
+            out << std::setw(11) << formatTime(report.realTime) << " " << std::left << std::setw(2) << unit << std::right
+                << std::setw(15) << formatTime(report.cpuTime) << " " << std::left << std::setw(2) << unit << std::right;
+
+            if (report.aggregate.empty())
+            {
+                out << std::setw(13) << report.iterations;
+                for (const CounterValue& counter : report.counters)
+                {
+                    out << " " << counter.name << "=" << humanise(counter.value, counter.is1024)
+                        << (counter.rate ? "/s" : "");
+                }
+            }
+            out << "\n";
+        }
+    }
+
+    std::string jsonString(const std::string& text)
+    {
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Report>& reports, const std::string& executable)
+    {
+        char              date[64];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+        out << std::scientific << std::setprecision(16);
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"date\": " << jsonString(date) << ",\n"
+            << "    \"executable\": " << jsonString(executable) << ",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"harness\": \"fallback\"\n"
+            << "  },\n"
+            << "  \"benchmarks\": [";
+
+        for (std::size_t r = 0; r < reports.size(); ++r)
+        {
+            const Report& report = reports[r];
+
+            out << (r ? "," : "") << "\n    {\n"
+                << "      \"name\": " << jsonString(report.name) << ",\n"
+                << "      \"run_name\": " << jsonString(report.runName) << ",\n"
+                << "      \"run_type\": " << (report.aggregate.empty() ? "\"iteration\"" : "\"aggregate\"") << ",\n"
+                << "      \"repetitions\": 1,\n"
+                << "      \"threads\": 1,\n";
+
+            if (report.aggregate == "RMS")
+            {
+                out << "      \"aggregate_name\": \"RMS\",\n"
+                    << "      \"rms\": " << report.rms << "\n    }";
+                continue;
+            }
+            if (report.aggregate == "BigO")
+            {
+                out << "      \"aggregate_name\": \"BigO\",\n"
+                    << "      \"cpu_coefficient\": " << report.cpuTime << ",\n"
+                    << "      \"real_coefficient\": " << report.realTime << ",\n"
+                    << "      \"big_o\": " << jsonString(report.bigO) << ",\n"
+                    << "      \"time_unit\": \"" << unitName(report.unit) << "\"\n    }";
+                continue;
+            }
+
+            out << "      \"iterations\": " << report.iterations << ",\n"
+                << "      \"real_time\": " << report.realTime << ",\n"
+                << "      \"cpu_time\": " << report.cpuTime << ",\n"
+                << "      \"time_unit\": \"" << unitName(report.unit) << "\"";
+            for (const CounterValue& counter : report.counters)
+            {
+                out << ",\n      " << jsonString(counter.name) << ": " << counter.value;
+            }
+            out << "\n    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    bool parseFormat(const std::string& value, bool& json)
+    {
+        if (value != "json" && value != "console")
+        {
+            return false;
+        }
+        json = value == "json";
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg   = argv[i];
+            const std::size_t equal = arg.find('=');
+            const std::string key   = arg.substr(0, equal);
+            const std::string value = equal == std::string::npos ? "" : arg.substr(equal + 1);
+
+            if (key == "--benchmark_filter")
+            {
+                options.filter = value == "all" ? "." : value;
+            }
+            else if (key == "--benchmark_min_time" && !value.empty())
+            {
+                char*        end    = nullptr;
+                const double number = std::strtod(value.c_str(), &end);
+                if (std::string(end) == "x")
+                {
+                    options.fixed = static_cast<IterationCount>(number);
+                }
+                else if (*end == '\0' || std::string(end) == "s")
+                {
+                    options.minTime = number;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            else if (key == "--benchmark_format")
+            {
+                if (!parseFormat(value, options.json))
+                {
+                    return false;
+                }
+            }
+            else if (key == "--benchmark_out")
+            {
+                options.out = value;
+            }
+            else if (key == "--benchmark_out_format")
+            {
+                if (!parseFormat(value, options.outJson))
+                {
+                    return false;
+                }
+            }
+            else if (key == "--benchmark_list_tests")
+            {
+                options.listTests = value.empty() || value == "true";
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>[s]|<n>x]\n"
+                  << "          [--benchmark_format=console|json] [--benchmark_out=<file>]\n"
+                  << "          [--benchmark_out_format=console|json] [--benchmark_list_tests]\n";
+        return 1;
+    }
+
+    std::regex filter;
+    try
+    {
+        filter = std::regex(options.filter);
+    }
+    catch (const std::regex_error&)
+    {
+        std::cerr << "Invalid --benchmark_filter: " << options.filter << "\n";
+        return 1;
+    }
+
+    std::vector<Report> reports;
+    for (const std::unique_ptr<Benchmark>& family : benchmark::internal::registry())
+    {
+        std::vector<std::vector<std::int64_t>> members = family->args();
+        if (members.empty())
+        {
+            members.emplace_back();
+        }
+
+        std::vector<Report>         runs;
+        std::vector<IterationCount> sizes;
+        for (const std::vector<std::int64_t>& args : members)
+        {
+            const std::string name = runName(*family, args);
+            if (!std::regex_search(name, filter))
+            {
+                continue;
+            }
+            if (options.listTests)
+            {
+                std::cout << name << "\n";
+                continue;
+            }
+
+            IterationCount complexityN = 0;
+            runs.push_back(runFamilyMember(*family, args, options, complexityN));
+            sizes.push_back(complexityN);
+            reports.push_back(runs.back());
+        }
+
+        if (family->complexity() && runs.size() >= 2)
+        {
+            fitComplexity(*family, runs, sizes, reports);
+        }
+    }
+
+    if (options.listTests)
+    {
+        return 0;
+    }
+
+    if (options.json)
+    {
+        writeJson(std::cout, reports, argv[0]);
+    }
+    else
+    {
+        writeConsole(std::cout, reports);
+    }
+
+    if (!options.out.empty())
+    {
+        std::ofstream file(options.out);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << options.out << "\n";
+            return 1;
+        }
+        if (options.outJson)
+        {
+            writeJson(file, reports, argv[0]);
+        }
+        else
+        {
+            writeConsole(file, reports);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+#ifndef FALLBACK_BENCHMARK_H
+#define FALLBACK_BENCHMARK_H
+
+// Stand-in for <benchmark/benchmark.h> when Google Benchmark is not
+// installed: the subset of its API the bench/ sources use, driven by the
+// steady_clock harness in BenchHarness.cpp.  Output keeps Google's console
+// columns and JSON fields, so scripts read either binary's results.
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+    using IterationCount = std::int64_t;
+
+    enum TimeUnit
+    {
+        kNanosecond,
+        kMicrosecond,
+        kMillisecond,
+        kSecond
+    };
+
+    class Counter
+    {
+    public:
+        enum Flags
+        {
+            kDefaults      = 0,
+            kIsRate        = 1 << 0,
+            kAvgIterations = 1 << 3
+        };
+
+        enum OneK
+        {
+            kIs1000 = 1000,
+            kIs1024 = 1024
+        };
+
+        Counter(double value = 0.0, Flags flags = kDefaults, OneK oneK = kIs1000)
+            : value(value), flags(flags), oneK(oneK)
+        {
+        }
+
+        double value;
+        Flags  flags;
+        OneK   oneK;
+    };
+
+    using UserCounters = std::map<std::string, Counter>;
+
+    class State
+    {
+    public:
+        struct __attribute__((unused)) Value {};
+
+        class Iterator
+        {
+        public:
+            explicit Iterator(State* state) : _state(state), _left(state ? state->_maxIterations : 0) {}
+
+            Value operator*() const { return Value(); }
+            void  operator++()      { --_left; }
+
+            bool operator!=(const Iterator&)
+            {
+                if (_left > 0)
+                {
+                    return true;
+                }
+                _state->stopClocks();
+                return false;
+            }
+
+        private:
+            State*         _state;
+            IterationCount _left;
+        };
+
+        State(const std::vector<std::int64_t>& args, IterationCount maxIterations)
+            : _args(args), _maxIterations(maxIterations)
+        {
+        }
+
+        Iterator begin()
+        {
+            startTiming();
+            return Iterator(this);
+        }
+        Iterator end() { return Iterator(nullptr); }
+
+        std::int64_t   range(std::size_t index = 0) const { return _args.at(index); }
+        IterationCount iterations()                 const { return _maxIterations; }
+
+        void PauseTiming()  { stopClocks(); }
+        void ResumeTiming() { startTiming(); }
+
+        void SetComplexityN(IterationCount n)       { _complexityN = n; }
+        void SetItemsProcessed(std::int64_t items)  { _items = items; }
+        void SetBytesProcessed(std::int64_t bytes)  { _bytes = bytes; }
+
+        IterationCount complexityN()    const { return _complexityN; }
+        std::int64_t   itemsProcessed() const { return _items; }
+        std::int64_t   bytesProcessed() const { return _bytes; }
+        double         realSeconds()    const { return _realSeconds; }
+        double         cpuSeconds()     const { return _cpuSeconds; }
+
+        UserCounters counters;
+
+    private:
+        void startTiming()
+        {
+            _realStart = std::chrono::steady_clock::now();
+            _cpuStart  = std::clock();
+            _running   = true;
+        }
+
+        void stopClocks()
+        {
+            if (!_running)
+            {
+                return;
+            }
+            _realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - _realStart).count();
+            _cpuSeconds  += static_cast<double>(std::clock() - _cpuStart) / CLOCKS_PER_SEC;
+            _running      = false;
+        }
+
+        std::vector<std::int64_t>             _args;
+        IterationCount                        _maxIterations;
+        IterationCount                        _complexityN = 0;
+        std::int64_t                          _items       = 0;
+        std::int64_t                          _bytes       = 0;
+        std::chrono::steady_clock::time_point _realStart;
+        std::clock_t                          _cpuStart    = 0;
+        double                                _realSeconds = 0.0;
+        double                                _cpuSeconds  = 0.0;
+        bool                                  _running     = false;
+    };
+
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename T>
+    inline void DoNotOptimize(T& value)
+    {
+        asm volatile("" : "+r,m"(value) : : "memory");
+    }
+
+    namespace internal
+    {
+        // One registered family; each argument tuple is one run.
+        class Benchmark
+        {
+        public:
+            using Function = std::function<void(State&)>;
+
+            Benchmark(std::string name, Function function);
+
+            Benchmark* Arg(std::int64_t value);
+            Benchmark* RangeMultiplier(int multiplier);
+            Benchmark* Range(std::int64_t low, std::int64_t high);
+            Benchmark* ArgsProduct(const std::vector<std::vector<std::int64_t>>& lists);
+            Benchmark* ArgNames(const std::vector<std::string>& names);
+            Benchmark* Unit(TimeUnit unit);
+            Benchmark* UseRealTime();
+            Benchmark* Complexity();
+
+            const std::string&                            name()        const { return _name; }
+            const Function&                               function()    const { return _function; }
+            const std::vector<std::vector<std::int64_t>>& args()        const { return _args; }
+            const std::vector<std::string>&               argNames()    const { return _argNames; }
+            TimeUnit                                      unit()        const { return _unit; }
+            bool                                          realTime()    const { return _realTime; }
+            bool                                          complexity()  const { return _complexity; }
+
+        private:
+            std::string                            _name;
+            Function                               _function;
+            std::vector<std::vector<std::int64_t>> _args;
+            std::vector<std::string>               _argNames;
+            int                                    _multiplier = 8;
+            TimeUnit                               _unit       = kNanosecond;
+            bool                                   _realTime   = false;
+            bool                                   _complexity = false;
+        };
+
+        Benchmark* registerBenchmark(const std::string& name, Benchmark::Function function);
+    }
+}
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b)  BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK_NAME          BENCHMARK_CONCAT(benchmark_registered_, __COUNTER__)
+
+#define BENCHMARK(function)                                                                     \
+    static ::benchmark::internal::Benchmark* BENCHMARK_NAME __attribute__((unused)) =           \
+        ::benchmark::internal::registerBenchmark(#function, function)
+
+#define BENCHMARK_TEMPLATE(function, type)                                                      \
+    static ::benchmark::internal::Benchmark* BENCHMARK_NAME __attribute__((unused)) =           \
+        ::benchmark::internal::registerBenchmark(#function "<" #type ">", function<type>)
+
+#endif
@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# Regenerates the tables of 06_Variance_Reduction_Report.md.
+# Run from module05 after building; prints the Markdown rows.
+
+EXECUTABLE="${EXECUTABLE:-./build/Railway_Simulator}"
+NETWORK="examples/network_complex.txt"
+TRAINS="examples/trains_complex.txt"
+RUNS="${RUNS:-200}"
+SEED=1000
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Timetable B: ExpressLine leaves at 06h20 instead of 06h40.
+sed 's/^\(ExpressLine .*\) 06h40 /\1 06h20 /' "$TRAINS" > "$WORK/trains_b.txt"
+
+# run <name> <trains> <seed> <sampling>: per-run CSV saved as $WORK/<name>.csv
+run()
+{
+    "$EXECUTABLE" "$NETWORK" "$2" --monte-carlo="$RUNS" --seed="$3" --sampling="$4" --run-csv > /dev/null \
+        || { echo "Run $1 failed" >&2; exit 1; }
+    cp output/monte_carlo_results.csv "$WORK/$1.csv"
+}
+
+run a_indep       "$TRAINS"             "$SEED"  independent
+run b_indep_other "$WORK/trains_b.txt"  2000     independent
+run b_indep       "$WORK/trains_b.txt"  "$SEED"  independent
+run a_crn         "$TRAINS"             "$SEED"  crn
+run b_crn         "$WORK/trains_b.txt"  "$SEED"  crn
+run a_anti        "$TRAINS"             "$SEED"  antithetic
+
+# Prints "<metric>\n" per run: tt (sum of *_actualTime), totalDuration,
+# collisionAvoidances, in file order.
+metrics()
+{
+    awk -F, -v metric="$2" '
+        NR == 1 { for (i = 1; i <= NF; ++i) { column[$i] = i; if ($i ~ /_actualTime$/) tt[i] = 1 } next }
+        {
+            if (metric == "tt") { v = 0; for (i in tt) v += $i; print v }
+            else                { print $(column[metric]) }
+        }' "$WORK/$1.csv"
+}
+
+# Sample variance of the differences between two runs files, row by row.
+diffVariance()
+{
+    paste -d' ' <(metrics "$1" tt) <(metrics "$2" tt) | awk '
+        { d = $1 - $2; n++; s += d; ss += d * d }
+        END { m = s / n; printf "%.0f %.0f\n", (ss - n * m * m) / (n - 1), m }'
+}
+
+echo "### Var(tt_A - tt_B)"
+read -r reference meanOther <<< "$(diffVariance a_indep b_indep_other)"
+read -r shared    meanShared <<< "$(diffVariance a_indep b_indep)"
+read -r crn       meanCrn    <<< "$(diffVariance a_crn b_crn)"
+awk -v r="$reference" -v s="$shared" -v c="$crn" 'BEGIN {
+    printf "| independent, different seeds for A and B    | %16s | %8.1fx |\n", r, 1.0
+    printf "| independent, same seeds (shared stream)     | %16s | %8.0fx |\n", s, r / s
+    printf "| crn, same seeds (per-site streams)          | %16s | %8.0fx |\n", c, r / c
+}'
+echo "mean differences: $meanOther (different seeds), $meanShared (shared), $meanCrn (crn)"
+
+echo "### Antithetic"
+for metric in tt totalDuration collisionAvoidances; do
+    # Baseline: crn runs (same per-site streams, no mirroring), one sample
+    # each.  Antithetic: consecutive rows form a pair.
+    paste -d' ' <(metrics a_crn "$metric") <(metrics a_anti "$metric") | awk -v metric="$metric" '
+        {
+            n++; s += $1; ss += $1 * $1; sa += $2; ssa += $2 * $2
+            if (n % 2) { x = $2 } else {
+                y = $2; p++
+                sx += x; sy += y; sxx += x * x; syy += y * y; sxy += x * y
+                pm = (x + y) / 2; sp += pm; spp += pm * pm
+            }
+        }
+        END {
+            varBase = (ss - s * s / n) / (n - 1)
+            varAnti = (ssa - sa * sa / n) / (n - 1)
+            varPair = (spp - sp * sp / p) / (p - 1)
+            cov     = (sxy - sx * sy / p) / (p - 1)
+            rho     = cov / sqrt(((sxx - sx * sx / p) / (p - 1)) * ((syy - sy * sy / p) / (p - 1)))
+            # Estimator variance: baseline varBase / n, antithetic varPair / p.
+            printf "| %-20s | %+16.2f | %9.2fx | %13.2fx | %12.2fx |\n",
+                   metric, rho, 1 + rho, varAnti / varBase, (varPair / p) / (varBase / n)
+        }'
+done
@@ -11,6 +11,7 @@
 
 class IOutputWriter;
 class IRunModeHandler;
+class RunSession;
 
 // Orchestrates run-mode selection and simulation lifecycle at a high level.
 class Application
@@ -26,6 +27,10 @@ private:
 
     void registerModeHandlers();
     void printConfiguration(const std::string& netFile, const std::string& trainFile) const;
+    int  runTraceCommand() const;
+    int  runGenerateCommand() const;
+    int  runProfiled(IRunModeHandler& handler, const std::string& netFile,
+                     const std::string& trainFile, RunSession& session) const;
 
 public:
     Application(int argc, char* argv[]);
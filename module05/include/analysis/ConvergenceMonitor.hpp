@@ -0,0 +1,58 @@
+#ifndef CONVERGENCE_MONITOR_HPP
+#define CONVERGENCE_MONITOR_HPP
+
+#include <string>
+#include <vector>
+
+class MonteCarloAggregator;
+class RunningStats;
+
+// Stopping rule for convergence-driven Monte Carlo.  A metric has converged
+// when the confidence-interval half-width of its mean, relative to the mean,
+// is at most relativeTolerance.
+struct ConvergenceCriteria
+{
+    // Watched metrics: "totalDuration", "totalEvents", "collisionAvoidances",
+    // "trainActualTime" or "trainDelay" (the last two require every train).
+    std::vector<std::string> metrics           = {"trainDelay"};
+    double                   relativeTolerance = 0.05;
+    double                   zScore            = 1.96;  // 95% confidence
+    unsigned int             minRuns           = 10;
+    unsigned int             checkInterval     = 10;    // Runs between checks
+    double                   timeBudgetSeconds = 0.0;   // 0 = unlimited
+};
+
+// Outcome of a convergence-driven runAll().
+struct ConvergenceReport
+{
+    bool         converged              = false;
+    unsigned int runs                   = 0;
+    double       worstRelativeHalfWidth = 0.0;
+    std::string  worstMetric;
+    std::string  stopReason;  // "converged", "max runs" or "time budget"
+};
+
+class ConvergenceMonitor
+{
+public:
+    // Throws std::invalid_argument on unknown metric names or non-positive
+    // tolerance.
+    explicit ConvergenceMonitor(const ConvergenceCriteria& criteria);
+
+    const ConvergenceCriteria& getCriteria() const;
+
+    // True when runCount is a checkpoint (>= minRuns, on the interval).
+    bool isCheckpoint(unsigned int runCount) const;
+
+    // Evaluates every watched metric; report receives the worst one.
+    bool evaluate(const MonteCarloAggregator& aggregate, ConvergenceReport& report) const;
+
+    // z * SE / |mean|; infinite while fewer than two samples, 0 for a
+    // constant-zero metric.
+    static double relativeHalfWidth(const RunningStats& stats, double zScore);
+
+private:
+    ConvergenceCriteria _criteria;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MONTE_CARLO_AGGREGATOR_HPP
+#define MONTE_CARLO_AGGREGATOR_HPP
+
+#include "analysis/RunningStats.hpp"
+#include "analysis/QuantileSketch.hpp"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+struct SimulationMetrics;
+
+// Moments plus a quantile sketch for one scalar metric.
+struct MetricSummary
+{
+    RunningStats   moments;
+    QuantileSketch distribution;
+
+    void add(double value);
+    void merge(const MetricSummary& other);
+};
+
+// Streaming summary of many Monte Carlo runs.  Each run is folded in and can
+// then be discarded, so memory depends on the number of trains, not runs.
+class MonteCarloAggregator
+{
+public:
+    struct TrainSummary
+    {
+        MetricSummary actualTime;       // Seconds, over runs that reached the destination
+        MetricSummary delay;            // actualTime - estimatedTime, same runs
+        RunningStats  eventsAffecting;
+        RunningStats  reached;          // 1/0 per run; mean is the arrival rate
+    };
+
+    MonteCarloAggregator();
+
+    void add(const SimulationMetrics& run);
+
+    // Folds the mean of two paired runs (e.g. antithetic twins) as one sample.
+    // Train times count only when both runs reached the destination.
+    void addPair(const SimulationMetrics& first, const SimulationMetrics& second);
+    void merge(const MonteCarloAggregator& other);
+
+    std::uint64_t getRunCount() const;
+
+    const MetricSummary& getTotalDuration()       const;
+    const MetricSummary& getTotalEvents()         const;
+    const MetricSummary& getCollisionAvoidances() const;
+
+    const std::map<std::string, TrainSummary>& getTrains() const;
+
+    // One row per metric: metric,count,mean,stddev,min,p05,p50,p95,max.
+    void writeCSV(std::ostream& out) const;
+
+private:
+    std::uint64_t                       _runCount;
+    MetricSummary                       _totalDuration;
+    MetricSummary                       _totalEvents;
+    MetricSummary                       _collisionAvoidances;
+    std::map<std::string, TrainSummary> _trains;
+};
+
+#endif
@@ -2,18 +2,41 @@
 #define MONTE_CARLO_RUNNER_HPP
 
 #include "analysis/StatsCollector.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/ConvergenceMonitor.hpp"
 #include "simulation/core/SimulationManager.hpp"
 
+#include <fstream>
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
-class Graph;
 class Train;
-class IPathfindingStrategy;
 class ILogger;
-struct TrainConfig;
+class ScenarioTrainPool;
 
+// How run i draws its event randomness.
+enum class SamplingMode
+{
+    Independent,          // One shared stream seeded baseSeed + i (legacy)
+    CommonRandomNumbers,  // Per-decision-site streams seeded baseSeed + i; two
+                          // configurations run with the same seeds see aligned events
+    Antithetic            // Per-site streams; runs 2k and 2k+1 share seed baseSeed + 2k
+                          // and the second mirrors every draw (u -> 1 - u)
+};
+
+// Runs the same scenario under consecutive seeds and collects per-run metrics.
+// Runs are distributed over a worker pool (see setThreads()); each worker owns
+// its own SimulationManager, StatsCollector and train pool over one shared
+// PreparedScenario.  Finished runs are committed in seed order into a
+// streaming MonteCarloAggregator (and optionally a per-run CSV), so memory
+// does not grow with the run count and output is identical for any thread
+// count.
 class MonteCarloRunner
 {
 public:
@@ -25,8 +48,35 @@ public:
                      const std::string& pathfindingAlgo,
                      ILogger*           logger = nullptr);
 
+    // Number of worker threads used by runAll(); clamped to [1, numRuns].
+    void         setThreads(unsigned int threads);
+    unsigned int getThreads() const;
+
+    // Streams one row per run to filename during runAll(); empty disables.
+    void setRunsCSV(const std::string& filename);
+
+    void         setSampling(SamplingMode mode);
+    SamplingMode getSampling() const;
+
+    // Seed and mirroring used for run index i under the current sampling mode.
+    unsigned int seedForRun(unsigned int index)       const;
+    bool         isAntitheticRun(unsigned int index) const;
+
+    // Stops runAll() as soon as the criteria are met; numRuns becomes the
+    // run cap.  Checks happen on committed (seed-ordered) runs, so the stop
+    // point does not depend on the thread count unless the time budget hits.
+    void                     setConvergence(const ConvergenceCriteria& criteria);
+    const ConvergenceReport& getConvergenceReport() const;
+
     void runAll();
-    void writeCSV(const std::string& filename) const;
+    void writeSummaryCSV(const std::string& filename) const;
+
+    // Summary over every committed run; valid after runAll().
+    const MonteCarloAggregator& getAggregate() const;
+
+    // Antithetic mode only: one sample per completed pair (the pair mean).
+    // Confidence intervals for the estimated means must use these samples.
+    const MonteCarloAggregator& getPairAggregate() const;
 
 private:
     std::string  _networkFile;
@@ -35,41 +85,57 @@ private:
     unsigned int _numRuns;
     std::string  _pathfindingAlgo;
     ILogger*     _logger;
+    unsigned int _threads;
+    SamplingMode _sampling;
 
-    std::vector<SimulationMetrics> _allMetrics;
+    // Parsed and routed once on the first runAll(), then shared by all workers.
+    std::unique_ptr<PreparedScenario> _scenario;
 
-    // Owned simulation instance — reset() called between runs.
-    SimulationManager _sim;
+    MonteCarloAggregator _aggregate;
+    MonteCarloAggregator _pairAggregate;
+    SimulationMetrics    _pairFirst;  // Even run waiting for its antithetic twin
 
-    SimulationMetrics runSingleSimulation(unsigned int seed);
-    Graph*                   parseNetwork() const;
-    std::vector<TrainConfig> parseTrains()  const;
+    // Optional per-run CSV; columns are the scenario's train names.
+    std::string              _runsCSVPath;
+    std::ofstream            _runsCSV;
+    std::vector<std::string> _csvTrainNames;
 
-    IPathfindingStrategy* selectStrategy(IPathfindingStrategy& dijkstra,
-                                         IPathfindingStrategy& astar);
+    // Runs finished ahead of _nextCommit wait here so they are folded in
+    // seed order; the backlog is bounded by how far workers drift apart.
+    std::mutex                                _commitMutex;
+    std::map<unsigned int, SimulationMetrics> _pending;
+    unsigned int                              _nextCommit;
 
-    std::vector<Train*> buildTrains(Graph* graph, StatsCollector& stats,
-                                    IPathfindingStrategy* strategy);
+    // Runs with index >= _stopAt are neither started nor committed.
+    std::atomic<unsigned int> _stopAt;
 
-    void setupSimulation(Graph* graph, const std::vector<Train*>& trains,
-                         StatsCollector& stats, unsigned int seed);
+    std::unique_ptr<ConvergenceMonitor>   _convergence;
+    ConvergenceReport                     _convergenceReport;
+    std::chrono::steady_clock::time_point _deadline;
 
-    void runSimulationLoop(const std::vector<Train*>& trains,
-                           StatsCollector& stats,
-                           std::map<Train*, double>& departureTime,
-                           std::map<Train*, double>& arrivalTime);
+    // Aggregate whose moments give the estimator's confidence interval.
+    const MonteCarloAggregator& estimatorAggregate() const;
 
-    SimulationMetrics finalizeMetrics(StatsCollector& stats,
-                                      const std::vector<Train*>& trains,
-                                      const std::map<Train*, double>& departureTime,
-                                      const std::map<Train*, double>& arrivalTime);
+    // Called under _commitMutex after each in-order commit.
+    void checkStopConditions();
+    void stopAfterCommitted(const std::string& reason);
 
-    void cleanup(Graph* graph, std::vector<Train*>& trains);
+    // Serialises logger access from worker threads.
+    mutable std::mutex _logMutex;
 
-    void log(const std::string& message) const;
+    // Worker body: claims run indices from nextRun until all runs are taken.
+    void runWorker(std::atomic<unsigned int>& nextRun);
+
+    void commitRun(unsigned int index, SimulationMetrics metrics);
 
-    // Returns estimated journey duration in seconds for a fully-pathed train.
-    static double estimateJourneySeconds(const Train* train);
+    void openRunsCSV();
+    void writeRunRow(const SimulationMetrics& metrics);
+
+    SimulationMetrics runSingleSimulation(SimulationManager& sim,
+                                          ScenarioTrainPool& pool,
+                                          unsigned int index);
+
+    void log(const std::string& message) const;
 };
 
 #endif
\ No newline at end of file
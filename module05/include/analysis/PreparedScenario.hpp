@@ -0,0 +1,58 @@
+#ifndef PREPARED_SCENARIO_HPP
+#define PREPARED_SCENARIO_HPP
+
+#include "core/Train.hpp"
+#include "patterns/creational/factories/TrainFactory.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Graph;
+class ILogger;
+class RailFootprintIndex;
+
+// Parsed network, validated train configs and routed paths, built once and
+// then shared read-only by every Monte Carlo run (and every worker thread).
+// Dynamic rail attributes live in each run's SimulationContext overlay, so
+// the graph is never mutated while a run is in progress.  The weather
+// footprint cache over the network is shared too, and fills across runs.
+class PreparedScenario
+{
+public:
+    struct TrainPlan
+    {
+        TrainConfig config;
+        Train::Path path;
+        double      estimatedSeconds;  // Free-running journey time at base speed limits
+    };
+
+    // Parses both files and routes every valid train with pathfindingAlgo
+    // ("astar" or Dijkstra otherwise).  Skipped trains are reported through
+    // logger, which may be nullptr.  Throws on parse errors.
+    PreparedScenario(const std::string& networkFile,
+                     const std::string& trainFile,
+                     const std::string& pathfindingAlgo,
+                     ILogger*           logger = nullptr);
+    ~PreparedScenario();
+
+    PreparedScenario(const PreparedScenario&)            = delete;
+    PreparedScenario& operator=(const PreparedScenario&) = delete;
+
+    Graph*                        getNetwork()    const;
+    const std::vector<TrainPlan>& getTrains()     const;
+    RailFootprintIndex*           getFootprints() const;
+
+    static double estimateJourneySeconds(const Train::Path& path);
+
+private:
+    std::unique_ptr<Graph>              _network;
+    std::vector<TrainPlan>              _trains;
+    std::unique_ptr<RailFootprintIndex> _footprints;  // Thread-safe; see RailFootprintIndex
+
+    void routeTrains(const std::vector<TrainConfig>& configs,
+                     const std::string&              pathfindingAlgo,
+                     ILogger*                        logger);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mergeable streaming quantile sketch (KLL).  Level h holds items of weight
+// 2^h; when a level overflows it is sorted and every other item is promoted,
+// so memory stays O(k log(n/k)) while rank error stays around 1/k.  The
+// promotion offset alternates per level instead of being drawn at random,
+// which keeps results reproducible for a given insertion order.
+class QuantileSketch
+{
+public:
+    static constexpr std::size_t DEFAULT_K = 128;
+
+    explicit QuantileSketch(std::size_t k = DEFAULT_K);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    // Approximate value at rank q in [0, 1]; exact at 0 and 1.  Returns 0
+    // for an empty sketch.
+    double quantile(double q) const;
+
+    std::uint64_t count()    const;
+    std::size_t   retained() const;  // Items currently stored across levels
+
+private:
+    std::size_t                      _k;
+    std::uint64_t                    _count;
+    double                           _min;
+    double                           _max;
+    std::vector<std::vector<double>> _levels;
+    std::vector<unsigned char>       _offsets;  // Next promotion offset per level
+
+    std::size_t capacity(std::size_t level) const;
+    std::size_t totalCapacity()             const;
+    void        compress();
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef RUNNING_STATS_HPP
+#define RUNNING_STATS_HPP
+
+#include <cstdint>
+
+// Online mean/variance (Welford) with min/max.  O(1) memory; two instances
+// built over disjoint samples merge exactly (Chan et al.).
+class RunningStats
+{
+public:
+    RunningStats();
+
+    void add(double value);
+    void merge(const RunningStats& other);
+
+    std::uint64_t count()    const;
+    double        mean()     const;
+    double        variance() const;  // Sample variance (n - 1); 0 below two samples
+    double        stddev()   const;
+    double        min()      const;
+    double        max()      const;
+
+    // Standard error of the mean: stddev / sqrt(n).
+    double standardError() const;
+
+private:
+    std::uint64_t _count;
+    double        _mean;
+    double        _m2;    // Sum of squared deviations from the mean
+    double        _min;
+    double        _max;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef SCENARIO_RUN_HPP
+#define SCENARIO_RUN_HPP
+
+#include "analysis/StatsCollector.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+
+#include <map>
+#include <vector>
+
+class PreparedScenario;
+class SimulationManager;
+class Train;
+
+// One headless, silent run of a PreparedScenario, driven step by step to
+// completion.  Shared by MonteCarloRunner and SweepRunner so batch modes
+// measure runs identically.  sim is reset() before and after, so a worker
+// can reuse one SimulationManager for all its runs.
+class ScenarioRun
+{
+public:
+    // trains are the scenario's trains in plan order (see ScenarioTrainPool).
+    // config.network and config.footprints are replaced by the scenario's;
+    // config.writer must be nullptr.
+    static SimulationMetrics execute(SimulationManager&         sim,
+                                     const PreparedScenario&    scenario,
+                                     const std::vector<Train*>& trains,
+                                     SimulationConfig           config);
+
+private:
+    static void runLoop(SimulationManager&         sim,
+                        const std::vector<Train*>& trains,
+                        StatsCollector&            stats,
+                        std::map<Train*, double>&  departureTime,
+                        std::map<Train*, double>&  arrivalTime);
+
+    static SimulationMetrics finalizeMetrics(SimulationManager&              sim,
+                                             StatsCollector&                 stats,
+                                             const std::vector<Train*>&      trains,
+                                             const std::map<Train*, double>& departureTime,
+                                             const std::map<Train*, double>& arrivalTime);
+};
+
+#endif
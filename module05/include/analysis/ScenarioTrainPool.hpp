@@ -0,0 +1,41 @@
+#ifndef SCENARIO_TRAIN_POOL_HPP
+#define SCENARIO_TRAIN_POOL_HPP
+
+#include <memory>
+#include <vector>
+
+class PreparedScenario;
+class Train;
+
+// Multipliers applied to every train's configured physics (1.0 = as parsed).
+struct TrainPhysicsScale
+{
+    double mass          = 1.0;
+    double friction      = 1.0;
+    double maxAccelForce = 1.0;
+    double maxBrakeForce = 1.0;
+};
+
+// One Train per scenario plan, allocated once and rewound before every run.
+// Each Monte Carlo worker owns its own pool; the scenario itself is shared.
+class ScenarioTrainPool
+{
+public:
+    explicit ScenarioTrainPool(const PreparedScenario& scenario);
+    ~ScenarioTrainPool();
+
+    ScenarioTrainPool(const ScenarioTrainPool&)            = delete;
+    ScenarioTrainPool& operator=(const ScenarioTrainPool&) = delete;
+
+    // Resets every train to its planned path, departure time and physics
+    // (scaled by physics).  Trains are returned in scenario order and stay
+    // owned by the pool.
+    const std::vector<Train*>& acquire(const TrainPhysicsScale& physics = TrainPhysicsScale());
+
+private:
+    const PreparedScenario&             _scenario;
+    std::vector<std::unique_ptr<Train>> _storage;
+    std::vector<Train*>                 _trains;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef SWEEP_RUNNER_HPP
+#define SWEEP_RUNNER_HPP
+
+#include "analysis/StatsCollector.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/SweepSpec.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ILogger;
+class SimulationManager;
+class ScenarioTrainPool;
+
+// Runs a Monte Carlo batch at every point of a SweepSpec.  The scenario is
+// parsed and routed once; every (point, seed) pair is one job.  Jobs are dealt
+// round-robin into per-worker deques; a worker pops its own front and, once
+// empty, steals from the back of another's, so short points never leave
+// threads idle while long ones finish.  Each point reuses seeds baseSeed .. baseSeed + runs - 1
+// with per-site event streams, so points are compared under common random
+// numbers.  Results are committed in job order (identical for any thread
+// count) into one tidy CSV: a row per (point, seed, train).
+class SweepRunner
+{
+public:
+    // logger may be nullptr for silent execution.  Throws on invalid spec or
+    // unreadable inputs.
+    SweepRunner(const std::string& networkFile,
+                const std::string& trainFile,
+                const SweepSpec&   spec,
+                unsigned int       baseSeed,
+                const std::string& pathfindingAlgo,
+                ILogger*           logger = nullptr);
+    ~SweepRunner();
+
+    SweepRunner(const SweepRunner&)            = delete;
+    SweepRunner& operator=(const SweepRunner&) = delete;
+
+    void         setThreads(unsigned int threads);
+    unsigned int getThreads() const;
+
+    // Streams the tidy results table to filename during runAll(); empty disables.
+    void setResultsCSV(const std::string& filename);
+
+    void runAll();
+
+    const std::vector<SweepPoint>& getPoints() const;
+
+    // Per-point summary over its runs; valid after runAll().
+    const MonteCarloAggregator& getPointAggregate(std::size_t point) const;
+
+private:
+    SweepSpec                         _spec;
+    unsigned int                      _baseSeed;
+    ILogger*                          _logger;
+    unsigned int                      _threads;
+    std::unique_ptr<PreparedScenario> _scenario;
+    std::vector<SweepPoint>           _points;
+    std::vector<MonteCarloAggregator> _aggregates;
+
+    std::string   _resultsCSVPath;
+    std::ofstream _resultsCSV;
+
+    // Jobs finished ahead of _nextCommit wait here (see MonteCarloRunner).
+    std::mutex                               _commitMutex;
+    std::map<std::size_t, SimulationMetrics> _pending;
+    std::size_t                              _nextCommit;
+
+    // One deque per worker.  The owner takes from the front (job order, so
+    // commits stay close behind); thieves take from the back.
+    struct WorkerQueue
+    {
+        std::mutex              mutex;
+        std::deque<std::size_t> jobs;
+    };
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+
+    mutable std::mutex _logMutex;
+
+    std::size_t jobCount() const;
+
+    void              dealJobs(std::size_t workerCount);
+    bool              takeJob(std::size_t worker, std::size_t& job);
+    void              runWorker(std::size_t worker, std::atomic<bool>& failed);
+    SimulationMetrics runJob(SimulationManager& sim, ScenarioTrainPool& pool, std::size_t job);
+    void              commitJob(std::size_t job, SimulationMetrics metrics);
+
+    void openResultsCSV();
+    void writeResultRows(std::size_t point, const SimulationMetrics& metrics);
+
+    void log(const std::string& message) const;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SWEEP_SPEC_HPP
+#define SWEEP_SPEC_HPP
+
+#include "analysis/ScenarioTrainPool.hpp"
+#include "event_system/EventParameters.hpp"
+
+#include <string>
+#include <vector>
+
+// One swept parameter: its range and, for grid designs, how many evenly
+// spaced levels to take across it (min and max included).
+struct SweepParameter
+{
+    std::string  name;
+    double       min;
+    double       max;
+    unsigned int levels;
+};
+
+// One point of the design: the sampled values (in SweepSpec parameter
+// order) and the simulation settings they translate to.
+struct SweepPoint
+{
+    std::vector<double> values;
+    EventParameters     events;
+    TrainPhysicsScale   physics;
+};
+
+// Design over event probabilities/durations and train physics multipliers.
+// Parameter names:
+//   <event>.probability, <event>.minMinutes, <event>.maxMinutes
+//     with <event> one of stationDelay, trackMaintenance, signalFailure, weather
+//   train.massScale, train.frictionScale, train.accelScale, train.brakeScale
+// Parameters not swept keep their defaults.
+class SweepSpec
+{
+public:
+    enum class Design
+    {
+        Grid,           // Cartesian product of every parameter's levels
+        LatinHypercube  // samples points, each parameter stratified into samples bins
+    };
+
+    SweepSpec();
+
+    void         setDesign(Design design);
+    Design       getDesign() const;
+    void         setSamples(unsigned int samples);  // Latin hypercube point count
+    unsigned int getSamples() const;
+    void         setRunsPerPoint(unsigned int runs);
+    unsigned int getRunsPerPoint() const;
+
+    // Throws std::invalid_argument for unknown names, duplicates, inverted
+    // or out-of-domain ranges.
+    void addParameter(const SweepParameter& parameter);
+    const std::vector<SweepParameter>& getParameters() const;
+
+    // Expands the design into points.  Grid points vary the last parameter
+    // fastest; Latin hypercube strata are permuted and jittered with streams
+    // keyed by seed, so the same seed always yields the same design.
+    std::vector<SweepPoint> expand(unsigned int seed) const;
+
+    static bool isKnownParameter(const std::string& name);
+
+    // Writes value into the setting named by name (minutes are rounded).
+    static void apply(const std::string& name, double value, SweepPoint& point);
+
+private:
+    Design                      _design;
+    unsigned int                _samples;
+    unsigned int                _runsPerPoint;
+    std::vector<SweepParameter> _parameters;
+
+    std::vector<SweepPoint> expandGrid() const;
+    std::vector<SweepPoint> expandLatinHypercube(unsigned int seed) const;
+    SweepPoint              makePoint(const std::vector<double>& values) const;
+};
+
+#endif
@@ -3,6 +3,26 @@
 
 #include "app/IRunModeHandler.hpp"
 
+class CompileModeHandler : public IRunModeHandler
+{
+public:
+    bool matches(const CLI& cli) const override;
+
+    int run(const std::string& netFile,
+            const std::string& trainFile,
+            RunSession& session) override;
+};
+
+class SweepModeHandler : public IRunModeHandler
+{
+public:
+    bool matches(const CLI& cli) const override;
+
+    int run(const std::string& netFile,
+            const std::string& trainFile,
+            RunSession& session) override;
+};
+
 class MonteCarloModeHandler : public IRunModeHandler
 {
 public:
@@ -43,6 +63,16 @@ public:
             RunSession& session) override;
 };
 
+class LiveFeedModeHandler : public IRunModeHandler
+{
+public:
+    bool matches(const CLI& cli) const override;
+
+    int run(const std::string& netFile,
+            const std::string& trainFile,
+            RunSession& session) override;
+};
+
 class ConsoleModeHandler : public IRunModeHandler
 {
 public:
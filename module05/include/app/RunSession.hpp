@@ -11,6 +11,7 @@ class CLI;
 class IOutputWriter;
 class FileOutputWriter;
 class CommandManager;
+class LiveTrainFeed;
 
 class RunSession
 {
@@ -25,6 +26,19 @@ public:
                          SimulationBundle& outBundle,
                          int seedOverride = -1);
 
+    // Apply edited files to the running simulation (SimulationBuilder::reload).
+    // On failure the error is reported and bundle keeps running unchanged.
+    bool reloadSimulation(const std::string& netFile,
+                          const std::string& trainFile,
+                          SimulationBundle& bundle);
+
+    // Live feed routing on bundle's network with the session's pathfinding.
+    std::unique_ptr<LiveTrainFeed> createLiveFeed(const std::string& source, SimulationBundle& bundle) const;
+
+    // Add a train to the running simulation with its own output writer.
+    // False (train not taken) when a train of that name already exists.
+    bool addLiveTrain(Train* train, const TrainConfig& config, SimulationBundle& bundle);
+
     void teardownSimulation(SimulationBundle& bundle);
 
     void finishRun(CommandManager* cmdMgr,
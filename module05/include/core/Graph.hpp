@@ -20,7 +20,10 @@ public:
 private:
 	std::vector<std::unique_ptr<Node>> _nodes;
 	std::vector<std::unique_ptr<Rail>> _rails;
+	NodeList _nodeList;  // Raw views of _nodes/_rails handed out without copying
+	RailList _railList;
 	AdjacencyMap _adjacency;
+	std::map<std::string, Node*, std::less<>> _nodesByName;  // Name lookup for parsers
 
 	bool nodeExistsInGraph(Node* node) const;
 
@@ -34,19 +37,22 @@ public:
 	void addNode(Node* node);
 	Node* getNode(const std::string& name);
 	const Node* getNode(const std::string& name) const;
-	NodeList getNodes() const;
+	const NodeList& getNodes() const override;
 	bool hasNode(const std::string& name) const;
 	size_t getNodeCount() const;
 
 	// Rail management
 	void addRail(Rail* rail);
-	RailList getRails() const;
+	const RailList& getRails() const override;
 	size_t getRailCount() const;
 
 	// Adjacency queries
-	RailList getRailsFromNode(Node* node) const;
+	const RailList& getRailsFromNode(Node* node) const override;
 	std::vector<Node*> getNeighbors(Node* node) const;
 
+	// Approximate bytes held by the graph (see MemoryReport)
+	std::size_t getMemoryUsage() const;
+
 	// Validation
 	bool isValid() const;
 	void clear();
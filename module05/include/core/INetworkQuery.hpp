@@ -1,10 +1,10 @@
 #ifndef INETWORKQUERY_HPP
 #define INETWORKQUERY_HPP
 
+#include "core/Rail.hpp"
 #include <vector>
 
 class Node;
-class Rail;
 
 // Narrow read-only interface that EventFactory needs from the network.
 // Graph implements this; EventFactory depends only on this interface,
@@ -13,8 +13,12 @@ class INetworkQuery
 public:
     virtual ~INetworkQuery() = default;
 
-    virtual std::vector<Node*> getNodes() const = 0;
-    virtual std::vector<Rail*> getRails() const = 0;
+    // Views stay valid until the network changes.
+    virtual const std::vector<Node*>& getNodes() const = 0;
+    virtual const std::vector<Rail*>& getRails() const = 0;
+
+    // Rails incident to node (empty for an unknown node).
+    virtual const std::vector<Rail*>& getRailsFromNode(Node* node) const = 0;
 };
 
 #endif
\ No newline at end of file
@@ -1,19 +1,27 @@
 #ifndef RAIL_HPP
 #define RAIL_HPP
 
+#include <cstddef>
+
 class Node;
 
 // Represents a bidirectional rail segment connecting two nodes.
 // Runtime occupancy (which trains are currently on this rail) has been moved
 // to OccupancyMap, owned by CollisionAvoidance.  Rail is now a pure geometric
 // data class with no dependency on Train.
+// Rail attributes are immutable once loaded: per-run modifiers (event speed
+// reductions, added friction) live in RailAttributeOverlay, indexed by getID().
 class Rail
 {
+public:
+    static constexpr std::size_t INVALID_ID = static_cast<std::size_t>(-1);
+
 private:
-    Node*  _nodeA;
-    Node*  _nodeB;
-    double _length;      // km
-    double _speedLimit;  // km/h
+    Node*       _nodeA;
+    Node*       _nodeB;
+    double      _length;      // km
+    double      _speedLimit;  // km/h
+    std::size_t _id;          // Dense index assigned by Graph::addRail
 
 public:
     Rail();
@@ -26,7 +34,10 @@ public:
     Node*  getNodeB()      const;
     double getLength()     const;
     double getSpeedLimit() const;
-    void   setSpeedLimit(double speedLimit);
+
+    // Dense id in [0, Graph::getRailCount()), INVALID_ID until added to a Graph.
+    std::size_t getID()                  const;
+    void        setID(std::size_t id);
 
     bool   isValid()                const;
     Node*  getOtherNode(Node* node) const;
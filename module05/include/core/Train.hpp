@@ -1,12 +1,15 @@
 #ifndef TRAIN_HPP
 #define TRAIN_HPP
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 #include "utils/Time.hpp"
 
 class Rail;
 class ITrainState;
+class IPhysicsQueries;
 class Time;
 class Node;
 class Event;
@@ -54,7 +57,10 @@ private:
     // State pattern
     ITrainState* _currentState;
 
-    static int _nextID;
+    // Atomic so trains can be built concurrently (parallel Monte Carlo).
+    static std::atomic<int> _nextID;
+
+    Train(const Train&) = default;  // clone() only: the copy keeps the ID
 
 public:
     Train();
@@ -64,22 +70,28 @@ public:
           const Time& departureTime, const Time& stopDuration);
     ~Train() = default;
 
-    Train(const Train&)            = delete;
     Train& operator=(const Train&) = delete;
     Train(Train&&)                  = delete;
     Train& operator=(Train&&)       = delete;
 
+    // Independent copy with the same ID, physics, path and journey state
+    // (SimulationManager::fork).  The state pointer still refers to the
+    // original's StateRegistry until the copy is added to a simulation.
+    std::unique_ptr<Train> clone() const;
+
     // Identity
-    std::string getName()     const;
-    int         getID()       const;
-    bool        isFinished()  const;
-    void        markFinished();
+    const std::string& getName()     const;
+    int                getID()       const;
+    bool               isFinished()  const;
+    void               markFinished();
 
     // Physical properties
     double getMass()          const;
     double getFrictionCoef()  const;
     double getMaxAccelForce() const;
     double getMaxBrakeForce() const;
+    void   setPhysics(double mass, double frictionCoef,
+                      double maxAccelForce, double maxBrakeForce);
 
     // Motion state
     double getVelocity()            const;
@@ -88,11 +100,11 @@ public:
     void   setPosition(double p);
 
     // Journey
-    std::string getDepartureStation() const;
-    std::string getArrivalStation()   const;
-    Time        getDepartureTime()    const;
-    Time        getStopDuration()     const;
-    void        setDepartureTime(const Time& time);
+    const std::string& getDepartureStation() const;
+    const std::string& getArrivalStation()   const;
+    Time               getDepartureTime()    const;
+    Time               getStopDuration()     const;
+    void               setDepartureTime(const Time& time);
 
     // Path management
     const Path&        getPath()               const;
@@ -103,6 +115,13 @@ public:
     void               advanceToNextRail();
     void               reverseJourney();
 
+    // Returns the train to its pre-departure state on path (stations follow
+    // the path's endpoints) so one object can be reused across runs.
+    void               resetJourney(const Path& path, const Time& departureTime);
+
+    // Approximate bytes held by the train and its path (see MemoryReport)
+    std::size_t getMemoryUsage() const;
+
     // State management
     ITrainState* getCurrentState() const;
     void         setState(ITrainState* state);
@@ -114,8 +133,9 @@ public:
     static void resetIDCounter();
     static int  getNextID();
 
-    // Update delegates to current state.
-    void update(double dt);
+    // Update delegates to current state.  physics provides the run's effective
+    // rail attributes; without it states fall back to base rail values.
+    void update(double dt, const IPhysicsQueries* physics = nullptr);
 
     // Helpers for collision/context queries.
     Node* getCurrentNode() const;
@@ -0,0 +1,21 @@
+#ifndef EVENTPARAMETERS_HPP
+#define EVENTPARAMETERS_HPP
+
+struct EventConfig
+{
+    double probabilityPerTimestep;
+    int    minDurationMinutes;
+    int    maxDurationMinutes;
+};
+
+// Per-minute probabilities and duration ranges of every event type.  The
+// defaults are the simulator's calibrated values; sweeps override them.
+struct EventParameters
+{
+    EventConfig stationDelay     = {0.03,  15,  45};
+    EventConfig trackMaintenance = {0.015, 60, 180};
+    EventConfig signalFailure    = {0.01,   5,  20};
+    EventConfig weather          = {0.005, 120, 300};
+};
+
+#endif
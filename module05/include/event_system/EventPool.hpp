@@ -0,0 +1,66 @@
+#ifndef EVENTPOOL_HPP
+#define EVENTPOOL_HPP
+
+#include "utils/ObjectPool.hpp"
+#include "events/StationDelayEvent.hpp"
+#include "events/TrackMaintenanceEvent.hpp"
+#include "events/SignalFailureEvent.hpp"
+#include "events/WeatherEvent.hpp"
+#include <type_traits>
+#include <utility>
+
+// Per-simulation typed pools for Event objects.
+// Owned by SimulationManager.  EventFactory creates events here and
+// EventScheduler hands them back through release() once they expire or the
+// schedule is cleared.  Events that were not allocated by this pool
+// (e.g. created with plain new in tests) are released with delete.
+class EventPool
+{
+private:
+    ObjectPool<StationDelayEvent>     _stationDelays;
+    ObjectPool<TrackMaintenanceEvent> _trackMaintenance;
+    ObjectPool<SignalFailureEvent>    _signalFailures;
+    ObjectPool<WeatherEvent>          _weather;
+
+public:
+    EventPool()  = default;
+    ~EventPool() = default;
+
+    EventPool(const EventPool&)            = delete;
+    EventPool& operator=(const EventPool&) = delete;
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_base_of<Event, T>::value, "EventPool only allocates Event types");
+
+        if constexpr (std::is_same<T, StationDelayEvent>::value)
+        {
+            return _stationDelays.create(std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_same<T, TrackMaintenanceEvent>::value)
+        {
+            return _trackMaintenance.create(std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_same<T, SignalFailureEvent>::value)
+        {
+            return _signalFailures.create(std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_same<T, WeatherEvent>::value)
+        {
+            return _weather.create(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return new T(std::forward<Args>(args)...);
+        }
+    }
+
+    // Destroys event and recycles its slot.  Safe with nullptr.
+    void release(Event* event);
+
+    // Aggregated counters across all event pools.
+    PoolStats stats() const;
+};
+
+#endif
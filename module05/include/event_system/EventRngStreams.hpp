@@ -0,0 +1,56 @@
+#ifndef EVENTRNGSTREAMS_HPP
+#define EVENTRNGSTREAMS_HPP
+
+#include "utils/StreamRng.hpp"
+#include <array>
+#include <cstddef>
+
+// Every random decision EventFactory makes, grouped by event type.
+enum class EventRngSite : std::size_t
+{
+    StationDelayTrigger,
+    StationDelayTarget,
+    StationDelayMagnitude,
+    MaintenanceTrigger,
+    MaintenanceTarget,
+    MaintenanceMagnitude,
+    SignalFailureTrigger,
+    SignalFailureTarget,
+    SignalFailureMagnitude,
+    WeatherTrigger,
+    WeatherTarget,
+    WeatherMagnitude,
+    Count
+};
+
+// One independent counter-based stream per decision site, keyed by
+// (seed, site).  A draw skipped at one site (e.g. a rejected event never
+// samples its duration) cannot shift the numbers seen by any other site,
+// which keeps runs that share a seed aligned across configurations (common
+// random numbers) and lets an antithetic twin mirror its partner site by site.
+// The run slot of the CounterRng key stays 0: Monte Carlo already gives run i
+// seed base + i, antithetic twins must share streams although their run
+// indices differ, and checkpoints and recordings only store the seed.
+class EventRngStreams
+{
+public:
+    static constexpr std::size_t SITE_COUNT = static_cast<std::size_t>(EventRngSite::Count);
+
+    EventRngStreams();
+
+    void reseed(unsigned int seed, bool antithetic);
+
+    // Inline: EventFactory draws through these on every tick.
+    StreamRng&       operator[](EventRngSite site)       { return _streams[static_cast<std::size_t>(site)]; }
+    const StreamRng& operator[](EventRngSite site) const { return _streams[static_cast<std::size_t>(site)]; }
+
+    unsigned int getSeed()     const;
+    bool         isAntithetic() const;
+
+private:
+    std::array<StreamRng, SITE_COUNT> _streams;
+    unsigned int                      _seed;
+    bool                              _antithetic;
+};
+
+#endif
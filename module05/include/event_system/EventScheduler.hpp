@@ -5,6 +5,7 @@
 #include <vector>
 
 class EventDispatcher;
+class EventPool;
 class Event;
 class Node;
 class Rail;
@@ -15,18 +16,23 @@ enum class EventType;
 // Activates scheduled events when their time arrives, expires active events
 // when they end, and delegates observer notification to EventDispatcher.
 // No knowledge of observer lists — calls dispatcher.notify() instead.
+// Owns every scheduled and active event; expired events are returned to the
+// EventPool they came from (or deleted when no pool is attached).
 class EventScheduler : public IEventScheduler
 {
 private:
     EventDispatcher&        _dispatcher;
+    EventPool*              _eventPool;
     std::vector<Event*>     _scheduledEvents;
     std::vector<Event*>     _activeEvents;
-    int                     _totalEventsGenerated = 0;\
-    
+    int                     _totalEventsGenerated = 0;
+
+    void destroyEvent(Event* event);
+
 public:
-    // dispatcher is non-owning; must outlive this object.
-    explicit EventScheduler(EventDispatcher& dispatcher);
-    ~EventScheduler() override = default;
+    // dispatcher and eventPool are non-owning; both must outlive this object.
+    explicit EventScheduler(EventDispatcher& dispatcher, EventPool* eventPool = nullptr);
+    ~EventScheduler() override;
 
     // IEventScheduler
     void scheduleEvent(Event* event)                      override;
@@ -39,6 +45,11 @@ public:
     int  getTotalEventsGenerated()                  const override;
     void clear()                                          override;
 
+    // Checkpoint restore: replaces the schedule with the given events (owned
+    // from now on) without activating, expiring or notifying any of them.
+    void restore(const std::vector<Event*>& scheduled,
+                 const std::vector<Event*>& active,
+                 int                        totalEventsGenerated);
 };
 
 #endif
\ No newline at end of file
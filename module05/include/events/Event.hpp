@@ -58,6 +58,10 @@ public:
     bool              isActive()       const;
     const VisualData& getVisualData()  const;
 
+    // Set the flag without activate()/deactivate(): a checkpoint restores
+    // the effects (rail overlay) itself.
+    void restoreActive(bool active);
+
     virtual std::string getDescription()                   const = 0;
     virtual bool        affectsNode(Node* node)            const = 0;
     virtual bool        affectsRail(Rail* rail)            const = 0;
@@ -4,17 +4,22 @@
 #include "Event.hpp"
 #include "utils/Time.hpp"
 
-// Event: Rail segment has reduced speed limit during maintenance
+class RailAttributeOverlay;
+
+// Event: Rail segment has reduced speed limit during maintenance.
+// The reduction is applied to the run's RailAttributeOverlay; the Rail itself
+// is never modified.  Without an overlay the event is informational only.
 class TrackMaintenanceEvent : public Event
 {
 private:
-	Rail*  _rail;                 // Which rail is under maintenance
-	double _speedReductionFactor; // 0.0-1.0 (e.g., 0.6 = 60% of original speed)
-	double _originalSpeedLimit;   // Stored for restoration
+	Rail*                 _rail;                 // Which rail is under maintenance
+	double                _speedReductionFactor; // 0.0-1.0 (e.g., 0.6 = 60% of original speed)
+	RailAttributeOverlay* _railAttributes;       // Per-run overlay receiving the modifier
 
 public:
 	TrackMaintenanceEvent(Rail* rail, const Time& startTime,
-	                      const Time& duration, double speedReductionFactor);
+	                      const Time& duration, double speedReductionFactor,
+	                      RailAttributeOverlay* railAttributes = nullptr);
 
 	void activate() override;
 	void deactivate() override;
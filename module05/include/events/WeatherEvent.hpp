@@ -6,22 +6,27 @@
 #include <vector>
 #include <string>
 
-// Event: Weather affects multiple rails within radius
+class RailAttributeOverlay;
+
+// Event: Weather affects multiple rails within radius.
+// Speed reduction and added friction are applied to the run's
+// RailAttributeOverlay; the Rails themselves are never modified.
 class WeatherEvent : public Event
 {
 private:
-	std::string        _weatherType;         // "Heavy Rain", "Storm", "Snow", etc.
-	Node*              _centerNode;          // Epicenter
-	double             _radiusKm;            // Affected area
-	double             _speedReductionFactor; // 0.0-1.0
-	double             _frictionIncrease;    // Added to train friction
-	std::vector<Rail*> _affectedRails;       // Rails within radius
-	std::vector<double> _originalSpeedLimits; // For restoration
+	std::string           _weatherType;          // "Heavy Rain", "Storm", "Snow", etc.
+	Node*                 _centerNode;           // Epicenter
+	double                _radiusKm;             // Affected area
+	double                _speedReductionFactor; // 0.0-1.0
+	double                _frictionIncrease;     // Added to train friction
+	std::vector<Rail*>    _affectedRails;        // Rails within radius
+	RailAttributeOverlay* _railAttributes;       // Per-run overlay receiving the modifiers
 
 public:
 	WeatherEvent(const std::string& weatherType, Node* centerNode,
 	             const Time& startTime, const Time& duration,
-	             double radiusKm, double speedReductionFactor, double frictionIncrease);
+	             double radiusKm, double speedReductionFactor, double frictionIncrease,
+	             RailAttributeOverlay* railAttributes = nullptr);
 
 	void activate() override;
 	void deactivate() override;
@@ -45,6 +50,7 @@ public:
 
 	// Set affected rails (called by EventFactory after creation)
 	void setAffectedRails(const std::vector<Rail*>& rails);
+	const std::vector<Rail*>& getAffectedRails() const;
 };
 
 #endif
\ No newline at end of file
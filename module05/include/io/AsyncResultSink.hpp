@@ -0,0 +1,116 @@
+#ifndef ASYNCRESULTSINK_HPP
+#define ASYNCRESULTSINK_HPP
+
+#include "io/IResultStore.hpp"
+#include "utils/SpscRing.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// One snapshot line of a .result file, captured as plain values so the
+// simulation thread never formats text.  Node names are read later on the
+// writer thread: the graph must outlive AsyncResultSink::shutdown().
+struct ResultSnapshot
+{
+    static constexpr std::size_t MAX_OTHERS = 8;
+
+    double             timeSeconds = 0.0;
+    const std::string* from        = nullptr;
+    const std::string* to          = nullptr;
+    double             remainingKm = 0.0;
+    double             velocityKmh = 0.0;
+    char               status[16]  = {};
+    std::int32_t       cellCount   = 0;  // 0 = no rail: "[ ]"
+    std::int32_t       trainCell   = 0;
+    std::int32_t       otherCount  = 0;  // Other trains' cells, marked 'O'
+    std::int32_t       otherCells[MAX_OTHERS] = {};
+};
+
+// Background writer shared by every FileOutputWriter of a simulation.
+// The simulation thread fills records in place in a lock-free ring (text
+// goes into the slot's own string, whose buffer is reused every lap); one
+// writer thread hands them to an IResultStore (per-train .result files
+// by default, or a single trace file).  All methods except the destructor
+// must be called from one (producer) thread.
+class AsyncResultSink
+{
+public:
+    static constexpr std::size_t RING_CAPACITY = 4096;
+
+    // Per-train .result files through a ResultFileStore.
+    explicit AsyncResultSink(std::size_t maxOpenFiles = 64);
+    explicit AsyncResultSink(std::unique_ptr<IResultStore> store);
+    ~AsyncResultSink();
+
+    AsyncResultSink(const AsyncResultSink&)            = delete;
+    AsyncResultSink& operator=(const AsyncResultSink&) = delete;
+
+    // Let the store validate path now (the file store creates or truncates
+    // it, throwing std::runtime_error("Failed to open output file: <path>")
+    // on failure) and return its handle.
+    std::uint32_t open(const std::string& path);
+
+    void write(std::uint32_t file, std::string_view text);
+    void writeSnapshot(std::uint32_t file, const ResultSnapshot& snapshot);
+    void close(std::uint32_t file);
+
+    // Block until everything queued so far has reached the store.  Throws
+    // std::runtime_error if the writer thread failed.
+    void flush();
+
+    // flush(), stop the writer thread and finish the store.
+    void shutdown();
+
+    // Bytes held by the sink and its record ring (see MemoryReport).
+    std::size_t getMemoryUsage() const;
+
+    // Format one snapshot line (with trailing newline) exactly as the
+    // .result format expects.
+    static void appendSnapshot(std::string&          out,
+                               const ResultSnapshot& snapshot,
+                               std::string_view      from,
+                               std::string_view      to);
+
+private:
+    struct Record
+    {
+        enum class Kind : std::uint8_t { Open, Text, Snapshot, Close, Flush };
+
+        Kind           kind = Kind::Flush;
+        std::uint32_t  file = 0;
+        std::string    text;        // Open: path; Text: content
+        std::uint64_t  ticket = 0;  // Flush
+        ResultSnapshot snapshot;
+    };
+
+    std::unique_ptr<IResultStore>   _store;  // Writer thread only, after construction
+    SpscRing<Record, RING_CAPACITY> _ring;
+    std::thread                     _thread;
+    std::uint32_t                   _nextFile;
+    std::uint64_t                   _nextTicket;
+
+    // Shared with the writer thread.
+    std::mutex              _mutex;
+    std::condition_variable _wake;      // Writer: new records or stop
+    std::condition_variable _flushed;   // Producer: a flush ticket completed
+    std::atomic<bool>       _idle;      // Writer is (about to be) waiting on _wake
+    bool                    _stopping;
+    std::uint64_t           _doneTicket;
+    std::string             _error;
+
+    Record&       claim();
+    void          publish();
+    std::uint64_t pushFlush();
+    void          run();
+    void consume(Record& record);
+    void fail(const std::exception& e);
+    void throwIfFailed();
+};
+
+#endif
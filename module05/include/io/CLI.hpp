@@ -1,8 +1,10 @@
 #ifndef CLI_HPP
 #define CLI_HPP
 
+#include <cstddef>
 #include <map>
 #include <string>
+#include <vector>
 
 // Handles command-line argument parsing and help messages
 class CLI
@@ -19,6 +21,21 @@ public:
     std::string getNetworkFile() const;
     std::string getTrainFile()   const;
 
+    // Trace subcommand: railway_sim trace <trace_file> [train] [--out=file]
+    bool        isTraceCommand()    const;
+    std::string getTraceInput()     const;
+    std::string getTraceTrain()     const;  // Empty: list the traced trains
+    std::string getTraceOutput()    const;  // --out=file; empty: stdout
+
+    // Generate subcommand: railway_sim generate <network_out> <train_out> [flags]
+    bool        isGenerateCommand()  const;
+    std::string getGenerateNetwork() const;
+    std::string getGenerateTrains()  const;
+    std::string getTopology()        const;  // --topology (default "grid")
+    std::size_t getStations()        const;  // --stations=N (default 100)
+    std::size_t getJunctions()       const;  // --junctions=K RailNodes per line (default 1)
+    std::size_t getTrainCount()      const;  // --trains=N (default 10)
+
     // Optional flags
     bool         hasSeed()           const;
     unsigned int getSeed()           const;
@@ -30,11 +47,46 @@ public:
 
     bool         hasMonteCarloRuns() const;
     unsigned int getMonteCarloRuns() const;
+    unsigned int getThreads()        const;  // --threads=N (default 1)
+    bool         hasRunCSV()         const;  // --run-csv: stream one row per run
+    std::string  getSampling()       const;  // "independent", "crn" or "antithetic"
+
+    // Convergence-driven Monte Carlo (--monte-carlo=N becomes the run cap)
+    bool                     hasConvergence()          const;  // --converge=TOL
+    double                   getConvergenceTolerance() const;  // Relative CI half-width
+    std::vector<std::string> getConvergenceMetrics()   const;  // --converge-metrics=a,b
+    double                   getTimeBudget()           const;  // --time-budget=S (0 = none)
+
+    // Parameter sweep (--sweep=spec): one Monte Carlo batch per design point
+    bool         hasSweep()          const;
+    std::string  getSweepFile()      const;
+
+    // Compiled scenario (--compile[=path]): write a binary snapshot and exit
+    bool         hasCompile()        const;
+    std::string  getCompileFile()    const;  // Default output/scenario.rsim
+
+    // Single trace file (--trace[=path]) instead of per-train .result files
+    bool         hasTrace()          const;
+    std::string  getTraceFile()      const;  // Default output/trace.rtrace
+
+    // Live timetable feed (--live-feed[=path]): trains streamed in while running
+    bool         hasLiveFeed()       const;
+    std::string  getLiveFeed()       const;  // FIFO or file; default "-" (stdin)
+    double       getLiveSpeed()      const;  // --live-speed=N simulated minutes per second
+
+    // Tick profiler (--profile[=path]): Chrome trace plus a CSV summary
+    bool         hasProfile()        const;
+    std::string  getProfileFile()    const;  // Default output/profile.json
+    std::string  getProfileSummary() const;  // Profile file with a .csv extension
 
     // Command Pattern / Replay
-    bool         hasRecord()         const;  // --record
+    bool         hasRecord()         const;  // --record[=file]
+    std::string  getRecordFile()     const;  // Default output/replay.json
+    bool         isBinaryRecord()    const;  // Record file is not .json: binary command log
     bool         hasReplay()         const;  // --replay=file
     std::string  getReplayFile()     const;  // Path provided to --replay=
+    bool         hasReplayFrom()     const;  // --replay-from=HHhMM
+    std::string  getReplayFrom()     const;
 
     void printUsage(const std::string& programName) const;
     void printHelp()                                const;
@@ -45,6 +97,7 @@ private:
     int   _argc;
     char** _argv;
     std::map<std::string, std::string> _flags;
+    std::string                        _traceTrain;
 
     void parseFlags();
     bool parseFlag(const std::string& arg, std::string& key, std::string& value);
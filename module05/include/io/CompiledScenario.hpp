@@ -0,0 +1,74 @@
+#ifndef COMPILEDSCENARIO_HPP
+#define COMPILEDSCENARIO_HPP
+
+#include "patterns/creational/factories/TrainFactory.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Graph;
+
+// Binary snapshot of a network and its timetable, written by --compile and
+// accepted by RailNetworkParser / TrainConfigParser in place of the text
+// files.  Layout (native byte order):
+//   header   "RSIMSCN1", u32 version, u32 reserved, u64 payload size,
+//            u64 checksum of the payload (word-wise FNV-1a)
+//   sources  network and train text files: path, size, mtime
+//   strings  interned names: u32 count, u32 offsets[count + 1], bytes
+//   nodes    u32 count, {u32 name, u8 type}
+//   rails    u32 count, {u32 nodeA, u32 nodeB, f64 length, f64 speed}
+//   trains   u32 count, {u32 name, f64 physics x4, u32 departure,
+//            u32 arrival, i32 departure h/m, i32 stop h/m}
+// Loading walks the mapped bytes with bounds checks; names are the only
+// allocations.
+class CompiledScenario
+{
+public:
+    // A text file the snapshot was compiled from.
+    struct Source
+    {
+        std::string  path;
+        std::int64_t size     = 0;
+        std::int64_t modified = 0;  // mtime, nanoseconds since epoch
+    };
+
+    static constexpr std::uint32_t VERSION = 1;
+
+    // True when bytes start with the compiled-scenario magic.
+    static bool isCompiled(std::string_view bytes);
+
+    // Serialises network and trains to path; the two source files are
+    // fingerprinted now so a later load can detect edits.
+    static void write(const std::string&              path,
+                      const Graph&                    network,
+                      const std::vector<TrainConfig>& trains,
+                      const std::string&              networkSource,
+                      const std::string&              trainSource);
+
+    // Checks magic, version, size and checksum.  bytes must outlive this
+    // object.  Throws std::runtime_error when the file is corrupt.
+    CompiledScenario(std::string_view bytes, const std::string& path);
+
+    // True when a recorded source still exists but no longer matches its
+    // fingerprint.  Missing sources are not stale: the snapshot stands alone.
+    static bool isStale(const Source& source);
+
+    const Source& getNetworkSource() const;
+    const Source& getTrainSource()   const;
+
+    Graph*                   buildNetwork() const;  // Caller owns the graph
+    std::vector<TrainConfig> buildTrains()  const;
+
+private:
+    std::string                   _path;
+    Source                        _network;
+    Source                        _trains;
+    std::vector<std::string_view> _strings;
+    std::string_view              _nodeSection;
+    std::string_view              _railSection;
+    std::string_view              _trainSection;
+};
+
+#endif
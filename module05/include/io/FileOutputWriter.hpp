@@ -5,15 +5,19 @@
 #include "core/Rail.hpp"
 #include "simulation/state/OccupancyMap.hpp"
 #include "utils/Time.hpp"
+#include <cstdint>
 #include <string>
-#include <fstream>
 #include <vector>
 
-// Generates output files for train journeys
+class AsyncResultSink;
+struct ResultSnapshot;
+
+// Generates output files for train journeys.  Text is handed to a shared
+// AsyncResultSink, which formats and writes it off the simulation thread.
 class FileOutputWriter
 {
 public:
-	FileOutputWriter(Train* train);
+	FileOutputWriter(Train* train, AsyncResultSink& sink);
 	~FileOutputWriter();
 
 	// Open output file
@@ -40,9 +44,15 @@ public:
     // Pass nullptr to disable multi-train visualization (default).
     void setOccupancyMap(const OccupancyMap* occupancy);
 
+    // Approximate bytes held by the writer; the shared sink is counted once
+    // by its owner (see MemoryReport).
+    std::size_t getMemoryUsage() const;
+
 private:
 	Train*              _train;
-	std::ofstream       _file;
+	AsyncResultSink&    _sink;
+	std::uint32_t       _fileId;
+	bool                _isOpen;
 	std::string         _filename;
 	double              _totalPathDistance;
 	bool                _finalSnapshotWritten;
@@ -52,7 +62,7 @@ private:
 	double      calculateTotalPathDistance() const;
 	std::string getStatusString() const;
 	double      calculateRemainingDistance() const;
-	std::string generateRailVisualization() const;
+	void        fillRailCells(ResultSnapshot& snapshot, std::vector<int>& overflow) const;
 	std::string formatTime(double seconds) const;
 };
 
@@ -1,24 +1,37 @@
 #ifndef FILEPARSER_HPP
 #define FILEPARSER_HPP
 
+#include "io/MappedFile.hpp"
+#include <cstddef>
 #include <string>
-#include <vector>
-#include <fstream>
+#include <string_view>
 
-// Base class for all file parsers.
+// Base class for all file parsers.  The file is memory-mapped and handed out
+// line by line as views into the mapping, so parsing copies nothing until a
+// parser builds its own objects.
 class FileParser
 {
 protected:
-    std::string   _filepath;
-    std::ifstream _file;
-    int           _lineNumber;  // Tracks current line; reset to 0 in constructor.
+    std::string _filepath;
+    MappedFile  _file;
+    std::size_t _cursor;      // Offset of the first unread byte in _file.
+    int         _lineNumber;  // 1-based file line of the last line returned by nextLine().
+    std::string _staleSource; // Text source parsed in place of a stale compiled scenario.
 
     FileParser(const std::string& filepath);
     virtual ~FileParser() = default;
 
-    // Read all non-empty, non-comment lines from the file.
-    // Strips inline '#' comments, trims whitespace via StringUtils::trim.
-    std::vector<std::string> readLines();
+    // Advances to the next non-empty, non-comment line.  Inline '#' comments
+    // are stripped and whitespace trimmed.  Returns false at end of file.
+    // line stays valid for the parser's lifetime.
+    bool nextLine(std::string_view& line);
+
+    // Same scan over any slice of the file (e.g. one chunk of a parallel
+    // parse), with caller-held cursor and line counter.
+    static bool nextLine(std::string_view  text,
+                         std::size_t&      cursor,
+                         int&              lineNumber,
+                         std::string_view& line);
 
     // Throw a std::runtime_error formatted as:
     //   "Error at line N: <message>\nContent: <lineContent>"
@@ -26,7 +39,12 @@ protected:
     // Marked [[noreturn]] so the compiler knows it never returns.
     [[noreturn]] void throwLineError(
         const std::string& message,
-        const std::string& lineContent) const;
+        std::string_view   lineContent) const;
+
+    static std::string formatLineError(
+        int                lineNumber,
+        const std::string& message,
+        std::string_view   lineContent);
 
 public:
     // Returns true when the file exists and is a regular file.
@@ -34,6 +52,11 @@ public:
 
     // Throws std::runtime_error when the file cannot be opened for reading.
     static void validateFile(const std::string& filepath);
+
+    // True when parse() found an out-of-date compiled scenario and parsed its
+    // text source instead.  Reporting it is left to the caller.
+    bool        wasStale() const;
+    std::string getStaleWarning() const;  // Empty unless wasStale().
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,31 @@
+#ifndef IRESULTSTORE_HPP
+#define IRESULTSTORE_HPP
+
+#include <cstdint>
+#include <string>
+
+struct ResultSnapshot;
+
+// Where AsyncResultSink's writer thread puts train output (Strategy).
+// Every method except prepare() runs on the writer thread only.
+class IResultStore
+{
+public:
+    virtual ~IResultStore() = default;
+
+    // Producer thread, before open(): fail early on paths that cannot work.
+    virtual void prepare(const std::string& path) = 0;
+
+    virtual void open(std::uint32_t file, const std::string& path) = 0;
+    virtual void text(std::uint32_t file, const std::string& text) = 0;
+    virtual void snapshot(std::uint32_t file, const ResultSnapshot& snapshot) = 0;
+    virtual void close(std::uint32_t file) = 0;
+
+    // Push everything accepted so far to the OS.
+    virtual void flush() = 0;
+
+    // Last call: flush and release every resource.
+    virtual void finish() = 0;
+};
+
+#endif
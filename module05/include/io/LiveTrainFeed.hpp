@@ -0,0 +1,115 @@
+#ifndef LIVETRAINFEED_HPP
+#define LIVETRAINFEED_HPP
+
+#include "core/Train.hpp"
+#include "patterns/creational/factories/TrainFactory.hpp"
+#include "utils/SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Graph;
+class IPathfindingStrategy;
+
+// Streams trains into a running simulation.  A background thread reads
+// lines in the train file format from a FIFO, a file or stdin ("-"),
+// validates and routes each one (routes are cached per station pair) and
+// builds its Train.  Built trains wait in a bounded lock-free queue until
+// the simulation loop collects them with next().  While the queue is full
+// the reader stops reading, so a fast producer is held back by the pipe
+// instead of growing memory.
+class LiveTrainFeed
+{
+public:
+    static constexpr std::size_t QUEUE_CAPACITY = 64;
+
+    // A built train and the config it came from; the caller owns train.
+    struct Arrival
+    {
+        Train*      train = nullptr;
+        TrainConfig config;
+    };
+
+    // Throughput and backpressure counters.
+    struct Stats
+    {
+        std::size_t lines          = 0;    // Train lines read
+        std::size_t queued         = 0;    // Built and queued
+        std::size_t delivered      = 0;    // Collected by next()
+        std::size_t rejected       = 0;    // Invalid, unknown stations or no route
+        std::size_t stalls         = 0;    // Trains that found the queue full
+        double      stalledMs      = 0.0;  // Time the reader waited for room
+        std::size_t peakDepth      = 0;    // Most trains waiting at once
+        std::size_t routeCacheHits = 0;
+    };
+
+    LiveTrainFeed(std::string source, Graph* network, std::unique_ptr<IPathfindingStrategy> strategy);
+    ~LiveTrainFeed();
+
+    LiveTrainFeed(const LiveTrainFeed&)            = delete;
+    LiveTrainFeed& operator=(const LiveTrainFeed&) = delete;
+
+    // Opens the source and starts the reader.  Throws std::runtime_error
+    // when the source cannot be opened.
+    void start();
+
+    // Stops the reader; trains still queued are deleted.
+    void stop();
+
+    // Simulation thread only: the next built train, false when none waits.
+    bool next(Arrival& arrival);
+
+    // The input has ended and every train has been collected.
+    bool isFinished() const;
+
+    // Why lines were rejected since the last call (one message per line).
+    std::vector<std::string> takeRejections();
+
+    Stats getStats() const;
+
+private:
+    using RouteKey = std::pair<std::string, std::string>;
+
+    std::string                           _source;
+    Graph*                                _network;
+    std::unique_ptr<IPathfindingStrategy> _strategy;
+    bool                                  _running;
+    std::thread                           _thread;
+    int                                   _fd;
+    int                                   _stopPipe[2];
+    SpscRing<Arrival, QUEUE_CAPACITY>     _queue;
+
+    std::atomic<bool>        _inputClosed;
+    std::atomic<std::size_t> _lines;
+    std::atomic<std::size_t> _queued;
+    std::atomic<std::size_t> _delivered;
+    std::atomic<std::size_t> _rejected;
+    std::atomic<std::size_t> _stalls;
+    std::atomic<long long>   _stalledUs;
+    std::atomic<std::size_t> _peakDepth;
+    std::atomic<std::size_t> _routeCacheHits;
+
+    std::mutex               _rejectionMutex;
+    std::vector<std::string> _rejections;
+    std::atomic<bool>        _hasRejections;  // Lets takeRejections() skip the lock
+
+    // Reader thread only.
+    std::map<RouteKey, Train::Path> _routes;
+    int                             _lineNumber;
+
+    void openSource();
+    void closeFds();
+    void run();
+    bool handleLine(std::string_view line);
+    bool enqueue(const Arrival& arrival);
+    void reject(const std::string& message);
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file.  The contents are exposed as a
+// string_view valid for the object's lifetime; nothing is copied.  Empty
+// files map to an empty view.
+class MappedFile
+{
+public:
+    // Throws std::runtime_error("Failed to open file: <path>") on failure.
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view view() const;
+    std::size_t      size() const;
+
+private:
+    const char* _data;
+    std::size_t _size;
+};
+
+#endif
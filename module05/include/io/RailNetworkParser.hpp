@@ -4,7 +4,8 @@
 #include "io/FileParser.hpp"
 #include "core/Graph.hpp"
 
-// Parses railway network file and builds Graph
+// Parses railway network file and builds Graph.  Also accepts a compiled
+// scenario (--compile); a stale one falls back to its text source.
 class RailNetworkParser : public FileParser
 {
 public:
@@ -14,7 +15,8 @@ public:
     Graph* parse();
 
 private:
-    void parseLine(const std::string& line, Graph* graph);
+    Graph* parseCompiled();
+    void parseLine(std::string_view line, Graph* graph);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef RESULTFILESTORE_HPP
+#define RESULTFILESTORE_HPP
+
+#include "io/IResultStore.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+// One .result text file per train.  Output is gathered in per-file buffers
+// and each buffer is written with a single syscall once it fills.
+// Descriptors are opened on demand and kept in a small LRU, so thousands
+// of trains never hold thousands of open files.
+class ResultFileStore : public IResultStore
+{
+public:
+    static constexpr std::size_t FILE_BUFFER_BYTES  = 16 * 1024;         // Per-file write threshold
+    static constexpr std::size_t TOTAL_BUFFER_BYTES = 32 * 1024 * 1024;  // Flush everything beyond this
+
+    explicit ResultFileStore(std::size_t maxOpenFiles = 64);
+    ~ResultFileStore() override;
+
+    ResultFileStore(const ResultFileStore&)            = delete;
+    ResultFileStore& operator=(const ResultFileStore&) = delete;
+
+    // Creates or truncates path; throws std::runtime_error("Failed to open
+    // output file: <path>") on failure.
+    void prepare(const std::string& path) override;
+
+    void open(std::uint32_t file, const std::string& path) override;
+    void text(std::uint32_t file, const std::string& text) override;
+    void snapshot(std::uint32_t file, const ResultSnapshot& snapshot) override;
+    void close(std::uint32_t file) override;
+    void flush() override;
+    void finish() override;
+
+private:
+    struct FileState
+    {
+        std::string                        path;
+        std::string                        buffer;
+        int                                fd = -1;
+        std::list<std::uint32_t>::iterator lru;
+    };
+
+    std::vector<FileState>   _files;
+    std::list<std::uint32_t> _openFiles;  // Most recently used first
+    std::size_t              _maxOpenFiles;
+    std::size_t              _buffered;
+
+    void appended(std::uint32_t file, std::size_t bytes);
+    void flushFile(std::uint32_t file);
+    void releaseDescriptor(FileState& file);
+    int  descriptor(std::uint32_t file);
+};
+
+#endif
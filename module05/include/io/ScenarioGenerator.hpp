@@ -0,0 +1,60 @@
+#ifndef SCENARIOGENERATOR_HPP
+#define SCENARIOGENERATOR_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+// Layout of the stations and the lines between them.
+enum class NetworkTopology
+{
+    Grid,         // Square lattice: each station linked to its neighbours
+    HubAndSpoke,  // Ring of fast trunk lines between hubs, spokes off each hub
+    ScaleFree,    // Preferential attachment: a few heavily connected stations
+    Corridor      // One long line with express links every few stations
+};
+
+// Parameters of railway_sim generate.
+struct GeneratorSpec
+{
+    NetworkTopology topology  = NetworkTopology::Grid;
+    std::size_t     stations  = 100;
+    std::size_t     junctions = 1;    // RailNode chain on every line
+    std::size_t     trains    = 10;
+    unsigned int    seed      = 42;
+};
+
+// Writes a synthetic network and timetable in the text formats, for scale
+// testing.  Stations are CityN; a line between two stations runs through
+// its own chain of RailNodeN junctions.  The network is connected and every
+// train ends a few lines away from where it starts, so every train has a
+// route.  The output depends only on the spec.
+class ScenarioGenerator
+{
+public:
+    struct Summary
+    {
+        std::size_t stations  = 0;
+        std::size_t junctions = 0;
+        std::size_t rails     = 0;
+        std::size_t trains    = 0;
+    };
+
+    // "grid", "hub", "scale-free" or "corridor".  Throws std::runtime_error
+    // for anything else.
+    static NetworkTopology parseTopology(const std::string& name);
+    static const char*     topologyName(NetworkTopology topology);
+
+    // Throws std::runtime_error when the spec cannot produce a valid scenario.
+    explicit ScenarioGenerator(const GeneratorSpec& spec);
+
+    Summary write(std::ostream& network, std::ostream& trains) const;
+
+    // Throws std::runtime_error when a file cannot be written.
+    Summary writeFiles(const std::string& networkFile, const std::string& trainFile) const;
+
+private:
+    GeneratorSpec _spec;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SWEEPSPECPARSER_HPP
+#define SWEEPSPECPARSER_HPP
+
+#include "io/FileParser.hpp"
+#include "analysis/SweepSpec.hpp"
+
+// Parses a sweep specification file:
+//   design grid|lhs                          (default grid)
+//   samples <N>                              (lhs: number of points)
+//   runs <N>                                 (seeds per point, default 1)
+//   param <name> <min> <max> [levels]        (grid levels, default 2)
+class SweepSpecParser : public FileParser
+{
+public:
+    SweepSpecParser(const std::string& filepath);
+    ~SweepSpecParser() = default;
+
+    SweepSpec parse();
+
+private:
+    void         parseLine(std::string_view line, SweepSpec& spec);
+    unsigned int parseCount(std::string_view token, const std::string& fieldName) const;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef TRACEFILE_HPP
+#define TRACEFILE_HPP
+
+#include "io/IResultStore.hpp"
+#include "io/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Single-file alternative to per-train .result files.
+//
+// Layout (native byte order):
+//   header   "RSIMTRC1", u32 version, u32 reserved
+//   chunk*   u32 payload bytes, u32 record count, payload
+//   footer   string table, chunk offsets, train index
+//   trailer  u64 footer offset, "RSIMTRCE"
+//
+// A chunk payload is a run of records: u8 kind, varint train, varint
+// length, body.  Text bodies are the raw .result text; snapshot bodies
+// hold the ResultSnapshot fields with node names and status as string ids
+// and time, remaining distance and velocity XOR-delta encoded against the
+// same train's previous snapshot in the chunk.  Delta state restarts with
+// every chunk, so any chunk decodes on its own and the per-train index
+// (the chunks each train appears in) lets a reader skip the rest.
+class TraceWriter : public IResultStore
+{
+public:
+    static constexpr std::uint32_t VERSION     = 1;
+    static constexpr std::size_t   CHUNK_BYTES = 64 * 1024;  // Seal a chunk beyond this
+
+    // Creates or truncates path; throws std::runtime_error("Failed to open
+    // trace file: <path>") on failure.
+    explicit TraceWriter(const std::string& path);
+    ~TraceWriter() override;
+
+    TraceWriter(const TraceWriter&)            = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void prepare(const std::string& path) override;
+    void open(std::uint32_t file, const std::string& path) override;
+    void text(std::uint32_t file, const std::string& text) override;
+    void snapshot(std::uint32_t file, const ResultSnapshot& snapshot) override;
+    void close(std::uint32_t file) override;
+    void flush() override;
+
+    // Seal the last chunk and write the footer; the file is readable after this.
+    void finish() override;
+
+private:
+    struct TrainState
+    {
+        std::string                path;
+        std::uint32_t              records    = 0;
+        std::vector<std::uint32_t> chunks;
+        std::uint32_t              lastChunk  = UINT32_MAX;  // Last chunk listed in chunks
+        std::uint32_t              deltaChunk = UINT32_MAX;  // Chunk the delta state belongs to
+        std::uint64_t              time       = 0;           // Previous values, as bits
+        std::uint64_t              remaining  = 0;
+        std::uint64_t              velocity   = 0;
+    };
+
+    std::string                                    _path;
+    int                                            _fd;
+    std::uint64_t                                  _offset;
+    std::string                                    _chunk;
+    std::uint32_t                                  _chunkRecords;
+    std::vector<std::uint64_t>                     _chunkOffsets;
+    std::vector<TrainState>                        _trains;
+    std::vector<std::string>                       _strings;
+    std::unordered_map<std::string, std::uint32_t> _stringIds;
+    std::string                                    _lookup;  // Reused intern key
+    std::string                                    _body;    // Reused record body
+
+    TrainState&   train(std::uint32_t file);
+    std::uint32_t intern(std::string_view text);
+    void          appendRecord(std::uint8_t kind, std::uint32_t file, std::string_view body);
+    void          sealChunk();
+    void          writeAll(const char* data, std::size_t size);
+};
+
+// Read side of a trace written by TraceWriter: maps the file, validates the
+// trailer and footer and renders any train's .result text on demand.
+// Throws std::runtime_error("Corrupt trace file '<path>': ...") on
+// malformed input.
+class TraceReader
+{
+public:
+    struct Train
+    {
+        std::string                path;     // The .result file it stands for
+        std::string                label;    // Its stem: <name>_<departure>
+        std::uint32_t              records = 0;
+        std::vector<std::uint32_t> chunks;
+    };
+
+    explicit TraceReader(const std::string& path);
+
+    static bool isTrace(std::string_view bytes);
+
+    const std::vector<Train>& getTrains() const;
+
+    // Trains whose label is query, or whose name (label minus departure) is.
+    std::vector<std::size_t> findTrains(const std::string& query) const;
+
+    // Append train's complete .result text to out.
+    void render(std::size_t train, std::string& out) const;
+
+private:
+    MappedFile                    _file;
+    std::string                   _path;
+    std::vector<std::string_view> _strings;
+    std::vector<std::string_view> _chunks;  // Payloads
+    std::vector<Train>            _trains;
+
+    [[noreturn]] void corrupt(const std::string& reason) const;
+    std::string_view  string(std::uint64_t id) const;
+};
+
+#endif
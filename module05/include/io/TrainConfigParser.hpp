@@ -5,19 +5,33 @@
 #include "patterns/creational/factories/TrainFactory.hpp"
 #include <vector>
 
-// Parses train configuration file
+// Parses train configuration file (text or compiled scenario)
 class TrainConfigParser : public FileParser
 {
 public:
 	TrainConfigParser(const std::string& filepath);
 	~TrainConfigParser() = default;
 
+	// Files at least this large are split at line boundaries and parsed
+	// on several threads; smaller ones stay on the calling thread.
+	static constexpr std::size_t PARALLEL_MIN_BYTES = 1u << 20;
+
+	// Worker threads for large files (default: hardware concurrency).
+	void setThreads(unsigned int threads);
+
 	// Parse file and return train configurations
 	std::vector<TrainConfig> parse();
     void validateUniqueNames(const std::vector<TrainConfig>& configs) const;
 
+	// One train line (comments and surrounding whitespace already removed).
+	// Throws std::runtime_error describing the first problem.
+	static TrainConfig parseLine(std::string_view line);
+
 private:
-	TrainConfig parseLine(const std::string& line);
+	unsigned int _threads;
+
+	std::vector<TrainConfig> parseCompiled();
+	std::vector<TrainConfig> parseParallel(unsigned int chunkCount);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef COMMANDLOG_HPP
+#define COMMANDLOG_HPP
+
+#include "io/MappedFile.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
+#include "patterns/behavioral/command/ReplayKeyframe.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct RecordingMetadata;
+
+// Binary alternative to replay.json, written while the simulation runs.
+//
+// Layout (native byte order):
+//   header   "RSIMCMD1", u32 version, u32 reserved
+//   chunk*   u32 payload bytes, u32 record count, payload
+//   end      u32 0, metadata, "RSIMCMDE"
+//
+// A payload is a run of records, each starting with a u8 kind:
+//   string    varint length, bytes; takes the next string id (0 = empty)
+//   command   XOR-delta timestamp against the previous command, then four
+//             u32 fields: three string ids and an index (see CommandRecord)
+//   keyframe  f64 time, varint trains, then per train: u32 name, state and
+//             departure ids, u32 rail, f64 position, velocity and stop, u8
+// Strings are defined once, before first use, so names cost four bytes per
+// command.  Metadata (files, seed, stop time) is only known at the end.
+class CommandLogWriter
+{
+public:
+    static constexpr std::uint32_t VERSION     = 1;
+    static constexpr std::size_t   CHUNK_BYTES = 64 * 1024;  // Write out beyond this
+
+    // Creates or truncates path; throws std::runtime_error("Failed to open
+    // command log: <path>") on failure.
+    explicit CommandLogWriter(const std::string& path);
+    ~CommandLogWriter();
+
+    CommandLogWriter(const CommandLogWriter&)            = delete;
+    CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+
+    void append(const CommandRecord& record);
+    void append(const ReplayKeyframe& keyframe);
+
+    // Write the last chunk and the metadata; the log is readable after this.
+    void finish(const RecordingMetadata& meta);
+
+    const std::string& getPath()     const;
+    std::uint64_t      commandCount() const;
+
+private:
+    std::string                                    _path;
+    int                                            _fd;
+    std::string                                    _chunk;
+    std::uint32_t                                  _chunkRecords;
+    std::uint64_t                                  _commands;
+    std::uint64_t                                  _lastTime;  // Previous timestamp, as bits
+    std::unordered_map<std::string, std::uint32_t> _stringIds;
+    std::string                                    _lookup;    // Reused intern key
+
+    std::uint32_t intern(std::string_view text);
+    void          endRecord();
+    void          sealChunk();
+    void          writeAll(const char* data, std::size_t size);
+};
+
+// Read side of a log written by CommandLogWriter: maps the file, checks its
+// framing and decodes the records in order.  Throws
+// std::runtime_error("Corrupt command log '<path>': ...") on malformed input,
+// including a log whose recording never finished.
+class CommandLogReader
+{
+public:
+    explicit CommandLogReader(const std::string& path);
+
+    static bool isCommandLog(std::string_view bytes);
+
+    // Fills meta, then calls onCommand / onKeyframe for every record in
+    // recorded order.  Record views are valid for the reader's lifetime.
+    void read(RecordingMetadata&                                meta,
+              const std::function<void(const CommandRecord&)>&  onCommand,
+              const std::function<void(const ReplayKeyframe&)>& onKeyframe) const;
+
+private:
+    MappedFile                    _file;
+    std::string                   _path;
+    std::vector<std::string_view> _chunks;    // Payloads
+    std::string_view              _metadata;
+
+    [[noreturn]] void corrupt(const std::string& reason) const;
+};
+
+#endif
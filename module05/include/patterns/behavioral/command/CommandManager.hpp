@@ -1,10 +1,15 @@
 #ifndef COMMANDMANAGER_HPP
 #define COMMANDMANAGER_HPP
 
+#include "patterns/behavioral/command/CommandPool.hpp"
+#include "patterns/behavioral/command/ICommand.hpp"
+#include "patterns/behavioral/command/ReplayKeyframe.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 
-class ICommand;
+class CommandLogWriter;
+struct CommandRecord;
 
 // Metadata written to and read from a replay file.
 struct RecordingMetadata
@@ -15,9 +20,16 @@ struct RecordingMetadata
     double       stopTime = 0.0;  // sim time (seconds) when recording stopped
 };
 
-// Owns a list of ICommand objects.
-// In recording mode:  Application calls record() after each action.
-// In replay mode:     SimulationManager calls getCommandsForTime() each tick.
+// Owns a list of ICommand objects, allocated from (and released to) its
+// CommandPool so long recordings do not pay one heap allocation per command.
+// In recording mode:  Application calls record() after each action, and
+//                     SimulationManager adds a keyframe every few minutes.
+//                     Both are kept for saveToFile() (JSON), or, when
+//                     recording to a binary command log, encoded and
+//                     written out in chunks as they arrive and released.
+// In replay mode:     commands are sorted once by startReplay(); then
+//                     SimulationManager drains them with consumeUntil() each
+//                     tick, a moving cursor with no scan and no allocation.
 class CommandManager
 {
 public:
@@ -31,32 +43,82 @@ public:
     void startRecording();
     bool isRecording() const;
 
+    // Record straight to a binary command log at logPath (see CommandLog.hpp)
+    // instead of memory.  Throws std::runtime_error if it cannot be created.
+    void startRecording(const std::string& logPath);
+    bool isStreaming() const;
+
+    // Streaming only: write the metadata and close the log.
+    void finishRecording(const RecordingMetadata& meta);
+
     // Takes ownership of cmd and appends it to the log.
     void record(ICommand* cmd);
 
+    // Pool backing recorded and loaded commands.
+    CommandPool&       pool();
+    const CommandPool& pool() const;
+
+    void addKeyframe(const ReplayKeyframe& keyframe);
+
     // --- Replay ---
+    // Sorts commands by timestamp (stable) and rewinds the cursor.
     void startReplay();
     bool isReplaying() const;
 
-    // Returns (non-owning) pointers to commands whose timestamp falls in
-    // [startTime, endTime).  Caller must not delete the returned pointers.
-    std::vector<ICommand*> getCommandsForTime(double startTime, double endTime) const;
+    // Move the cursor to the first command at or after time.
+    void seek(double time);
+
+    // Pass every command from the cursor up to (excluding) endTime to visit,
+    // in timestamp order, and move the cursor past them.  Commands stay owned
+    // by the manager.
+    template <typename Visitor>
+    void consumeUntil(double endTime, Visitor&& visit)
+    {
+        while (_cursor < _commands.size() && _commands[_cursor]->getTimestamp() < endTime)
+        {
+            visit(_commands[_cursor++]);
+        }
+    }
+
+    // Latest keyframe at or before time; nullptr if there is none.
+    const ReplayKeyframe* keyframeAtOrBefore(double time) const;
 
     // --- Persistence ---
+    // JSON; not available while streaming (the commands are on disk already).
     bool saveToFile(const std::string& path, const RecordingMetadata& meta) const;
+
+    // Reads JSON or a binary command log, told apart by its magic bytes.
     bool loadFromFile(const std::string& path, RecordingMetadata& outMeta);
 
     // --- Query ---
-    std::size_t commandCount() const;
+    std::size_t commandCount()  const;
+    std::size_t keyframeCount() const;
+
+    // Approximate bytes held by the pool, command list and keyframes
+    std::size_t getMemoryUsage() const;
 
 private:
-    std::vector<ICommand*> _commands;
-    bool                   _recording;
-    bool                   _replaying;
+    CommandPool                       _pool;
+    std::vector<ICommand*>            _commands;
+    std::vector<ReplayKeyframe>       _keyframes;  // Ascending time
+    std::unique_ptr<CommandLogWriter> _log;        // Set while streaming
+    std::size_t                       _cursor;
+    bool                              _recording;
+    bool                              _replaying;
 
     // Reconstruct a single command object from its serialized JSON line.
     // Returns nullptr when the type is unrecognised or the line is malformed.
-    static ICommand* deserializeCommand(const std::string& json);
+    ICommand* deserializeCommand(const std::string& json);
+    ICommand* deserializeRecord(const CommandRecord& record);
+
+    bool loadCommandLog(const std::string& path, RecordingMetadata& outMeta);
+
+    static std::string serializeKeyframe(const ReplayKeyframe& keyframe);
+    static bool        deserializeKeyframe(const std::string& json, ReplayKeyframe& out);
+
+    // Calls onObject with each top-level {...} of the JSON array named key.
+    template <typename Callback>
+    static bool forEachArrayObject(const std::string& content, const std::string& key, Callback&& onObject);
 
     // Minimal JSON helpers — no external dependency.
     static std::string extractString(const std::string& json, const std::string& key);
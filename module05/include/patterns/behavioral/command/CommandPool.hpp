@@ -0,0 +1,57 @@
+#ifndef COMMANDPOOL_HPP
+#define COMMANDPOOL_HPP
+
+#include "utils/ObjectPool.hpp"
+#include "patterns/behavioral/command/TrainStateChangeCommand.hpp"
+#include "patterns/behavioral/command/TrainAdvanceRailCommand.hpp"
+#include "patterns/behavioral/command/SimEventCommand.hpp"
+#include <type_traits>
+#include <utility>
+
+// Typed pools for the high-volume replay commands recorded every tick.
+// Owned by CommandManager, which releases every command it holds back here.
+// Other command types (departures, reloads) are rare and fall back to new;
+// release() deletes anything it did not allocate.
+class CommandPool
+{
+private:
+    ObjectPool<TrainStateChangeCommand, 256> _stateChanges;
+    ObjectPool<TrainAdvanceRailCommand, 256> _railAdvances;
+    ObjectPool<SimEventCommand>              _simEvents;
+
+public:
+    CommandPool()  = default;
+    ~CommandPool() = default;
+
+    CommandPool(const CommandPool&)            = delete;
+    CommandPool& operator=(const CommandPool&) = delete;
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        if constexpr (std::is_same<T, TrainStateChangeCommand>::value)
+        {
+            return _stateChanges.create(std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_same<T, TrainAdvanceRailCommand>::value)
+        {
+            return _railAdvances.create(std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_same<T, SimEventCommand>::value)
+        {
+            return _simEvents.create(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return new T(std::forward<Args>(args)...);
+        }
+    }
+
+    // Destroys cmd and recycles its slot.  Safe with nullptr.
+    void release(ICommand* cmd);
+
+    // Aggregated counters across all command pools.
+    PoolStats stats() const;
+};
+
+#endif
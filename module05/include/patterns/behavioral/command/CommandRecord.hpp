@@ -0,0 +1,26 @@
+#ifndef COMMANDRECORD_HPP
+#define COMMANDRECORD_HPP
+
+#include <cstdint>
+#include <string_view>
+
+// Flat, fixed-shape view of a replayable command, as stored in the binary
+// command log.  Views point into the command (or the mapped log) and are
+// only valid while it lives.
+struct CommandRecord
+{
+    enum class Kind : std::uint8_t
+    {
+        Departure   = 1,  // text[0] train
+        StateChange = 2,  // text[0] train, text[1] from state, text[2] to state
+        AdvanceRail = 3,  // text[0] train, index rail index
+        Event       = 4   // text[0] event type, text[1] description
+    };
+
+    Kind             kind      = Kind::Departure;
+    double           timestamp = 0.0;
+    std::string_view text[3];
+    std::uint32_t    index     = 0;
+};
+
+#endif
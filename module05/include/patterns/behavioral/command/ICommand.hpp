@@ -4,6 +4,7 @@
 #include <string>
 
 class IReplayTarget;
+struct CommandRecord;
 
 // Abstract base for all recordable simulation actions.
 class ICommand
@@ -25,6 +26,10 @@ public:
 
     // Re-apply this command during replay mode (default: no-op).
     virtual void applyReplay(IReplayTarget*) {}
+
+    // Fill out for the binary command log; false when the command has no
+    // binary form (default).
+    virtual bool toRecord(CommandRecord&) const { return false; }
 };
 
 #endif
\ No newline at end of file
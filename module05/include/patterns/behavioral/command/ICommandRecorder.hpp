@@ -1,6 +1,9 @@
 #ifndef ICOMMANDRECORDER_HPP
 #define ICOMMANDRECORDER_HPP
 
+#include "patterns/behavioral/command/CommandPool.hpp"
+#include <utility>
+
 class ICommand;
 
 // Narrow interface that services use to record replay commands.
@@ -8,13 +11,32 @@ class ICommand;
 // that needs to record.  Services never depend on CommandManager directly.
 //
 // record() takes ownership of cmd.  If recording is not active, the
-// implementation must delete cmd to avoid leaking.
+// implementation must release cmd to avoid leaking.
+// Prefer emplace(): it allocates nothing when recording is off and draws
+// from the recorder's CommandPool when it is on.
 class ICommandRecorder
 {
 public:
     virtual ~ICommandRecorder() = default;
 
     virtual void record(ICommand* cmd) = 0;
+    virtual bool isRecording()   const = 0;
+
+    // Pool owned by the active command log, or nullptr when there is none.
+    virtual CommandPool* commandPool() = 0;
+
+    template <typename T, typename... Args>
+    void emplace(Args&&... args)
+    {
+        if (!isRecording())
+        {
+            return;
+        }
+
+        CommandPool* pool = commandPool();
+        record(pool ? pool->create<T>(std::forward<Args>(args)...)
+                    : new T(std::forward<Args>(args)...));
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
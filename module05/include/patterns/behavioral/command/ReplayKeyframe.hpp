@@ -0,0 +1,31 @@
+#ifndef REPLAYKEYFRAME_HPP
+#define REPLAYKEYFRAME_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One train's full state inside a keyframe.
+struct TrainKeyframe
+{
+    std::string name;
+    std::string state;             // ITrainState::getName()
+    std::string departureStation;  // Journey direction: round trips swap it
+    std::size_t railIndex   = 0;
+    double      position    = 0.0;  // metres along the current rail
+    double      velocity    = 0.0;  // m/s
+    double      stopSeconds = 0.0;  // Remaining stop timer; 0 = none
+    bool        finished    = false;
+};
+
+// Every train's state at the start of the tick at `time`, captured while
+// recording so a replay can start there instead of at 00:00.  Events are
+// not stored: they depend only on the seed and the clock, so a seek
+// regenerates them.
+struct ReplayKeyframe
+{
+    double                     time = 0.0;
+    std::vector<TrainKeyframe> trains;
+};
+
+#endif
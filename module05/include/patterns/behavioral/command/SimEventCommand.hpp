@@ -20,6 +20,7 @@ public:
     std::string getType()                        const override;
     double      getTimestamp()                   const override;
     void        applyReplay(IReplayTarget* target)    override;
+    bool        toRecord(CommandRecord& out)         const override;
 
 private:
     double      _timestamp;
@@ -9,7 +9,7 @@ public:
 	BrakingState() = default;
 	~BrakingState() override = default;
 	
-	void update(Train* train, double dt) override;
+	void update(Train* train, const IPhysicsQueries* physics, double dt) override;
 	std::string getName() const override;
 	ITrainState* checkTransition(Train* train, SimulationContext* ctx) override;
 };
@@ -9,7 +9,7 @@ public:
 	EmergencyState() = default;
 	~EmergencyState() override = default;
 	
-	void update(Train* train, double dt) override;
+	void update(Train* train, const IPhysicsQueries* physics, double dt) override;
 	ITrainState* checkTransition(Train* train, SimulationContext* ctx) override;
 	std::string getName() const override;
 };
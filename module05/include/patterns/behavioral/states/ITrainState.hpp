@@ -6,14 +6,16 @@
 
 class Train;
 class SimulationContext;
+class IPhysicsQueries;
 
 class ITrainState
 {
 public:
 	virtual ~ITrainState() = default;
 	
-	// Existing: Update train physics/behavior
-	virtual void update(Train* train, double dt) = 0;
+	// Update train physics/behavior.  physics supplies the effective (overlaid)
+	// rail speed limit and friction; when nullptr, base rail values are used.
+	virtual void update(Train* train, const IPhysicsQueries* physics, double dt) = 0;
 	
 	// Returns next state (or nullptr if no transition)
 	virtual ITrainState* checkTransition(Train* train, SimulationContext* ctx) = 0;
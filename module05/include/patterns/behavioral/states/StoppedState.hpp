@@ -9,7 +9,7 @@ public:
 	StoppedState() = default;
 	~StoppedState() override = default;
 	
-	void update(Train* train, double dt) override;
+	void update(Train* train, const IPhysicsQueries* physics, double dt) override;
 	std::string getName() const override;
 	ITrainState* checkTransition(Train* train, SimulationContext* ctx) override;
 };
@@ -12,7 +12,8 @@ public:
 	AStarStrategy() = default;
 	~AStarStrategy() override = default;
 	
-	Path findPath(const Graph* graph, Node* start, Node* end) const override;
+	Path findPath(const Graph* graph, Node* start, Node* end,
+	              const RailAttributeOverlay* railAttributes = nullptr) const override;
 	std::string getName() const override;
 
 private:
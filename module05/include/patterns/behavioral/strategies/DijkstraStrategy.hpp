@@ -9,7 +9,8 @@ public:
 	DijkstraStrategy() = default;
 	~DijkstraStrategy() override = default;
 	
-	Path findPath(const Graph* graph, Node* start, Node* end) const override;
+	Path findPath(const Graph* graph, Node* start, Node* end,
+	              const RailAttributeOverlay* railAttributes = nullptr) const override;
 	std::string getName() const override;
 };
 
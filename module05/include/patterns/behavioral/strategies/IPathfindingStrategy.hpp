@@ -7,6 +7,7 @@
 
 class Graph;
 class Node;
+class RailAttributeOverlay;
 
 class IPathfindingStrategy
 {
@@ -15,7 +16,10 @@ public:
 	
 	virtual ~IPathfindingStrategy() = default;
 	
-	virtual Path findPath(const Graph* graph, Node* start, Node* end) const = 0;
+	// Edge cost is travel time (length / speed limit).  When railAttributes is
+	// given, the run's effective speed limits are used instead of base values.
+	virtual Path findPath(const Graph* graph, Node* start, Node* end,
+	                      const RailAttributeOverlay* railAttributes = nullptr) const = 0;
 	virtual std::string getName() const = 0;
 };
 
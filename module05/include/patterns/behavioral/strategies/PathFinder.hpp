@@ -15,7 +15,8 @@ public:
 	void setStrategy(IPathfindingStrategy* strategy);
 	IPathfindingStrategy* getStrategy() const;
 	
-	Path findPath(const Graph* graph, Node* start, Node* end) const;
+	Path findPath(const Graph* graph, Node* start, Node* end,
+	              const RailAttributeOverlay* railAttributes = nullptr) const;
 	
 private:
 	IPathfindingStrategy* _strategy;
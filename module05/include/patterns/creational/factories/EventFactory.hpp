@@ -3,6 +3,10 @@
 
 #include "events/Event.hpp"
 #include "utils/Time.hpp"
+#include "simulation/systems/RailFootprintIndex.hpp"
+#include "event_system/EventRngStreams.hpp"
+#include "event_system/EventParameters.hpp"
+#include <memory>
 #include <vector>
 
 class IRng;
@@ -10,32 +14,51 @@ class INetworkQuery;
 class IEventScheduler;
 class Node;
 class Rail;
-
-struct EventConfig
-{
-    double probabilityPerTimestep;
-    int    minDurationMinutes;
-    int    maxDurationMinutes;
-};
+class RailAttributeOverlay;
+class EventPool;
 
 class EventFactory
 {
 private:
-    IRng&                _rng;          // Non-owning reference — caller owns the RNG.
-    const INetworkQuery* _network;      // Non-owning.
-    IEventScheduler*     _eventManager; // Non-owning, for conflict checking.
+    // Legacy mode: every decision site draws from one IRng.  Same interface
+    // as EventRngStreams, so the draw helpers below are written once.
+    struct SharedRng
+    {
+        IRng* rng;
+        IRng& operator[](EventRngSite) const { return *rng; }
+    };
+
+    // Exactly one is set (non-owning).  With _streams the helpers are
+    // instantiated on StreamRng, which is final: no virtual call per draw.
+    SharedRng        _shared;
+    EventRngStreams* _streams;
+
+    const INetworkQuery*  _network;           // Non-owning.
+    IEventScheduler*      _eventManager;      // Non-owning, for conflict checking.
+    RailAttributeOverlay* _railAttributes;    // Non-owning; rail events apply modifiers here.
+    EventPool*            _eventPool;         // Non-owning; nullptr allocates with new.
+    RailFootprintIndex*   _weatherFootprints; // Memoized rails-within-radius queries, shared per network.
+    EventParameters       _parameters;
 
-    static const EventConfig CONFIG_STATION_DELAY;
-    static const EventConfig CONFIG_TRACK_MAINTENANCE;
-    static const EventConfig CONFIG_SIGNAL_FAILURE;
-    static const EventConfig CONFIG_WEATHER;
+    std::unique_ptr<RailFootprintIndex> _ownedFootprints;  // Used when no shared index was given.
 
-    Event* createStationDelay(const Time& currentTime);
-    Event* createTrackMaintenance(const Time& currentTime);
-    Event* createSignalFailure(const Time& currentTime);
-    Event* createWeather(const Time& currentTime);
+    template <typename Sites>
+    std::vector<Event*> generate(Sites& sites, const Time& currentTime);
 
-    Time generateDuration(const EventConfig& config);
+    template <typename Sites>
+    Event* createStationDelay(Sites& sites, const Time& currentTime);
+    template <typename Sites>
+    Event* createTrackMaintenance(Sites& sites, const Time& currentTime);
+    template <typename Sites>
+    Event* createSignalFailure(Sites& sites, const Time& currentTime);
+    template <typename Sites>
+    Event* createWeather(Sites& sites, const Time& currentTime);
+
+    template <typename Rng>
+    static Time generateDuration(const EventConfig& config, Rng& rng);
+
+    template <typename T, typename... Args>
+    T* allocate(Args&&... args);
 
     bool canCreateStationDelay(Node* node)    const;
     bool canCreateTrackMaintenance(Rail* rail) const;
@@ -43,14 +66,29 @@ private:
     bool canCreateWeather()                   const;
 
 public:
-    // rng, network, and eventScheduler are all non-owning; caller manages lifetime.
-    EventFactory(IRng& rng, const INetworkQuery* network, IEventScheduler* eventScheduler);
+    // All pointers are non-owning; caller manages lifetime.
+    // Without railAttributes, rail events are generated but have no speed/friction effect.
+    // With eventPool, events are allocated from it and must be released back to it
+    // (EventScheduler does this when built with the same pool).
+    // footprints, an index over the same network, outlives factories rebuilt on
+    // every reseed; without it the factory keeps its own.
+    EventFactory(IRng& rng, const INetworkQuery* network, IEventScheduler* eventScheduler,
+                 RailAttributeOverlay* railAttributes = nullptr, EventPool* eventPool = nullptr,
+                 RailFootprintIndex* footprints = nullptr);
+
+    // Same, but every decision site draws from its own stream in streams.
+    EventFactory(EventRngStreams& streams, const INetworkQuery* network, IEventScheduler* eventScheduler,
+                 RailAttributeOverlay* railAttributes = nullptr, EventPool* eventPool = nullptr,
+                 RailFootprintIndex* footprints = nullptr);
 
     // Attempt to generate events based on per-minute probability.
-    // Returns a (possibly empty) vector of heap-allocated events; caller owns them.
+    // Returns a (possibly empty) vector of events; caller owns them (see eventPool above).
     std::vector<Event*> tryGenerateEvents(const Time& currentTime, double timestepSeconds = 1.0);
 
     unsigned int getSeed() const;
+
+    void                   setParameters(const EventParameters& parameters);
+    const EventParameters& getParameters() const;
 };
 
 #endif
\ No newline at end of file
@@ -11,6 +11,9 @@ namespace SimConfig
     constexpr double SECONDS_PER_HOUR       = 3600.0;
     constexpr double SECONDS_PER_DAY        = 86400.0;
 
+    // Replay keyframe spacing while recording (simulated seconds)
+    constexpr double REPLAY_KEYFRAME_INTERVAL_SECONDS = 900.0;
+
     constexpr int MINUTES_PER_DAY       = 1440;
     constexpr int MINUTES_PER_HALF_DAY  = 720;
 
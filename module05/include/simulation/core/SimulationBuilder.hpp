@@ -11,15 +11,32 @@
 class Graph;
 class Train;
 class FileOutputWriter;
+class AsyncResultSink;
 class IOutputWriter;
 class IPathfindingStrategy;
+class SimulationManager;
+class LiveTrainFeed;
 
-// Owns the three objects built and torn down together each simulation run.
+// Owns the objects built and torn down together each simulation run.
+// The writers share sink; it must be shut down before trains and graph go.
 struct SimulationBundle
 {
     Graph*                         graph   = nullptr;
     std::vector<Train*>            trains;
+    std::vector<TrainConfig>       configs;  // What each train was built from
     std::vector<FileOutputWriter*> writers;
+    AsyncResultSink*               sink    = nullptr;
+};
+
+// What SimulationBuilder::reload() did, counted per train.
+struct ReloadSummary
+{
+    bool        networkChanged = false;
+    std::size_t kept           = 0;  // Same config: object and live state preserved
+    std::size_t rerouted       = 0;  // Kept, with the route ahead recomputed
+    std::size_t added          = 0;
+    std::size_t modified       = 0;  // Created again (new config, or its current rail changed)
+    std::size_t removed        = 0;  // Gone from the file, or no longer routable
 };
 
 // Per-config result returned by validateTrainConfigs.
@@ -44,22 +61,46 @@ class SimulationBuilder
 private:
     IOutputWriter* _logger;
     std::string    _pathfindingAlgo;
+    std::string    _traceFile;  // Empty: one .result file per train
 
     Graph*                                _parseNetwork(const std::string& netFile);
     std::vector<TrainConfig>              _parseTrains(const std::string& trainFile);
     std::unique_ptr<IPathfindingStrategy> _createStrategy() const;
-    std::vector<Train*>                   _buildTrains(const std::vector<TrainValidationResult>& results, Graph* graph);
-    std::vector<FileOutputWriter*>        _createOutputWriters(const std::vector<Train*>& trains);
+    Train*                                _buildTrain(const TrainValidationResult& result, Graph* graph);
+    void                                  _buildTrains(const std::vector<TrainValidationResult>& results,
+                                                       SimulationBundle&                         bundle);
+    std::vector<FileOutputWriter*>        _createOutputWriters(const std::vector<Train*>& trains,
+                                                               AsyncResultSink&           sink);
 
     static double _estimateJourneyMinutes(const Train* train);
 
 public:
     SimulationBuilder(IOutputWriter* logger, const std::string& pathfindingAlgo);
 
+    // Send every train's output to one trace file instead of .result files.
+    void setTraceFile(const std::string& path);
+
     // Full pipeline: parse network + trains, validate, build trains, create writers.
     // Throws on parse/IO failure. Returns populated bundle on success.
     SimulationBundle build(const std::string& netFile, const std::string& trainFile);
 
+    // Diff-based hot reload of sim, running the trains in bundle.  Trains
+    // are matched by name: an unchanged train keeps its object, output file
+    // and live state; only added or modified trains are routed and created.
+    // When the network changed, kept trains move onto the new network's
+    // unchanged rails and only a route that crosses a removed or edited
+    // rail ahead of the train is recomputed; events on such rails end.
+    // Throws on parse failure, leaving bundle and sim untouched.
+    ReloadSummary reload(const std::string& netFile, const std::string& trainFile,
+                         SimulationBundle& bundle, SimulationManager& sim);
+
+    // Output writer for a train added while running; the caller owns it.
+    FileOutputWriter* createOutputWriter(Train* train, AsyncResultSink& sink);
+
+    // Feed of trains streamed from source (see LiveTrainFeed), routed on
+    // network with this builder's pathfinding algorithm.  Not started.
+    std::unique_ptr<LiveTrainFeed> createLiveFeed(const std::string& source, Graph* network) const;
+
     // Stateless validation helper — exposed for hot-reload pre-flight checks.
     // Does NOT log — caller handles per-context message prefixes.
     static std::vector<TrainValidationResult> validateTrainConfigs(
@@ -0,0 +1,74 @@
+#ifndef SIMULATIONCHECKPOINT_HPP
+#define SIMULATIONCHECKPOINT_HPP
+
+#include "event_system/EventRngStreams.hpp"
+#include "events/Event.hpp"
+#include "patterns/behavioral/command/ReplayKeyframe.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
+#include "utils/Time.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A replay keyframe plus what a keyframe can leave to the recording.
+struct TrainCheckpoint : TrainKeyframe
+{
+    Time        departureTime;         // Moves on every round trip
+    std::string previousState;         // Last state the reporter saw ("" = none)
+    bool        stopTimer = false;     // A stop timer exists, even at zero
+};
+
+// Constructor arguments of one scheduled or active event; which fields are
+// used depends on type.  Nodes are kept by name, rails by Rail::getID().
+struct EventCheckpoint
+{
+    EventType                type        = EventType::STATION_DELAY;
+    Time                     start;
+    Time                     duration;
+    bool                     active      = false;
+    std::string              node;                 // Station, signal or weather centre
+    std::size_t              rail        = 0;      // Track maintenance
+    Time                     extra;                // Station delay or signal stop
+    double                   speedFactor = 1.0;
+    double                   friction    = 0.0;
+    double                   radiusKm    = 0.0;
+    std::string              weatherType;
+    std::vector<std::size_t> affectedRails;
+};
+
+// Everything SimulationManager::restore() needs to continue a run exactly
+// where SimulationManager::checkpoint() left it: clock, random generator
+// positions, trains, events and the rail overlay they produced.  Output
+// writers, stats collectors and recordings are not part of it.
+//
+// serialize() gives a self-contained byte string ("RSIMCKP1", then the
+// fields in declaration order, native byte order); deserialize() throws
+// std::runtime_error("Corrupt simulation checkpoint: ...") on bad input.
+struct SimulationCheckpoint
+{
+    double       currentTime             = 0.0;
+    double       lastEventGenerationTime = -60.0;
+    double       nextKeyframeTime        = 0.0;
+    int          lastSnapshotMinute      = -1;
+    int          lastDashboardMinute     = -1;
+
+    unsigned int seed       = 0;
+    bool         rngStreams = false;
+    bool         antithetic = false;
+    std::string  rngState;                                               // SeededRNG::saveState()
+    std::array<std::uint64_t, EventRngStreams::SITE_COUNT> streamPositions{};
+    int          totalEventsGenerated = 0;
+
+    std::vector<TrainCheckpoint>                trains;
+    std::vector<EventCheckpoint>                scheduledEvents;
+    std::vector<EventCheckpoint>                activeEvents;
+    std::vector<RailAttributeOverlay::Modifier> railAttributes;  // By rail id
+
+    std::string                 serialize() const;
+    static SimulationCheckpoint deserialize(std::string_view bytes);
+};
+
+#endif
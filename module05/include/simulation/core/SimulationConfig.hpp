@@ -1,19 +1,32 @@
 #ifndef SIMULATIONCONFIG_HPP
 #define SIMULATIONCONFIG_HPP
 
+#include "event_system/EventParameters.hpp"
+
 class Graph;
 class ISimulationOutput;
+class RailFootprintIndex;
 
 // Aggregates all one-time configuration values that Application passes to
 // SimulationManager before calling run().
 // writer is ISimulationOutput* — SimulationManager only needs
 // writeEventActivated and writeDashboard, not the full IOutputWriter.
+// rngStreams gives every event decision site its own stream (see
+// EventRngStreams); antithetic additionally mirrors those streams (u -> 1 - u).
+// events overrides the default event probabilities and durations.
+// footprints, an index over network shared by every run on it, keeps weather
+// footprints cached from one run to the next; without it each simulation
+// keeps its own.
 struct SimulationConfig
 {
-    Graph*             network   = nullptr;
-    unsigned int       seed      = 0;
-    bool               roundTrip = false;
-    ISimulationOutput* writer    = nullptr;
+    Graph*              network    = nullptr;
+    unsigned int        seed       = 0;
+    bool                roundTrip  = false;
+    ISimulationOutput*  writer     = nullptr;
+    bool                rngStreams = false;
+    bool                antithetic = false;
+    EventParameters     events;
+    RailFootprintIndex* footprints = nullptr;
 };
 
 #endif
\ No newline at end of file
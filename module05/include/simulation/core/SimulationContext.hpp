@@ -2,7 +2,9 @@
 #define SIMULATIONCONTEXT_HPP
 
 #include "simulation/interfaces/IPhysicsQueries.hpp"
+#include "simulation/physics/RiskData.hpp"
 #include "simulation/state/IStopTimerStore.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 #include "patterns/behavioral/states/StateRegistry.hpp"
 #include <map>
 #include <vector>
@@ -12,19 +14,26 @@ class Graph;
 class Node;
 class ICollisionAvoidance;
 class ITrainController;
-struct RiskData;
 
 class SimulationContext : public IPhysicsQueries, public IStopTimerStore
 {
 private:
+    struct RiskEntry
+    {
+        RiskData data;
+        unsigned refresh = 0;  // Last refreshAllRiskData() that saw the train
+    };
+
     Graph*                     _network;
     ICollisionAvoidance*       _collisionSystem;
     ITrainController*          _trafficController;
     const std::vector<Train*>* _trains;
 
     StateRegistry              _states;
-    std::map<Train*, RiskData> _riskMap;
-    std::map<Train*, double>   _stopDurations;
+    RailAttributeOverlay       _railAttributes;
+    std::map<Train*, RiskEntry> _riskMap;
+    unsigned                    _riskRefresh;
+    std::map<Train*, double>    _stopDurations;
 
 public:
     SimulationContext(Graph*                     network,
@@ -40,20 +49,27 @@ public:
     const RiskData& getRisk(const Train* train) const;
     void            refreshAllRiskData();
 
-    double getCurrentRailSpeedLimit(const Train* train) const override;
-    double getCurrentRailLength(const Train* train)     const override;
-    double getBrakingDistance(const Train* train)       const override;
-    double getDistanceToRailEnd(const Train* train)     const override;
-    Node*  getCurrentArrivalNode(const Train* train)    const override;
+    double getCurrentRailSpeedLimit(const Train* train)       const override;
+    double getCurrentRailFrictionIncrease(const Train* train) const override;
+    double getCurrentRailLength(const Train* train)           const override;
+    double getBrakingDistance(const Train* train)             const override;
+    double getDistanceToRailEnd(const Train* train)           const override;
+    Node*  getCurrentArrivalNode(const Train* train)          const override;
 
     void   setStopDuration(Train* train, double durationSeconds) override;
     double getStopDuration(const Train* train)                   const override;
     bool   decrementStopDuration(Train* train, double dt)        override;
     void   clearStopDuration(Train* train)                       override;
+    // True while a stop timer exists, even one that has run down to zero.
+    bool   hasStopDuration(const Train* train)                   const;
 
     StateRegistry&       states();
     const StateRegistry& states() const;
 
+    // Per-run rail modifiers layered over the immutable network.
+    RailAttributeOverlay&       railAttributes();
+    const RailAttributeOverlay& railAttributes() const;
+
     ITrainController* getTrafficController() const;
 
     void applyForce(Train* train, double force, double dt);
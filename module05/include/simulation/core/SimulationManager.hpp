@@ -5,6 +5,8 @@
 #include <map>
 #include <memory>
 #include <functional>
+#include <string>
+#include <unordered_map>
 #include "utils/Time.hpp"
 #include "utils/SeededRNG.hpp"
 #include "simulation/core/SimConstants.hpp"
@@ -13,11 +15,14 @@
 #include "event_system/ObserverManager.hpp"
 #include "event_system/EventDispatcher.hpp"
 #include "event_system/EventScheduler.hpp"
+#include "event_system/EventPool.hpp"
+#include "event_system/EventRngStreams.hpp"
 #include "patterns/behavioral/command/ICommandRecorder.hpp"
 #include "simulation/interfaces/IReplayTarget.hpp"
 #include "simulation/services/TrainLifecycleService.hpp"
 #include "simulation/systems/EventPipeline.hpp"
 #include "simulation/reporting/SimulationReporting.hpp"
+#include "simulation/reporting/MemoryReport.hpp"
 
 class Train;
 class Graph;
@@ -27,11 +32,16 @@ class FileOutputWriter;
 class ISimulationOutput;
 class TrafficController;
 class EventFactory;
+class RailFootprintIndex;
 class Event;
 class StatsCollector;
 class CommandManager;
 class ICommand;
 class ITrainState;
+struct ReplayKeyframe;
+struct TrainKeyframe;
+struct SimulationCheckpoint;
+struct SimulationFork;
 
 using TrainList = std::vector<Train*>;
 
@@ -45,8 +55,12 @@ class SimulationManager : public ICommandRecorder, public IReplayTarget
 {
 private:
     EventDispatcher        _eventDispatcher;
+    EventPool              _eventPool;       // Declared before the scheduler: outlives every event.
     EventScheduler         _eventScheduler;
     SeededRNG              _rng;
+    EventRngStreams        _rngStreams;      // Used instead of _rng when _useRngStreams.
+    bool                   _useRngStreams;
+    EventParameters        _eventParameters; // Applied to every EventFactory built here.
     NetworkServicesFactory _networkServicesFactory;
     ObserverManager        _observerManager;
 
@@ -59,20 +73,32 @@ private:
     std::unique_ptr<SimulationContext> _context;
     std::unique_ptr<EventFactory>      _eventFactory;
 
+    // Weather footprint cache handed to every EventFactory: the configured
+    // one when it indexes this network, else one owned until the network
+    // changes, so reseeds and restores keep it warm.
+    RailFootprintIndex*                 _sharedFootprints;
+    std::unique_ptr<RailFootprintIndex> _ownedFootprints;
+    RailFootprintIndex*                 _footprints;
+
     Graph*    _network;
     TrainList _trains;
+    std::unordered_map<std::string, Train*> _trainsByName;  // findTrain() for replay commands
 
     double _currentTime;
     double _timestep;
     double _simulationSpeed;
     bool   _running;
     bool   _roundTripEnabled;
+    bool   _awaitingTrains;  // run() must not stop once every train arrived
     double _lastEventGenerationTime;
+    double _nextKeyframeTime;  // Recording: capture a replay keyframe at this time
 
     ISimulationOutput*                  _simulationWriter;
     StatsCollector*                     _statsCollector;
     CommandManager*                     _commandManager;
 
+    std::unique_ptr<SimulationCheckpoint> _replayOrigin;  // Replay: state at start(), for backward seeks
+
     std::map<Train*, FileOutputWriter*> _outputWriters;
     std::map<Train*, ITrainState*>      _previousStates;
 
@@ -84,11 +110,16 @@ private:
     SimulationReporting   _reporting;
 
     void resetNetworkServices();
-    void tick(bool replayMode, bool advanceTime);
+    RailFootprintIndex* footprintsFor(Graph* network);
+    void tick(bool replayMode, bool advanceTime, bool report = true);
     void cleanupOutputWriters();
     void refreshSimulationState();
     void simulationTick(bool replayMode);
     void applyReplayCommands();
+    void captureKeyframe();
+    void restoreKeyframe(const ReplayKeyframe& keyframe);
+    void restoreTrain(Train& train, const TrainKeyframe& entry, const Time& departureTime);
+    void restoreEvents(const SimulationCheckpoint& checkpoint);
     bool shouldStopEarly(bool replayMode);
 
 public:
@@ -101,12 +132,25 @@ public:
     SimulationManager(SimulationManager&&)                  = delete;
     SimulationManager& operator=(SimulationManager&&)       = delete;
 
-    void record(ICommand* cmd) override;
+    void         record(ICommand* cmd) override;
+    bool         isRecording()   const override;
+    CommandPool* commandPool()         override;
 
     void setNetwork(Graph* network);
+    // Also valid while running: the train starts idle and departs on schedule.
     void addTrain(Train* train);
+
+    // While set, run() keeps going after every train has arrived because
+    // more are expected (e.g. from a live feed).
+    void setAwaitingTrains(bool awaiting);
     void setTimestep(double timestep);
     void setEventSeed(unsigned int seed);
+    // Per-site event streams (optionally antithetic); applied by the next setEventSeed().
+    void setEventSampling(bool rngStreams, bool antithetic);
+    void setEventParameters(const EventParameters& parameters);
+    // Shared weather footprint cache (non-owning); used from the next
+    // setNetwork() on when it indexes that network.
+    void setFootprintIndex(RailFootprintIndex* footprints);
     void setRoundTripMode(bool enabled);
     void setSimulationWriter(ISimulationOutput* writer);
     void registerOutputWriter(Train* train, FileOutputWriter* writer);
@@ -120,6 +164,37 @@ public:
     void stop();
     void step();
 
+    // Replay only, after start(): move the clock to time without replaying
+    // everything before it.  Events are regenerated up to the nearest
+    // recorded keyframe (they depend only on seed and clock), the trains are
+    // restored from it and only the commands after it are replayed, without
+    // writing snapshots.  Seeking backwards first rewinds to the state
+    // start() saw.  Returns the keyframe time used (the time seeking started
+    // from when there is none).
+    double seekReplay(double time);
+
+    // Copy of the complete run state at the current tick boundary.
+    SimulationCheckpoint checkpoint() const;
+
+    // Continue from checkpoint: needs the same network and trains with the
+    // same names already added (their paths are rewound and replayed).
+    // Starts the simulation if needed; replaces events, random state and
+    // clock.  Throws std::runtime_error when the checkpoint does not match.
+    void restore(const SimulationCheckpoint& checkpoint);
+
+    // Independent in-memory copy of this run (cloned trains, own services)
+    // that steps exactly like this one would; setEventSeed() on it branches
+    // the future.  Output writers, stats, recordings and an injected
+    // collision system are not carried over.
+    SimulationFork fork() const;
+
+    // Hot reload while running: switch to network (possibly the current one)
+    // and trains, then restore checkpoint, which must already be expressed
+    // in network's names and rail ids.  Trains absent from the checkpoint
+    // start idle; writers of trains no longer listed are dropped.
+    void reload(Graph* network, const TrainList& trains, const SimulationCheckpoint& checkpoint);
+
+    // Calls start() unless the simulation is already running.
     void run(double maxTime,
              bool renderMode = false,
              bool replayMode = false,
@@ -136,9 +211,26 @@ public:
     unsigned int               getSeed()                 const;
     double                     getSimulationSpeed()      const;
     SimulationContext*         getContext()              const override;
+    const EventPool&           getEventPool()            const;
+
+    // Approximate bytes per subsystem.  outputBuffers covers the registered
+    // writers only: their shared AsyncResultSink belongs to the caller.
+    MemoryReport               getMemoryReport()         const;
 
     void setSimulationSpeed(double speed);
     void reset();
 };
 
+// A forked simulation and the trains it runs; trains outlive the simulation.
+struct SimulationFork
+{
+    std::vector<std::unique_ptr<Train>> trains;
+    std::unique_ptr<SimulationManager>  simulation;
+
+    SimulationFork();
+    SimulationFork(SimulationFork&&);
+    SimulationFork& operator=(SimulationFork&&);
+    ~SimulationFork();
+};
+
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@ class Graph;
 class Rail;
 struct RiskData;
 class OccupancyMap;
+class RailAttributeOverlay;
 
 // Narrow interface for collision detection and occupancy tracking.
 // Consumers depend on this; not on the concrete CollisionAvoidance.
@@ -17,7 +18,9 @@ public:
     virtual ~ICollisionAvoidance() = default;
 
     virtual void             refreshRailOccupancy(const std::vector<Train*>& trains, const Graph* network) = 0;
-    virtual RiskData         assessRisk(const Train* train, const std::vector<Train*>& allTrains) const    = 0;
+    // railAttributes may be nullptr, in which case base rail values are used.
+    virtual RiskData         assessRisk(const Train* train, const std::vector<Train*>& allTrains,
+                                        const RailAttributeOverlay* railAttributes) const                 = 0;
     virtual const OccupancyMap& getOccupancyMap() const                                                    = 0;
 };
 
@@ -11,9 +11,13 @@ class IPhysicsQueries
 public:
     virtual ~IPhysicsQueries() = default;
 
-    // Speed limit of the rail the train is currently on, in m/s.
+    // Effective speed limit of the rail the train is currently on, in m/s
+    // (base limit with any active event modifiers applied).
     virtual double getCurrentRailSpeedLimit(const Train* train) const = 0;
 
+    // Friction coefficient added by active events on the current rail.
+    virtual double getCurrentRailFrictionIncrease(const Train* train) const = 0;
+
     // Physical length of the current rail, in metres.
     virtual double getCurrentRailLength(const Train* train) const = 0;
 
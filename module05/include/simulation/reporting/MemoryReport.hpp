@@ -0,0 +1,26 @@
+#ifndef MEMORYREPORT_HPP
+#define MEMORYREPORT_HPP
+
+#include <cstddef>
+#include <string>
+
+// Approximate resident bytes of one simulation, per subsystem: object sizes
+// plus the capacity of the containers they own.
+struct MemoryReport
+{
+    std::size_t graph         = 0;  // Nodes, rails, adjacency and name index
+    std::size_t trains        = 0;  // Trains with their paths
+    std::size_t events        = 0;  // Event pool chunks and scheduler lists
+    std::size_t commandLog    = 0;  // Recorded commands and keyframes
+    std::size_t outputBuffers = 0;  // Result writers and their shared queue
+
+    std::size_t total() const
+    {
+        return graph + trains + events + commandLog + outputBuffers;
+    }
+
+    // "graph 12.3 KiB, trains ..." for the console.
+    std::string toString() const;
+};
+
+#endif
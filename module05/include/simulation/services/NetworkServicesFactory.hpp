@@ -11,6 +11,10 @@ class SimulationContext;
 class EventFactory;
 class IEventScheduler;
 class IRng;
+class RailAttributeOverlay;
+class EventPool;
+class EventRngStreams;
+class RailFootprintIndex;
 
 // Returned by NetworkServicesFactory::build(); caller owns all pointers.
 struct NetworkServices
@@ -27,15 +31,26 @@ class NetworkServicesFactory
 private:
     ICollisionAvoidance*       _collisionSystem;
     const std::vector<Train*>* _trains;
+    EventPool*                 _eventPool;
 
 public:
-    NetworkServicesFactory(ICollisionAvoidance* collisionSystem, const std::vector<Train*>* trains);
+    // eventPool (optional, non-owning) backs every EventFactory built here.
+    NetworkServicesFactory(ICollisionAvoidance* collisionSystem, const std::vector<Train*>* trains,
+                           EventPool* eventPool = nullptr);
 
     // Builds all three network-bound services. Caller owns the returned pointers.
-    NetworkServices build(Graph* network, IRng& rng, IEventScheduler* eventScheduler) const;
+    // With streams, EventFactory draws each decision from its own stream instead of rng.
+    // footprints (optional, non-owning) is the weather footprint cache for network.
+    NetworkServices build(Graph* network, IRng& rng, IEventScheduler* eventScheduler,
+                          EventRngStreams* streams = nullptr,
+                          RailFootprintIndex* footprints = nullptr) const;
 
     // Builds only EventFactory. Used when the seed changes but the network is unchanged.
-    EventFactory* buildEventFactory(Graph* network, IRng& rng, IEventScheduler* eventScheduler) const;
+    // railAttributes is the existing context's overlay that rail events modify.
+    EventFactory* buildEventFactory(Graph* network, IRng& rng, IEventScheduler* eventScheduler,
+                                    RailAttributeOverlay* railAttributes,
+                                    EventRngStreams* streams = nullptr,
+                                    RailFootprintIndex* footprints = nullptr) const;
 };
 
 #endif
\ No newline at end of file
@@ -32,7 +32,9 @@ public:
     // The returned reference is stable until the next add/remove/clearAll.
     const std::vector<Train*>& get(Rail* rail) const;
 
-    // Remove all trains from every rail in the provided list.
+    // Remove all trains from every rail in the provided list.  Every rail
+    // keeps room for at least one train, so rebuilding the map each tick
+    // allocates only when a rail first holds more trains than ever before.
     void clearAll(const std::vector<Rail*>& rails);
 
 private:
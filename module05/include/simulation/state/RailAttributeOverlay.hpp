@@ -0,0 +1,56 @@
+#ifndef RAILATTRIBUTEOVERLAY_HPP
+#define RAILATTRIBUTEOVERLAY_HPP
+
+#include <cstddef>
+#include <vector>
+
+class Rail;
+
+// Per-run dynamic rail attributes layered over the immutable loaded network.
+// Dense array indexed by Rail::getID(); owned by SimulationContext and sized
+// once per network.  Events apply and remove modifiers here instead of
+// mutating Rail, so one Graph can back any number of simulation runs.
+class RailAttributeOverlay
+{
+public:
+    struct Modifier
+    {
+        double speedFactor      = 1.0;  // Product of all active speed factors
+        double frictionIncrease = 0.0;  // Sum of all active friction increases
+        int    activeCount      = 0;    // Number of modifiers currently applied
+    };
+
+    RailAttributeOverlay()  = default;
+    explicit RailAttributeOverlay(std::size_t railCount);
+    ~RailAttributeOverlay() = default;
+
+    RailAttributeOverlay(const RailAttributeOverlay&)            = default;
+    RailAttributeOverlay& operator=(const RailAttributeOverlay&) = default;
+
+    // Resize to railCount entries and restore every rail to its base values.
+    void        reset(std::size_t railCount);
+    std::size_t size() const;
+
+    // Stack / unstack a modifier on rail.  Rails without a valid id are ignored.
+    void applyModifier(const Rail* rail, double speedFactor, double frictionIncrease);
+    void removeModifier(const Rail* rail, double speedFactor, double frictionIncrease);
+
+    // Effective speed limit in km/h (base limit × active speed factors).
+    double getSpeedLimit(const Rail* rail)       const;
+    double getSpeedFactor(const Rail* rail)      const;
+    // Friction coefficient added on top of the train's own coefficient.
+    double getFrictionIncrease(const Rail* rail) const;
+    bool   isModified(const Rail* rail)          const;
+
+    // Every rail's entry by id, for simulation checkpoints.
+    const std::vector<Modifier>& getModifiers() const;
+    void                         setModifiers(const std::vector<Modifier>& modifiers);
+
+private:
+    std::vector<Modifier> _modifiers;
+
+    const Modifier* find(const Rail* rail) const;
+    Modifier*       find(const Rail* rail);
+};
+
+#endif
@@ -10,6 +10,7 @@ class Train;
 class Graph;
 class Rail;
 struct RiskData;
+class RailAttributeOverlay;
 
 class CollisionAvoidance : public ICollisionAvoidance
 {
@@ -19,10 +20,10 @@ private:
     Train* findLeaderOnRoute(const Train* train, const std::vector<Train*>& allTrains) const;
     double calculateGap(const Train* train, const Train* leader)                       const;
     double calculateClosingSpeed(const Train* train, const Train* leader)               const;
-    double calculateBrakingDistance(const Train* train)                                const;
-    double calculateSafeDistance(const Train* train)                                   const;
-    double getCurrentSpeedLimit(const Train* train)                                    const;
-    double getNextSpeedLimit(const Train* train)                                        const;
+    double calculateBrakingDistance(const Train* train, double extraFrictionCoef)      const;
+    double calculateSafeDistance(const Train* train, double brakingDistance)           const;
+    double getCurrentSpeedLimit(const Train* train, const RailAttributeOverlay* attrs) const;
+    double getNextSpeedLimit(const Train* train, const RailAttributeOverlay* attrs)    const;
     double calculateAbsoluteRoutePosition(const Train* train)                          const;
 
     bool findRailIndexInPath(const Train* t, const Rail* rail,
@@ -35,7 +36,8 @@ public:
     ~CollisionAvoidance() override = default;
 
     void                refreshRailOccupancy(const std::vector<Train*>& trains, const Graph* network) override;
-    RiskData            assessRisk(const Train* train, const std::vector<Train*>& allTrains) const override;
+    RiskData            assessRisk(const Train* train, const std::vector<Train*>& allTrains,
+                                   const RailAttributeOverlay* railAttributes) const override;
     const OccupancyMap& getOccupancyMap() const override;
 };
 
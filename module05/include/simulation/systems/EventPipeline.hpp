@@ -1,6 +1,8 @@
 #ifndef EVENTPIPELINE_HPP
 #define EVENTPIPELINE_HPP
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <map>
 #include <memory>
@@ -41,6 +43,9 @@ public:
     void update();
 
 private:
+    // Active events per EventType.
+    using TypeCounts = std::array<int, 4>;
+
     std::unique_ptr<EventFactory>&           _eventFactory;
     EventScheduler&                          _eventScheduler;
     std::vector<Train*>&                     _trains;
@@ -51,11 +56,10 @@ private:
     double&                                  _currentTime;
     double&                                  _lastEventGenerationTime;
     ICommandRecorder*                        _recorder;
+    std::vector<Event*>                      _previousActive;  // Reused each tick
 
     void notifyNewEvent(Event* event);
-    void notifyEndedEvents(
-        const std::map<std::string, int>& preCounts,
-        const std::map<std::string, int>& postCounts);
+    void notifyEndedEvents(const TypeCounts& preCounts, const TypeCounts& postCounts);
     void logEventForAffectedTrains(Event* event, const std::string& action);
 };
 
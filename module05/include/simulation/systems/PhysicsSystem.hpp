@@ -19,11 +19,13 @@ public:
     static double msToKmh(double ms);
     static double mToKm(double meters);
 
-    // Force calculations
-    static double calculateFriction(const Train* train);
-    static double calculateNetForce(const Train* train, double appliedForce);
-    static double calculateBrakingDeceleration(const Train* train);
-    static double calculateBrakingDistance(const Train* train);
+    // Force calculations.
+    // extraFrictionCoef is added to the train's own coefficient; it carries
+    // per-rail increases from RailAttributeOverlay (e.g. weather).
+    static double calculateFriction(const Train* train, double extraFrictionCoef = 0.0);
+    static double calculateNetForce(const Train* train, double appliedForce, double extraFrictionCoef = 0.0);
+    static double calculateBrakingDeceleration(const Train* train, double extraFrictionCoef = 0.0);
+    static double calculateBrakingDistance(const Train* train, double extraFrictionCoef = 0.0);
 
     // Motion updates
     static void updateVelocity(Train* train, double netForce, double dt);
@@ -0,0 +1,54 @@
+#ifndef RAILFOOTPRINTINDEX_HPP
+#define RAILFOOTPRINTINDEX_HPP
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class INetworkQuery;
+class Node;
+class Rail;
+
+// Answers "which rails lie within R km of this node?" by graph distance.
+// Runs a Dijkstra over rail lengths bounded by the radius, so the cost scales
+// with the affected area rather than the network size.  Results are memoized
+// per (centre, radius bucket): the search runs once to the bucket's upper
+// bound and any radius inside that bucket is answered exactly from the cache.
+// Footprints depend only on the network, so one index serves every run on
+// it; railsWithin() may be called from several threads at once.
+class RailFootprintIndex
+{
+public:
+    static constexpr double BUCKET_KM = 5.0;
+
+    // network is non-owning and must outlive this object.
+    explicit RailFootprintIndex(const INetworkQuery* network);
+
+    // Rails incident to center, plus every rail that can be fully traversed
+    // within radiusKm of center.  Ordered by rail id (network order).
+    std::vector<Rail*> railsWithin(Node* center, double radiusKm);
+
+    const INetworkQuery* getNetwork()       const;
+    std::size_t          cachedFootprints() const;
+    // Not safe while another thread is inside railsWithin().
+    void                 clear();
+
+private:
+    struct Reach
+    {
+        double reachKm;  // Graph distance to the far end of the rail
+        Rail*  rail;
+    };
+
+    using Key = std::pair<const Node*, int>;
+
+    const INetworkQuery*              _network;
+    mutable std::mutex                _mutex;  // Guards _cache; entries never change once added
+    std::map<Key, std::vector<Reach>> _cache;
+
+    // All rails reachable within boundKm, sorted by ascending reach.
+    std::vector<Reach> computeFootprint(Node* center, double boundKm) const;
+};
+
+#endif
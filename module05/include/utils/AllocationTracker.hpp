@@ -0,0 +1,51 @@
+#ifndef ALLOCATIONTRACKER_HPP
+#define ALLOCATIONTRACKER_HPP
+
+#include "utils/TickProfiler.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Heap accounting.  Counting needs the replacement operator new/delete in
+// src/utils/AllocationHooks.cpp, which the test and bench binaries always
+// link and railway_sim links with -DRAILWAY_ALLOC_TRACKING=ON.  The same option tags
+// allocations made inside SimulationManager::tick() with the running phase.
+namespace AllocationTracker
+{
+    struct Counters
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes       = 0;  // Requested bytes
+    };
+
+    // The hooks are linked in; every other query returns zeros otherwise.
+    bool isInstalled();
+
+    // Since start-up, over all threads.
+    Counters      total();
+    std::uint64_t liveBytes();  // Usable size of the blocks not freed yet
+
+    // Allocations made while phase was the innermost tag; TickPhase::COUNT
+    // gives the untagged ones.
+    Counters phase(TickPhase phase);
+
+    // Called by the hooks.
+    void install();
+    void onAllocate(std::size_t bytes, std::size_t usable);
+    void onFree(std::size_t usable);
+
+    // Tags the calling thread's allocations with phase while in scope.
+    class TagScope
+    {
+    public:
+        explicit TagScope(TickPhase phase);
+        ~TagScope();
+
+        TagScope(const TagScope&)            = delete;
+        TagScope& operator=(const TagScope&) = delete;
+
+    private:
+        TickPhase _previous;
+    };
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef BINARY_CODEC_HPP
+#define BINARY_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Field encoding shared by the binary formats (compiled scenario, trace file,
+// command log).  Writers append to a std::string; Reader walks a byte range.
+// Fixed-width fields are host byte order: the files are caches and logs of
+// the machine that wrote them, not an exchange format.
+class BinaryCodec
+{
+public:
+    // putDelta() marker byte: value bits unchanged.
+    static constexpr std::uint8_t SAME_BITS = 64;
+
+    template <typename T>
+    static void put(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // LEB128: 7 bits per byte, high bit set on all but the last.
+    static void putVarint(std::string& out, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    // Zigzag, so small negative values stay short.
+    static void putSigned(std::string& out, std::int32_t value)
+    {
+        const std::uint32_t zigzag = (static_cast<std::uint32_t>(value) << 1)
+                                   ^ static_cast<std::uint32_t>(value >> 31);
+        putVarint(out, zigzag);
+    }
+
+    // u32 length, then the bytes.
+    static void putString(std::string& out, std::string_view text)
+    {
+        put(out, static_cast<std::uint32_t>(text.size()));
+        out.append(text.data(), text.size());
+    }
+
+    // Bits XOR the previous value's bits, stripped of trailing zeros: a
+    // repeated value is one byte and a round step only a few.  Exact.
+    static void putDelta(std::string& out, double value, std::uint64_t& previous)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const std::uint64_t delta = bits ^ previous;
+        previous = bits;
+
+        if (delta == 0)
+        {
+            out += static_cast<char>(SAME_BITS);
+            return;
+        }
+
+        const int shift = __builtin_ctzll(delta);
+        out += static_cast<char>(shift);
+        putVarint(out, delta >> shift);
+    }
+
+    // Bounds-checked cursor; any overrun throws std::runtime_error, which
+    // callers report as a truncated or corrupt file.
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view bytes) : _bytes(bytes), _pos(0) {}
+
+        template <typename T>
+        T get()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        std::string_view take(std::size_t count)
+        {
+            if (count > _bytes.size() - _pos)
+            {
+                throw std::runtime_error("truncated data");
+            }
+
+            std::string_view slice = _bytes.substr(_pos, count);
+            _pos += count;
+            return slice;
+        }
+
+        std::uint64_t varint()
+        {
+            std::uint64_t value = 0;
+
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                const std::uint8_t byte = get<std::uint8_t>();
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+
+            throw std::runtime_error("varint too long");
+        }
+
+        std::int32_t signedVarint()
+        {
+            const std::uint32_t zigzag = static_cast<std::uint32_t>(varint());
+            return static_cast<std::int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+        }
+
+        double delta(std::uint64_t& previous)
+        {
+            const std::uint8_t shift = get<std::uint8_t>();
+
+            if (shift != SAME_BITS)
+            {
+                if (shift > 63)
+                {
+                    throw std::runtime_error("bad delta");
+                }
+                previous ^= varint() << shift;
+            }
+
+            double value;
+            std::memcpy(&value, &previous, sizeof(value));
+            return value;
+        }
+
+        std::string_view string() { return take(get<std::uint32_t>()); }
+
+        bool        atEnd()     const { return _pos == _bytes.size(); }
+        std::size_t position()  const { return _pos; }
+        std::size_t remaining() const { return _bytes.size() - _pos; }
+
+    private:
+        std::string_view _bytes;
+        std::size_t      _pos;
+    };
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef COUNTERRNG_HPP
+#define COUNTERRNG_HPP
+
+#include "utils/IRng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Counter-based splittable generator (SplitMix64 family).  Draw n of a stream
+// is a pure function of (key, gamma, n), so:
+//   - state is three words instead of mt19937's ~5 KB;
+//   - independent streams for any (seed, run, subsystem) are derived directly,
+//     without generating or coordinating with any other stream;
+//   - seek() jumps to any position in O(1).
+// Each stream gets its own odd gamma (increment) from its key, as in
+// SplittableRandom.  The class is final and the next*() methods are inline:
+// code holding a CounterRng (not an IRng&) pays no virtual dispatch.
+class CounterRng final : public IRng
+{
+private:
+    static constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t _key;
+    std::uint64_t _gamma;
+    std::uint64_t _counter;
+    unsigned int  _seed;
+    bool          _antithetic;
+
+public:
+    CounterRng()
+        : _key(0), _gamma(GOLDEN_GAMMA), _counter(0), _seed(0), _antithetic(false)
+    {
+        reseed(0);
+    }
+
+    explicit CounterRng(unsigned int seed, std::uint64_t run = 0, std::uint64_t subsystem = 0)
+        : _key(0), _gamma(GOLDEN_GAMMA), _counter(0), _seed(seed), _antithetic(false)
+    {
+        reseed(seed, run, subsystem);
+    }
+
+    // SplitMix64 finaliser: a bijective 64-bit avalanche mix.
+    static std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static std::uint64_t deriveKey(unsigned int seed, std::uint64_t run, std::uint64_t subsystem)
+    {
+        std::uint64_t key = mix(static_cast<std::uint64_t>(seed) + GOLDEN_GAMMA);
+        key = mix(key ^ (run + 2 * GOLDEN_GAMMA));
+        return mix(key ^ (subsystem + 3 * GOLDEN_GAMMA));
+    }
+
+    // Restarts the stream identified by (seed, run, subsystem) at position 0.
+    void reseed(unsigned int seed, std::uint64_t run = 0, std::uint64_t subsystem = 0)
+    {
+        _seed    = seed;
+        _key     = deriveKey(seed, run, subsystem);
+        _gamma   = mix(_key ^ GOLDEN_GAMMA) | 1ULL;
+        _counter = 0;
+    }
+
+    // Child stream keyed off this one; the parent's position is unaffected.
+    CounterRng split(std::uint64_t subsystem) const
+    {
+        CounterRng child(*this);
+        child._key     = mix(_key ^ mix(subsystem + GOLDEN_GAMMA));
+        child._gamma   = mix(child._key ^ GOLDEN_GAMMA) | 1ULL;
+        child._counter = 0;
+        return child;
+    }
+
+    // Antithetic streams return 1 - u for every uniform u.
+    void setAntithetic(bool antithetic) { _antithetic = antithetic; }
+    bool isAntithetic() const           { return _antithetic; }
+
+    void          seek(std::uint64_t position) { _counter = position; }
+    std::uint64_t position() const             { return _counter; }
+
+    std::uint64_t nextBits()
+    {
+        return mix(_key + (++_counter) * _gamma);
+    }
+
+    // Uniform in [0, 1) with 53 random bits.
+    double nextUniform()
+    {
+        double u = static_cast<double>(nextBits() >> 11) * 0x1.0p-53;
+        if (_antithetic)
+        {
+            // 1 - u lies in (0, 1]; nudge the endpoint back into [0, 1).
+            u = std::min(1.0 - u, 0x1.fffffffffffffp-1);
+        }
+        return u;
+    }
+
+    // Inversion sampling: one uniform per draw, monotone in u.
+    int nextInt(int min, int max)
+    {
+        double span   = static_cast<double>(max) - static_cast<double>(min) + 1.0;
+        int    offset = static_cast<int>(std::floor(nextUniform() * span));
+        return std::min(min + offset, max);
+    }
+
+    double nextDouble(double min, double max)
+    {
+        return min + nextUniform() * (max - min);
+    }
+
+    bool nextBool(double probability)
+    {
+        return nextUniform() < probability;
+    }
+
+    // IRng
+    int          getInt(int min, int max)          override { return nextInt(min, max); }
+    double       getDouble(double min, double max)  override { return nextDouble(min, max); }
+    bool         getBool(double probability)        override { return nextBool(probability); }
+    unsigned int getSeed()                    const override { return _seed; }
+};
+
+#endif
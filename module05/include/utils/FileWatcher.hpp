@@ -1,19 +1,38 @@
 #ifndef FILEWATCHER_HPP
 #define FILEWATCHER_HPP
 
+#include "utils/SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <thread>
 #include <vector>
-#include <functional>
-#include <map>
 
 // Watches a set of files for modification and fires a callback on change.
-// Polling is explicit and runs on the caller's thread.
+// A background thread detects changes: with inotify on Linux (blocked in
+// the kernel while nothing happens; the parent directories are watched so
+// editors that save by rename are seen too; a queue overflow re-checks every
+// file and a lost directory watch is polled until it can be re-added), or by
+// polling stat() with nanosecond mtimes as a fallback.  A file's changes are reported once it
+// has been quiet for debounceMs, then queued through a lock-free ring;
+// poll() drains that queue and runs the callback on the caller's thread.
 class FileWatcher
 {
 public:
     using Callback = std::function<void(const std::string&)>;
 
-    FileWatcher(std::vector<std::string> files, Callback callback, int pollIntervalMs = 500);
+    enum class Backend
+    {
+        Auto,     // inotify when available, else polling
+        Inotify,  // start() throws std::runtime_error if unavailable
+        Polling
+    };
+
+    static constexpr std::size_t QUEUE_CAPACITY = 64;
+
+    FileWatcher(std::vector<std::string> files, Callback callback, int pollIntervalMs = 500,
+                int debounceMs = 50, Backend backend = Backend::Auto);
     ~FileWatcher();
 
     FileWatcher(const FileWatcher&)            = delete;
@@ -21,17 +40,50 @@ public:
 
     void start();
     void stop();
+
+    // Deliver queued changes; a single atomic load when there are none.
     void poll();
 
+    // The backend in use after start() (Auto resolved).
+    Backend getBackend() const;
+
 private:
-    std::vector<std::string>         _files;
-    Callback                         _callback;
-    int                              _pollIntervalMs;
-    bool                             _running;
-    std::map<std::string, long long> _lastModTimes;
-    long long                        _lastPollTimeMs;
-
-    long long getModTime(const std::string& path) const;
+    struct Stamp
+    {
+        long long     seconds     = -1;  // -1 = missing
+        long long     nanoseconds = 0;
+        long long     size        = 0;
+        unsigned long inode       = 0;
+
+        bool operator==(const Stamp& other) const;
+    };
+
+    std::vector<std::string>              _files;
+    Callback                              _callback;
+    int                                   _pollIntervalMs;
+    int                                   _debounceMs;
+    Backend                               _backend;
+    bool                                  _running;
+    std::thread                           _thread;
+    int                                   _stopPipe[2];
+    int                                   _inotifyFd;
+    std::vector<int>                      _watches;  // Per file: its directory's watch (-1 = lost)
+    SpscRing<std::size_t, QUEUE_CAPACITY> _changes;  // File indices, watcher -> poll()
+
+    // Watcher thread only.
+    std::vector<Stamp>     _stamps;
+    std::vector<long long> _dueMs;  // Per file: report at this time (-1 = nothing pending)
+
+    bool      openInotify();
+    void      closeFds();
+    void      run();
+    void      readInotify();
+    void      restoreWatches();
+    bool      hasLostWatch() const;
+    void      scan();
+    void      publishDue(long long now);
+    int       waitMs(long long now, long long nextScan) const;
+    Stamp     stamp(const std::string& path) const;
     long long nowMs() const;
 };
 
@@ -0,0 +1,36 @@
+#ifndef MEMORYUSAGE_HPP
+#define MEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Heap bytes held by standard containers, for the approximate per-subsystem
+// memory reports.  Counts capacity, not size; allocator headers are ignored.
+namespace MemoryUsage
+{
+    // Links and colour of one std::map node.
+    constexpr std::size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+    // Nothing while the text fits the string's inline buffer.
+    inline std::size_t heapBytes(const std::string& text)
+    {
+        return (text.capacity() > std::string().capacity()) ? text.capacity() + 1 : 0;
+    }
+
+    template <typename T, typename A>
+    std::size_t heapBytes(const std::vector<T, A>& items)
+    {
+        return items.capacity() * sizeof(T);
+    }
+
+    // Nodes only: keys or values that own memory are the caller's to add.
+    template <typename K, typename V, typename C, typename A>
+    std::size_t heapBytes(const std::map<K, V, C, A>& items)
+    {
+        return items.size() * (TREE_NODE_OVERHEAD + sizeof(typename std::map<K, V, C, A>::value_type));
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef OBJECTPOOL_HPP
+#define OBJECTPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Allocation counters reported by every pool.
+struct PoolStats
+{
+    std::size_t chunkAllocations = 0;  // Heap allocations performed by the pool
+    std::size_t created          = 0;  // Objects constructed over the pool's lifetime
+    std::size_t live             = 0;  // Objects currently constructed
+    std::size_t peakLive         = 0;  // Highest simultaneous live count
+    std::size_t reservedBytes    = 0;  // Chunk storage held, live or free
+
+    PoolStats& operator+=(const PoolStats& other)
+    {
+        chunkAllocations += other.chunkAllocations;
+        created          += other.created;
+        live             += other.live;
+        peakLive         += other.peakLive;
+        reservedBytes    += other.reservedBytes;
+        return *this;
+    }
+};
+
+// Typed free-list pool.  Storage is carved from chunks of at least
+// ChunkSize slots that are returned to the heap only when the pool is
+// destroyed; destroyed slots are reused by later create() calls, so
+// steady-state churn allocates nothing.
+// Not thread-safe — one pool per simulation.  The owner must destroy() every
+// live object before the pool goes away.
+template <typename T, std::size_t ChunkSize = 64>
+class ObjectPool
+{
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr std::size_t roundUpToPowerOfTwo(std::size_t bytes)
+    {
+        std::size_t size = alignof(Slot);
+        while (size < bytes)
+        {
+            size *= 2;
+        }
+        return size;
+    }
+
+    // Each chunk is a power of two in size and aligned to it, so masking an
+    // address gives the base of the only chunk that could hold it and owns()
+    // is a single hash lookup.  The rounding is spent on extra slots.
+    static constexpr std::size_t CHUNK_BYTES = roundUpToPowerOfTwo(ChunkSize * sizeof(Slot));
+    static constexpr std::size_t CHUNK_SLOTS = CHUNK_BYTES / sizeof(Slot);
+
+    struct ChunkDeleter
+    {
+        void operator()(Slot* chunk) const
+        {
+            ::operator delete(chunk, std::align_val_t(CHUNK_BYTES));
+        }
+    };
+
+    std::vector<std::unique_ptr<Slot, ChunkDeleter>> _chunks;
+    std::unordered_set<std::uintptr_t>               _chunkBases;
+    Slot*                                            _freeList;
+    PoolStats                                        _stats;
+
+    static std::uintptr_t chunkBaseOf(const void* address)
+    {
+        return reinterpret_cast<std::uintptr_t>(address) & ~static_cast<std::uintptr_t>(CHUNK_BYTES - 1);
+    }
+
+    void grow()
+    {
+        void* raw = ::operator new(CHUNK_BYTES, std::align_val_t(CHUNK_BYTES));
+        _chunks.push_back(std::unique_ptr<Slot, ChunkDeleter>(static_cast<Slot*>(raw)));
+        _chunkBases.insert(reinterpret_cast<std::uintptr_t>(raw));
+
+        Slot* slots = static_cast<Slot*>(raw);
+        for (std::size_t i = 0; i < CHUNK_SLOTS; ++i)
+        {
+            ::new (static_cast<void*>(&slots[i])) Slot;
+            slots[i].next = (i + 1 < CHUNK_SLOTS) ? &slots[i + 1] : _freeList;
+        }
+
+        _freeList = &slots[0];
+        ++_stats.chunkAllocations;
+        _stats.reservedBytes += CHUNK_BYTES;
+    }
+
+public:
+    ObjectPool() : _freeList(nullptr) {}
+    ~ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        if (!_freeList)
+        {
+            grow();
+        }
+
+        Slot* slot = _freeList;
+        _freeList  = slot->next;
+
+        T* object = nullptr;
+
+        try
+        {
+            object = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            slot->next = _freeList;
+            _freeList  = slot;
+            throw;
+        }
+
+        ++_stats.created;
+        if (++_stats.live > _stats.peakLive)
+        {
+            _stats.peakLive = _stats.live;
+        }
+
+        return object;
+    }
+
+    void destroy(T* object)
+    {
+        if (!object)
+        {
+            return;
+        }
+
+        object->~T();
+
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = _freeList;
+        _freeList  = slot;
+        --_stats.live;
+    }
+
+    // True when the object at address was handed out by this pool.  Any
+    // address may be asked about; it is never dereferenced.
+    bool owns(const void* address) const
+    {
+        return address && _chunkBases.count(chunkBaseOf(address)) != 0;
+    }
+
+    const PoolStats& stats() const
+    {
+        return _stats;
+    }
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "utils/IRng.hpp"
 #include <random>
+#include <string>
 
 // Seeded Random Number Generator for reproducible simulations.
 // Same seed = identical event sequence.
@@ -22,6 +23,11 @@ public:
 
     // Reset generator to a new seed (used by MonteCarloRunner between runs).
     void reseed(unsigned int seed);
+
+    // Full generator state as text, for simulation checkpoints.  loadState()
+    // throws std::runtime_error on a malformed state.
+    std::string saveState() const;
+    void        loadState(const std::string& state);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded single-producer / single-consumer queue.  Exactly one thread may
+// push and exactly one other thread pop; neither blocks or allocates.
+// Capacity must be a power of two.  Slots live as long as the ring, so
+// claim()/publish() and front()/release() let both sides work on a slot in
+// place and keep whatever buffers it owns for the next lap.
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    std::vector<T>                       _slots;
+    alignas(64) std::atomic<std::size_t> _head;  // Next slot to write (producer-owned)
+    alignas(64) std::atomic<std::size_t> _tail;  // Next slot to read (consumer-owned)
+
+public:
+    SpscRing() : _slots(Capacity), _head(0), _tail(0) {}
+
+    SpscRing(const SpscRing&)            = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer only.  False when the ring is full.
+    bool tryPush(const T& value)
+    {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+
+        if (head - _tail.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+
+        _slots[head & MASK] = value;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.  False when the ring is empty.
+    bool tryPop(T& out)
+    {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        out = _slots[tail & MASK];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only.  Next free slot to fill in place, or nullptr when full;
+    // publish() hands it to the consumer.
+    T* claim()
+    {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+
+        if (head - _tail.load(std::memory_order_acquire) == Capacity)
+        {
+            return nullptr;
+        }
+        return &_slots[head & MASK];
+    }
+
+    void publish()
+    {
+        _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer only.  Oldest published slot, or nullptr when empty;
+    // release() returns it to the producer.
+    T* front()
+    {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &_slots[tail & MASK];
+    }
+
+    void release()
+    {
+        _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
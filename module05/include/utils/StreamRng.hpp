@@ -0,0 +1,39 @@
+#ifndef STREAMRNG_HPP
+#define STREAMRNG_HPP
+
+#include "utils/CounterRng.hpp"
+#include <cstdint>
+
+// Generator for a single decision site, sampled by inversion: every draw
+// consumes exactly one uniform u in [0, 1) and maps it monotonically, so an
+// antithetic twin (same seed, u -> 1 - u) mirrors the original draw for draw.
+// Backed by a CounterRng keyed by (seed, streamKey), so a site's position can
+// be saved and restored with seek().  The class is final and forwards inline,
+// so callers holding a StreamRng directly pay no virtual dispatch.
+class StreamRng final : public IRng
+{
+private:
+    CounterRng _stream;
+
+public:
+    StreamRng() = default;
+
+    int          getInt(int min, int max)          override { return _stream.nextInt(min, max); }
+    double       getDouble(double min, double max)  override { return _stream.nextDouble(min, max); }
+    bool         getBool(double probability)        override { return _stream.nextBool(probability); }
+    unsigned int getSeed()                    const override { return _stream.getSeed(); }
+
+    // seed is reported by getSeed(); streamKey selects the independent stream.
+    void reseed(unsigned int seed, unsigned int streamKey, bool antithetic)
+    {
+        _stream.reseed(seed, 0, streamKey);
+        _stream.setAntithetic(antithetic);
+    }
+
+    bool isAntithetic() const { return _stream.isAntithetic(); }
+
+    void          seek(std::uint64_t position) { _stream.seek(position); }
+    std::uint64_t position() const             { return _stream.position(); }
+};
+
+#endif
@@ -1,7 +1,12 @@
 #ifndef STRING_UTILS_HPP
 #define STRING_UTILS_HPP
 
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -21,29 +26,42 @@ public:
         return ss.str();
     }
 
-    // Split a string by whitespace into tokens
-    static std::vector<std::string> splitTokens(const std::string& line)
+    // Split a line into whitespace-separated views without allocating.
+    // Returns the total token count; tokens past N are counted but not stored.
+    template <std::size_t N>
+    static std::size_t splitTokens(std::string_view line, std::array<std::string_view, N>& tokens)
     {
-        std::istringstream iss(line);
-        std::vector<std::string> tokens;
-        std::string token;
+        std::size_t count = 0;
+        std::size_t pos   = line.find_first_not_of(" \t\r\n");
 
-        while (iss >> token)
+        while (pos != std::string_view::npos)
         {
-            tokens.push_back(token);
+            std::size_t end = line.find_first_of(" \t\r\n", pos);
+            if (end == std::string_view::npos)
+            {
+                end = line.size();
+            }
+
+            if (count < N)
+            {
+                tokens[count] = line.substr(pos, end - pos);
+            }
+            ++count;
+
+            pos = line.find_first_not_of(" \t\r\n", end);
         }
 
-        return tokens;
+        return count;
     }
 
-    // Trim leading and trailing whitespace
-    static std::string trim(const std::string& s)
+    // Trim leading and trailing whitespace; the result views into s.
+    static std::string_view trim(std::string_view s)
     {
         std::size_t start = s.find_first_not_of(" \t\r\n");
 
-        if (start == std::string::npos)
+        if (start == std::string_view::npos)
         {
-            return "";
+            return std::string_view();
         }
 
         std::size_t end = s.find_last_not_of(" \t\r\n");
@@ -51,6 +69,42 @@ public:
         return s.substr(start, end - start + 1);
     }
 
+    // Append value in fixed notation with the given number of decimals;
+    // same digits as `std::fixed << std::setprecision(precision)`.
+    static void appendFixed(std::string& out, double value, int precision)
+    {
+        char buffer[400];  // Widest finite double in fixed notation fits
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                                    std::chars_format::fixed, precision);
+        out.append(buffer, result.ptr);
+    }
+
+    // Append the shortest text that parses back to exactly value.
+    static void appendShortest(std::string& out, double value)
+    {
+        char buffer[32];
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    // Append text padded with fill to at least width characters, like
+    // `std::setw(width)` with std::left (padLeft = false) or std::right.
+    static void appendPadded(std::string& out, std::string_view text, std::size_t width,
+                             char fill = ' ', bool padLeft = false)
+    {
+        const std::size_t padding = (text.size() < width) ? width - text.size() : 0;
+
+        if (padLeft)
+        {
+            out.append(padding, fill);
+        }
+        out.append(text.data(), text.size());
+        if (!padLeft)
+        {
+            out.append(padding, fill);
+        }
+    }
+
     // Escape a string for JSON output (handles ", \, \n)
     static std::string escapeJson(const std::string& s)
     {
@@ -80,15 +134,24 @@ public:
         return out;
     }
 
-    // Parse a double from a token; throws if the token contains non-numeric characters.
-    static double parseDouble(const std::string& token, const std::string& fieldName)
+    // Parse a double from a token (locale-independent, no allocation); throws
+    // if the token is empty, out of range or contains non-numeric characters.
+    static double parseDouble(std::string_view token, const std::string& fieldName)
     {
-        std::size_t pos = 0;
-        double value = std::stod(token, &pos);
+        // from_chars rejects a leading '+', which stod used to accept.
+        if (!token.empty() && token.front() == '+')
+        {
+            token.remove_prefix(1);
+        }
+
+        double value = 0.0;
+        const char* end = token.data() + token.size();
+        std::from_chars_result result = std::from_chars(token.data(), end, value);
 
-        if (pos != token.size())
+        if (token.empty() || result.ec != std::errc() || result.ptr != end)
         {
-            throw std::runtime_error("Invalid numeric value for '" + fieldName + "': '" + token + "'");
+            throw std::runtime_error("Invalid numeric value for '" + fieldName + "': '"
+                                     + std::string(token) + "'");
         }
 
         return value;
@@ -0,0 +1,172 @@
+#ifndef TICKPROFILER_HPP
+#define TICKPROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Phases of SimulationManager::tick() timed by PROFILE_PHASE.
+enum class TickPhase : std::uint8_t
+{
+    Tick,               // The whole tick
+    CheckDepartures,
+    RefreshState,       // Rail occupancy + risk data
+    StateTransitions,   // Or replayed commands
+    UpdateTrainStates,
+    EventPipeline,
+    WriteSnapshots,
+    UpdateDashboard,
+    COUNT
+};
+
+const char* tickPhaseName(TickPhase phase);
+
+// Collects scoped phase timings from every simulation thread (--profile).
+// Each thread records into its own buffer: a fixed ring of the latest spans
+// for the Chrome trace, plus per-phase histograms that see every span.  The
+// buffers are merged only when exported, after the simulations have run.
+//
+// Timers exist only in builds with RAILWAY_PROFILING (CMake option, on by
+// default); without it PROFILE_PHASE expands to nothing.  In a profiling
+// build that is not profiling, a timer costs one relaxed atomic load.
+class TickProfiler
+{
+public:
+    static constexpr std::size_t RING_CAPACITY = 1u << 16;  // Spans kept per thread for the trace
+    static constexpr std::size_t BUCKETS       = 256;       // Four per power of two nanoseconds
+
+    // One phase's durations, merged over threads.
+    struct PhaseSummary
+    {
+        std::uint64_t                     count   = 0;
+        std::uint64_t                     totalNs = 0;
+        std::uint64_t                     minNs   = UINT64_MAX;
+        std::uint64_t                     maxNs   = 0;
+        std::array<std::uint64_t, BUCKETS> buckets{};
+
+        void          add(std::uint64_t ns);
+        void          merge(const PhaseSummary& other);
+        std::uint64_t quantileNs(double q) const;  // Within 12.5%; exact at the min and max
+    };
+
+    using Summary = std::array<PhaseSummary, static_cast<std::size_t>(TickPhase::COUNT)>;
+
+    TickProfiler();
+    ~TickProfiler();
+
+    TickProfiler(const TickProfiler&)            = delete;
+    TickProfiler& operator=(const TickProfiler&) = delete;
+
+    // Make this the profiler every thread records into, or stop recording.
+    // Only one profiler records at a time; stop() before reading results.
+    void start();
+    void stop();
+
+    static bool isActive()
+    {
+        return _active.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    // Span of phase on the calling thread, in steady_clock nanoseconds.
+    static void record(TickPhase phase, std::uint64_t startNs, std::uint64_t endNs);
+
+    static std::uint64_t nowNs()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    std::size_t threadCount() const;
+    Summary     summarize() const;
+
+    // Chrome trace_event JSON (chrome://tracing, Perfetto) of the spans
+    // each thread still holds.  Throws std::runtime_error on I/O failure.
+    void writeChromeTrace(const std::string& path) const;
+
+    // One row per phase: count, total, mean, min, p50/p90/p99, max and the
+    // share of tick time.  Throws std::runtime_error on I/O failure.
+    void writeSummaryCsv(const std::string& path) const;
+
+    // Times the enclosing block while a profiler is active.
+    class Scope
+    {
+    public:
+        explicit Scope(TickPhase phase)
+            : _phase(phase),
+              _startNs(isActive() ? nowNs() : 0)
+        {
+        }
+
+        ~Scope()
+        {
+            if (_startNs != 0)
+            {
+                record(_phase, _startNs, nowNs());
+            }
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        TickPhase     _phase;
+        std::uint64_t _startNs;
+    };
+
+private:
+    struct Span
+    {
+        std::uint64_t startNs;
+        std::uint32_t durationNs;  // Saturates at ~4.3 s
+        TickPhase     phase;
+    };
+
+    struct ThreadBuffer
+    {
+        int               id;
+        std::vector<Span> ring;
+        std::uint64_t     recorded = 0;  // Spans ever recorded; ring holds the last RING_CAPACITY
+        Summary           phases;
+    };
+
+    static std::atomic<TickProfiler*> _active;
+    static std::atomic<unsigned>      _generation;  // Bumped by start(): invalidates thread caches
+
+    // The calling thread's buffer in the current session.
+    static thread_local ThreadBuffer* _threadBuffer;
+    static thread_local unsigned      _threadGeneration;
+
+    mutable std::mutex                         _mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+    std::uint64_t                              _originNs;
+
+    ThreadBuffer* registerThread();
+};
+
+#define PROFILE_PHASE_CONCAT_(a, b)       a##b
+#define PROFILE_PHASE_NAME_(prefix, line) PROFILE_PHASE_CONCAT_(prefix, line)
+
+#ifdef RAILWAY_PROFILING
+#define PROFILE_PHASE_TIMER_(phase) TickProfiler::Scope PROFILE_PHASE_NAME_(profilePhase_, __LINE__)(phase)
+#else
+#define PROFILE_PHASE_TIMER_(phase) static_cast<void>(0)
+#endif
+
+#ifdef RAILWAY_ALLOC_TRACKING
+#include "utils/AllocationTracker.hpp"
+#define PROFILE_PHASE_TAG_(phase) AllocationTracker::TagScope PROFILE_PHASE_NAME_(allocationTag_, __LINE__)(phase)
+#else
+#define PROFILE_PHASE_TAG_(phase) static_cast<void>(0)
+#endif
+
+// Times the rest of the block as phase and, with RAILWAY_ALLOC_TRACKING,
+// counts its allocations under that phase.
+#define PROFILE_PHASE(phase) PROFILE_PHASE_TIMER_(phase); PROFILE_PHASE_TAG_(phase)
+
+#endif
@@ -2,6 +2,7 @@
 #define TIME_HPP
 
 #include <string>
+#include <string_view>
 
 // Represents time in HHhMM format (e.g., "14h10" = 14 hours 10 minutes)
 class Time
@@ -13,7 +14,7 @@ private:
 public:
     Time();
     Time(int hours, int minutes);
-    Time(const std::string& timeStr);  // Parse "HHhMM" format
+    Time(std::string_view timeStr);  // Parse "HHhMM" format
     Time(const Time&)            = default;
     Time& operator=(const Time&) = default;
     ~Time()                      = default;
@@ -2,9 +2,23 @@
 #include "app/RunSession.hpp"
 #include "app/ModeHandlers.hpp"
 #include "io/FileParser.hpp"
+#include "io/ScenarioGenerator.hpp"
 #include "io/IOutputWriter.hpp"
 #include "io/ConsoleOutputWriter.hpp"
+#include "io/TraceFile.hpp"
+#include "utils/TickProfiler.hpp"
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(TickPhase::COUNT);
+}
 
 Application::Application(int argc, char* argv[])
     : _cli(argc, argv),
@@ -23,10 +37,13 @@ Application::~Application()
 
 void Application::registerModeHandlers()
 {
+    _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new CompileModeHandler()));
+    _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new SweepModeHandler()));
     _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new MonteCarloModeHandler()));
     _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new ReplayModeHandler()));
     _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new HotReloadModeHandler()));
     _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new RenderModeHandler()));
+    _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new LiveFeedModeHandler()));
     _modeHandlers.push_back(std::unique_ptr<IRunModeHandler>(new ConsoleModeHandler()));
 }
 
@@ -49,7 +66,7 @@ void Application::printConfiguration(const std::string& netFile,
     }
     if (_cli.hasRecord())
     {
-        _consoleWriter->writeConfiguration("Recording", "enabled -> output/replay.json");
+        _consoleWriter->writeConfiguration("Recording", "enabled -> " + _cli.getRecordFile());
     }
     if (_cli.hasReplay())
     {
@@ -59,6 +76,184 @@ void Application::printConfiguration(const std::string& netFile,
     {
         _consoleWriter->writeConfiguration("Monte Carlo", std::to_string(_cli.getMonteCarloRuns()) + " runs");
     }
+    if (_cli.hasCompile())
+    {
+        _consoleWriter->writeConfiguration("Compile to", _cli.getCompileFile());
+    }
+    if (_cli.hasSweep())
+    {
+        _consoleWriter->writeConfiguration("Sweep", _cli.getSweepFile());
+    }
+    if (_cli.hasTrace())
+    {
+        _consoleWriter->writeConfiguration("Trace file", _cli.getTraceFile());
+    }
+    if (_cli.hasProfile())
+    {
+        _consoleWriter->writeConfiguration("Profile", _cli.getProfileFile());
+    }
+}
+
+int Application::runTraceCommand() const
+{
+    try
+    {
+        const TraceReader reader(_cli.getTraceInput());
+        const std::string query = _cli.getTraceTrain();
+
+        if (query.empty())
+        {
+            for (const TraceReader::Train& train : reader.getTrains())
+            {
+                std::cout << train.label << " (" << train.records << " records)\n";
+            }
+            return 0;
+        }
+
+        const std::vector<std::size_t> matches = reader.findTrains(query);
+
+        if (matches.empty())
+        {
+            _consoleWriter->writeError("No train '" + query + "' in trace " + _cli.getTraceInput());
+            return 1;
+        }
+        if (matches.size() > 1)
+        {
+            std::string labels;
+            for (std::size_t index : matches)
+            {
+                labels += " " + reader.getTrains()[index].label;
+            }
+            _consoleWriter->writeError("Train '" + query + "' is ambiguous, use one of:" + labels);
+            return 1;
+        }
+
+        std::string text;
+        reader.render(matches.front(), text);
+
+        const std::string outPath = _cli.getTraceOutput();
+        if (outPath.empty())
+        {
+            std::cout << text;
+            return 0;
+        }
+
+        std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(text.data(), static_cast<std::streamsize>(text.size())))
+        {
+            throw std::runtime_error("Failed to write file: " + outPath);
+        }
+        _consoleWriter->writeOutputFileListing(outPath);
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        _consoleWriter->writeError(e.what());
+        return 1;
+    }
+}
+
+int Application::runGenerateCommand() const
+{
+    try
+    {
+        GeneratorSpec spec;
+        spec.topology  = ScenarioGenerator::parseTopology(_cli.getTopology());
+        spec.stations  = _cli.getStations();
+        spec.junctions = _cli.getJunctions();
+        spec.trains    = _cli.getTrainCount();
+        spec.seed      = _cli.getSeed();
+
+        for (const std::string& file : {_cli.getGenerateNetwork(), _cli.getGenerateTrains()})
+        {
+            const std::filesystem::path dir = std::filesystem::path(file).parent_path();
+            if (!dir.empty())
+            {
+                std::filesystem::create_directories(dir);
+            }
+        }
+
+        const ScenarioGenerator::Summary summary =
+            ScenarioGenerator(spec).writeFiles(_cli.getGenerateNetwork(), _cli.getGenerateTrains());
+
+        _consoleWriter->writeProgress("Generated " + std::string(ScenarioGenerator::topologyName(spec.topology)) + " network: "
+                                      + std::to_string(summary.stations + summary.junctions) + " nodes ("
+                                      + std::to_string(summary.stations) + " stations, "
+                                      + std::to_string(summary.junctions) + " junctions), "
+                                      + std::to_string(summary.rails) + " rails, "
+                                      + std::to_string(summary.trains) + " trains");
+        _consoleWriter->writeOutputFileListing(_cli.getGenerateNetwork());
+        _consoleWriter->writeOutputFileListing(_cli.getGenerateTrains());
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        _consoleWriter->writeError(e.what());
+        return 1;
+    }
+}
+
+int Application::runProfiled(IRunModeHandler& handler, const std::string& netFile,
+                             const std::string& trainFile, RunSession& session) const
+{
+#ifdef RAILWAY_ALLOC_TRACKING
+    std::array<AllocationTracker::Counters, PHASE_COUNT> allocationsBefore;
+    for (std::size_t i = 0; i < PHASE_COUNT; ++i)
+    {
+        allocationsBefore[i] = AllocationTracker::phase(static_cast<TickPhase>(i));
+    }
+#endif
+
+    TickProfiler profiler;
+    profiler.start();
+    const int status = handler.run(netFile, trainFile, session);
+    profiler.stop();
+
+    const TickProfiler::PhaseSummary tick = profiler.summarize()[static_cast<std::size_t>(TickPhase::Tick)];
+    if (tick.count == 0)
+    {
+        _consoleWriter->writeProgress("Profile: no simulation ticks ran");
+        return status;
+    }
+
+    try
+    {
+        const std::filesystem::path dir = std::filesystem::path(_cli.getProfileFile()).parent_path();
+        if (!dir.empty())
+        {
+            std::filesystem::create_directories(dir);
+        }
+        profiler.writeChromeTrace(_cli.getProfileFile());
+        profiler.writeSummaryCsv(_cli.getProfileSummary());
+    }
+    catch (const std::exception& e)
+    {
+        _consoleWriter->writeError(e.what());
+        return 1;
+    }
+
+    _consoleWriter->writeProgress("Profile: " + std::to_string(tick.count) + " ticks on "
+                                  + std::to_string(profiler.threadCount()) + " thread(s), mean tick "
+                                  + std::to_string(tick.totalNs / tick.count / 1000) + " us");
+#ifdef RAILWAY_ALLOC_TRACKING
+    // Allocations made inside each phase, and per tick.
+    for (std::size_t i = 0; i < PHASE_COUNT; ++i)
+    {
+        const AllocationTracker::Counters now = AllocationTracker::phase(static_cast<TickPhase>(i));
+        const std::uint64_t allocations = now.allocations - allocationsBefore[i].allocations;
+        const std::uint64_t bytes       = now.bytes - allocationsBefore[i].bytes;
+
+        char perTick[32];
+        std::snprintf(perTick, sizeof(perTick), "%.3f", static_cast<double>(allocations) / static_cast<double>(tick.count));
+        _consoleWriter->writeProgress("Allocations in " + std::string(tickPhaseName(static_cast<TickPhase>(i))) + ": "
+                                      + std::to_string(allocations) + " (" + std::to_string(bytes) + " bytes, "
+                                      + perTick + " per tick)");
+    }
+#endif
+
+    _consoleWriter->writeOutputFileListing(_cli.getProfileFile());
+    _consoleWriter->writeOutputFileListing(_cli.getProfileSummary());
+    return status;
 }
 
 int Application::run()
@@ -84,6 +279,26 @@ int Application::run()
         return 1;
     }
 
+    if (_cli.isTraceCommand())
+    {
+        return runTraceCommand();
+    }
+
+    if (_cli.isGenerateCommand())
+    {
+        return runGenerateCommand();
+    }
+
+#ifndef RAILWAY_PROFILING
+    if (_cli.hasProfile())
+    {
+        _consoleWriter->writeError("--profile is not available: built with RAILWAY_PROFILING=OFF");
+        return 1;
+    }
+#endif
+
+    _builder.setTraceFile(_cli.hasTrace() ? _cli.getTraceFile() : "");
+
     const std::string netFile   = _cli.getNetworkFile();
     const std::string trainFile = _cli.getTrainFile();
 
@@ -106,6 +321,10 @@ int Application::run()
     {
         if (_modeHandlers[i]->matches(_cli))
         {
+            if (_cli.hasProfile())
+            {
+                return runProfiled(*_modeHandlers[i], netFile, trainFile, session);
+            }
             return _modeHandlers[i]->run(netFile, trainFile, session);
         }
     }
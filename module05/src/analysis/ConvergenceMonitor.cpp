@@ -0,0 +1,127 @@
+#include "analysis/ConvergenceMonitor.hpp"
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/RunningStats.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    bool isKnownMetric(const std::string& name)
+    {
+        return name == "totalDuration"
+            || name == "totalEvents"
+            || name == "collisionAvoidances"
+            || name == "trainActualTime"
+            || name == "trainDelay";
+    }
+
+    void consider(const std::string& name, double width, ConvergenceReport& report)
+    {
+        if (width > report.worstRelativeHalfWidth || report.worstMetric.empty())
+        {
+            report.worstRelativeHalfWidth = width;
+            report.worstMetric            = name;
+        }
+    }
+}
+
+ConvergenceMonitor::ConvergenceMonitor(const ConvergenceCriteria& criteria)
+    : _criteria(criteria)
+{
+    if (_criteria.metrics.empty())
+    {
+        throw std::invalid_argument("Convergence requires at least one metric");
+    }
+
+    for (const std::string& metric : _criteria.metrics)
+    {
+        if (!isKnownMetric(metric))
+        {
+            throw std::invalid_argument("Unknown convergence metric: '" + metric + "'");
+        }
+    }
+
+    if (!(_criteria.relativeTolerance > 0.0))
+    {
+        throw std::invalid_argument("Convergence tolerance must be positive");
+    }
+
+    if (_criteria.checkInterval == 0)
+    {
+        _criteria.checkInterval = 1;
+    }
+
+    if (_criteria.minRuns < 2)
+    {
+        _criteria.minRuns = 2;
+    }
+}
+
+const ConvergenceCriteria& ConvergenceMonitor::getCriteria() const
+{
+    return _criteria;
+}
+
+bool ConvergenceMonitor::isCheckpoint(unsigned int runCount) const
+{
+    return runCount >= _criteria.minRuns
+        && (runCount - _criteria.minRuns) % _criteria.checkInterval == 0;
+}
+
+bool ConvergenceMonitor::evaluate(const MonteCarloAggregator& aggregate,
+                                  ConvergenceReport&          report) const
+{
+    report.worstRelativeHalfWidth = 0.0;
+    report.worstMetric.clear();
+
+    const double z = _criteria.zScore;
+
+    for (const std::string& metric : _criteria.metrics)
+    {
+        if (metric == "totalDuration")
+        {
+            consider(metric, relativeHalfWidth(aggregate.getTotalDuration().moments, z), report);
+        }
+        else if (metric == "totalEvents")
+        {
+            consider(metric, relativeHalfWidth(aggregate.getTotalEvents().moments, z), report);
+        }
+        else if (metric == "collisionAvoidances")
+        {
+            consider(metric, relativeHalfWidth(aggregate.getCollisionAvoidances().moments, z), report);
+        }
+        else
+        {
+            bool delay = (metric == "trainDelay");
+            for (const auto& kv : aggregate.getTrains())
+            {
+                const RunningStats& stats = delay ? kv.second.delay.moments
+                                                  : kv.second.actualTime.moments;
+                consider(kv.first + "_" + (delay ? "delay" : "actualTime"),
+                         relativeHalfWidth(stats, z), report);
+            }
+        }
+    }
+
+    return report.worstRelativeHalfWidth <= _criteria.relativeTolerance;
+}
+
+double ConvergenceMonitor::relativeHalfWidth(const RunningStats& stats, double zScore)
+{
+    if (stats.count() < 2)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double halfWidth = zScore * stats.standardError();
+    double scale     = std::fabs(stats.mean());
+
+    if (scale == 0.0)
+    {
+        return (halfWidth == 0.0) ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+
+    return halfWidth / scale;
+}
@@ -0,0 +1,176 @@
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/StatsCollector.hpp"
+
+// ---------------------------------------------------------------------------
+// MetricSummary
+// ---------------------------------------------------------------------------
+
+void MetricSummary::add(double value)
+{
+    moments.add(value);
+    distribution.add(value);
+}
+
+void MetricSummary::merge(const MetricSummary& other)
+{
+    moments.merge(other.moments);
+    distribution.merge(other.distribution);
+}
+
+// ---------------------------------------------------------------------------
+// MonteCarloAggregator
+// ---------------------------------------------------------------------------
+
+namespace
+{
+    void writeRow(std::ostream& out, const std::string& name, const MetricSummary& summary)
+    {
+        const RunningStats&   m = summary.moments;
+        const QuantileSketch& d = summary.distribution;
+
+        out << name
+            << "," << m.count()
+            << "," << m.mean()
+            << "," << m.stddev()
+            << "," << m.min()
+            << "," << d.quantile(0.05)
+            << "," << d.quantile(0.50)
+            << "," << d.quantile(0.95)
+            << "," << m.max()
+            << "\n";
+    }
+
+    // Moments-only metrics leave the quantile columns empty.
+    void writeRow(std::ostream& out, const std::string& name, const RunningStats& m)
+    {
+        out << name
+            << "," << m.count()
+            << "," << m.mean()
+            << "," << m.stddev()
+            << "," << m.min()
+            << ",,,"
+            << "," << m.max()
+            << "\n";
+    }
+}
+
+MonteCarloAggregator::MonteCarloAggregator()
+    : _runCount(0)
+{
+}
+
+void MonteCarloAggregator::add(const SimulationMetrics& run)
+{
+    ++_runCount;
+    _totalDuration.add(run.totalDuration);
+    _totalEvents.add(static_cast<double>(run.totalEventsGenerated));
+    _collisionAvoidances.add(static_cast<double>(run.collisionAvoidanceActivations));
+
+    for (const auto& kv : run.trainMetrics)
+    {
+        const TrainMetrics& tm      = kv.second;
+        TrainSummary&       summary = _trains[kv.first];
+
+        summary.eventsAffecting.add(static_cast<double>(tm.eventsAffectingTrain));
+        summary.reached.add(tm.reachedDestination ? 1.0 : 0.0);
+
+        if (tm.reachedDestination)
+        {
+            summary.actualTime.add(tm.actualTravelTime);
+            summary.delay.add(tm.actualTravelTime - tm.estimatedTravelTime);
+        }
+    }
+}
+
+void MonteCarloAggregator::addPair(const SimulationMetrics& first, const SimulationMetrics& second)
+{
+    ++_runCount;
+    _totalDuration.add(0.5 * (first.totalDuration + second.totalDuration));
+    _totalEvents.add(0.5 * (first.totalEventsGenerated + second.totalEventsGenerated));
+    _collisionAvoidances.add(0.5 * (first.collisionAvoidanceActivations
+                                    + second.collisionAvoidanceActivations));
+
+    for (const auto& kv : first.trainMetrics)
+    {
+        auto other = second.trainMetrics.find(kv.first);
+        if (other == second.trainMetrics.end())
+        {
+            continue;
+        }
+
+        const TrainMetrics& a       = kv.second;
+        const TrainMetrics& b       = other->second;
+        TrainSummary&       summary = _trains[kv.first];
+
+        summary.eventsAffecting.add(0.5 * (a.eventsAffectingTrain + b.eventsAffectingTrain));
+        summary.reached.add(0.5 * ((a.reachedDestination ? 1.0 : 0.0)
+                                   + (b.reachedDestination ? 1.0 : 0.0)));
+
+        if (a.reachedDestination && b.reachedDestination)
+        {
+            double actual = 0.5 * (a.actualTravelTime + b.actualTravelTime);
+            summary.actualTime.add(actual);
+            summary.delay.add(actual - 0.5 * (a.estimatedTravelTime + b.estimatedTravelTime));
+        }
+    }
+}
+
+void MonteCarloAggregator::merge(const MonteCarloAggregator& other)
+{
+    _runCount += other._runCount;
+    _totalDuration.merge(other._totalDuration);
+    _totalEvents.merge(other._totalEvents);
+    _collisionAvoidances.merge(other._collisionAvoidances);
+
+    for (const auto& kv : other._trains)
+    {
+        TrainSummary& summary = _trains[kv.first];
+        summary.actualTime.merge(kv.second.actualTime);
+        summary.delay.merge(kv.second.delay);
+        summary.eventsAffecting.merge(kv.second.eventsAffecting);
+        summary.reached.merge(kv.second.reached);
+    }
+}
+
+std::uint64_t MonteCarloAggregator::getRunCount() const
+{
+    return _runCount;
+}
+
+const MetricSummary& MonteCarloAggregator::getTotalDuration() const
+{
+    return _totalDuration;
+}
+
+const MetricSummary& MonteCarloAggregator::getTotalEvents() const
+{
+    return _totalEvents;
+}
+
+const MetricSummary& MonteCarloAggregator::getCollisionAvoidances() const
+{
+    return _collisionAvoidances;
+}
+
+const std::map<std::string, MonteCarloAggregator::TrainSummary>& MonteCarloAggregator::getTrains() const
+{
+    return _trains;
+}
+
+void MonteCarloAggregator::writeCSV(std::ostream& out) const
+{
+    out << "metric,count,mean,stddev,min,p05,p50,p95,max\n";
+
+    writeRow(out, "totalDuration", _totalDuration);
+    writeRow(out, "totalEvents", _totalEvents);
+    writeRow(out, "collisionAvoidances", _collisionAvoidances);
+
+    for (const auto& kv : _trains)
+    {
+        const std::string& name = kv.first;
+        writeRow(out, name + "_actualTime", kv.second.actualTime);
+        writeRow(out, name + "_delay", kv.second.delay);
+        writeRow(out, name + "_eventsAffecting", kv.second.eventsAffecting);
+        writeRow(out, name + "_reached", kv.second.reached);
+    }
+}
@@ -1,22 +1,15 @@
 #include "analysis/MonteCarloRunner.hpp"
-#include "io/RailNetworkParser.hpp"
-#include "io/TrainConfigParser.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "analysis/ScenarioRun.hpp"
 #include "io/ILogger.hpp"
-#include "patterns/creational/factories/TrainFactory.hpp"
-#include "patterns/creational/factories/TrainValidator.hpp"
-#include "patterns/behavioral/strategies/IPathfindingStrategy.hpp"
-#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
-#include "patterns/behavioral/strategies/AStarStrategy.hpp"
 #include "simulation/core/SimulationConfig.hpp"
-#include "core/Train.hpp"
-#include "core/Graph.hpp"
-#include "core/Node.hpp"
-#include "core/Rail.hpp"
-#include "patterns/behavioral/states/ITrainState.hpp"
-#include "utils/FileSystemUtils.hpp"
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <stdexcept>
 #include <iostream>
+#include <set>
+#include <thread>
 
 // ---------------------------------------------------------------------------
 // Construction
@@ -33,7 +26,12 @@ MonteCarloRunner::MonteCarloRunner(const std::string& networkFile,
       _baseSeed(baseSeed),
       _numRuns(numRuns),
       _pathfindingAlgo(pathfindingAlgo),
-      _logger(logger)
+      _logger(logger),
+      _threads(1),
+      _sampling(SamplingMode::Independent),
+      _pairFirst(),
+      _nextCommit(0),
+      _stopAt(0)
 {
 }
 
@@ -41,395 +39,360 @@ MonteCarloRunner::MonteCarloRunner(const std::string& networkFile,
 // Public API
 // ---------------------------------------------------------------------------
 
-void MonteCarloRunner::runAll()
+void MonteCarloRunner::setThreads(unsigned int threads)
 {
-    _allMetrics.clear();
-    _allMetrics.reserve(_numRuns);
+    _threads = std::max(threads, 1u);
+}
 
-    for (unsigned int i = 0; i < _numRuns; ++i)
-    {
-        unsigned int seed = _baseSeed + i;
-        log("Run " + std::to_string(i + 1) + "/" + std::to_string(_numRuns)
-            + " (seed=" + std::to_string(seed) + ")");
+unsigned int MonteCarloRunner::getThreads() const
+{
+    return _threads;
+}
 
-        SimulationMetrics metrics = runSingleSimulation(seed);
-        _allMetrics.push_back(metrics);
-    }
+void MonteCarloRunner::setRunsCSV(const std::string& filename)
+{
+    _runsCSVPath = filename;
+}
 
-    log("Monte Carlo complete: " + std::to_string(_numRuns) + " runs finished.");
+void MonteCarloRunner::setSampling(SamplingMode mode)
+{
+    _sampling = mode;
 }
 
-void MonteCarloRunner::writeCSV(const std::string& filename) const
+SamplingMode MonteCarloRunner::getSampling() const
 {
-    std::ofstream file(filename);
-    if (!file.is_open())
+    return _sampling;
+}
+
+unsigned int MonteCarloRunner::seedForRun(unsigned int index) const
+{
+    if (_sampling == SamplingMode::Antithetic)
     {
-        throw std::runtime_error("Cannot open CSV output: " + filename);
+        return _baseSeed + (index - index % 2);
     }
+    return _baseSeed + index;
+}
+
+bool MonteCarloRunner::isAntitheticRun(unsigned int index) const
+{
+    return _sampling == SamplingMode::Antithetic && (index % 2) == 1;
+}
+
+void MonteCarloRunner::setConvergence(const ConvergenceCriteria& criteria)
+{
+    _convergence.reset(new ConvergenceMonitor(criteria));
+}
 
-    // Header
-    file << "seed,totalDuration,totalEvents,collisionAvoidances";
+const ConvergenceReport& MonteCarloRunner::getConvergenceReport() const
+{
+    return _convergenceReport;
+}
 
-    // Collect all unique train names across all runs for column headers
-    std::vector<std::string> trainNames;
-    for (const SimulationMetrics& m : _allMetrics)
+void MonteCarloRunner::runAll()
+{
+    if (!_scenario)
     {
-        for (const auto& kv : m.trainMetrics)
-        {
-            const std::string& name = kv.first;
-            bool found = false;
-            for (const std::string& n : trainNames)
-            {
-                if (n == name)
-                {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                trainNames.push_back(name);
-            }
-        }
+        _scenario.reset(new PreparedScenario(_networkFile, _trainFile,
+                                             _pathfindingAlgo, _logger));
     }
 
-    for (const std::string& name : trainNames)
+    _aggregate         = MonteCarloAggregator();
+    _pairAggregate     = MonteCarloAggregator();
+    _convergenceReport = ConvergenceReport();
+    _nextCommit        = 0;
+    _stopAt.store(_numRuns);
+    _pending.clear();
+    openRunsCSV();
+
+    if (_convergence && _convergence->getCriteria().timeBudgetSeconds > 0.0)
     {
-        file << "," << name << "_actualTime"
-             << "," << name << "_estimatedTime"
-             << "," << name << "_stateTransitions"
-             << "," << name << "_eventsAffecting"
-             << "," << name << "_reached";
+        _deadline = std::chrono::steady_clock::now()
+                  + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(_convergence->getCriteria().timeBudgetSeconds));
     }
-    file << "\n";
 
-    // Rows
-    for (const SimulationMetrics& m : _allMetrics)
+    std::atomic<unsigned int> nextRun(0);
+    unsigned int workerCount = std::min(_threads, std::max(_numRuns, 1u));
+
+    if (workerCount <= 1)
     {
-        file << m.seed
-             << "," << m.totalDuration
-             << "," << m.totalEventsGenerated
-             << "," << m.collisionAvoidanceActivations;
+        runWorker(nextRun);
+    }
+    else
+    {
+        log("Running " + std::to_string(_numRuns) + " simulations on "
+            + std::to_string(workerCount) + " threads");
+
+        std::vector<std::thread>        workers;
+        std::vector<std::exception_ptr> errors(workerCount);
+        workers.reserve(workerCount);
 
-        for (const std::string& name : trainNames)
+        for (unsigned int w = 0; w < workerCount; ++w)
         {
-            auto it = m.trainMetrics.find(name);
-            if (it != m.trainMetrics.end())
+            workers.emplace_back([this, &nextRun, &errors, w]()
             {
-                const TrainMetrics& tm = it->second;
-                file << "," << tm.actualTravelTime
-                     << "," << tm.estimatedTravelTime
-                     << "," << tm.stateTransitions
-                     << "," << tm.eventsAffectingTrain
-                     << "," << (tm.reachedDestination ? 1 : 0);
-            }
-            else
+                try
+                {
+                    runWorker(nextRun);
+                }
+                catch (...)
+                {
+                    errors[w] = std::current_exception();
+                    _stopAt.store(0);  // Stop handing out further runs.
+                }
+            });
+        }
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        for (const std::exception_ptr& error : errors)
+        {
+            if (error)
             {
-                file << ",,,,,";
+                _runsCSV.close();
+                std::rethrow_exception(error);
             }
         }
-        file << "\n";
     }
 
-    log("CSV written: " + filename);
-}
-
-// ---------------------------------------------------------------------------
-// Private helpers
-// ---------------------------------------------------------------------------
-
-void MonteCarloRunner::log(const std::string& message) const
-{
-    if (_logger)
-    {
-        _logger->writeProgress(message);
-    }
-}
+    // Runs that finished past the stop point are discarded.
+    _pending.clear();
 
-double MonteCarloRunner::estimateJourneySeconds(const Train* train)
-{
-    if (!train)
+    if (_runsCSV.is_open())
     {
-        return 0.0;
+        _runsCSV.close();
+        log("CSV written: " + _runsCSVPath);
     }
 
-    double seconds = 0.0;
-    for (const PathSegment& seg : train->getPath())
+    if (_convergence)
     {
-        if (seg.rail && seg.rail->getSpeedLimit() > 0.0)
+        // Final evaluation so the report reflects every committed run.
+        _convergenceReport.converged = _convergence->evaluate(estimatorAggregate(), _convergenceReport);
+        _convergenceReport.runs      = _nextCommit;
+        if (_convergenceReport.stopReason.empty())
         {
-            seconds += (seg.rail->getLength() / seg.rail->getSpeedLimit())
-                       * SimConfig::SECONDS_PER_HOUR;
+            _convergenceReport.stopReason = _convergenceReport.converged ? "converged" : "max runs";
         }
+
+        log("Convergence: " + _convergenceReport.stopReason + " after "
+            + std::to_string(_nextCommit) + " runs (worst "
+            + _convergenceReport.worstMetric + " ±"
+            + std::to_string(_convergenceReport.worstRelativeHalfWidth * 100.0) + "%)");
     }
-    return seconds;
+
+    log("Monte Carlo complete: " + std::to_string(_nextCommit) + " runs finished.");
 }
 
-Graph* MonteCarloRunner::parseNetwork() const
+const MonteCarloAggregator& MonteCarloRunner::getAggregate() const
 {
-    RailNetworkParser parser(_networkFile);
-    return parser.parse();
+    return _aggregate;
 }
 
-std::vector<TrainConfig> MonteCarloRunner::parseTrains() const
+const MonteCarloAggregator& MonteCarloRunner::getPairAggregate() const
 {
-    TrainConfigParser parser(_trainFile);
-    return parser.parse();
+    return _pairAggregate;
 }
 
-IPathfindingStrategy* MonteCarloRunner::selectStrategy(
-    IPathfindingStrategy& dijkstra,
-    IPathfindingStrategy& astar)
+const MonteCarloAggregator& MonteCarloRunner::estimatorAggregate() const
 {
-    if (_pathfindingAlgo == "astar")
-    {
-        return &astar;
-    }
-    return &dijkstra;
+    return (_sampling == SamplingMode::Antithetic) ? _pairAggregate : _aggregate;
 }
 
-std::vector<Train*> MonteCarloRunner::buildTrains(
-    Graph*                graph,
-    StatsCollector&       stats,
-    IPathfindingStrategy* strategy)
+void MonteCarloRunner::writeSummaryCSV(const std::string& filename) const
 {
-    std::vector<TrainConfig> configs = parseTrains();
-    std::vector<Train*>      trains;
-
-    for (const TrainConfig& config : configs)
+    std::ofstream file(filename);
+    if (!file.is_open())
     {
-        // Validate config against the network (mirrors Application::_buildTrains).
-        ValidationResult vr = TrainValidator::validate(config, graph);
-        if (!vr.valid)
-        {
-            log("Skipping train '" + config.name + "': " + vr.error);
-            continue;
-        }
-
-        Train* train = TrainFactory::create(config, graph);
-        if (!train)
-        {
-            log("Failed to create train: " + config.name);
-            continue;
-        }
-
-        Node* startNode = graph->getNode(config.departureStation);
-        Node* endNode   = graph->getNode(config.arrivalStation);
-        auto  path      = strategy->findPath(graph, startNode, endNode);
-
-        if (path.empty())
-        {
-            log("No path for train '" + config.name + "' ("
-                + config.departureStation + " -> " + config.arrivalStation + ")");
-            delete train;
-            continue;
-        }
-
-        train->setPath(path);
-
-        double estimatedSeconds = estimateJourneySeconds(train);
-        stats.registerTrain(train, estimatedSeconds);
-
-        trains.push_back(train);
+        throw std::runtime_error("Cannot open CSV output: " + filename);
     }
 
-    return trains;
+    _aggregate.writeCSV(file);
+    log("Summary written: " + filename);
 }
 
-void MonteCarloRunner::setupSimulation(
-    Graph*                     graph,
-    const std::vector<Train*>& trains,
-    StatsCollector&            stats,
-    unsigned int               seed)
+void MonteCarloRunner::runWorker(std::atomic<unsigned int>& nextRun)
 {
-    _sim.reset();
+    // Each worker owns a simulation instance — reset() between its runs —
+    // and a pool of trains rewound at the start of every run.
+    SimulationManager sim;
+    ScenarioTrainPool pool(*_scenario);
 
-    SimulationConfig config;
-    config.network   = graph;
-    config.seed      = seed;
-    config.roundTrip = false;
-    config.writer    = nullptr;  // Silent — no console output during MC runs.
+    for (unsigned int i = nextRun.fetch_add(1); i < _stopAt.load(); i = nextRun.fetch_add(1))
+    {
+        if (_convergence && _convergence->getCriteria().timeBudgetSeconds > 0.0
+            && std::chrono::steady_clock::now() >= _deadline)
+        {
+            std::lock_guard<std::mutex> lock(_commitMutex);
+            stopAfterCommitted("time budget");
+            break;
+        }
 
-    _sim.configure(config);
-    _sim.setStatsCollector(&stats);
+        log("Run " + std::to_string(i + 1) + "/" + std::to_string(_numRuns)
+            + " (seed=" + std::to_string(seedForRun(i))
+            + (isAntitheticRun(i) ? ", antithetic" : "") + ")");
 
-    for (Train* train : trains)
-    {
-        _sim.addTrain(train);
+        commitRun(i, runSingleSimulation(sim, pool, i));
     }
 }
 
-void MonteCarloRunner::runSimulationLoop(
-    const std::vector<Train*>&  trains,
-    StatsCollector&             stats,
-    std::map<Train*, double>&   departureTime,
-    std::map<Train*, double>&   arrivalTime)
+void MonteCarloRunner::commitRun(unsigned int index, SimulationMetrics metrics)
 {
-    // Track previous states to detect transitions.
-    std::map<Train*, std::string> prevStates;
-    for (Train* train : trains)
+    std::lock_guard<std::mutex> lock(_commitMutex);
+
+    if (index >= _stopAt.load())
     {
-        if (train)
-        {
-            prevStates[train] = "Idle";
-        }
+        return;
     }
 
-    _sim.start();
-
-    constexpr double maxSimTime = 1e9;  // shouldStopEarly() terminates when done.
+    _pending.emplace(index, std::move(metrics));
 
-    while (_sim.isRunning() && _sim.getCurrentTime() < maxSimTime)
+    for (auto it = _pending.begin();
+         it != _pending.end() && it->first == _nextCommit && _nextCommit < _stopAt.load();
+         it = _pending.erase(it))
     {
-        _sim.step();
+        _aggregate.add(it->second);
+        writeRunRow(it->second);
 
-        double currentTime = _sim.getCurrentTime();
-
-        for (Train* train : trains)
+        if (_sampling == SamplingMode::Antithetic)
         {
-            if (!train)
-            {
-                continue;
-            }
-
-            if (!train->getCurrentState())
-            {
-                continue;
-            }
-
-            std::string currentStateName = train->getCurrentState()->getName();
-            std::string& prevStateName   = prevStates[train];
-
-            if (currentStateName != prevStateName)
-            {
-                // Detect departure (Idle → anything else)
-                if (prevStateName == "Idle" && currentStateName != "Idle")
-                {
-                    departureTime[train] = currentTime;
-                }
-
-                // Detect arrival (transition to finished state at destination)
-                if (train->isFinished() && arrivalTime.find(train) == arrivalTime.end())
-                {
-                    arrivalTime[train] = currentTime;
-                    stats.checkTrainDestination(train);
-                }
-
-                // Collision avoidance proxy: Idle → Waiting mid-journey
-                if (currentStateName == "Waiting" && prevStateName != "Idle")
-                {
-                    stats.recordCollisionAvoidance();
-                }
-
-                stats.recordStateTransition(train, prevStateName, currentStateName);
-                prevStateName = currentStateName;
-            }
-
-            // Check arrival for already-finished trains that may not change state
-            if (train->isFinished() && arrivalTime.find(train) == arrivalTime.end())
+            if (isAntitheticRun(_nextCommit))
             {
-                arrivalTime[train] = currentTime;
-                stats.checkTrainDestination(train);
+                _pairAggregate.addPair(_pairFirst, it->second);
             }
-        }
-
-        // shouldStopEarly is called inside sim.run(), but since we drive via
-        // step() here we replicate the stop condition manually.
-        bool allDone = true;
-        for (Train* train : trains)
-        {
-            if (train && !train->isFinished())
+            else
             {
-                allDone = false;
-                break;
+                _pairFirst = it->second;
             }
         }
 
-        if (allDone)
-        {
-            break;
-        }
+        ++_nextCommit;
+        checkStopConditions();
     }
 }
 
-SimulationMetrics MonteCarloRunner::finalizeMetrics(
-    StatsCollector&                    stats,
-    const std::vector<Train*>&         trains,
-    const std::map<Train*, double>&    departureTime,
-    const std::map<Train*, double>&    arrivalTime)
+void MonteCarloRunner::checkStopConditions()
 {
-    double totalDuration = _sim.getCurrentTime();
-    stats.finalize(totalDuration);
-
-    // Patch actual travel times from our timing maps.
-    for (Train* train : trains)
+    if (!_convergence || !_convergence->isCheckpoint(_nextCommit))
     {
-        if (!train)
-        {
-            continue;
-        }
+        return;
+    }
 
-        auto deptIt = departureTime.find(train);
-        auto arrIt  = arrivalTime.find(train);
+    // Antithetic estimates are only defined over complete pairs.
+    if (_sampling == SamplingMode::Antithetic && (_nextCommit % 2) != 0)
+    {
+        return;
+    }
 
-        if (deptIt != departureTime.end() && arrIt != arrivalTime.end())
-        {
-            double actual = arrIt->second - deptIt->second;
+    _convergenceReport.converged = _convergence->evaluate(estimatorAggregate(), _convergenceReport);
+    if (_convergenceReport.converged)
+    {
+        stopAfterCommitted("converged");
+    }
+}
 
-            SimulationMetrics& m = const_cast<SimulationMetrics&>(stats.getMetrics());
-            auto tmIt = m.trainMetrics.find(train->getName());
-            if (tmIt != m.trainMetrics.end())
-            {
-                tmIt->second.actualTravelTime = actual;
-            }
-        }
+void MonteCarloRunner::stopAfterCommitted(const std::string& reason)
+{
+    if (_convergenceReport.stopReason.empty())
+    {
+        _convergenceReport.stopReason = reason;
     }
 
-    return stats.getMetrics();
+    if (_nextCommit < _stopAt.load())
+    {
+        _stopAt.store(_nextCommit);
+    }
 }
 
-void MonteCarloRunner::cleanup(Graph* graph, std::vector<Train*>& trains)
+void MonteCarloRunner::openRunsCSV()
 {
-    _sim.reset();
+    _runsCSV.close();
+    if (_runsCSVPath.empty())
+    {
+        return;
+    }
 
-    for (Train* train : trains)
+    _runsCSV.open(_runsCSVPath);
+    if (!_runsCSV.is_open())
     {
-        delete train;
+        throw std::runtime_error("Cannot open CSV output: " + _runsCSVPath);
     }
-    trains.clear();
 
-    delete graph;
+    // Every run registers the same trains, so the columns are known up front.
+    std::set<std::string> names;
+    for (const PreparedScenario::TrainPlan& plan : _scenario->getTrains())
+    {
+        names.insert(plan.config.name);
+    }
+    _csvTrainNames.assign(names.begin(), names.end());
+
+    _runsCSV << "seed,totalDuration,totalEvents,collisionAvoidances";
+    for (const std::string& name : _csvTrainNames)
+    {
+        _runsCSV << "," << name << "_actualTime"
+                 << "," << name << "_estimatedTime"
+                 << "," << name << "_stateTransitions"
+                 << "," << name << "_eventsAffecting"
+                 << "," << name << "_reached";
+    }
+    _runsCSV << "\n";
 }
 
-SimulationMetrics MonteCarloRunner::runSingleSimulation(unsigned int seed)
+void MonteCarloRunner::writeRunRow(const SimulationMetrics& m)
 {
-    DijkstraStrategy dijkstra;
-    AStarStrategy    astar;
-
-    Graph*           graph  = parseNetwork();
-    StatsCollector   stats(seed);
+    if (!_runsCSV.is_open())
+    {
+        return;
+    }
 
-    IPathfindingStrategy* strategy = selectStrategy(dijkstra, astar);
-    std::vector<Train*>   trains   = buildTrains(graph, stats, strategy);
+    _runsCSV << m.seed
+             << "," << m.totalDuration
+             << "," << m.totalEventsGenerated
+             << "," << m.collisionAvoidanceActivations;
 
-    if (trains.empty())
+    for (const std::string& name : _csvTrainNames)
     {
-        cleanup(graph, trains);
-        SimulationMetrics empty{};
-        empty.seed = seed;
-        return empty;
+        auto it = m.trainMetrics.find(name);
+        if (it != m.trainMetrics.end())
+        {
+            const TrainMetrics& tm = it->second;
+            _runsCSV << "," << tm.actualTravelTime
+                     << "," << tm.estimatedTravelTime
+                     << "," << tm.stateTransitions
+                     << "," << tm.eventsAffectingTrain
+                     << "," << (tm.reachedDestination ? 1 : 0);
+        }
+        else
+        {
+            _runsCSV << ",,,,,";
+        }
     }
+    _runsCSV << "\n";
+}
 
-    setupSimulation(graph, trains, stats, seed);
-
-    std::map<Train*, double> departureTime;
-    std::map<Train*, double> arrivalTime;
+// ---------------------------------------------------------------------------
+// Private helpers
+// ---------------------------------------------------------------------------
 
-    runSimulationLoop(trains, stats, departureTime, arrivalTime);
+void MonteCarloRunner::log(const std::string& message) const
+{
+    if (_logger)
+    {
+        std::lock_guard<std::mutex> lock(_logMutex);
+        _logger->writeProgress(message);
+    }
+}
 
-    SimulationMetrics metrics =
-        finalizeMetrics(stats, trains, departureTime, arrivalTime);
+SimulationMetrics MonteCarloRunner::runSingleSimulation(SimulationManager& sim,
+                                                        ScenarioTrainPool& pool,
+                                                        unsigned int       index)
+{
+    SimulationConfig config;
+    config.seed       = seedForRun(index);
+    config.rngStreams = (_sampling != SamplingMode::Independent);
+    config.antithetic = isAntitheticRun(index);
 
-    cleanup(graph, trains);
-    return metrics;
-}
\ No newline at end of file
+    return ScenarioRun::execute(sim, *_scenario, pool.acquire(), config);
+}
@@ -0,0 +1,112 @@
+#include "analysis/PreparedScenario.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "io/TrainConfigParser.hpp"
+#include "io/ILogger.hpp"
+#include "patterns/creational/factories/TrainValidator.hpp"
+#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
+#include "patterns/behavioral/strategies/AStarStrategy.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "simulation/core/SimConstants.hpp"
+#include "simulation/systems/RailFootprintIndex.hpp"
+
+PreparedScenario::PreparedScenario(const std::string& networkFile,
+                                   const std::string& trainFile,
+                                   const std::string& pathfindingAlgo,
+                                   ILogger*           logger)
+{
+    RailNetworkParser networkParser(networkFile);
+    _network.reset(networkParser.parse());
+
+    TrainConfigParser        trainParser(trainFile);
+    std::vector<TrainConfig> configs = trainParser.parse();
+
+    if (logger && networkParser.wasStale())
+    {
+        logger->writeError(networkParser.getStaleWarning());
+    }
+    if (logger && trainParser.wasStale())
+    {
+        logger->writeError(trainParser.getStaleWarning());
+    }
+
+    routeTrains(configs, pathfindingAlgo, logger);
+
+    _footprints.reset(new RailFootprintIndex(_network.get()));
+}
+
+PreparedScenario::~PreparedScenario() = default;
+
+Graph* PreparedScenario::getNetwork() const
+{
+    return _network.get();
+}
+
+const std::vector<PreparedScenario::TrainPlan>& PreparedScenario::getTrains() const
+{
+    return _trains;
+}
+
+RailFootprintIndex* PreparedScenario::getFootprints() const
+{
+    return _footprints.get();
+}
+
+double PreparedScenario::estimateJourneySeconds(const Train::Path& path)
+{
+    double seconds = 0.0;
+    for (const PathSegment& seg : path)
+    {
+        if (seg.rail && seg.rail->getSpeedLimit() > 0.0)
+        {
+            seconds += (seg.rail->getLength() / seg.rail->getSpeedLimit())
+                       * SimConfig::SECONDS_PER_HOUR;
+        }
+    }
+    return seconds;
+}
+
+void PreparedScenario::routeTrains(const std::vector<TrainConfig>& configs,
+                                   const std::string&              pathfindingAlgo,
+                                   ILogger*                        logger)
+{
+    DijkstraStrategy      dijkstra;
+    AStarStrategy         astar;
+    IPathfindingStrategy* strategy = (pathfindingAlgo == "astar")
+                                         ? static_cast<IPathfindingStrategy*>(&astar)
+                                         : static_cast<IPathfindingStrategy*>(&dijkstra);
+    Graph* graph = _network.get();
+
+    for (const TrainConfig& config : configs)
+    {
+        // Validate config against the network (mirrors Application::_buildTrains).
+        ValidationResult vr = TrainValidator::validate(config, graph);
+        if (!vr.valid)
+        {
+            if (logger)
+            {
+                logger->writeProgress("Skipping train '" + config.name + "': " + vr.error);
+            }
+            continue;
+        }
+
+        Node*       startNode = graph->getNode(config.departureStation);
+        Node*       endNode   = graph->getNode(config.arrivalStation);
+        Train::Path path      = strategy->findPath(graph, startNode, endNode);
+
+        if (path.empty())
+        {
+            if (logger)
+            {
+                logger->writeProgress("No path for train '" + config.name + "' ("
+                                      + config.departureStation + " -> "
+                                      + config.arrivalStation + ")");
+            }
+            continue;
+        }
+
+        double estimatedSeconds = estimateJourneySeconds(path);
+        _trains.push_back(TrainPlan{config, std::move(path), estimatedSeconds});
+    }
+}
@@ -0,0 +1,185 @@
+#include "analysis/QuantileSketch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+QuantileSketch::QuantileSketch(std::size_t k)
+    : _k(std::max<std::size_t>(k, 8)), _count(0), _min(0.0), _max(0.0),
+      _levels(1), _offsets(1, 0)
+{
+}
+
+void QuantileSketch::add(double value)
+{
+    if (_count == 0)
+    {
+        _min = value;
+        _max = value;
+    }
+    else
+    {
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    ++_count;
+    _levels[0].push_back(value);
+    compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    if (other._count == 0)
+    {
+        return;
+    }
+
+    if (_count == 0)
+    {
+        _min = other._min;
+        _max = other._max;
+    }
+    else
+    {
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    if (_levels.size() < other._levels.size())
+    {
+        _levels.resize(other._levels.size());
+        _offsets.resize(other._levels.size(), 0);
+    }
+
+    for (std::size_t h = 0; h < other._levels.size(); ++h)
+    {
+        _levels[h].insert(_levels[h].end(), other._levels[h].begin(), other._levels[h].end());
+    }
+
+    _count += other._count;
+    compress();
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (_count == 0)
+    {
+        return 0.0;
+    }
+    if (q <= 0.0)
+    {
+        return _min;
+    }
+    if (q >= 1.0)
+    {
+        return _max;
+    }
+
+    std::vector<std::pair<double, std::uint64_t>> weighted;
+    weighted.reserve(retained());
+
+    for (std::size_t h = 0; h < _levels.size(); ++h)
+    {
+        std::uint64_t weight = std::uint64_t(1) << h;
+        for (double value : _levels[h])
+        {
+            weighted.emplace_back(value, weight);
+        }
+    }
+
+    std::sort(weighted.begin(), weighted.end());
+
+    double        target     = q * static_cast<double>(_count);
+    std::uint64_t cumulative = 0;
+
+    for (const auto& item : weighted)
+    {
+        cumulative += item.second;
+        if (static_cast<double>(cumulative) >= target)
+        {
+            return item.first;
+        }
+    }
+
+    return _max;
+}
+
+std::uint64_t QuantileSketch::count() const
+{
+    return _count;
+}
+
+std::size_t QuantileSketch::retained() const
+{
+    std::size_t total = 0;
+    for (const std::vector<double>& level : _levels)
+    {
+        total += level.size();
+    }
+    return total;
+}
+
+std::size_t QuantileSketch::capacity(std::size_t level) const
+{
+    // Top level gets k; each level below shrinks by 2/3.
+    std::size_t depth = _levels.size() - 1 - level;
+    double      cap   = static_cast<double>(_k) * std::pow(2.0 / 3.0, static_cast<double>(depth));
+    return std::max<std::size_t>(2, static_cast<std::size_t>(std::ceil(cap)));
+}
+
+std::size_t QuantileSketch::totalCapacity() const
+{
+    std::size_t total = 0;
+    for (std::size_t h = 0; h < _levels.size(); ++h)
+    {
+        total += capacity(h);
+    }
+    return total;
+}
+
+void QuantileSketch::compress()
+{
+    // Lazy KLL: only when the sketch as a whole is over budget, compact the
+    // lowest level that is over its own capacity, one level at a time.
+    while (retained() > totalCapacity())
+    {
+        std::size_t h = 0;
+        while (_levels[h].size() <= capacity(h))
+        {
+            ++h;
+        }
+
+        if (h + 1 == _levels.size())
+        {
+            _levels.emplace_back();
+            _offsets.push_back(0);
+        }
+
+        std::vector<double>& level = _levels[h];
+        std::sort(level.begin(), level.end());
+
+        // An odd item out stays behind at this level.
+        double leftover    = 0.0;
+        bool   hasLeftover = (level.size() % 2) != 0;
+        if (hasLeftover)
+        {
+            leftover = level.front();
+            level.erase(level.begin());
+        }
+
+        std::size_t offset = _offsets[h];
+        _offsets[h]        = static_cast<unsigned char>(1 - offset);
+
+        std::vector<double>& next = _levels[h + 1];
+        for (std::size_t i = offset; i < level.size(); i += 2)
+        {
+            next.push_back(level[i]);
+        }
+
+        level.clear();
+        if (hasLeftover)
+        {
+            level.push_back(leftover);
+        }
+    }
+}
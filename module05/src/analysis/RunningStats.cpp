@@ -0,0 +1,95 @@
+#include "analysis/RunningStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+RunningStats::RunningStats()
+    : _count(0), _mean(0.0), _m2(0.0), _min(0.0), _max(0.0)
+{
+}
+
+void RunningStats::add(double value)
+{
+    if (_count == 0)
+    {
+        _min = value;
+        _max = value;
+    }
+    else
+    {
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    ++_count;
+    double delta = value - _mean;
+    _mean += delta / static_cast<double>(_count);
+    _m2   += delta * (value - _mean);
+}
+
+void RunningStats::merge(const RunningStats& other)
+{
+    if (other._count == 0)
+    {
+        return;
+    }
+
+    if (_count == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    double n1    = static_cast<double>(_count);
+    double n2    = static_cast<double>(other._count);
+    double n     = n1 + n2;
+    double delta = other._mean - _mean;
+
+    _mean  += delta * n2 / n;
+    _m2    += other._m2 + delta * delta * n1 * n2 / n;
+    _count += other._count;
+    _min    = std::min(_min, other._min);
+    _max    = std::max(_max, other._max);
+}
+
+std::uint64_t RunningStats::count() const
+{
+    return _count;
+}
+
+double RunningStats::mean() const
+{
+    return _mean;
+}
+
+double RunningStats::variance() const
+{
+    if (_count < 2)
+    {
+        return 0.0;
+    }
+    return _m2 / static_cast<double>(_count - 1);
+}
+
+double RunningStats::stddev() const
+{
+    return std::sqrt(variance());
+}
+
+double RunningStats::min() const
+{
+    return _min;
+}
+
+double RunningStats::max() const
+{
+    return _max;
+}
+
+double RunningStats::standardError() const
+{
+    if (_count == 0)
+    {
+        return 0.0;
+    }
+    return stddev() / std::sqrt(static_cast<double>(_count));
+}
@@ -0,0 +1,184 @@
+#include "analysis/ScenarioRun.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include "core/Train.hpp"
+#include "patterns/behavioral/states/ITrainState.hpp"
+
+#include <string>
+
+SimulationMetrics ScenarioRun::execute(SimulationManager&         sim,
+                                       const PreparedScenario&    scenario,
+                                       const std::vector<Train*>& trains,
+                                       SimulationConfig           config)
+{
+    if (trains.empty())
+    {
+        SimulationMetrics empty{};
+        empty.seed = config.seed;
+        return empty;
+    }
+
+    StatsCollector stats(config.seed);
+    const std::vector<PreparedScenario::TrainPlan>& plans = scenario.getTrains();
+    for (std::size_t i = 0; i < trains.size(); ++i)
+    {
+        stats.registerTrain(trains[i], plans[i].estimatedSeconds);
+    }
+
+    sim.reset();
+
+    config.network    = scenario.getNetwork();
+    config.footprints = scenario.getFootprints();  // Warm from earlier runs
+    config.roundTrip  = false;
+    config.writer     = nullptr;  // Silent — no console output during batch runs.
+
+    sim.configure(config);
+    sim.setStatsCollector(&stats);
+
+    for (Train* train : trains)
+    {
+        sim.addTrain(train);
+    }
+
+    std::map<Train*, double> departureTime;
+    std::map<Train*, double> arrivalTime;
+
+    runLoop(sim, trains, stats, departureTime, arrivalTime);
+
+    SimulationMetrics metrics =
+        finalizeMetrics(sim, stats, trains, departureTime, arrivalTime);
+
+    sim.reset();
+    return metrics;
+}
+
+void ScenarioRun::runLoop(
+    SimulationManager&          sim,
+    const std::vector<Train*>&  trains,
+    StatsCollector&             stats,
+    std::map<Train*, double>&   departureTime,
+    std::map<Train*, double>&   arrivalTime)
+{
+    // Track previous states to detect transitions.
+    std::map<Train*, std::string> prevStates;
+    for (Train* train : trains)
+    {
+        if (train)
+        {
+            prevStates[train] = "Idle";
+        }
+    }
+
+    sim.start();
+
+    constexpr double maxSimTime = 1e9;  // shouldStopEarly() terminates when done.
+
+    while (sim.isRunning() && sim.getCurrentTime() < maxSimTime)
+    {
+        sim.step();
+
+        double currentTime = sim.getCurrentTime();
+
+        for (Train* train : trains)
+        {
+            if (!train)
+            {
+                continue;
+            }
+
+            if (!train->getCurrentState())
+            {
+                continue;
+            }
+
+            std::string currentStateName = train->getCurrentState()->getName();
+            std::string& prevStateName   = prevStates[train];
+
+            if (currentStateName != prevStateName)
+            {
+                // Detect departure (Idle → anything else)
+                if (prevStateName == "Idle" && currentStateName != "Idle")
+                {
+                    departureTime[train] = currentTime;
+                }
+
+                // Detect arrival (transition to finished state at destination)
+                if (train->isFinished() && arrivalTime.find(train) == arrivalTime.end())
+                {
+                    arrivalTime[train] = currentTime;
+                    stats.checkTrainDestination(train);
+                }
+
+                // Collision avoidance proxy: Idle → Waiting mid-journey
+                if (currentStateName == "Waiting" && prevStateName != "Idle")
+                {
+                    stats.recordCollisionAvoidance();
+                }
+
+                stats.recordStateTransition(train, prevStateName, currentStateName);
+                prevStateName = currentStateName;
+            }
+
+            // Check arrival for already-finished trains that may not change state
+            if (train->isFinished() && arrivalTime.find(train) == arrivalTime.end())
+            {
+                arrivalTime[train] = currentTime;
+                stats.checkTrainDestination(train);
+            }
+        }
+
+        // shouldStopEarly is called inside sim.run(), but since we drive via
+        // step() here we replicate the stop condition manually.
+        bool allDone = true;
+        for (Train* train : trains)
+        {
+            if (train && !train->isFinished())
+            {
+                allDone = false;
+                break;
+            }
+        }
+
+        if (allDone)
+        {
+            break;
+        }
+    }
+}
+
+SimulationMetrics ScenarioRun::finalizeMetrics(
+    SimulationManager&                 sim,
+    StatsCollector&                    stats,
+    const std::vector<Train*>&         trains,
+    const std::map<Train*, double>&    departureTime,
+    const std::map<Train*, double>&    arrivalTime)
+{
+    double totalDuration = sim.getCurrentTime();
+    stats.finalize(totalDuration);
+
+    // Patch actual travel times from our timing maps.
+    for (Train* train : trains)
+    {
+        if (!train)
+        {
+            continue;
+        }
+
+        auto deptIt = departureTime.find(train);
+        auto arrIt  = arrivalTime.find(train);
+
+        if (deptIt != departureTime.end() && arrIt != arrivalTime.end())
+        {
+            double actual = arrIt->second - deptIt->second;
+
+            SimulationMetrics& m = const_cast<SimulationMetrics&>(stats.getMetrics());
+            auto tmIt = m.trainMetrics.find(train->getName());
+            if (tmIt != m.trainMetrics.end())
+            {
+                tmIt->second.actualTravelTime = actual;
+            }
+        }
+    }
+
+    return stats.getMetrics();
+}
@@ -0,0 +1,46 @@
+#include "analysis/ScenarioTrainPool.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "core/Train.hpp"
+
+#include <stdexcept>
+
+ScenarioTrainPool::ScenarioTrainPool(const PreparedScenario& scenario)
+    : _scenario(scenario)
+{
+    const std::vector<PreparedScenario::TrainPlan>& plans = _scenario.getTrains();
+
+    _storage.reserve(plans.size());
+    _trains.reserve(plans.size());
+
+    for (const PreparedScenario::TrainPlan& plan : plans)
+    {
+        std::unique_ptr<Train> train(TrainFactory::create(plan.config, _scenario.getNetwork()));
+        if (!train)
+        {
+            throw std::runtime_error("Cannot create pooled train: " + plan.config.name);
+        }
+
+        _trains.push_back(train.get());
+        _storage.push_back(std::move(train));
+    }
+}
+
+ScenarioTrainPool::~ScenarioTrainPool() = default;
+
+const std::vector<Train*>& ScenarioTrainPool::acquire(const TrainPhysicsScale& physics)
+{
+    const std::vector<PreparedScenario::TrainPlan>& plans = _scenario.getTrains();
+
+    for (std::size_t i = 0; i < _trains.size(); ++i)
+    {
+        const TrainConfig& config = plans[i].config;
+
+        _trains[i]->resetJourney(plans[i].path, config.departureTime);
+        _trains[i]->setPhysics(config.mass          * physics.mass,
+                               config.frictionCoef  * physics.friction,
+                               config.maxAccelForce * physics.maxAccelForce,
+                               config.maxBrakeForce * physics.maxBrakeForce);
+    }
+
+    return _trains;
+}
@@ -0,0 +1,286 @@
+#include "analysis/SweepRunner.hpp"
+#include "analysis/ScenarioRun.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "io/ILogger.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+SweepRunner::SweepRunner(const std::string& networkFile,
+                         const std::string& trainFile,
+                         const SweepSpec&   spec,
+                         unsigned int       baseSeed,
+                         const std::string& pathfindingAlgo,
+                         ILogger*           logger)
+    : _spec(spec),
+      _baseSeed(baseSeed),
+      _logger(logger),
+      _threads(1),
+      _scenario(new PreparedScenario(networkFile, trainFile, pathfindingAlgo, logger)),
+      _points(spec.expand(baseSeed)),
+      _nextCommit(0)
+{
+}
+
+SweepRunner::~SweepRunner() = default;
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void SweepRunner::setThreads(unsigned int threads)
+{
+    _threads = std::max(threads, 1u);
+}
+
+unsigned int SweepRunner::getThreads() const
+{
+    return _threads;
+}
+
+void SweepRunner::setResultsCSV(const std::string& filename)
+{
+    _resultsCSVPath = filename;
+}
+
+const std::vector<SweepPoint>& SweepRunner::getPoints() const
+{
+    return _points;
+}
+
+const MonteCarloAggregator& SweepRunner::getPointAggregate(std::size_t point) const
+{
+    return _aggregates.at(point);
+}
+
+void SweepRunner::runAll()
+{
+    _aggregates.assign(_points.size(), MonteCarloAggregator());
+    _pending.clear();
+    _nextCommit = 0;
+    openResultsCSV();
+
+    std::atomic<bool> failed(false);
+    std::size_t       workerCount = std::min<std::size_t>(_threads, std::max<std::size_t>(jobCount(), 1));
+    dealJobs(workerCount);
+
+    log("Sweep: " + std::to_string(_points.size()) + " points x "
+        + std::to_string(_spec.getRunsPerPoint()) + " runs on "
+        + std::to_string(workerCount) + " thread(s)");
+
+    std::vector<std::thread>        workers;
+    std::vector<std::exception_ptr> errors(workerCount);
+    workers.reserve(workerCount);
+
+    for (std::size_t w = 0; w < workerCount; ++w)
+    {
+        workers.emplace_back([this, &failed, &errors, w]()
+        {
+            try
+            {
+                runWorker(w, failed);
+            }
+            catch (...)
+            {
+                errors[w] = std::current_exception();
+                failed.store(true);  // Stop handing out further jobs.
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    _resultsCSV.close();
+    _queues.clear();
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (std::size_t p = 0; p < _points.size(); ++p)
+    {
+        double delay = 0.0;
+        for (const auto& kv : _aggregates[p].getTrains())
+        {
+            delay += kv.second.delay.moments.mean();
+        }
+
+        log("Point " + std::to_string(p) + ": mean total delay "
+            + std::to_string(delay) + " s over "
+            + std::to_string(_aggregates[p].getRunCount()) + " runs");
+    }
+
+    if (!_resultsCSVPath.empty())
+    {
+        log("CSV written: " + _resultsCSVPath);
+    }
+    log("Sweep complete: " + std::to_string(_nextCommit) + " runs finished.");
+}
+
+// ---------------------------------------------------------------------------
+// Private helpers
+// ---------------------------------------------------------------------------
+
+std::size_t SweepRunner::jobCount() const
+{
+    return _points.size() * _spec.getRunsPerPoint();
+}
+
+void SweepRunner::dealJobs(std::size_t workerCount)
+{
+    _queues.clear();
+    for (std::size_t w = 0; w < workerCount; ++w)
+    {
+        _queues.emplace_back(new WorkerQueue());
+    }
+
+    // Round-robin keeps every worker's front near the commit frontier.
+    for (std::size_t job = 0; job < jobCount(); ++job)
+    {
+        _queues[job % workerCount]->jobs.push_back(job);
+    }
+}
+
+bool SweepRunner::takeJob(std::size_t worker, std::size_t& job)
+{
+    {
+        WorkerQueue&                own = *_queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+
+    // Own deque drained: steal the latest job of the next non-empty worker.
+    for (std::size_t i = 1; i < _queues.size(); ++i)
+    {
+        WorkerQueue&                victim = *_queues[(worker + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void SweepRunner::runWorker(std::size_t worker, std::atomic<bool>& failed)
+{
+    SimulationManager sim;
+    ScenarioTrainPool pool(*_scenario);
+    std::size_t       job = 0;
+
+    while (!failed.load() && takeJob(worker, job))
+    {
+        commitJob(job, runJob(sim, pool, job));
+    }
+}
+
+SimulationMetrics SweepRunner::runJob(SimulationManager& sim, ScenarioTrainPool& pool, std::size_t job)
+{
+    const SweepPoint& point = _points[job / _spec.getRunsPerPoint()];
+
+    SimulationConfig config;
+    config.seed       = _baseSeed + static_cast<unsigned int>(job % _spec.getRunsPerPoint());
+    config.rngStreams = true;
+    config.events     = point.events;
+
+    return ScenarioRun::execute(sim, *_scenario, pool.acquire(point.physics), config);
+}
+
+void SweepRunner::commitJob(std::size_t job, SimulationMetrics metrics)
+{
+    std::lock_guard<std::mutex> lock(_commitMutex);
+
+    _pending.emplace(job, std::move(metrics));
+
+    for (auto it = _pending.begin(); it != _pending.end() && it->first == _nextCommit;
+         it = _pending.erase(it))
+    {
+        std::size_t point = _nextCommit / _spec.getRunsPerPoint();
+
+        _aggregates[point].add(it->second);
+        writeResultRows(point, it->second);
+        ++_nextCommit;
+    }
+}
+
+void SweepRunner::openResultsCSV()
+{
+    _resultsCSV.close();
+    if (_resultsCSVPath.empty())
+    {
+        return;
+    }
+
+    _resultsCSV.open(_resultsCSVPath);
+    if (!_resultsCSV.is_open())
+    {
+        throw std::runtime_error("Cannot open CSV output: " + _resultsCSVPath);
+    }
+
+    _resultsCSV << "point";
+    for (const SweepParameter& parameter : _spec.getParameters())
+    {
+        _resultsCSV << "," << parameter.name;
+    }
+    _resultsCSV << ",seed,totalDuration,collisionAvoidances"
+                << ",train,actualTime,estimatedTime,delay,eventsAffecting,reached\n";
+}
+
+void SweepRunner::writeResultRows(std::size_t point, const SimulationMetrics& m)
+{
+    if (!_resultsCSV.is_open())
+    {
+        return;
+    }
+
+    for (const auto& kv : m.trainMetrics)
+    {
+        const TrainMetrics& tm = kv.second;
+
+        _resultsCSV << point;
+        for (double value : _points[point].values)
+        {
+            _resultsCSV << "," << value;
+        }
+        _resultsCSV << "," << m.seed
+                    << "," << m.totalDuration
+                    << "," << m.collisionAvoidanceActivations
+                    << "," << kv.first
+                    << "," << tm.actualTravelTime
+                    << "," << tm.estimatedTravelTime
+                    << "," << (tm.actualTravelTime - tm.estimatedTravelTime)
+                    << "," << tm.eventsAffectingTrain
+                    << "," << (tm.reachedDestination ? 1 : 0)
+                    << "\n";
+    }
+}
+
+void SweepRunner::log(const std::string& message) const
+{
+    if (_logger)
+    {
+        std::lock_guard<std::mutex> lock(_logMutex);
+        _logger->writeProgress(message);
+    }
+}
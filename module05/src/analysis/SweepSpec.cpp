@@ -0,0 +1,302 @@
+#include "analysis/SweepSpec.hpp"
+#include "utils/CounterRng.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    struct EventField
+    {
+        const char*  prefix;
+        EventConfig EventParameters::* config;
+    };
+
+    const EventField EVENT_FIELDS[] = {
+        {"stationDelay.",     &EventParameters::stationDelay},
+        {"trackMaintenance.", &EventParameters::trackMaintenance},
+        {"signalFailure.",    &EventParameters::signalFailure},
+        {"weather.",          &EventParameters::weather},
+    };
+
+    struct PhysicsField
+    {
+        const char*  name;
+        double TrainPhysicsScale::* scale;
+    };
+
+    const PhysicsField PHYSICS_FIELDS[] = {
+        {"train.massScale",     &TrainPhysicsScale::mass},
+        {"train.frictionScale", &TrainPhysicsScale::friction},
+        {"train.accelScale",    &TrainPhysicsScale::maxAccelForce},
+        {"train.brakeScale",    &TrainPhysicsScale::maxBrakeForce},
+    };
+
+    // Splits "stationDelay.minMinutes" into its event and field; false when
+    // name is not an event parameter.
+    bool findEventField(const std::string& name, const EventField*& event, std::string& field)
+    {
+        for (const EventField& candidate : EVENT_FIELDS)
+        {
+            std::string prefix(candidate.prefix);
+            if (name.compare(0, prefix.size(), prefix) == 0)
+            {
+                field = name.substr(prefix.size());
+                if (field == "probability" || field == "minMinutes" || field == "maxMinutes")
+                {
+                    event = &candidate;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    const PhysicsField* findPhysicsField(const std::string& name)
+    {
+        for (const PhysicsField& candidate : PHYSICS_FIELDS)
+        {
+            if (name == candidate.name)
+            {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+}
+
+SweepSpec::SweepSpec()
+    : _design(Design::Grid), _samples(0), _runsPerPoint(1)
+{
+}
+
+void SweepSpec::setDesign(Design design)
+{
+    _design = design;
+}
+
+SweepSpec::Design SweepSpec::getDesign() const
+{
+    return _design;
+}
+
+void SweepSpec::setSamples(unsigned int samples)
+{
+    _samples = samples;
+}
+
+unsigned int SweepSpec::getSamples() const
+{
+    return _samples;
+}
+
+void SweepSpec::setRunsPerPoint(unsigned int runs)
+{
+    _runsPerPoint = std::max(runs, 1u);
+}
+
+unsigned int SweepSpec::getRunsPerPoint() const
+{
+    return _runsPerPoint;
+}
+
+void SweepSpec::addParameter(const SweepParameter& parameter)
+{
+    const EventField* event = nullptr;
+    std::string       field;
+
+    if (!findEventField(parameter.name, event, field) && !findPhysicsField(parameter.name))
+    {
+        throw std::invalid_argument("Unknown sweep parameter: '" + parameter.name + "'");
+    }
+
+    for (const SweepParameter& existing : _parameters)
+    {
+        if (existing.name == parameter.name)
+        {
+            throw std::invalid_argument("Duplicate sweep parameter: '" + parameter.name + "'");
+        }
+    }
+
+    if (parameter.min > parameter.max)
+    {
+        throw std::invalid_argument("Sweep parameter '" + parameter.name + "' has min > max");
+    }
+
+    if (parameter.levels == 0)
+    {
+        throw std::invalid_argument("Sweep parameter '" + parameter.name + "' needs at least one level");
+    }
+
+    if (event && field == "probability" && (parameter.min < 0.0 || parameter.max > 1.0))
+    {
+        throw std::invalid_argument("Sweep parameter '" + parameter.name + "' must lie in [0, 1]");
+    }
+
+    if (event && field != "probability" && parameter.min < 0.0)
+    {
+        throw std::invalid_argument("Sweep parameter '" + parameter.name + "' must not be negative");
+    }
+
+    if (!event && parameter.min <= 0.0)
+    {
+        throw std::invalid_argument("Sweep parameter '" + parameter.name + "' must be positive");
+    }
+
+    _parameters.push_back(parameter);
+}
+
+const std::vector<SweepParameter>& SweepSpec::getParameters() const
+{
+    return _parameters;
+}
+
+bool SweepSpec::isKnownParameter(const std::string& name)
+{
+    const EventField* event = nullptr;
+    std::string       field;
+    return findEventField(name, event, field) || findPhysicsField(name);
+}
+
+void SweepSpec::apply(const std::string& name, double value, SweepPoint& point)
+{
+    const EventField* event = nullptr;
+    std::string       field;
+
+    if (findEventField(name, event, field))
+    {
+        EventConfig& config = point.events.*(event->config);
+        if (field == "probability")
+        {
+            config.probabilityPerTimestep = value;
+        }
+        else if (field == "minMinutes")
+        {
+            config.minDurationMinutes = static_cast<int>(std::lround(value));
+        }
+        else
+        {
+            config.maxDurationMinutes = static_cast<int>(std::lround(value));
+        }
+        return;
+    }
+
+    const PhysicsField* physics = findPhysicsField(name);
+    if (!physics)
+    {
+        throw std::invalid_argument("Unknown sweep parameter: '" + name + "'");
+    }
+    point.physics.*(physics->scale) = value;
+}
+
+std::vector<SweepPoint> SweepSpec::expand(unsigned int seed) const
+{
+    if (_parameters.empty())
+    {
+        throw std::invalid_argument("Sweep has no parameters");
+    }
+
+    if (_design == Design::LatinHypercube)
+    {
+        if (_samples == 0)
+        {
+            throw std::invalid_argument("Latin hypercube sweep needs samples > 0");
+        }
+        return expandLatinHypercube(seed);
+    }
+
+    return expandGrid();
+}
+
+std::vector<SweepPoint> SweepSpec::expandGrid() const
+{
+    std::vector<SweepPoint>   points;
+    std::vector<unsigned int> level(_parameters.size(), 0);
+    std::vector<double>       values(_parameters.size());
+
+    while (true)
+    {
+        for (std::size_t p = 0; p < _parameters.size(); ++p)
+        {
+            const SweepParameter& param = _parameters[p];
+            values[p] = (param.levels > 1)
+                ? param.min + (param.max - param.min) * level[p] / (param.levels - 1)
+                : param.min;
+        }
+        points.push_back(makePoint(values));
+
+        // Odometer increment, last parameter fastest.
+        std::size_t p = _parameters.size();
+        while (p > 0 && ++level[p - 1] == _parameters[p - 1].levels)
+        {
+            level[p - 1] = 0;
+            --p;
+        }
+
+        if (p == 0)
+        {
+            break;
+        }
+    }
+
+    return points;
+}
+
+std::vector<SweepPoint> SweepSpec::expandLatinHypercube(unsigned int seed) const
+{
+    std::vector<std::vector<double>> values(_samples, std::vector<double>(_parameters.size()));
+
+    for (std::size_t p = 0; p < _parameters.size(); ++p)
+    {
+        const SweepParameter& param = _parameters[p];
+        CounterRng            rng(seed, 0, p);
+
+        std::vector<unsigned int> strata(_samples);
+        for (unsigned int i = 0; i < _samples; ++i)
+        {
+            strata[i] = i;
+        }
+
+        // Fisher-Yates shuffle: each point gets a distinct stratum.
+        for (unsigned int i = _samples; i > 1; --i)
+        {
+            std::swap(strata[i - 1], strata[rng.nextInt(0, static_cast<int>(i) - 1)]);
+        }
+
+        for (unsigned int i = 0; i < _samples; ++i)
+        {
+            double u = (strata[i] + rng.nextUniform()) / _samples;
+            values[i][p] = param.min + (param.max - param.min) * u;
+        }
+    }
+
+    std::vector<SweepPoint> points;
+    points.reserve(_samples);
+    for (const std::vector<double>& row : values)
+    {
+        points.push_back(makePoint(row));
+    }
+    return points;
+}
+
+SweepPoint SweepSpec::makePoint(const std::vector<double>& values) const
+{
+    SweepPoint point;
+    point.values = values;
+
+    for (std::size_t p = 0; p < _parameters.size(); ++p)
+    {
+        apply(_parameters[p].name, values[p], point);
+    }
+
+    // A sampled minimum above the (possibly default) maximum collapses the range.
+    for (const EventField& event : EVENT_FIELDS)
+    {
+        EventConfig& config = point.events.*(event.config);
+        config.maxDurationMinutes = std::max(config.maxDurationMinutes, config.minDurationMinutes);
+    }
+
+    return point;
+}
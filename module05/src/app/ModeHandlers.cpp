@@ -2,15 +2,26 @@
 #include "app/HotReloadSupport.hpp"
 #include "app/RunSession.hpp"
 #include "analysis/MonteCarloRunner.hpp"
+#include "analysis/SweepRunner.hpp"
 #include "core/Train.hpp"
 #include "io/CLI.hpp"
+#include "io/CompiledScenario.hpp"
 #include "io/IOutputWriter.hpp"
+#include "io/LiveTrainFeed.hpp"
+#include "io/MappedFile.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "io/SweepSpecParser.hpp"
+#include "io/TrainConfigParser.hpp"
 #include "patterns/behavioral/command/CommandManager.hpp"
 #include "rendering/core/IRenderer.hpp"
 #include "rendering/factory/IRendererFactory.hpp"
 #include "utils/FileSystemUtils.hpp"
 #include "utils/FileWatcher.hpp"
+#include "utils/Time.hpp"
+#include <chrono>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 
 namespace
 {
@@ -35,7 +46,11 @@ int runPreparedSimulation(const std::string& netFile,
 
     int status = runLoop(bundle, cmdMgr.get());
 
-    if (listOutputs)
+    if (listOutputs && session.cli().hasTrace())
+    {
+        session.output().writeOutputFileListing(session.cli().getTraceFile());
+    }
+    else if (listOutputs)
     {
         for (const Train* train : bundle.trains)
         {
@@ -49,6 +64,81 @@ int runPreparedSimulation(const std::string& netFile,
 }
 } // namespace
 
+bool CompileModeHandler::matches(const CLI& cli) const
+{
+    return cli.hasCompile();
+}
+
+int CompileModeHandler::run(const std::string& netFile,
+                            const std::string& trainFile,
+                            RunSession& session)
+{
+    try
+    {
+        FileSystemUtils::ensureOutputDirectoryExists();
+
+        // Sources must be text: a snapshot fingerprints the files it came from.
+        for (const std::string& input : {netFile, trainFile})
+        {
+            if (CompiledScenario::isCompiled(MappedFile(input).view()))
+            {
+                throw std::runtime_error("Already compiled: " + input);
+            }
+        }
+
+        RailNetworkParser        networkParser(netFile);
+        TrainConfigParser        trainParser(trainFile);
+        std::unique_ptr<Graph>   network(networkParser.parse());
+        std::vector<TrainConfig> trains = trainParser.parse();
+
+        const std::string target = session.cli().getCompileFile();
+        CompiledScenario::write(target, *network, trains, netFile, trainFile);
+
+        session.output().writeProgress("Compiled " + std::to_string(network->getNodeCount()) + " nodes, " +
+                                       std::to_string(network->getRailCount()) + " rails, " +
+                                       std::to_string(trains.size()) + " trains -> " + target);
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        session.output().writeError(e.what());
+        return 1;
+    }
+}
+
+bool SweepModeHandler::matches(const CLI& cli) const
+{
+    return cli.hasSweep();
+}
+
+int SweepModeHandler::run(const std::string& netFile,
+                          const std::string& trainFile,
+                          RunSession& session)
+{
+    try
+    {
+        FileSystemUtils::ensureOutputDirectoryExists();
+
+        SweepSpecParser parser(session.cli().getSweepFile());
+        SweepRunner     runner(netFile,
+                               trainFile,
+                               parser.parse(),
+                               session.cli().getSeed(),
+                               session.cli().getPathfinding(),
+                               &session.output());
+
+        runner.setThreads(session.cli().getThreads());
+        runner.setResultsCSV("output/sweep_results.csv");
+        runner.runAll();
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        session.output().writeError(e.what());
+        return 1;
+    }
+}
+
 bool MonteCarloModeHandler::matches(const CLI& cli) const
 {
     return cli.hasMonteCarloRuns();
@@ -69,8 +159,30 @@ int MonteCarloModeHandler::run(const std::string& netFile,
                                 session.cli().getPathfinding(),
                                 &session.output());
 
+        runner.setThreads(session.cli().getThreads());
+        const std::string sampling = session.cli().getSampling();
+        if (sampling == "crn")
+        {
+            runner.setSampling(SamplingMode::CommonRandomNumbers);
+        }
+        else if (sampling == "antithetic")
+        {
+            runner.setSampling(SamplingMode::Antithetic);
+        }
+        if (session.cli().hasRunCSV())
+        {
+            runner.setRunsCSV("output/monte_carlo_results.csv");
+        }
+        if (session.cli().hasConvergence())
+        {
+            ConvergenceCriteria criteria;
+            criteria.relativeTolerance = session.cli().getConvergenceTolerance();
+            criteria.metrics           = session.cli().getConvergenceMetrics();
+            criteria.timeBudgetSeconds = session.cli().getTimeBudget();
+            runner.setConvergence(criteria);
+        }
         runner.runAll();
-        runner.writeCSV("output/monte_carlo_results.csv");
+        runner.writeSummaryCSV("output/monte_carlo_summary.csv");
         return 0;
     }
     catch (const std::exception& e)
@@ -112,6 +224,23 @@ int ReplayModeHandler::run(const std::string& /*netFile*/,
 
     const double maxTime = (meta.stopTime > 0.0) ? meta.stopTime : 1e9;
 
+    if (session.cli().hasReplayFrom())
+    {
+        const Time target = Time(session.cli().getReplayFrom());
+
+        session.simulation().start();
+
+        const auto   began    = std::chrono::steady_clock::now();
+        const double keyframe = session.simulation().seekReplay(target.toSeconds());
+        const auto   elapsed  = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - began).count();
+
+        session.output().writeProgress("Replay seek to " + target.toString() +
+                                       " from keyframe " + Time::fromSeconds(keyframe).toString() +
+                                       " in " + std::to_string(elapsed) + " ms (" +
+                                       std::to_string(cmdMgr.keyframeCount()) + " keyframes)");
+    }
+
     if (session.cli().hasRender())
     {
         std::unique_ptr<IRendererFactory> factory(createRendererFactory());
@@ -159,27 +288,21 @@ int HotReloadModeHandler::run(const std::string& netFile,
                 return 1;
             }
 
-            IRenderer*       rendererPtr   = renderer.get();
+            IRenderer*       rendererPtr = renderer.get();
             HotReloadSupport support(session.output());
-            const int        hotReloadSeed = static_cast<int>(session.simulation().getSeed());
 
             std::function<bool(const std::string&, const std::string&)> rebuildCallback =
                 [&](const std::string& net, const std::string& train) -> bool
                 {
-                    session.teardownSimulation(bundle);
-                    if (!session.buildSimulation(net, train, bundle, hotReloadSeed))
+                    // Running trains, clock and events carry over; only
+                    // what the edit touched is rebuilt.
+                    if (!session.reloadSimulation(net, train, bundle))
                     {
                         return false;
                     }
 
-                    if (cmdMgr)
-                    {
-                        session.simulation().setCommandManager(cmdMgr);
-                    }
-
                     rendererPtr->shutdown();
                     rendererPtr->initialize(session.simulation());
-                    session.simulation().start();
                     return true;
                 };
 
@@ -197,12 +320,12 @@ int HotReloadModeHandler::run(const std::string& netFile,
                         return;
                     }
 
-                    session.output().writeProgress("Hot-reload: files valid, restarting simulation...");
+                    session.output().writeProgress("Hot-reload: files valid, applying changes...");
 
                     const double reloadTime = session.simulation().getCurrentTime();
                     if (!rebuildCallback(netFile, trainFile))
                     {
-                        session.output().writeError("Hot-reload: failed to rebuild simulation.");
+                        session.output().writeError("Hot-reload: failed to apply changes; simulation continues unchanged.");
                         return;
                     }
 
@@ -214,7 +337,7 @@ int HotReloadModeHandler::run(const std::string& netFile,
                                                 trainFile,
                                                 rebuildCallback);
 
-                    session.output().writeProgress("Hot-reload: simulation restarted successfully.");
+                    session.output().writeProgress("Hot-reload: changes applied.");
                 });
 
             watcher.start();
@@ -254,6 +377,93 @@ int RenderModeHandler::run(const std::string& netFile,
         });
 }
 
+bool LiveFeedModeHandler::matches(const CLI& cli) const
+{
+    return cli.hasLiveFeed();
+}
+
+int LiveFeedModeHandler::run(const std::string& netFile,
+                             const std::string& trainFile,
+                             RunSession& session)
+{
+    return runPreparedSimulation(
+        netFile,
+        trainFile,
+        session,
+        true,
+        [&](SimulationBundle& bundle, CommandManager* /*cmdMgr*/) -> int
+        {
+            using clock = std::chrono::steady_clock;
+
+            SimulationManager&             sim  = session.simulation();
+            std::unique_ptr<LiveTrainFeed> feed = session.createLiveFeed(session.cli().getLiveFeed(), bundle);
+
+            try
+            {
+                feed->start();
+            }
+            catch (const std::exception& e)
+            {
+                session.output().writeError(e.what());
+                return 1;
+            }
+
+            session.output().writeProgress("Live feed: reading trains from " +
+                                           (session.cli().getLiveFeed() == "-" ? std::string("stdin")
+                                                                               : session.cli().getLiveFeed()));
+
+            // Simulated time follows the wall clock so trains can be
+            // dispatched ahead of their departure.
+            sim.setSimulationSpeed(session.cli().getLiveSpeed());
+            const double            secondsPerSecond = sim.getSimulationSpeed() * 60.0;
+            const double            startTime        = sim.getCurrentTime();
+            const clock::time_point wallStart        = clock::now();
+
+            std::size_t added = 0;
+            sim.setAwaitingTrains(true);
+            sim.run(1e9, false, false, nullptr, [&]()
+            {
+                LiveTrainFeed::Arrival arrival;
+                while (feed->next(arrival))
+                {
+                    if (session.addLiveTrain(arrival.train, arrival.config, bundle))
+                    {
+                        ++added;
+                    }
+                    else
+                    {
+                        delete arrival.train;
+                    }
+                }
+                for (const std::string& message : feed->takeRejections())
+                {
+                    session.output().writeError("Live feed: " + message);
+                }
+                sim.setAwaitingTrains(!feed->isFinished());
+
+                const std::chrono::duration<double> wall = clock::now() - wallStart;
+                const double ahead = (sim.getCurrentTime() - startTime) / secondsPerSecond - wall.count();
+                if (ahead > 0.0)
+                {
+                    std::this_thread::sleep_for(std::chrono::duration<double>(ahead));
+                }
+            });
+
+            feed->stop();
+
+            const LiveTrainFeed::Stats stats = feed->getStats();
+            session.output().writeProgress(
+                "Live feed: " + std::to_string(stats.lines) + " lines, " +
+                std::to_string(added) + " trains added, " +
+                std::to_string(stats.rejected + stats.delivered - added) + " rejected, " +
+                std::to_string(stats.routeCacheHits) + " cached routes; queue peak " +
+                std::to_string(stats.peakDepth) + "/" + std::to_string(LiveTrainFeed::QUEUE_CAPACITY) +
+                ", full " + std::to_string(stats.stalls) + " times (" +
+                std::to_string(static_cast<long long>(stats.stalledMs)) + " ms)");
+            return 0;
+        });
+}
+
 bool ConsoleModeHandler::matches(const CLI& /*cli*/) const
 {
     return true;
@@ -1,7 +1,9 @@
 #include "app/RunSession.hpp"
 #include "io/CLI.hpp"
 #include "io/IOutputWriter.hpp"
+#include "io/AsyncResultSink.hpp"
 #include "io/FileOutputWriter.hpp"
+#include "io/LiveTrainFeed.hpp"
 #include "simulation/core/SimulationConfig.hpp"
 #include "patterns/behavioral/command/CommandManager.hpp"
 #include "utils/FileSystemUtils.hpp"
@@ -28,7 +30,16 @@ std::unique_ptr<CommandManager> RunSession::setupCommandManager() const
     }
 
     std::unique_ptr<CommandManager> cmdMgr(new CommandManager());
-    cmdMgr->startRecording();
+
+    if (_cli.isBinaryRecord())
+    {
+        FileSystemUtils::ensureOutputDirectoryExists();
+        cmdMgr->startRecording(_cli.getRecordFile());
+    }
+    else
+    {
+        cmdMgr->startRecording();
+    }
     return cmdMgr;
 }
 
@@ -61,9 +72,19 @@ void RunSession::saveRecording(CommandManager*    cmdMgr,
     meta.seed        = seed;
     meta.stopTime    = stopTime;
 
-    cmdMgr->saveToFile("output/replay.json", meta);
+    const std::string path = _cli.getRecordFile();
+
+    if (cmdMgr->isStreaming())
+    {
+        cmdMgr->finishRecording(meta);
+    }
+    else
+    {
+        cmdMgr->saveToFile(path, meta);
+    }
+
     _consoleWriter.writeProgress(
-        "Recording saved: output/replay.json (" +
+        "Recording saved: " + path + " (" +
         std::to_string(cmdMgr->commandCount()) + " commands)");
 }
 
@@ -142,9 +163,12 @@ bool RunSession::buildSimulation(const std::string& netFile,
     {
         outBundle = _builder.build(netFile, trainFile);
 
-        if (outBundle.trains.empty())
+        // With --live-feed the trains may all still be to come.
+        if (outBundle.trains.empty() && !_cli.hasLiveFeed())
         {
             _consoleWriter.writeError("No valid trains created.");
+            delete outBundle.sink;
+            outBundle.sink = nullptr;
             delete outBundle.graph;
             outBundle.graph = nullptr;
             return false;
@@ -158,6 +182,8 @@ bool RunSession::buildSimulation(const std::string& netFile,
         _consoleWriter.writeError(e.what());
         for (FileOutputWriter* w : outBundle.writers) { delete w; }
         outBundle.writers.clear();
+        delete outBundle.sink;
+        outBundle.sink = nullptr;
         for (Train* t : outBundle.trains)             { delete t; }
         outBundle.trains.clear();
         delete outBundle.graph;
@@ -166,6 +192,54 @@ bool RunSession::buildSimulation(const std::string& netFile,
     }
 }
 
+bool RunSession::reloadSimulation(const std::string& netFile,
+                                  const std::string& trainFile,
+                                  SimulationBundle&  bundle)
+{
+    try
+    {
+        const ReloadSummary summary = _builder.reload(netFile, trainFile, bundle, _sim);
+
+        _consoleWriter.writeProgress(
+            std::string("Reloaded: network ") + (summary.networkChanged ? "changed" : "unchanged") +
+            ", " + std::to_string(summary.kept) + " kept (" + std::to_string(summary.rerouted) +
+            " rerouted), " + std::to_string(summary.added) + " added, " +
+            std::to_string(summary.modified) + " modified, " + std::to_string(summary.removed) + " removed");
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        _consoleWriter.writeError(e.what());
+        return false;
+    }
+}
+
+std::unique_ptr<LiveTrainFeed> RunSession::createLiveFeed(const std::string& source,
+                                                          SimulationBundle&  bundle) const
+{
+    return _builder.createLiveFeed(source, bundle.graph);
+}
+
+bool RunSession::addLiveTrain(Train* train, const TrainConfig& config, SimulationBundle& bundle)
+{
+    if (_sim.findTrain(train->getName()))
+    {
+        _consoleWriter.writeError("Live feed: train " + train->getName() + " already exists");
+        return false;
+    }
+
+    FileOutputWriter* writer = _builder.createOutputWriter(train, *bundle.sink);
+    _sim.registerOutputWriter(train, writer);
+    _sim.addTrain(train);
+
+    bundle.trains.push_back(train);
+    bundle.configs.push_back(config);
+    bundle.writers.push_back(writer);
+
+    _consoleWriter.writeTrainSchedule(train->getName(), train->getDepartureTime());
+    return true;
+}
+
 void RunSession::teardownSimulation(SimulationBundle& bundle)
 {
     _sim.reset();
@@ -177,6 +251,21 @@ void RunSession::teardownSimulation(SimulationBundle& bundle)
     }
     bundle.writers.clear();
 
+    // Drain queued output while the trains and graph it refers to still exist.
+    if (bundle.sink)
+    {
+        try
+        {
+            bundle.sink->shutdown();
+        }
+        catch (const std::exception& e)
+        {
+            _consoleWriter.writeError(e.what());
+        }
+        delete bundle.sink;
+        bundle.sink = nullptr;
+    }
+
     for (Train* t : bundle.trains)
     {
         delete t;
@@ -194,6 +283,14 @@ void RunSession::finishRun(CommandManager*    cmdMgr,
 {
     flushFinalSnapshots(bundle.writers, _sim.getCurrentTime());
     saveRecording(cmdMgr, netFile, trainFile, _sim.getSeed(), _sim.getCurrentTime());
+
+    if (_cli.hasProfile())
+    {
+        MemoryReport memory = _sim.getMemoryReport();
+        memory.outputBuffers += bundle.sink ? bundle.sink->getMemoryUsage() : 0;
+        _consoleWriter.writeProgress("Memory: " + memory.toString());
+    }
+
     teardownSimulation(bundle);
     _consoleWriter.writeSimulationComplete();
 }
@@ -1,6 +1,7 @@
 #include "core/Graph.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include "utils/MemoryUsage.hpp"
 
 void Graph::addNode(Node* node)
 {
@@ -15,42 +16,26 @@ void Graph::addNode(Node* node)
 	}
 
 	_adjacency[node] = {};
+	_nodesByName[node->getName()] = node;
 	_nodes.push_back(std::unique_ptr<Node>(node));
+	_nodeList.push_back(node);
 }
 
 Node* Graph::getNode(const std::string& name)
 {
-	for (auto& node : _nodes)
-	{
-		if (node && node->getName() == name)
-		{
-			return node.get();
-		}
-	}
-	return nullptr;
+	auto it = _nodesByName.find(name);
+	return (it != _nodesByName.end()) ? it->second : nullptr;
 }
 
 const Node* Graph::getNode(const std::string& name) const
 {
-	for (const auto& node : _nodes)
-	{
-		if (node && node->getName() == name)
-		{
-			return node.get();
-		}
-	}
-	return nullptr;
+	auto it = _nodesByName.find(name);
+	return (it != _nodesByName.end()) ? it->second : nullptr;
 }
 
-Graph::NodeList Graph::getNodes() const
+const Graph::NodeList& Graph::getNodes() const
 {
-	NodeList result;
-	result.reserve(_nodes.size());
-	for (const auto& node : _nodes)
-	{
-		result.push_back(node.get());
-	}
-	return result;
+	return _nodeList;
 }
 
 bool Graph::hasNode(const std::string& name) const
@@ -65,14 +50,8 @@ size_t Graph::getNodeCount() const
 
 bool Graph::nodeExistsInGraph(Node* node) const
 {
-	for (const auto& n : _nodes)
-	{
-		if (n.get() == node)
-		{
-			return true;
-		}
-	}
-	return false;
+	// Every owned node has an adjacency entry, even without rails.
+	return _adjacency.find(node) != _adjacency.end();
 }
 
 void Graph::addRail(Rail* rail)
@@ -90,20 +69,16 @@ void Graph::addRail(Rail* rail)
 		return;
 	}
 
+	rail->setID(_rails.size());
 	_adjacency[nodeA].push_back(rail);
 	_adjacency[nodeB].push_back(rail);
 	_rails.push_back(std::unique_ptr<Rail>(rail));
+	_railList.push_back(rail);
 }
 
-Graph::RailList Graph::getRails() const
+const Graph::RailList& Graph::getRails() const
 {
-	RailList result;
-	result.reserve(_rails.size());
-	for (const auto& rail : _rails)
-	{
-		result.push_back(rail.get());
-	}
-	return result;
+	return _railList;
 }
 
 size_t Graph::getRailCount() const
@@ -111,22 +86,22 @@ size_t Graph::getRailCount() const
 	return _rails.size();
 }
 
-Graph::RailList Graph::getRailsFromNode(Node* node) const
+const Graph::RailList& Graph::getRailsFromNode(Node* node) const
 {
+	static const RailList none;
+
 	if (auto it = _adjacency.find(node); it != _adjacency.end())
 	{
 		return it->second;
 	}
 
-	return {};
+	return none;
 }
 
 std::vector<Node*> Graph::getNeighbors(Node* node) const
 {
 	std::vector<Node*> neighbors;
-	const auto rails = getRailsFromNode(node);
-
-	for (const auto* rail : rails)
+	for (const auto* rail : getRailsFromNode(node))
 	{
 		if (auto* neighbor = rail->getOtherNode(node))
 		{
@@ -137,6 +112,29 @@ std::vector<Node*> Graph::getNeighbors(Node* node) const
 	return neighbors;
 }
 
+std::size_t Graph::getMemoryUsage() const
+{
+	std::size_t bytes = sizeof(Graph)
+		+ MemoryUsage::heapBytes(_nodes) + MemoryUsage::heapBytes(_rails)
+		+ MemoryUsage::heapBytes(_nodeList) + MemoryUsage::heapBytes(_railList)
+		+ MemoryUsage::heapBytes(_adjacency) + MemoryUsage::heapBytes(_nodesByName)
+		+ _rails.size() * sizeof(Rail);
+
+	for (const auto& node : _nodes)
+	{
+		bytes += sizeof(Node) + MemoryUsage::heapBytes(node->getName());
+	}
+	for (const auto& entry : _adjacency)
+	{
+		bytes += MemoryUsage::heapBytes(entry.second);
+	}
+	for (const auto& entry : _nodesByName)
+	{
+		bytes += MemoryUsage::heapBytes(entry.first);
+	}
+	return bytes;
+}
+
 bool Graph::isValid() const
 {
 	for (const auto& node : _nodes)
@@ -168,5 +166,8 @@ void Graph::clear()
 {
 	_nodes.clear();
 	_rails.clear();
+	_nodeList.clear();
+	_railList.clear();
 	_adjacency.clear();
+	_nodesByName.clear();
 }
\ No newline at end of file
@@ -5,7 +5,8 @@ Rail::Rail()
     : _nodeA(nullptr),
       _nodeB(nullptr),
       _length(0.0),
-      _speedLimit(0.0)
+      _speedLimit(0.0),
+      _id(INVALID_ID)
 {
 }
 
@@ -13,7 +14,8 @@ Rail::Rail(Node* nodeA, Node* nodeB, double length, double speedLimit)
     : _nodeA(nodeA),
       _nodeB(nodeB),
       _length(length),
-      _speedLimit(speedLimit)
+      _speedLimit(speedLimit),
+      _id(INVALID_ID)
 {
 }
 
@@ -37,9 +39,14 @@ double Rail::getSpeedLimit() const
     return _speedLimit;
 }
 
-void Rail::setSpeedLimit(double speedLimit)
+std::size_t Rail::getID() const
 {
-    _speedLimit = speedLimit;
+    return _id;
+}
+
+void Rail::setID(std::size_t id)
+{
+    _id = id;
 }
 
 bool Rail::isValid() const
@@ -1,12 +1,14 @@
 #include "core/Train.hpp"
 #include "core/Rail.hpp"
+#include "core/Node.hpp"
 #include "utils/Time.hpp"
 #include "patterns/behavioral/states/ITrainState.hpp"
+#include "utils/MemoryUsage.hpp"
 #include <iostream>
 #include <algorithm>
 
 // Initialize static ID counter
-int Train::_nextID = 1;
+std::atomic<int> Train::_nextID(1);
 
 // Default constructor
 Train::Train()
@@ -36,8 +38,13 @@ Train::Train(const std::string& name, double mass, double frictionCoef,
 {
 }
 
+std::unique_ptr<Train> Train::clone() const
+{
+	return std::unique_ptr<Train>(new Train(*this));
+}
+
 // Identity getters
-std::string Train::getName() const
+const std::string& Train::getName() const
 {
 	return _name;
 }
@@ -68,6 +75,15 @@ double Train::getMaxBrakeForce() const
 	return _maxBrakeForce;
 }
 
+void Train::setPhysics(double mass, double frictionCoef,
+                       double maxAccelForce, double maxBrakeForce)
+{
+	_mass          = mass;
+	_frictionCoef  = frictionCoef;
+	_maxAccelForce = maxAccelForce;
+	_maxBrakeForce = maxBrakeForce;
+}
+
 // Motion state getters/setters
 double Train::getVelocity() const
 {
@@ -90,12 +106,12 @@ void Train::setPosition(double position)
 }
 
 // Journey getters
-std::string Train::getDepartureStation() const
+const std::string& Train::getDepartureStation() const
 {
 	return _departureStation;
 }
 
-std::string Train::getArrivalStation() const
+const std::string& Train::getArrivalStation() const
 {
 	return _arrivalStation;
 }
@@ -116,6 +132,12 @@ void Train::setDepartureTime(const Time& time)
 }
 
 // Path management
+std::size_t Train::getMemoryUsage() const
+{
+	return sizeof(Train) + MemoryUsage::heapBytes(_name) + MemoryUsage::heapBytes(_departureStation)
+		+ MemoryUsage::heapBytes(_arrivalStation) + MemoryUsage::heapBytes(_path);
+}
+
 const Train::Path& Train::getPath() const
 {
 	return _path;
@@ -191,6 +213,24 @@ void Train::reverseJourney()
 	// Stop duration remains unchanged
 }
 
+void Train::resetJourney(const Path& path, const Time& departureTime)
+{
+	_path             = path;
+	_currentRailIndex = 0;
+	_position         = 0.0;
+	_velocity         = 0.0;
+	_finished         = false;
+	_currentState     = nullptr;
+	_departureTime    = departureTime;
+
+	// Undo any reverseJourney() swap from a previous round-trip run.
+	if (!_path.empty() && _path.front().from && _path.back().to)
+	{
+		_departureStation = _path.front().from->getName();
+		_arrivalStation   = _path.back().to->getName();
+	}
+}
+
 // State management
 ITrainState* Train::getCurrentState() const
 {
@@ -228,7 +268,7 @@ void Train::resetIDCounter()
 
 int Train::getNextID()
 {
-	return _nextID;
+	return _nextID.load();
 }
 
 bool Train::isFinished() const
@@ -247,11 +287,11 @@ void Train::markFinished()
 
 
 // Delegate update to current state
-void Train::update(double dt)
+void Train::update(double dt, const IPhysicsQueries* physics)
 {
 	if (_currentState)
 	{
-		_currentState->update(this, dt);
+		_currentState->update(this, physics, dt);
 	}
 }
 
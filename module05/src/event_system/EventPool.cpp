@@ -0,0 +1,66 @@
+#include "event_system/EventPool.hpp"
+
+void EventPool::release(Event* event)
+{
+    if (!event)
+    {
+        return;
+    }
+
+    switch (event->getType())
+    {
+        case EventType::STATION_DELAY:
+        {
+            StationDelayEvent* ev = static_cast<StationDelayEvent*>(event);
+            if (_stationDelays.owns(ev))
+            {
+                _stationDelays.destroy(ev);
+                return;
+            }
+            break;
+        }
+        case EventType::TRACK_MAINTENANCE:
+        {
+            TrackMaintenanceEvent* ev = static_cast<TrackMaintenanceEvent*>(event);
+            if (_trackMaintenance.owns(ev))
+            {
+                _trackMaintenance.destroy(ev);
+                return;
+            }
+            break;
+        }
+        case EventType::SIGNAL_FAILURE:
+        {
+            SignalFailureEvent* ev = static_cast<SignalFailureEvent*>(event);
+            if (_signalFailures.owns(ev))
+            {
+                _signalFailures.destroy(ev);
+                return;
+            }
+            break;
+        }
+        case EventType::WEATHER:
+        {
+            WeatherEvent* ev = static_cast<WeatherEvent*>(event);
+            if (_weather.owns(ev))
+            {
+                _weather.destroy(ev);
+                return;
+            }
+            break;
+        }
+    }
+
+    // Not pool-allocated.
+    delete event;
+}
+
+PoolStats EventPool::stats() const
+{
+    PoolStats total;
+    total += _stationDelays.stats();
+    total += _trackMaintenance.stats();
+    total += _signalFailures.stats();
+    total += _weather.stats();
+    return total;
+}
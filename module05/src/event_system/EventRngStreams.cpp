@@ -0,0 +1,28 @@
+#include "event_system/EventRngStreams.hpp"
+
+EventRngStreams::EventRngStreams()
+    : _seed(0), _antithetic(false)
+{
+    reseed(0, false);
+}
+
+void EventRngStreams::reseed(unsigned int seed, bool antithetic)
+{
+    _seed       = seed;
+    _antithetic = antithetic;
+
+    for (std::size_t site = 0; site < SITE_COUNT; ++site)
+    {
+        _streams[site].reseed(seed, static_cast<unsigned int>(site), antithetic);
+    }
+}
+
+unsigned int EventRngStreams::getSeed() const
+{
+    return _seed;
+}
+
+bool EventRngStreams::isAntithetic() const
+{
+    return _antithetic;
+}
@@ -1,14 +1,33 @@
 #include "event_system/EventScheduler.hpp"
 #include "event_system/EventDispatcher.hpp"
+#include "event_system/EventPool.hpp"
 #include "events/Event.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
 
-EventScheduler::EventScheduler(EventDispatcher& dispatcher)
-    : _dispatcher(dispatcher)
+EventScheduler::EventScheduler(EventDispatcher& dispatcher, EventPool* eventPool)
+    : _dispatcher(dispatcher),
+      _eventPool(eventPool)
 {
 }
 
+EventScheduler::~EventScheduler()
+{
+    clear();
+}
+
+void EventScheduler::destroyEvent(Event* event)
+{
+    if (_eventPool)
+    {
+        _eventPool->release(event);
+    }
+    else
+    {
+        delete event;
+    }
+}
+
 void EventScheduler::scheduleEvent(Event* event)
 {
     if (!event)
@@ -51,7 +70,7 @@ void EventScheduler::update(const Time& currentTime)
         if (!event->isActive())
         {
             _dispatcher.notify(event);
-            delete event;
+            destroyEvent(event);
             activeIt = _activeEvents.erase(activeIt);
         }
         else
@@ -127,15 +146,24 @@ void EventScheduler::clear()
 {
     for (Event* event : _activeEvents)
     {
-        delete event;
+        destroyEvent(event);
     }
     _activeEvents.clear();
 
     for (Event* event : _scheduledEvents)
     {
-        delete event;
+        destroyEvent(event);
     }
     _scheduledEvents.clear();
 
     _totalEventsGenerated = 0;
-}
\ No newline at end of file
+}
+void EventScheduler::restore(const std::vector<Event*>& scheduled,
+                             const std::vector<Event*>& active,
+                             int                        totalEventsGenerated)
+{
+    clear();
+    _scheduledEvents      = scheduled;
+    _activeEvents         = active;
+    _totalEventsGenerated = totalEventsGenerated;
+}
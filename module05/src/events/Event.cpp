@@ -57,6 +57,11 @@ const VisualData& Event::getVisualData() const
     return _visualData;
 }
 
+void Event::restoreActive(bool active)
+{
+    _isActive = active;
+}
+
 // static
 std::string Event::typeToString(EventType type)
 {
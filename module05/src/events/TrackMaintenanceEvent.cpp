@@ -2,18 +2,18 @@
 #include "core/Rail.hpp"
 #include "core/Node.hpp"
 #include "core/Train.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 
 TrackMaintenanceEvent::TrackMaintenanceEvent(Rail* rail, const Time& startTime,
-                                             const Time& duration, double speedReductionFactor)
+                                             const Time& duration, double speedReductionFactor,
+                                             RailAttributeOverlay* railAttributes)
 	: Event(EventType::TRACK_MAINTENANCE, startTime, duration),
 	  _rail(rail),
 	  _speedReductionFactor(speedReductionFactor),
-	  _originalSpeedLimit(0.0)
+	  _railAttributes(railAttributes)
 {
 	if (_rail)
 	{
-		_originalSpeedLimit = _rail->getSpeedLimit();
-
 		// Setup visual data for isometric rendering
 		_visualData.centerNode = _rail->getNodeA();  // Use start node as anchor
 		_visualData.radius = _rail->getLength();     // Show affected rail length
@@ -24,20 +24,19 @@ TrackMaintenanceEvent::TrackMaintenanceEvent(Rail* rail, const Time& startTime,
 
 void TrackMaintenanceEvent::activate()
 {
-	if (_rail)
+	if (_rail && _railAttributes)
 	{
-		// Reduce rail speed limit
-		double reducedSpeed = _originalSpeedLimit * _speedReductionFactor;
-		_rail->setSpeedLimit(reducedSpeed);
+		// Reduce effective rail speed limit for this run
+		_railAttributes->applyModifier(_rail, _speedReductionFactor, 0.0);
 	}
 }
 
 void TrackMaintenanceEvent::deactivate()
 {
-	if (_rail)
+	if (_rail && _railAttributes)
 	{
-		// Restore original speed limit
-		_rail->setSpeedLimit(_originalSpeedLimit);
+		// Restore effective speed limit
+		_railAttributes->removeModifier(_rail, _speedReductionFactor, 0.0);
 	}
 }
 
@@ -2,16 +2,19 @@
 #include "core/Rail.hpp"
 #include "core/Node.hpp"
 #include "core/Train.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 
 WeatherEvent::WeatherEvent(const std::string& weatherType, Node* centerNode,
                            const Time& startTime, const Time& duration,
-                           double radiusKm, double speedReductionFactor, double frictionIncrease)
+                           double radiusKm, double speedReductionFactor, double frictionIncrease,
+                           RailAttributeOverlay* railAttributes)
 	: Event(EventType::WEATHER, startTime, duration),
 	  _weatherType(weatherType),
 	  _centerNode(centerNode),
 	  _radiusKm(radiusKm),
 	  _speedReductionFactor(speedReductionFactor),
-	  _frictionIncrease(frictionIncrease)
+	  _frictionIncrease(frictionIncrease),
+	  _railAttributes(railAttributes)
 {
 	// Setup visual data for isometric rendering
 	_visualData.centerNode = centerNode;
@@ -22,30 +25,28 @@ WeatherEvent::WeatherEvent(const std::string& weatherType, Node* centerNode,
 
 void WeatherEvent::activate()
 {
-	// Store original speed limits and reduce them
-	_originalSpeedLimits.clear();
+	if (!_railAttributes)
+	{
+		return;
+	}
+
 	for (Rail* rail : _affectedRails)
 	{
-		if (rail)
-		{
-			_originalSpeedLimits.push_back(rail->getSpeedLimit());
-			double reducedSpeed = rail->getSpeedLimit() * _speedReductionFactor;
-			rail->setSpeedLimit(reducedSpeed);
-		}
+		_railAttributes->applyModifier(rail, _speedReductionFactor, _frictionIncrease);
 	}
 }
 
 void WeatherEvent::deactivate()
 {
-	// Restore original speed limits
-	for (size_t i = 0; i < _affectedRails.size() && i < _originalSpeedLimits.size(); ++i)
+	if (!_railAttributes)
 	{
-		if (_affectedRails[i])
-		{
-			_affectedRails[i]->setSpeedLimit(_originalSpeedLimits[i]);
-		}
+		return;
+	}
+
+	for (Rail* rail : _affectedRails)
+	{
+		_railAttributes->removeModifier(rail, _speedReductionFactor, _frictionIncrease);
 	}
-	_originalSpeedLimits.clear();
 }
 
 bool WeatherEvent::affectsNode(Node* node) const
@@ -127,6 +128,11 @@ void WeatherEvent::setAffectedRails(const std::vector<Rail*>& rails)
 	_affectedRails = rails;
 }
 
+const std::vector<Rail*>& WeatherEvent::getAffectedRails() const
+{
+	return _affectedRails;
+}
+
 
 const Node* WeatherEvent::getAnchorNode() const
 {
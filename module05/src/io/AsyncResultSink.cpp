@@ -0,0 +1,303 @@
+#include "io/AsyncResultSink.hpp"
+#include "io/ResultFileStore.hpp"
+#include "utils/StringUtils.hpp"
+#include "utils/Time.hpp"
+#include <stdexcept>
+
+AsyncResultSink::AsyncResultSink(std::size_t maxOpenFiles)
+    : AsyncResultSink(std::unique_ptr<IResultStore>(new ResultFileStore(maxOpenFiles)))
+{
+}
+
+AsyncResultSink::AsyncResultSink(std::unique_ptr<IResultStore> store)
+    : _store(std::move(store)),
+      _nextFile(0),
+      _nextTicket(0),
+      _idle(false),
+      _stopping(false),
+      _doneTicket(0)
+{
+    if (!_store)
+    {
+        throw std::invalid_argument("AsyncResultSink needs a result store");
+    }
+
+    _thread = std::thread(&AsyncResultSink::run, this);
+}
+
+AsyncResultSink::~AsyncResultSink()
+{
+    try
+    {
+        shutdown();
+    }
+    catch (const std::exception&)
+    {
+        // Already reported through flush()/shutdown() by a well-behaved owner.
+    }
+}
+
+std::uint32_t AsyncResultSink::open(const std::string& path)
+{
+    // On the caller's thread, so a bad path fails where it always did.
+    _store->prepare(path);
+
+    const std::uint32_t file = _nextFile++;
+
+    Record& record = claim();
+    record.kind = Record::Kind::Open;
+    record.file = file;
+    record.text.assign(path);
+    publish();
+
+    return file;
+}
+
+void AsyncResultSink::write(std::uint32_t file, std::string_view text)
+{
+    // The slot keeps its buffer between laps: no allocation once warm.
+    Record& record = claim();
+    record.kind = Record::Kind::Text;
+    record.file = file;
+    record.text.assign(text);
+    publish();
+}
+
+void AsyncResultSink::writeSnapshot(std::uint32_t file, const ResultSnapshot& snapshot)
+{
+    Record& record  = claim();
+    record.kind     = Record::Kind::Snapshot;
+    record.file     = file;
+    record.snapshot = snapshot;
+    publish();
+}
+
+void AsyncResultSink::close(std::uint32_t file)
+{
+    Record& record = claim();
+    record.kind = Record::Kind::Close;
+    record.file = file;
+    publish();
+}
+
+void AsyncResultSink::flush()
+{
+    if (!_thread.joinable())
+    {
+        throwIfFailed();
+        return;
+    }
+
+    const std::uint64_t ticket = pushFlush();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _flushed.wait(lock, [this, ticket]() { return _doneTicket >= ticket; });
+    lock.unlock();
+
+    throwIfFailed();
+}
+
+void AsyncResultSink::shutdown()
+{
+    if (_thread.joinable())
+    {
+        pushFlush();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+
+        // The writer is gone: the store is ours now.
+        try
+        {
+            _store->finish();
+        }
+        catch (const std::exception& e)
+        {
+            fail(e);
+        }
+    }
+
+    throwIfFailed();
+}
+
+std::size_t AsyncResultSink::getMemoryUsage() const
+{
+    return sizeof(*this) + RING_CAPACITY * sizeof(Record);
+}
+
+AsyncResultSink::Record& AsyncResultSink::claim()
+{
+    Record* record = _ring.claim();
+
+    while (!record)
+    {
+        // Full: the writer is draining (it never sleeps on a non-empty
+        // ring), so just back off until a slot comes free.
+        std::this_thread::yield();
+        record = _ring.claim();
+    }
+    return *record;
+}
+
+void AsyncResultSink::publish()
+{
+    _ring.publish();
+
+    // Pairs with the fence in run(): either the writer sees this record
+    // before it sleeps, or we see _idle and wake it under the mutex.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_idle.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _wake.notify_one();
+    }
+}
+
+std::uint64_t AsyncResultSink::pushFlush()
+{
+    Record& record = claim();
+    record.kind    = Record::Kind::Flush;
+    record.ticket  = ++_nextTicket;
+    publish();
+
+    return _nextTicket;
+}
+
+void AsyncResultSink::run()
+{
+    for (;;)
+    {
+        if (Record* record = _ring.front())
+        {
+            consume(*record);
+            _ring.release();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        _wake.wait(lock, [this]() { return _stopping || !_ring.empty(); });
+        _idle.store(false, std::memory_order_relaxed);
+
+        if (_stopping && _ring.empty())
+        {
+            break;
+        }
+    }
+}
+
+void AsyncResultSink::consume(Record& record)
+{
+    try
+    {
+        switch (record.kind)
+        {
+            case Record::Kind::Open:
+                _store->open(record.file, record.text);
+                return;
+            case Record::Kind::Text:
+                _store->text(record.file, record.text);
+                return;
+            case Record::Kind::Snapshot:
+                _store->snapshot(record.file, record.snapshot);
+                return;
+            case Record::Kind::Close:
+                _store->close(record.file);
+                return;
+            case Record::Kind::Flush:
+                break;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        fail(e);
+        return;
+    }
+
+    try
+    {
+        _store->flush();
+    }
+    catch (const std::exception& e)
+    {
+        fail(e);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _doneTicket = record.ticket;
+    _flushed.notify_all();
+}
+
+void AsyncResultSink::fail(const std::exception& e)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_error.empty())
+    {
+        _error = e.what();
+    }
+}
+
+void AsyncResultSink::throwIfFailed()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_error.empty())
+    {
+        throw std::runtime_error(_error);
+    }
+}
+
+void AsyncResultSink::appendSnapshot(std::string&          out,
+                                     const ResultSnapshot& snapshot,
+                                     std::string_view      from,
+                                     std::string_view      to)
+{
+    out += '[';
+    out += Time::fromSeconds(snapshot.timeSeconds).toString();
+    out += "] - [";
+    StringUtils::appendPadded(out, from, 10);
+    out += "][";
+    StringUtils::appendPadded(out, to, 10);
+    out += "] - [";
+    StringUtils::appendFixed(out, snapshot.remainingKm, 2);
+    out += "km] - [";
+    StringUtils::appendPadded(out, snapshot.status, 9);
+    out += "] - [";
+
+    std::string velocity;
+    StringUtils::appendFixed(velocity, snapshot.velocityKmh, 0);
+    StringUtils::appendPadded(out, velocity, 6, '0', true);
+    out += "km/h] - ";
+
+    if (snapshot.cellCount <= 0)
+    {
+        out += "[ ]\n";
+        return;
+    }
+
+    const std::size_t start = out.size();
+
+    for (std::int32_t i = 0; i < snapshot.cellCount; ++i)
+    {
+        out += (i == snapshot.trainCell) ? "[x]" : "[ ]";
+    }
+
+    for (std::int32_t i = 0; i < snapshot.otherCount && i < static_cast<std::int32_t>(ResultSnapshot::MAX_OTHERS); ++i)
+    {
+        const std::int32_t cell = snapshot.otherCells[i];
+
+        if (cell >= 0 && cell < snapshot.cellCount && cell != snapshot.trainCell)
+        {
+            out[start + static_cast<std::size_t>(cell) * 3 + 1] = 'O';
+        }
+    }
+
+    out += '\n';
+}
@@ -1,8 +1,37 @@
 #include "io/CLI.hpp"
+#include "simulation/core/SimConstants.hpp"
+#include "utils/Time.hpp"
 #include <iostream>
 #include <sstream>
 #include <vector>
 
+namespace
+{
+    bool isPositiveNumber(const std::string& text)
+    {
+        std::istringstream ss(text);
+        double value = 0.0;
+        return !text.empty() && (ss >> value) && ss.eof() && value > 0.0;
+    }
+
+    bool isCountAtLeast(const std::string& text, std::size_t minimum)
+    {
+        std::istringstream ss(text);
+        std::size_t value = 0;
+        return !text.empty() && text[0] != '-' && (ss >> value) && ss.eof() && value >= minimum;
+    }
+
+    std::size_t countFlag(const std::map<std::string, std::string>& flags, const char* name, std::size_t fallback)
+    {
+        auto it = flags.find(name);
+        if (it == flags.end()) { return fallback; }
+        std::istringstream ss(it->second);
+        std::size_t value = fallback;
+        ss >> value;
+        return value;
+    }
+}
+
 CLI::CLI(int argc, char* argv[]) : _argc(argc), _argv(argv)
 {
     parseFlags();
@@ -15,6 +44,10 @@ bool CLI::shouldShowHelp() const
 
 bool CLI::hasValidArguments() const
 {
+    if (_argc >= 2 && std::string(_argv[1]) == "generate")
+    {
+        return _argc >= 4;
+    }
     return _argc >= 3;
 }
 
@@ -28,9 +61,57 @@ std::string CLI::getTrainFile() const
     return (_argc >= 3) ? std::string(_argv[2]) : "";
 }
 
+bool CLI::isTraceCommand() const
+{
+    return _argc >= 3 && std::string(_argv[1]) == "trace";
+}
+
+std::string CLI::getTraceInput() const
+{
+    return isTraceCommand() ? std::string(_argv[2]) : "";
+}
+
+std::string CLI::getTraceTrain() const
+{
+    return _traceTrain;
+}
+
+std::string CLI::getTraceOutput() const
+{
+    auto it = _flags.find("out");
+    return (it != _flags.end()) ? it->second : "";
+}
+
+bool CLI::isGenerateCommand() const
+{
+    return _argc >= 4 && std::string(_argv[1]) == "generate";
+}
+
+std::string CLI::getGenerateNetwork() const
+{
+    return isGenerateCommand() ? std::string(_argv[2]) : "";
+}
+
+std::string CLI::getGenerateTrains() const
+{
+    return isGenerateCommand() ? std::string(_argv[3]) : "";
+}
+
+std::string CLI::getTopology() const
+{
+    auto it = _flags.find("topology");
+    return (it != _flags.end()) ? it->second : "grid";
+}
+
+std::size_t CLI::getStations()   const { return countFlag(_flags, "stations", 100); }
+std::size_t CLI::getJunctions()  const { return countFlag(_flags, "junctions", 1); }
+std::size_t CLI::getTrainCount() const { return countFlag(_flags, "trains", 10); }
+
 void CLI::printUsage(const std::string& programName) const
 {
     std::cout << "Usage: " << programName << " <network_file> <train_file>" << std::endl;
+    std::cout << "       " << programName << " trace <trace_file> [train] [--out=file]" << std::endl;
+    std::cout << "       " << programName << " generate <network_out> <train_out> [--topology=...]" << std::endl;
     std::cout << "       " << programName << " --help" << std::endl;
 }
 
@@ -82,12 +163,59 @@ void CLI::printHelp() const
     std::cout << "  --hot-reload          Watch input files for changes (requires --render)\n";
     std::cout << "  --round-trip          Trains reverse at destination (indefinite)\n";
     std::cout << "  --monte-carlo=N       Run N simulations and output statistics\n";
-    std::cout << "  --record              Record simulation commands to output/replay.json\n";
-    std::cout << "  --replay=file         Replay a previously recorded session\n\n";
+    std::cout << "  --threads=N           Worker threads for --monte-carlo (default: 1)\n";
+    std::cout << "  --run-csv             Also write per-run rows for --monte-carlo\n";
+    std::cout << "  --sampling=MODE       Monte Carlo event sampling: independent (default),\n";
+    std::cout << "                        crn (common random numbers) or antithetic\n";
+    std::cout << "  --converge=TOL        Stop --monte-carlo once the 95% CI is within TOL of the mean\n";
+    std::cout << "  --converge-metrics=L  Metrics for --converge (default: trainDelay; also\n";
+    std::cout << "                        trainActualTime, totalDuration, totalEvents, collisionAvoidances)\n";
+    std::cout << "  --time-budget=S       Stop --monte-carlo after S seconds of wall time\n";
+    std::cout << "  --sweep=file          Run a parameter sweep (grid or Latin hypercube) over\n";
+    std::cout << "                        event probabilities/durations and train physics;\n";
+    std::cout << "                        writes output/sweep_results.csv (uses --seed, --threads)\n";
+    std::cout << "  --compile[=file]      Write network + trains as a binary scenario\n";
+    std::cout << "                        (default output/scenario.rsim) and exit; pass the\n";
+    std::cout << "                        .rsim as both input files to load it\n";
+    std::cout << "  --trace[=file]        Write all train output to one indexed binary trace\n";
+    std::cout << "                        (default output/trace.rtrace) instead of .result files\n";
+    std::cout << "  --live-feed[=file]    While running, read more trains (train file lines)\n";
+    std::cout << "                        from a FIFO or file (default: stdin); the run lasts\n";
+    std::cout << "                        until the feed ends and every train has arrived\n";
+    std::cout << "  --live-speed=N        With --live-feed: simulated minutes per second (default 10)\n";
+    std::cout << "  --profile[=file]      Time each phase of every tick; writes a Chrome trace\n";
+    std::cout << "                        (default output/profile.json, open in chrome://tracing)\n";
+    std::cout << "                        and a per-phase summary next to it (.csv)\n";
+    std::cout << "  --record[=file]       Record simulation commands (default output/replay.json);\n";
+    std::cout << "                        a file not ending in .json gets a compact binary log\n";
+    std::cout << "                        written while the simulation runs\n";
+    std::cout << "  --replay=file         Replay a previously recorded session\n";
+    std::cout << "  --replay-from=HHhMM   With --replay: seek to this time through the nearest\n";
+    std::cout << "                        recorded keyframe before writing output\n\n";
+
+    std::cout << "TRACE SUBCOMMAND:\n";
+    std::cout << "  ./railway_sim trace <trace_file>                  List traced trains\n";
+    std::cout << "  ./railway_sim trace <trace_file> <train> [--out=f] Print a train's .result text\n\n";
+
+    std::cout << "GENERATE SUBCOMMAND:\n";
+    std::cout << "  ./railway_sim generate <network_out> <train_out>  Write a synthetic scenario\n";
+    std::cout << "  --topology=T          grid (default), hub, scale-free or corridor\n";
+    std::cout << "  --stations=N          Stations (CityN, default 100)\n";
+    std::cout << "  --junctions=K         RailNode junctions chained along every line (default 1)\n";
+    std::cout << "  --trains=N            Trains, each a few lines from its departure (default 10)\n";
+    std::cout << "  --seed=N              Same seed and flags give the same files (default 42)\n\n";
 
     std::cout << "Examples:\n";
     std::cout << "  ./railway_sim network.txt trains.txt --seed=42 --record --render\n";
-    std::cout << "  ./railway_sim network.txt trains.txt --replay=output/replay.json --render\n\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --replay=output/replay.json --render\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --record=output/replay.rlog\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --compile=big.rsim\n";
+    std::cout << "  ./railway_sim big.rsim big.rsim --monte-carlo=100\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --trace\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --live-feed=dispatch.fifo\n";
+    std::cout << "  ./railway_sim network.txt trains.txt --monte-carlo=50 --threads=4 --profile\n";
+    std::cout << "  ./railway_sim trace output/trace.rtrace TrainAB\n";
+    std::cout << "  ./railway_sim generate big_net.txt big_trains.txt --topology=scale-free --stations=100000 --trains=10000\n\n";
 
     std::cout << "========================================\n\n";
 }
@@ -99,6 +227,19 @@ void CLI::parseFlags()
         std::string arg = _argv[i];
         std::string key, value;
 
+        // trace <file> <train>: the train is positional
+        if (i == 3 && isTraceCommand() && arg.compare(0, 2, "--") != 0)
+        {
+            _traceTrain = arg;
+            continue;
+        }
+
+        // generate <network_out> <train_out>: both are positional
+        if (i == 3 && isGenerateCommand())
+        {
+            continue;
+        }
+
         if (parseFlag(arg, key, value))
         {
             _flags[key] = value;
@@ -165,7 +306,153 @@ std::string CLI::getReplayFile() const
     return (it != _flags.end()) ? it->second : "";
 }
 
+std::string CLI::getRecordFile() const
+{
+    auto it = _flags.find("record");
+    if (it == _flags.end() || it->second.empty() || it->second == "true")
+    {
+        return "output/replay.json";
+    }
+    return it->second;
+}
+
+bool CLI::isBinaryRecord() const
+{
+    const std::string file = getRecordFile();
+    return file.size() < 5 || file.compare(file.size() - 5, 5, ".json") != 0;
+}
+
+bool CLI::hasReplayFrom()     const { return _flags.find("replay-from")  != _flags.end(); }
+
+std::string CLI::getReplayFrom() const
+{
+    auto it = _flags.find("replay-from");
+    return (it != _flags.end()) ? it->second : "";
+}
+
 bool CLI::hasMonteCarloRuns() const { return _flags.find("monte-carlo") != _flags.end(); }
+bool CLI::hasRunCSV()         const { return _flags.find("run-csv")     != _flags.end(); }
+std::string CLI::getSampling() const
+{
+    auto it = _flags.find("sampling");
+    return (it != _flags.end()) ? it->second : "independent";
+}
+
+bool CLI::hasSweep()          const { return _flags.find("sweep")       != _flags.end(); }
+
+std::string CLI::getSweepFile() const
+{
+    auto it = _flags.find("sweep");
+    return (it != _flags.end()) ? it->second : "";
+}
+
+bool CLI::hasCompile()        const { return _flags.find("compile")     != _flags.end(); }
+
+std::string CLI::getCompileFile() const
+{
+    auto it = _flags.find("compile");
+    if (it == _flags.end() || it->second.empty() || it->second == "true")
+    {
+        return "output/scenario.rsim";
+    }
+    return it->second;
+}
+
+bool CLI::hasTrace()          const { return _flags.find("trace")       != _flags.end(); }
+
+std::string CLI::getTraceFile() const
+{
+    auto it = _flags.find("trace");
+    if (it == _flags.end() || it->second.empty() || it->second == "true")
+    {
+        return "output/trace.rtrace";
+    }
+    return it->second;
+}
+
+bool CLI::hasLiveFeed()       const { return _flags.find("live-feed")   != _flags.end(); }
+
+std::string CLI::getLiveFeed() const
+{
+    auto it = _flags.find("live-feed");
+    if (it == _flags.end() || it->second.empty() || it->second == "true")
+    {
+        return "-";
+    }
+    return it->second;
+}
+
+bool CLI::hasProfile()        const { return _flags.find("profile")     != _flags.end(); }
+
+std::string CLI::getProfileFile() const
+{
+    auto it = _flags.find("profile");
+    if (it == _flags.end() || it->second.empty() || it->second == "true")
+    {
+        return "output/profile.json";
+    }
+    return it->second;
+}
+
+std::string CLI::getProfileSummary() const
+{
+    const std::string file = getProfileFile();
+    const std::size_t dot  = file.find_last_of('.');
+    const std::size_t dir  = file.find_last_of('/');
+
+    if (dot == std::string::npos || (dir != std::string::npos && dot < dir))
+    {
+        return file + ".csv";
+    }
+    return file.substr(0, dot) + ".csv";
+}
+
+double CLI::getLiveSpeed() const
+{
+    auto it = _flags.find("live-speed");
+    if (it == _flags.end()) { return SimConfig::DEFAULT_SPEED; }
+    std::istringstream ss(it->second);
+    double speed = SimConfig::DEFAULT_SPEED;
+    ss >> speed;
+    return speed;
+}
+
+bool CLI::hasConvergence()    const { return _flags.find("converge")    != _flags.end(); }
+
+double CLI::getConvergenceTolerance() const
+{
+    auto it = _flags.find("converge");
+    if (it == _flags.end()) { return 0.0; }
+    std::istringstream ss(it->second);
+    double tolerance = 0.0;
+    ss >> tolerance;
+    return tolerance;
+}
+
+std::vector<std::string> CLI::getConvergenceMetrics() const
+{
+    std::vector<std::string> metrics;
+    auto it = _flags.find("converge-metrics");
+    if (it == _flags.end()) { return {"trainDelay"}; }
+
+    std::istringstream ss(it->second);
+    std::string metric;
+    while (std::getline(ss, metric, ','))
+    {
+        if (!metric.empty()) { metrics.push_back(metric); }
+    }
+    return metrics;
+}
+
+double CLI::getTimeBudget() const
+{
+    auto it = _flags.find("time-budget");
+    if (it == _flags.end()) { return 0.0; }
+    std::istringstream ss(it->second);
+    double seconds = 0.0;
+    ss >> seconds;
+    return seconds;
+}
 
 unsigned int CLI::getMonteCarloRuns() const
 {
@@ -176,12 +463,28 @@ unsigned int CLI::getMonteCarloRuns() const
     return runs;
 }
 
+unsigned int CLI::getThreads() const
+{
+    auto it = _flags.find("threads");
+    if (it == _flags.end()) { return 1; }
+    std::istringstream ss(it->second);
+    unsigned int threads = 1;
+    ss >> threads;
+    return threads;
+}
+
 bool CLI::validateFlags(std::string& errorMsg) const
 {
-    const std::vector<std::string> validFlags = {
-        "seed", "pathfinding", "render", "hot-reload",
-        "monte-carlo", "round-trip", "record", "replay"
-    };
+    const std::vector<std::string> validFlags = isTraceCommand()
+        ? std::vector<std::string>{"out"}
+        : isGenerateCommand()
+        ? std::vector<std::string>{"topology", "stations", "junctions", "trains", "seed"}
+        : std::vector<std::string>{
+            "seed", "pathfinding", "render", "hot-reload",
+            "monte-carlo", "threads", "run-csv", "sampling", "converge", "converge-metrics",
+            "time-budget", "sweep", "compile", "trace", "round-trip", "record", "replay",
+            "replay-from", "live-feed", "live-speed", "profile"
+        };
 
     for (const auto& pair : _flags)
     {
@@ -241,6 +544,162 @@ bool CLI::validateFlags(std::string& errorMsg) const
         }
     }
 
+    if (_flags.find("threads") != _flags.end())
+    {
+        const std::string& threadStr = _flags.at("threads");
+        std::istringstream ss(threadStr);
+        unsigned int threads = 0;
+        if (threadStr.empty() || threadStr[0] == '-' || !(ss >> threads) || !ss.eof() || threads == 0)
+        {
+            errorMsg = "Invalid threads value: '" + threadStr + "' (must be a positive integer)";
+            return false;
+        }
+    }
+
+    if (_flags.find("sampling") != _flags.end())
+    {
+        const std::string& mode = _flags.at("sampling");
+        if (mode != "independent" && mode != "crn" && mode != "antithetic")
+        {
+            errorMsg = "Invalid sampling mode: '" + mode + "' (must be 'independent', 'crn' or 'antithetic')";
+            return false;
+        }
+    }
+
+    if (_flags.find("converge") != _flags.end() && !isPositiveNumber(_flags.at("converge")))
+    {
+        errorMsg = "Invalid converge value: '" + _flags.at("converge") + "' (must be a positive number, e.g. 0.02)";
+        return false;
+    }
+
+    if (_flags.find("time-budget") != _flags.end() && !isPositiveNumber(_flags.at("time-budget")))
+    {
+        errorMsg = "Invalid time-budget value: '" + _flags.at("time-budget") + "' (must be a positive number of seconds)";
+        return false;
+    }
+
+    if ((_flags.count("converge-metrics") || _flags.count("time-budget")) && !_flags.count("converge"))
+    {
+        errorMsg = "Flags --converge-metrics and --time-budget require --converge";
+        return false;
+    }
+
+    if (_flags.find("sweep") != _flags.end())
+    {
+        if (_flags.at("sweep").empty() || _flags.at("sweep") == "true")
+        {
+            errorMsg = "Flag --sweep requires a spec file (e.g. --sweep=examples/sweep_events.txt)";
+            return false;
+        }
+
+        for (const char* other : {"monte-carlo", "render", "record", "replay"})
+        {
+            if (_flags.count(other))
+            {
+                errorMsg = std::string("Flag --sweep cannot be combined with --") + other;
+                return false;
+            }
+        }
+    }
+
+    if (_flags.find("compile") != _flags.end())
+    {
+        for (const char* other : {"monte-carlo", "sweep", "render", "hot-reload", "record", "replay"})
+        {
+            if (_flags.count(other))
+            {
+                errorMsg = std::string("Flag --compile cannot be combined with --") + other;
+                return false;
+            }
+        }
+    }
+
+    if (_flags.find("trace") != _flags.end())
+    {
+        for (const char* other : {"monte-carlo", "sweep", "compile"})
+        {
+            if (_flags.count(other))
+            {
+                errorMsg = std::string("Flag --trace cannot be combined with --") + other;
+                return false;
+            }
+        }
+    }
+
+    if (_flags.find("live-feed") != _flags.end())
+    {
+        for (const char* other : {"monte-carlo", "sweep", "compile", "render", "hot-reload", "replay", "round-trip"})
+        {
+            if (_flags.count(other))
+            {
+                errorMsg = std::string("Flag --live-feed cannot be combined with --") + other;
+                return false;
+            }
+        }
+    }
+
+    if (_flags.find("live-speed") != _flags.end())
+    {
+        if (!_flags.count("live-feed"))
+        {
+            errorMsg = "Flag --live-speed requires --live-feed";
+            return false;
+        }
+        if (!isPositiveNumber(_flags.at("live-speed")))
+        {
+            errorMsg = "Invalid live-speed value: '" + _flags.at("live-speed") + "' (must be a positive number)";
+            return false;
+        }
+    }
+
+    if (_flags.find("profile") != _flags.end())
+    {
+        if (_flags.count("compile"))
+        {
+            errorMsg = "Flag --profile cannot be combined with --compile";
+            return false;
+        }
+        if (getProfileSummary() == getProfileFile())
+        {
+            errorMsg = "Flag --profile needs a file that does not end in .csv (the summary goes there)";
+            return false;
+        }
+    }
+
+    if (_flags.find("topology") != _flags.end())
+    {
+        const std::string& topology = _flags.at("topology");
+        if (topology != "grid" && topology != "hub" && topology != "scale-free" && topology != "corridor")
+        {
+            errorMsg = "Invalid topology: '" + topology + "' (must be 'grid', 'hub', 'scale-free' or 'corridor')";
+            return false;
+        }
+    }
+
+    if (_flags.find("stations") != _flags.end() && !isCountAtLeast(_flags.at("stations"), 2))
+    {
+        errorMsg = "Invalid stations value: '" + _flags.at("stations") + "' (must be an integer of at least 2)";
+        return false;
+    }
+
+    if (_flags.find("junctions") != _flags.end() && !isCountAtLeast(_flags.at("junctions"), 0))
+    {
+        errorMsg = "Invalid junctions value: '" + _flags.at("junctions") + "' (must be a non-negative integer)";
+        return false;
+    }
+
+    if (_flags.find("trains") != _flags.end() && !isCountAtLeast(_flags.at("trains"), 1))
+    {
+        errorMsg = "Invalid trains value: '" + _flags.at("trains") + "' (must be a positive integer)";
+        return false;
+    }
+
+    if (_flags.find("out") != _flags.end() && (_flags.at("out").empty() || _flags.at("out") == "true"))
+    {
+        errorMsg = "Flag --out requires a file path (e.g. --out=train.result)";
+        return false;
+    }
+
     // --replay requires a non-empty value
     if (_flags.find("replay") != _flags.end())
     {
@@ -251,6 +710,23 @@ bool CLI::validateFlags(std::string& errorMsg) const
         }
     }
 
+    // --replay-from=HHhMM seeks inside a replay
+    if (_flags.find("replay-from") != _flags.end())
+    {
+        if (_flags.find("replay") == _flags.end())
+        {
+            errorMsg = "Flag --replay-from requires --replay";
+            return false;
+        }
+
+        const std::string& value = _flags.at("replay-from");
+        if (value.size() != 5 || value[2] != 'h' || !Time(value).isValid())
+        {
+            errorMsg = "Flag --replay-from requires a time in HHhMM format (e.g. --replay-from=18h00)";
+            return false;
+        }
+    }
+
     // --record and --replay are mutually exclusive
     if (_flags.find("record") != _flags.end() && _flags.find("replay") != _flags.end())
     {
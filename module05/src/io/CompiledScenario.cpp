@@ -0,0 +1,437 @@
+#include "io/CompiledScenario.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "utils/BinaryCodec.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+
+namespace
+{
+    constexpr char        MAGIC[8]     = {'R', 'S', 'I', 'M', 'S', 'C', 'N', '1'};
+    constexpr std::size_t HEADER_SIZE  = sizeof(MAGIC) + 4 + 4 + 8 + 8;
+    constexpr std::size_t NODE_SIZE    = 4 + 1;
+    constexpr std::size_t RAIL_SIZE    = 4 + 4 + 8 + 8;
+    constexpr std::size_t TRAIN_SIZE   = 4 + 4 * 8 + 4 + 4 + 4 * 4;
+
+    // FNV-1a folded over 64-bit words (then the tail bytes): one multiply
+    // per word keeps validation well under the cost of building the objects.
+    std::uint64_t checksum(std::string_view bytes)
+    {
+        constexpr std::uint64_t PRIME = 1099511628211ULL;
+
+        std::uint64_t hash = 14695981039346656037ULL;
+        std::size_t   pos  = 0;
+
+        for (; pos + sizeof(std::uint64_t) <= bytes.size(); pos += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + pos, sizeof(word));
+            hash = (hash ^ word) * PRIME;
+        }
+
+        for (; pos < bytes.size(); ++pos)
+        {
+            hash = (hash ^ static_cast<unsigned char>(bytes[pos])) * PRIME;
+        }
+
+        return hash;
+    }
+
+    // Section of count records of recordSize bytes.
+    std::string_view section(BinaryCodec::Reader& in, std::size_t recordSize)
+    {
+        const std::uint32_t count = in.get<std::uint32_t>();
+
+        if (count > in.remaining() / recordSize)
+        {
+            throw std::runtime_error("truncated data");
+        }
+
+        return in.take(count * recordSize);
+    }
+
+    CompiledScenario::Source fingerprint(const std::string& filepath)
+    {
+        namespace fs = std::filesystem;
+
+        CompiledScenario::Source source;
+        std::error_code          ec;
+
+        fs::path absolute = fs::absolute(filepath, ec);
+        source.path       = ec ? filepath : absolute.lexically_normal().string();
+        source.size       = static_cast<std::int64_t>(fs::file_size(filepath, ec));
+
+        if (ec)
+        {
+            throw std::runtime_error("Cannot stat source file: " + filepath);
+        }
+
+        source.modified = static_cast<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                fs::last_write_time(filepath, ec).time_since_epoch()).count());
+        return source;
+    }
+
+    void putSource(std::string& out, const CompiledScenario::Source& source)
+    {
+        BinaryCodec::putString(out, source.path);
+        BinaryCodec::put(out, source.size);
+        BinaryCodec::put(out, source.modified);
+    }
+
+    CompiledScenario::Source getSource(BinaryCodec::Reader& in)
+    {
+        CompiledScenario::Source source;
+        source.path     = std::string(in.string());
+        source.size     = in.get<std::int64_t>();
+        source.modified = in.get<std::int64_t>();
+        return source;
+    }
+
+    // Assigns each distinct name a dense index in first-seen order.
+    class StringTable
+    {
+    public:
+        std::uint32_t intern(const std::string& text)
+        {
+            auto it = _index.find(text);
+            if (it != _index.end())
+            {
+                return it->second;
+            }
+
+            const std::uint32_t id = static_cast<std::uint32_t>(_strings.size());
+            _index.emplace(text, id);
+            _strings.push_back(text);
+            return id;
+        }
+
+        void writeTo(std::string& out) const
+        {
+            BinaryCodec::put(out, static_cast<std::uint32_t>(_strings.size()));
+
+            std::uint32_t offset = 0;
+            for (const std::string& text : _strings)
+            {
+                BinaryCodec::put(out, offset);
+                offset += static_cast<std::uint32_t>(text.size());
+            }
+            BinaryCodec::put(out, offset);
+
+            for (const std::string& text : _strings)
+            {
+                out.append(text);
+            }
+        }
+
+    private:
+        std::unordered_map<std::string, std::uint32_t> _index;
+        std::vector<std::string>                       _strings;
+    };
+}
+
+bool CompiledScenario::isCompiled(std::string_view bytes)
+{
+    return bytes.size() >= sizeof(MAGIC) && std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void CompiledScenario::write(const std::string&              path,
+                             const Graph&                    network,
+                             const std::vector<TrainConfig>& trains,
+                             const std::string&              networkSource,
+                             const std::string&              trainSource)
+{
+    StringTable                                      strings;
+    std::unordered_map<const Node*, std::uint32_t>   nodeIndex;
+    const Graph::NodeList                            nodes = network.getNodes();
+    const Graph::RailList                            rails = network.getRails();
+
+    for (const Node* node : nodes)
+    {
+        strings.intern(node->getName());
+    }
+    for (const TrainConfig& config : trains)
+    {
+        strings.intern(config.name);
+    }
+
+    std::string payload;
+    putSource(payload, fingerprint(networkSource));
+    putSource(payload, fingerprint(trainSource));
+
+    std::string records;
+
+    BinaryCodec::put(records, static_cast<std::uint32_t>(nodes.size()));
+    for (const Node* node : nodes)
+    {
+        nodeIndex.emplace(node, static_cast<std::uint32_t>(nodeIndex.size()));
+        BinaryCodec::put(records, strings.intern(node->getName()));
+        BinaryCodec::put(records, static_cast<std::uint8_t>(node->getType() == NodeType::JUNCTION ? 1 : 0));
+    }
+
+    BinaryCodec::put(records, static_cast<std::uint32_t>(rails.size()));
+    for (const Rail* rail : rails)
+    {
+        BinaryCodec::put(records, nodeIndex.at(rail->getNodeA()));
+        BinaryCodec::put(records, nodeIndex.at(rail->getNodeB()));
+        BinaryCodec::put(records, rail->getLength());
+        BinaryCodec::put(records, rail->getSpeedLimit());
+    }
+
+    BinaryCodec::put(records, static_cast<std::uint32_t>(trains.size()));
+    for (const TrainConfig& config : trains)
+    {
+        BinaryCodec::put(records, strings.intern(config.name));
+        BinaryCodec::put(records, config.mass);
+        BinaryCodec::put(records, config.frictionCoef);
+        BinaryCodec::put(records, config.maxAccelForce);
+        BinaryCodec::put(records, config.maxBrakeForce);
+        BinaryCodec::put(records, strings.intern(config.departureStation));
+        BinaryCodec::put(records, strings.intern(config.arrivalStation));
+        BinaryCodec::put(records, static_cast<std::int32_t>(config.departureTime.getHours()));
+        BinaryCodec::put(records, static_cast<std::int32_t>(config.departureTime.getMinutes()));
+        BinaryCodec::put(records, static_cast<std::int32_t>(config.stopDuration.getHours()));
+        BinaryCodec::put(records, static_cast<std::int32_t>(config.stopDuration.getMinutes()));
+    }
+
+    strings.writeTo(payload);
+    payload.append(records);
+
+    const std::string& body = payload;
+
+    std::string header;
+    header.append(MAGIC, sizeof(MAGIC));
+    BinaryCodec::put(header, VERSION);
+    BinaryCodec::put(header, static_cast<std::uint32_t>(0));
+    BinaryCodec::put(header, static_cast<std::uint64_t>(body.size()));
+    BinaryCodec::put(header, checksum(body));
+
+    // Write beside the target and rename, so readers never map a half-written file.
+    const std::string staging = path + ".tmp";
+    {
+        std::ofstream file(staging, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open file for writing: " + staging);
+        }
+
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(body.data(), static_cast<std::streamsize>(body.size()));
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write compiled scenario: " + path);
+        }
+    }
+
+    if (std::rename(staging.c_str(), path.c_str()) != 0)
+    {
+        std::remove(staging.c_str());
+        throw std::runtime_error("Failed to write compiled scenario: " + path);
+    }
+}
+
+CompiledScenario::CompiledScenario(std::string_view bytes, const std::string& path)
+    : _path(path)
+{
+    try
+    {
+        if (!isCompiled(bytes) || bytes.size() < HEADER_SIZE)
+        {
+            throw std::runtime_error("not a compiled scenario");
+        }
+
+        BinaryCodec::Reader header(bytes.substr(sizeof(MAGIC), HEADER_SIZE - sizeof(MAGIC)));
+        const std::uint32_t version = header.get<std::uint32_t>();
+        header.get<std::uint32_t>();
+        const std::uint64_t size = header.get<std::uint64_t>();
+        const std::uint64_t sum  = header.get<std::uint64_t>();
+
+        if (version != VERSION)
+        {
+            throw std::runtime_error("unsupported version " + std::to_string(version) +
+                                     " (expected " + std::to_string(VERSION) + ")");
+        }
+
+        const std::string_view body = bytes.substr(HEADER_SIZE);
+        if (body.size() != size)
+        {
+            throw std::runtime_error("payload size mismatch");
+        }
+        if (checksum(body) != sum)
+        {
+            throw std::runtime_error("checksum mismatch");
+        }
+
+        BinaryCodec::Reader in(body);
+        _network = getSource(in);
+        _trains  = getSource(in);
+
+        const std::uint32_t count = in.get<std::uint32_t>();
+        BinaryCodec::Reader offsets(in.take((static_cast<std::size_t>(count) + 1) * sizeof(std::uint32_t)));
+        std::vector<std::uint32_t> bounds(count + 1);
+
+        for (std::uint32_t& bound : bounds)
+        {
+            bound = offsets.get<std::uint32_t>();
+        }
+
+        const std::string_view chars = in.take(bounds.back());
+        _strings.reserve(count);
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            if (bounds[i] > bounds[i + 1])
+            {
+                throw std::runtime_error("bad string table");
+            }
+            _strings.push_back(chars.substr(bounds[i], bounds[i + 1] - bounds[i]));
+        }
+
+        _nodeSection  = section(in, NODE_SIZE);
+        _railSection  = section(in, RAIL_SIZE);
+        _trainSection = section(in, TRAIN_SIZE);
+
+        if (!in.atEnd())
+        {
+            throw std::runtime_error("trailing data");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error("Corrupt compiled scenario '" + path + "': " + e.what());
+    }
+}
+
+bool CompiledScenario::isStale(const Source& source)
+{
+    std::error_code ec;
+
+    if (!std::filesystem::exists(source.path, ec))
+    {
+        return false;
+    }
+
+    try
+    {
+        const Source current = fingerprint(source.path);
+        return current.size != source.size || current.modified != source.modified;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+const CompiledScenario::Source& CompiledScenario::getNetworkSource() const { return _network; }
+const CompiledScenario::Source& CompiledScenario::getTrainSource()   const { return _trains; }
+
+Graph* CompiledScenario::buildNetwork() const
+{
+    std::unique_ptr<Graph> graph(new Graph());
+    std::vector<Node*>     nodes;
+    BinaryCodec::Reader    in(_nodeSection);
+
+    nodes.reserve(_nodeSection.size() / NODE_SIZE);
+
+    try
+    {
+        while (!in.atEnd())
+        {
+            const std::uint32_t name = in.get<std::uint32_t>();
+            const std::uint8_t  type = in.get<std::uint8_t>();
+
+            if (name >= _strings.size() || graph->hasNode(std::string(_strings[name])))
+            {
+                throw std::runtime_error("bad node name");
+            }
+
+            Node* node = new Node(std::string(_strings[name]), type ? NodeType::JUNCTION : NodeType::CITY);
+            graph->addNode(node);
+            nodes.push_back(node);
+        }
+
+        BinaryCodec::Reader rails(_railSection);
+
+        while (!rails.atEnd())
+        {
+            const std::uint32_t a      = rails.get<std::uint32_t>();
+            const std::uint32_t b      = rails.get<std::uint32_t>();
+            const double        length = rails.get<double>();
+            const double        speed  = rails.get<double>();
+
+            if (a >= nodes.size() || b >= nodes.size())
+            {
+                throw std::runtime_error("rail endpoint out of range");
+            }
+
+            graph->addRail(new Rail(nodes[a], nodes[b], length, speed));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error("Corrupt compiled scenario '" + _path + "': " + e.what());
+    }
+
+    return graph.release();
+}
+
+std::vector<TrainConfig> CompiledScenario::buildTrains() const
+{
+    std::vector<TrainConfig> configs;
+    BinaryCodec::Reader      in(_trainSection);
+
+    configs.reserve(_trainSection.size() / TRAIN_SIZE);
+
+    auto name = [this](std::uint32_t index)
+    {
+        if (index >= _strings.size())
+        {
+            throw std::runtime_error("Corrupt compiled scenario '" + _path + "': train string out of range");
+        }
+        return std::string(_strings[index]);
+    };
+
+    // Names are interned, so a repeated index is a repeated train name.
+    std::vector<bool> seen(_strings.size(), false);
+
+    while (!in.atEnd())
+    {
+        const std::uint32_t id = in.get<std::uint32_t>();
+
+        TrainConfig config;
+        config.name = name(id);
+
+        if (seen[id])
+        {
+            throw std::runtime_error("Duplicate train name detected: '" + config.name + "'");
+        }
+        seen[id] = true;
+
+        config.mass             = in.get<double>();
+        config.frictionCoef     = in.get<double>();
+        config.maxAccelForce    = in.get<double>();
+        config.maxBrakeForce    = in.get<double>();
+        config.departureStation = name(in.get<std::uint32_t>());
+        config.arrivalStation   = name(in.get<std::uint32_t>());
+
+        const std::int32_t depHours  = in.get<std::int32_t>();
+        const std::int32_t depMins   = in.get<std::int32_t>();
+        const std::int32_t stopHours = in.get<std::int32_t>();
+        const std::int32_t stopMins  = in.get<std::int32_t>();
+        config.departureTime = Time(depHours, depMins);
+        config.stopDuration  = Time(stopHours, stopMins);
+
+        configs.push_back(std::move(config));
+    }
+
+    return configs;
+}
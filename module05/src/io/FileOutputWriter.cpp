@@ -1,16 +1,20 @@
 #include "io/FileOutputWriter.hpp"
+#include "io/AsyncResultSink.hpp"
 #include "simulation/state/OccupancyMap.hpp"
 #include "core/Node.hpp"
 #include "simulation/systems/PhysicsSystem.hpp"
 #include "patterns/behavioral/states/ITrainState.hpp"
 #include "utils/FileSystemUtils.hpp"
+#include "utils/MemoryUsage.hpp"
+#include "utils/StringUtils.hpp"
 #include "utils/Time.hpp"
-#include <iomanip>
-#include <sstream>
 #include <cmath>
 
-FileOutputWriter::FileOutputWriter(Train* train)
+FileOutputWriter::FileOutputWriter(Train* train, AsyncResultSink& sink)
     : _train(train),
+      _sink(sink),
+      _fileId(0),
+      _isOpen(false),
       _totalPathDistance(0.0),
       _finalSnapshotWritten(false),
       _occupancy(nullptr)
@@ -22,10 +26,7 @@ FileOutputWriter::FileOutputWriter(Train* train)
 
 FileOutputWriter::~FileOutputWriter()
 {
-    if (_file.is_open())
-    {
-        _file.close();
-    }
+    close();
 }
 
 std::string FileOutputWriter::generateFilename() const
@@ -36,11 +37,8 @@ std::string FileOutputWriter::generateFilename() const
 
 void FileOutputWriter::open()
 {
-    _file.open(_filename);
-    if (!_file.is_open())
-    {
-        throw std::runtime_error("Failed to open output file: " + _filename);
-    }
+    _fileId = _sink.open(_filename);
+    _isOpen = true;
 }
 
 void FileOutputWriter::writeHeader(double estimatedTimeMinutes)
@@ -48,18 +46,20 @@ void FileOutputWriter::writeHeader(double estimatedTimeMinutes)
     int hours   = static_cast<int>(estimatedTimeMinutes) / 60;
     int minutes = static_cast<int>(estimatedTimeMinutes) % 60;
 
-    _file << "Train : " << _train->getName() << "\n";
-    _file << "Final travel time : "
-          << std::setfill('0') << std::setw(2) << hours   << "h"
-          << std::setfill('0') << std::setw(2) << minutes << "m" << "\n";
-    _file << "\n";
+    std::string text = "Train : " + _train->getName() + "\n";
+    text += "Final travel time : ";
+    StringUtils::appendPadded(text, std::to_string(hours), 2, '0', true);
+    text += "h";
+    StringUtils::appendPadded(text, std::to_string(minutes), 2, '0', true);
+    text += "m\n\n";
+
+    _sink.write(_fileId, text);
 }
 
 void FileOutputWriter::writePathInfo()
 {
     const auto& path = _train->getPath();
-
-    _file << "PATH:" << "\n";
+    std::string text = "PATH:\n";
 
     for (std::size_t i = 0; i < path.size(); ++i)
     {
@@ -68,21 +68,28 @@ void FileOutputWriter::writePathInfo()
 		{
 			continue;
 		}
-        _file << "  Segment " << i << ": "
-              << segment.from->getName() << " <-> " << segment.to->getName()
-              << " | length=" << std::fixed << std::setprecision(2) << segment.rail->getLength() << "km"
-              << " | speed="  << static_cast<int>(segment.rail->getSpeedLimit()) << "km/h"
-              << "\n";
+        text += "  Segment " + std::to_string(i) + ": "
+              + segment.from->getName() + " <-> " + segment.to->getName()
+              + " | length=";
+        StringUtils::appendFixed(text, segment.rail->getLength(), 2);
+        text += "km | speed=" + std::to_string(static_cast<int>(segment.rail->getSpeedLimit())) + "km/h\n";
     }
 
-    _file << "  Total distance: " << std::fixed << std::setprecision(2)
-          << _totalPathDistance << "km" << "\n";
-    _file << "\n";
+    text += "  Total distance: ";
+    StringUtils::appendFixed(text, _totalPathDistance, 2);
+    text += "km\n\n";
+
+    _sink.write(_fileId, text);
 }
 
 void FileOutputWriter::writeSnapshot(double currentTimeSeconds)
 {
-    Rail* currentRail = _train->getCurrentRail();
+    Rail*          currentRail = _train->getCurrentRail();
+    ResultSnapshot snapshot;
+
+    snapshot.timeSeconds = currentTimeSeconds;
+    snapshot.velocityKmh = PhysicsSystem::msToKmh(_train->getVelocity());
+    getStatusString().copy(snapshot.status, sizeof(snapshot.status) - 1);  // State names are short
 
     if (!currentRail)
     {
@@ -91,48 +98,39 @@ void FileOutputWriter::writeSnapshot(double currentTimeSeconds)
 			return;
 		}
 
-        std::string timeStr   = formatTime(currentTimeSeconds);
-        std::string realState = getStatusString();
-        double      velocityKmh = PhysicsSystem::msToKmh(_train->getVelocity());
+        // Once per train, and the station name is a temporary: format here.
+        std::string line;
+        AsyncResultSink::appendSnapshot(line, snapshot, _train->getArrivalStation(), "");
+        _sink.write(_fileId, line);
 
-        std::ostringstream nodeStr, statusStr;
-        nodeStr   << std::setw(10) << std::left << _train->getArrivalStation();
-        statusStr << std::setw(9)  << std::left << realState;
+        _finalSnapshotWritten = true;
+        return;
+    }
 
-        _file << "[" << timeStr << "] - "
-              << "[" << nodeStr.str() << "]"
-              << "[" << std::setw(10) << std::left << "          " << "] - "
-              << "[" << std::fixed << std::setprecision(2) << 0.00 << "km] - "
-              << "[" << statusStr.str() << "] - "
-              << "[" << std::setw(6) << std::right << std::fixed
-                     << std::setprecision(0) << velocityKmh << "km/h] - "
-              << "[ ]" << "\n";
+    snapshot.from        = &currentRail->getNodeA()->getName();
+    snapshot.to          = &currentRail->getNodeB()->getName();
+    snapshot.remainingKm = calculateRemainingDistance();
 
-        _finalSnapshotWritten = true;
+    std::vector<int> overflow;
+    fillRailCells(snapshot, overflow);
+
+    if (overflow.empty())
+    {
+        _sink.writeSnapshot(_fileId, snapshot);
         return;
     }
 
-    std::string timeStr       = formatTime(currentTimeSeconds);
-    Node*       nodeA         = currentRail->getNodeA();
-    Node*       nodeB         = currentRail->getNodeB();
-    double      remainingDist = calculateRemainingDistance();
-    std::string status        = getStatusString();
-    std::string visualization = generateRailVisualization();
-    double      velocityKmh   = PhysicsSystem::msToKmh(_train->getVelocity());
-
-    std::ostringstream nodeAStr, nodeBStr, statusStr;
-    nodeAStr  << std::setw(10) << std::left << nodeA->getName();
-    nodeBStr  << std::setw(10) << std::left << nodeB->getName();
-    statusStr << std::setw(9)  << std::left << status;
-
-    _file << "[" << timeStr << "] - "
-          << "[" << nodeAStr.str() << "]"
-          << "[" << nodeBStr.str() << "] - "
-          << "[" << std::fixed << std::setprecision(2) << remainingDist << "km] - "
-          << "[" << statusStr.str() << "] - "
-          << "[" << std::setw(6) << std::right << std::fixed
-                 << std::setprecision(0) << velocityKmh << "km/h] - "
-          << visualization << "\n";
+    // More trains share the rail than a record holds: format this line here.
+    std::string line;
+    AsyncResultSink::appendSnapshot(line, snapshot, *snapshot.from, *snapshot.to);
+
+    const std::size_t cellsStart = line.size() - 1 - static_cast<std::size_t>(snapshot.cellCount) * 3;
+    for (int cell : overflow)
+    {
+        line[cellsStart + static_cast<std::size_t>(cell) * 3 + 1] = 'O';
+    }
+
+    _sink.write(_fileId, line);
 }
 
 void FileOutputWriter::writeEventNotification(double             currentTimeSeconds,
@@ -140,19 +138,18 @@ void FileOutputWriter::writeEventNotification(double             currentTimeSeco
                                               const std::string& eventDetails,
                                               const std::string& action)
 {
-    std::string timeStr = formatTime(currentTimeSeconds);
+    std::string text = "\n*** EVENT " + action + " ***\n";
+    text += "[" + formatTime(currentTimeSeconds) + "] - " + eventType + ": " + eventDetails + "\n\n";
 
-    _file << "\n";
-    _file << "*** EVENT " << action << " ***" << "\n";
-    _file << "[" << timeStr << "] - " << eventType << ": " << eventDetails << "\n";
-    _file << "\n";
+    _sink.write(_fileId, text);
 }
 
 void FileOutputWriter::close()
 {
-    if (_file.is_open())
+    if (_isOpen)
     {
-        _file.close();
+        _sink.close(_fileId);
+        _isOpen = false;
     }
 }
 
@@ -161,6 +158,11 @@ void FileOutputWriter::setOccupancyMap(const OccupancyMap* occupancy)
     _occupancy = occupancy;
 }
 
+std::size_t FileOutputWriter::getMemoryUsage() const
+{
+    return sizeof(*this) + MemoryUsage::heapBytes(_filename);
+}
+
 std::string FileOutputWriter::getStatusString() const
 {
     if (_train->getCurrentState())
@@ -212,13 +214,9 @@ double FileOutputWriter::calculateRemainingDistance() const
     return PhysicsSystem::mToKm(totalRemaining);
 }
 
-std::string FileOutputWriter::generateRailVisualization() const
+void FileOutputWriter::fillRailCells(ResultSnapshot& snapshot, std::vector<int>& overflow) const
 {
     Rail* currentRail = _train->getCurrentRail();
-    if (!currentRail)
-	{
-		return "[ ]";
-	}
 
     int cellCount = static_cast<int>(std::ceil(currentRail->getLength()));
     if (cellCount < 1)
@@ -239,18 +237,15 @@ std::string FileOutputWriter::generateRailVisualization() const
 		trainCell = cellCount - 1;
 	}
 
-    std::ostringstream oss;
-    for (int i = 0; i < cellCount; ++i)
+    snapshot.cellCount = cellCount;
+    snapshot.trainCell = trainCell;
+
+    if (!_occupancy)
     {
-        oss << (i == trainCell ? "[x]" : "[ ]");
+        return;
     }
 
-    std::string vizStr = oss.str();
-
-    const std::vector<Train*>& others =
-        _occupancy ? _occupancy->get(currentRail) : std::vector<Train*>{};
-
-    for (Train* otherTrain : others)
+    for (Train* otherTrain : _occupancy->get(currentRail))
     {
         if (!otherTrain || otherTrain == _train)
 		{
@@ -259,17 +254,20 @@ std::string FileOutputWriter::generateRailVisualization() const
         double otherProgress = otherTrain->getPosition() / railLengthM;
         int    otherCell     = static_cast<int>(otherProgress * cellCount);
 
-        if (otherCell >= 0 && otherCell < cellCount && otherCell != trainCell)
+        if (otherCell < 0 || otherCell >= cellCount || otherCell == trainCell)
         {
-            int insertPos = otherCell * 3;
-            if (insertPos < static_cast<int>(vizStr.length()))
-            {
-                vizStr[insertPos + 1] = 'O';
-            }
+            continue;
         }
-    }
 
-    return vizStr;
+        if (snapshot.otherCount < static_cast<std::int32_t>(ResultSnapshot::MAX_OTHERS))
+        {
+            snapshot.otherCells[snapshot.otherCount++] = otherCell;
+        }
+        else
+        {
+            overflow.push_back(otherCell);
+        }
+    }
 }
 
 std::string FileOutputWriter::formatTime(double seconds) const
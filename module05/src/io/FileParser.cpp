@@ -1,54 +1,87 @@
 #include "io/FileParser.hpp"
 #include "utils/StringUtils.hpp"
 #include <filesystem>
+#include <fstream>
 #include <stdexcept>
-#include <sstream>
 
 FileParser::FileParser(const std::string& filepath)
     : _filepath(filepath),
+      _file(filepath),
+      _cursor(0),
       _lineNumber(0)
 {
-    _file.open(filepath);
-    if (!_file.is_open())
+}
+
+bool FileParser::wasStale() const
+{
+    return !_staleSource.empty();
+}
+
+std::string FileParser::getStaleWarning() const
+{
+    if (!wasStale())
     {
-        throw std::runtime_error("Failed to open file: " + filepath);
+        return "";
     }
+    return "Warning: " + _filepath + " is out of date, parsed " + _staleSource + " instead";
 }
 
-std::vector<std::string> FileParser::readLines()
+bool FileParser::nextLine(std::string_view& line)
 {
-    std::vector<std::string> lines;
-    std::string              line;
+    return nextLine(_file.view(), _cursor, _lineNumber, line);
+}
 
-    while (std::getline(_file, line))
+bool FileParser::nextLine(std::string_view  text,
+                          std::size_t&      cursor,
+                          int&              lineNumber,
+                          std::string_view& line)
+{
+    while (cursor < text.size())
     {
+        std::size_t end = text.find('\n', cursor);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+
+        std::string_view raw = text.substr(cursor, end - cursor);
+        cursor = end + 1;
+        ++lineNumber;
+
         // Strip inline comments.
-        auto commentPos = line.find('#');
-        if (commentPos != std::string::npos)
+        std::size_t commentPos = raw.find('#');
+        if (commentPos != std::string_view::npos)
         {
-            line = line.substr(0, commentPos);
+            raw = raw.substr(0, commentPos);
         }
 
-        line = StringUtils::trim(line);
+        raw = StringUtils::trim(raw);
 
-        if (!line.empty())
+        if (!raw.empty())
         {
-            lines.push_back(line);
+            line = raw;
+            return true;
         }
     }
 
-    return lines;
+    return false;
 }
 
 void FileParser::throwLineError(
     const std::string& message,
-    const std::string& lineContent) const
+    std::string_view   lineContent) const
+{
+    throw std::runtime_error(formatLineError(_lineNumber, message, lineContent));
+}
+
+std::string FileParser::formatLineError(
+    int                lineNumber,
+    const std::string& message,
+    std::string_view   lineContent)
 {
-    throw std::runtime_error(
-        "Error at line " + std::to_string(_lineNumber) +
-        ": "             + message                     +
-        "\nContent: "    + lineContent
-    );
+    return "Error at line " + std::to_string(lineNumber) +
+           ": "             + message                    +
+           "\nContent: "    + std::string(lineContent);
 }
 
 bool FileParser::fileExists(const std::string& filepath)
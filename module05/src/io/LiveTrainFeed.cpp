@@ -0,0 +1,350 @@
+#include "io/LiveTrainFeed.hpp"
+#include "io/TrainConfigParser.hpp"
+#include "core/Graph.hpp"
+#include "patterns/behavioral/strategies/IPathfindingStrategy.hpp"
+#include "patterns/creational/factories/TrainValidator.hpp"
+#include "utils/StringUtils.hpp"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // How long a reader facing a full queue sleeps before trying again.
+    constexpr int FULL_QUEUE_WAIT_MS = 1;
+}
+
+LiveTrainFeed::LiveTrainFeed(std::string source, Graph* network,
+                             std::unique_ptr<IPathfindingStrategy> strategy)
+    : _source(std::move(source)),
+      _network(network),
+      _strategy(std::move(strategy)),
+      _running(false),
+      _fd(-1),
+      _stopPipe{-1, -1},
+      _inputClosed(false),
+      _lines(0),
+      _queued(0),
+      _delivered(0),
+      _rejected(0),
+      _stalls(0),
+      _stalledUs(0),
+      _peakDepth(0),
+      _routeCacheHits(0),
+      _hasRejections(false),
+      _lineNumber(0)
+{
+}
+
+LiveTrainFeed::~LiveTrainFeed()
+{
+    stop();
+}
+
+void LiveTrainFeed::start()
+{
+    if (_running)
+    {
+        return;
+    }
+
+    if (::pipe2(_stopPipe, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        throw std::runtime_error(std::string("Live feed: pipe failed: ") + std::strerror(errno));
+    }
+    openSource();
+
+    _running = true;
+    _thread  = std::thread(&LiveTrainFeed::run, this);
+}
+
+void LiveTrainFeed::stop()
+{
+    if (!_running)
+    {
+        return;
+    }
+
+    _running = false;
+
+    const char wake = 1;
+    while (::write(_stopPipe[1], &wake, 1) < 0 && errno == EINTR)
+    {
+    }
+    _thread.join();
+    closeFds();
+
+    Arrival arrival;
+    while (_queue.tryPop(arrival))
+    {
+        delete arrival.train;
+    }
+}
+
+bool LiveTrainFeed::next(Arrival& arrival)
+{
+    if (!_queue.tryPop(arrival))
+    {
+        return false;
+    }
+
+    _delivered.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool LiveTrainFeed::isFinished() const
+{
+    return _inputClosed.load(std::memory_order_acquire) &&
+           _delivered.load(std::memory_order_acquire) == _queued.load(std::memory_order_acquire);
+}
+
+std::vector<std::string> LiveTrainFeed::takeRejections()
+{
+    std::vector<std::string> taken;
+    if (!_hasRejections.load(std::memory_order_acquire))
+    {
+        return taken;
+    }
+
+    std::lock_guard<std::mutex> lock(_rejectionMutex);
+    taken.swap(_rejections);
+    _hasRejections.store(false, std::memory_order_release);
+    return taken;
+}
+
+LiveTrainFeed::Stats LiveTrainFeed::getStats() const
+{
+    Stats stats;
+    stats.lines          = _lines.load();
+    stats.queued         = _queued.load();
+    stats.delivered      = _delivered.load();
+    stats.rejected       = _rejected.load();
+    stats.stalls         = _stalls.load();
+    stats.stalledMs      = static_cast<double>(_stalledUs.load()) / 1000.0;
+    stats.peakDepth      = _peakDepth.load();
+    stats.routeCacheHits = _routeCacheHits.load();
+    return stats;
+}
+
+void LiveTrainFeed::openSource()
+{
+    if (_source == "-")
+    {
+        _fd = ::fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0);
+    }
+    else
+    {
+        // Non-blocking so opening a FIFO does not wait for its writer.
+        _fd = ::open(_source.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    }
+
+    if (_fd < 0)
+    {
+        const std::string reason = std::strerror(errno);
+        closeFds();
+        throw std::runtime_error("Live feed: cannot open '" + _source + "': " + reason);
+    }
+}
+
+void LiveTrainFeed::closeFds()
+{
+    for (int* fd : {&_fd, &_stopPipe[0], &_stopPipe[1]})
+    {
+        if (*fd >= 0)
+        {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void LiveTrainFeed::run()
+{
+    std::string pending;
+    char        buffer[4096];
+
+    while (true)
+    {
+        pollfd fds[2];
+        fds[0] = {_stopPipe[0], POLLIN, 0};
+        fds[1] = {_fd, POLLIN, 0};
+
+        // A FIFO reports nothing until a writer has come and gone, so an
+        // unconnected feed waits here rather than seeing end of file.
+        if (::poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            reject(std::string("poll failed: ") + std::strerror(errno));
+            break;
+        }
+        if (fds[0].revents != 0)
+        {
+            return;
+        }
+        if (fds[1].revents == 0)
+        {
+            continue;
+        }
+
+        const ssize_t length = ::read(_fd, buffer, sizeof(buffer));
+        if (length < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            reject(std::string("read failed: ") + std::strerror(errno));
+            break;
+        }
+        if (length == 0)
+        {
+            break;
+        }
+
+        pending.append(buffer, static_cast<std::size_t>(length));
+
+        std::size_t start = 0;
+        std::size_t end;
+        while ((end = pending.find('\n', start)) != std::string::npos)
+        {
+            if (!handleLine(std::string_view(pending).substr(start, end - start)))
+            {
+                return;
+            }
+            start = end + 1;
+        }
+        pending.erase(0, start);
+    }
+
+    // A last line without a newline still counts.
+    if (!pending.empty() && !handleLine(pending))
+    {
+        return;
+    }
+    _inputClosed.store(true, std::memory_order_release);
+}
+
+bool LiveTrainFeed::handleLine(std::string_view line)
+{
+    ++_lineNumber;
+
+    const std::size_t comment = line.find('#');
+    if (comment != std::string_view::npos)
+    {
+        line = line.substr(0, comment);
+    }
+    line = StringUtils::trim(line);
+    if (line.empty())
+    {
+        return true;
+    }
+
+    _lines.fetch_add(1, std::memory_order_relaxed);
+    const std::string prefix = "line " + std::to_string(_lineNumber) + ": ";
+
+    Arrival arrival;
+    try
+    {
+        arrival.config = TrainConfigParser::parseLine(line);
+    }
+    catch (const std::runtime_error& e)
+    {
+        reject(prefix + e.what());
+        return true;
+    }
+
+    const TrainConfig&     config     = arrival.config;
+    const ValidationResult validation = TrainValidator::validate(config, _network);
+    if (!validation.valid)
+    {
+        reject(prefix + validation.error);
+        return true;
+    }
+
+    const RouteKey key(config.departureStation, config.arrivalStation);
+    auto           route = _routes.find(key);
+    if (route != _routes.end())
+    {
+        _routeCacheHits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        Train::Path path = _strategy->findPath(_network, _network->getNode(config.departureStation),
+                                               _network->getNode(config.arrivalStation));
+        route = _routes.emplace(key, std::move(path)).first;
+    }
+
+    if (route->second.empty())
+    {
+        reject(prefix + "No path from " + config.departureStation + " to " + config.arrivalStation);
+        return true;
+    }
+
+    arrival.train = TrainFactory::create(config, _network);
+    if (!arrival.train)
+    {
+        reject(prefix + "Failed to create train: " + config.name);
+        return true;
+    }
+    arrival.train->setPath(route->second);
+
+    return enqueue(arrival);
+}
+
+bool LiveTrainFeed::enqueue(const Arrival& arrival)
+{
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point stalledSince;
+    bool              stalled = false;
+
+    while (!_queue.tryPush(arrival))
+    {
+        if (!stalled)
+        {
+            stalled      = true;
+            stalledSince = clock::now();
+            _stalls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Wait for room, or for stop().
+        pollfd wake = {_stopPipe[0], POLLIN, 0};
+        if (::poll(&wake, 1, FULL_QUEUE_WAIT_MS) > 0)
+        {
+            delete arrival.train;
+            return false;
+        }
+    }
+
+    if (stalled)
+    {
+        const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - stalledSince);
+        _stalledUs.fetch_add(waited.count(), std::memory_order_relaxed);
+    }
+
+    const std::size_t queued = _queued.fetch_add(1, std::memory_order_acq_rel) + 1;
+    const std::size_t depth  = queued - _delivered.load(std::memory_order_acquire);
+    if (depth > _peakDepth.load(std::memory_order_relaxed))
+    {
+        _peakDepth.store(depth, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void LiveTrainFeed::reject(const std::string& message)
+{
+    _rejected.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_rejectionMutex);
+    _rejections.push_back(message);
+    _hasRejections.store(true, std::memory_order_release);
+}
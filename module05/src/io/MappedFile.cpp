@@ -0,0 +1,60 @@
+#include "io/MappedFile.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filepath)
+    : _data(nullptr), _size(0)
+{
+    int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        ::close(fd);
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+
+    if (_size > 0)
+    {
+        void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to map file: " + filepath);
+        }
+
+        // Parsers make one forward pass.
+        ::madvise(mapping, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(mapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+    {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+}
+
+std::string_view MappedFile::view() const
+{
+    return std::string_view(_data, _size);
+}
+
+std::size_t MappedFile::size() const
+{
+    return _size;
+}
@@ -1,7 +1,9 @@
 #include "io/RailNetworkParser.hpp"
+#include "io/CompiledScenario.hpp"
 #include "utils/StringUtils.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include <array>
 #include <stdexcept>
 
 RailNetworkParser::RailNetworkParser(const std::string& filepath)
@@ -11,15 +13,19 @@ RailNetworkParser::RailNetworkParser(const std::string& filepath)
 
 Graph* RailNetworkParser::parse()
 {
+    if (CompiledScenario::isCompiled(_file.view()))
+    {
+        return parseCompiled();
+    }
+
     Graph* graph = new Graph();
 
     try
     {
-        std::vector<std::string> lines = readLines();
+        std::string_view line;
 
-        for (const auto& line : lines)
+        while (nextLine(line))
         {
-            _lineNumber++;
             try
             {
                 parseLine(line, graph);
@@ -44,25 +50,48 @@ Graph* RailNetworkParser::parse()
     return graph;
 }
 
-void RailNetworkParser::parseLine(const std::string& line, Graph* graph)
+Graph* RailNetworkParser::parseCompiled()
 {
-    auto tokens = StringUtils::splitTokens(line);
+    CompiledScenario compiled(_file.view(), _filepath);
 
-    if (tokens.empty())
+    const CompiledScenario::Source& source = compiled.getNetworkSource();
+    if (CompiledScenario::isStale(source))
+    {
+        _staleSource = source.path;
+        return RailNetworkParser(source.path).parse();
+    }
+
+    Graph* graph = compiled.buildNetwork();
+
+    if (!graph->isValid())
+    {
+        delete graph;
+        throw std::runtime_error("Graph validation failed after loading " + _filepath);
+    }
+
+    return graph;
+}
+
+void RailNetworkParser::parseLine(std::string_view line, Graph* graph)
+{
+    std::array<std::string_view, 5> tokens;
+    std::size_t                     count = StringUtils::splitTokens(line, tokens);
+
+    if (count == 0)
     {
         return;
     }
 
-    const std::string& keyword = tokens[0];
+    const std::string_view keyword = tokens[0];
 
     if (keyword == "Node")
     {
-        if (tokens.size() != 2)
+        if (count != 2)
         {
             throw std::runtime_error("Invalid Node format. Expected: Node <n>");
         }
 
-        const std::string& nodeName = tokens[1];
+        const std::string nodeName(tokens[1]);
 
         if (nodeName.empty())
         {
@@ -84,14 +113,14 @@ void RailNetworkParser::parseLine(const std::string& line, Graph* graph)
 
     if (keyword == "Rail")
     {
-        if (tokens.size() != 5)
+        if (count != 5)
         {
             throw std::runtime_error(
                 "Invalid Rail format. Expected: Rail <nodeA> <nodeB> <length> <speedLimit>");
         }
 
-        const std::string& nodeA = tokens[1];
-        const std::string& nodeB = tokens[2];
+        const std::string nodeA(tokens[1]);
+        const std::string nodeB(tokens[2]);
 
         if (nodeA == nodeB)
         {
@@ -99,12 +128,15 @@ void RailNetworkParser::parseLine(const std::string& line, Graph* graph)
                 "Rail cannot connect node to itself: '" + nodeA + "'");
         }
 
-        if (!graph->hasNode(nodeA))
+        Node* endA = graph->getNode(nodeA);
+        Node* endB = graph->getNode(nodeB);
+
+        if (!endA)
         {
             throw std::runtime_error("Unknown node: '" + nodeA + "'");
         }
 
-        if (!graph->hasNode(nodeB))
+        if (!endB)
         {
             throw std::runtime_error("Unknown node: '" + nodeB + "'");
         }
@@ -132,10 +164,9 @@ void RailNetworkParser::parseLine(const std::string& line, Graph* graph)
             throw std::runtime_error("Speed limit must be positive");
         }
 
-        graph->addRail(
-            new Rail(graph->getNode(nodeA), graph->getNode(nodeB), length, speed));
+        graph->addRail(new Rail(endA, endB, length, speed));
         return;
     }
 
-    throw std::runtime_error("Unknown keyword: '" + keyword + "'");
+    throw std::runtime_error("Unknown keyword: '" + std::string(keyword) + "'");
 }
\ No newline at end of file
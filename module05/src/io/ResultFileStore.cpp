@@ -0,0 +1,179 @@
+#include "io/ResultFileStore.hpp"
+#include "io/AsyncResultSink.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+ResultFileStore::ResultFileStore(std::size_t maxOpenFiles)
+    : _maxOpenFiles(maxOpenFiles > 0 ? maxOpenFiles : 1),
+      _buffered(0)
+{
+}
+
+ResultFileStore::~ResultFileStore()
+{
+    for (FileState& file : _files)
+    {
+        releaseDescriptor(file);
+    }
+}
+
+void ResultFileStore::prepare(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open output file: " + path);
+    }
+    ::close(fd);
+}
+
+void ResultFileStore::open(std::uint32_t file, const std::string& path)
+{
+    if (file >= _files.size())
+    {
+        _files.resize(file + 1);
+    }
+    _files[file].path = path;
+}
+
+void ResultFileStore::text(std::uint32_t file, const std::string& text)
+{
+    _files.at(file).buffer.append(text);
+    appended(file, text.size());
+}
+
+void ResultFileStore::snapshot(std::uint32_t file, const ResultSnapshot& snapshot)
+{
+    std::string&      buffer = _files.at(file).buffer;
+    const std::size_t before = buffer.size();
+
+    AsyncResultSink::appendSnapshot(buffer, snapshot,
+                                    snapshot.from ? std::string_view(*snapshot.from) : std::string_view(),
+                                    snapshot.to   ? std::string_view(*snapshot.to)   : std::string_view());
+    appended(file, buffer.size() - before);
+}
+
+void ResultFileStore::close(std::uint32_t file)
+{
+    FileState& state = _files.at(file);
+    flushFile(file);
+    releaseDescriptor(state);
+    std::string().swap(state.buffer);
+}
+
+void ResultFileStore::flush()
+{
+    for (std::uint32_t id = 0; id < _files.size(); ++id)
+    {
+        flushFile(id);
+    }
+}
+
+void ResultFileStore::finish()
+{
+    flush();
+
+    for (FileState& file : _files)
+    {
+        releaseDescriptor(file);
+    }
+}
+
+void ResultFileStore::appended(std::uint32_t file, std::size_t bytes)
+{
+    _buffered += bytes;
+
+    if (_files[file].buffer.size() >= FILE_BUFFER_BYTES)
+    {
+        flushFile(file);
+    }
+    if (_buffered >= TOTAL_BUFFER_BYTES)
+    {
+        flush();
+    }
+}
+
+void ResultFileStore::flushFile(std::uint32_t id)
+{
+    FileState& file = _files[id];
+
+    if (file.buffer.empty())
+    {
+        return;
+    }
+
+    const std::size_t size = file.buffer.size();
+    _buffered -= size;
+
+    int fd = -1;
+    try
+    {
+        fd = descriptor(id);
+    }
+    catch (...)
+    {
+        file.buffer.clear();
+        throw;
+    }
+
+    const char* data = file.buffer.data();
+    std::size_t left = size;
+
+    while (left > 0)
+    {
+        const ssize_t written = ::write(fd, data, left);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            file.buffer.clear();
+            throw std::runtime_error("Failed to write output file: " + file.path);
+        }
+
+        data += written;
+        left -= static_cast<std::size_t>(written);
+    }
+
+    file.buffer.clear();
+}
+
+void ResultFileStore::releaseDescriptor(FileState& file)
+{
+    if (file.fd >= 0)
+    {
+        ::close(file.fd);
+        file.fd = -1;
+        _openFiles.erase(file.lru);
+    }
+}
+
+int ResultFileStore::descriptor(std::uint32_t id)
+{
+    FileState& file = _files[id];
+
+    if (file.fd >= 0)
+    {
+        _openFiles.splice(_openFiles.begin(), _openFiles, file.lru);
+        return file.fd;
+    }
+
+    if (_openFiles.size() >= _maxOpenFiles)
+    {
+        releaseDescriptor(_files[_openFiles.back()]);
+    }
+
+    file.fd = ::open(file.path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (file.fd < 0)
+    {
+        throw std::runtime_error("Failed to write output file: " + file.path);
+    }
+
+    _openFiles.push_front(id);
+    file.lru = _openFiles.begin();
+    return file.fd;
+}
@@ -0,0 +1,360 @@
+#include "io/ScenarioGenerator.hpp"
+#include "utils/SeededRNG.hpp"
+#include "utils/Time.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t   MAX_JUNCTIONS = 100;  // Keeps every segment above 0.05 km
+    constexpr std::uint32_t EXPRESS_SPAN  = 5;    // Corridor stations skipped by an express link
+    constexpr int           MIN_HOPS      = 2;    // Lines between a train's departure and arrival
+    constexpr int           MAX_HOPS      = 8;
+
+    struct Line
+    {
+        std::uint32_t a;
+        std::uint32_t b;
+        bool          express;  // Trunk line: longer and faster
+    };
+
+    // Stations adjacent to each station, flattened.
+    struct Adjacency
+    {
+        std::vector<std::uint32_t> offsets;  // stations + 1 entries
+        std::vector<std::uint32_t> stations;
+    };
+
+    // One stream per part of the output, so changing the train count
+    // leaves the network as it was.
+    unsigned int streamSeed(unsigned int seed, unsigned int stream)
+    {
+        return seed ^ (stream * 0x9E3779B9u);
+    }
+
+    std::vector<Line> gridLines(std::uint32_t stations)
+    {
+        const auto width = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(stations))));
+
+        std::vector<Line> lines;
+        lines.reserve(2 * static_cast<std::size_t>(stations));
+        for (std::uint32_t i = 1; i < stations; ++i)
+        {
+            if (i % width != 0)
+            {
+                lines.push_back({i - 1, i, false});
+            }
+            if (i >= width)
+            {
+                lines.push_back({i - width, i, false});
+            }
+        }
+        return lines;
+    }
+
+    std::vector<Line> hubLines(std::uint32_t stations)
+    {
+        const auto hubs = std::max<std::uint32_t>(
+            1, static_cast<std::uint32_t>(std::lround(std::sqrt(static_cast<double>(stations)))));
+
+        std::vector<Line> lines;
+        lines.reserve(stations);
+        if (hubs == 2)
+        {
+            lines.push_back({0, 1, true});
+        }
+        else if (hubs > 2)
+        {
+            for (std::uint32_t hub = 0; hub < hubs; ++hub)
+            {
+                lines.push_back({hub, (hub + 1) % hubs, true});
+            }
+        }
+        for (std::uint32_t spoke = hubs; spoke < stations; ++spoke)
+        {
+            lines.push_back({(spoke - hubs) % hubs, spoke, false});
+        }
+        return lines;
+    }
+
+    // Barabasi-Albert with two lines per new station, starting from a
+    // triangle.
+    std::vector<Line> scaleFreeLines(std::uint32_t stations, IRng& rng)
+    {
+        std::vector<Line>          lines;
+        std::vector<std::uint32_t> ends;  // Both stations of every line: a uniform pick favours busy ones
+        lines.reserve(2 * static_cast<std::size_t>(stations));
+        ends.reserve(4 * static_cast<std::size_t>(stations));
+
+        auto link = [&](std::uint32_t a, std::uint32_t b)
+        {
+            lines.push_back({a, b, false});
+            ends.push_back(a);
+            ends.push_back(b);
+        };
+
+        link(0, 1);
+        if (stations > 2)
+        {
+            link(1, 2);
+            link(0, 2);
+        }
+
+        for (std::uint32_t station = 3; station < stations; ++station)
+        {
+            const int           last   = static_cast<int>(ends.size()) - 1;
+            const std::uint32_t first  = ends[static_cast<std::size_t>(rng.getInt(0, last))];
+            std::uint32_t       second = first;
+            while (second == first)
+            {
+                second = ends[static_cast<std::size_t>(rng.getInt(0, last))];
+            }
+            link(first, station);
+            link(second, station);
+        }
+        return lines;
+    }
+
+    std::vector<Line> corridorLines(std::uint32_t stations)
+    {
+        std::vector<Line> lines;
+        lines.reserve(stations + stations / EXPRESS_SPAN);
+        for (std::uint32_t i = 1; i < stations; ++i)
+        {
+            lines.push_back({i - 1, i, false});
+        }
+        for (std::uint32_t i = 0; i + EXPRESS_SPAN < stations; i += EXPRESS_SPAN)
+        {
+            lines.push_back({i, i + EXPRESS_SPAN, true});
+        }
+        return lines;
+    }
+
+    Adjacency adjacencyOf(const std::vector<Line>& lines, std::uint32_t stations)
+    {
+        Adjacency adjacency;
+        adjacency.offsets.assign(static_cast<std::size_t>(stations) + 1, 0);
+        for (const Line& line : lines)
+        {
+            ++adjacency.offsets[line.a + 1];
+            ++adjacency.offsets[line.b + 1];
+        }
+        for (std::size_t i = 1; i < adjacency.offsets.size(); ++i)
+        {
+            adjacency.offsets[i] += adjacency.offsets[i - 1];
+        }
+
+        std::vector<std::uint32_t> next(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+        adjacency.stations.resize(adjacency.offsets.back());
+        for (const Line& line : lines)
+        {
+            adjacency.stations[next[line.a]++] = line.b;
+            adjacency.stations[next[line.b]++] = line.a;
+        }
+        return adjacency;
+    }
+
+    std::uint32_t randomNeighbour(const Adjacency& adjacency, std::uint32_t station, IRng& rng)
+    {
+        const std::uint32_t begin = adjacency.offsets[station];
+        const std::uint32_t end   = adjacency.offsets[station + 1];
+        return adjacency.stations[begin + static_cast<std::uint32_t>(rng.getInt(0, static_cast<int>(end - begin) - 1))];
+    }
+
+    void writeJunction(std::ostream& out, std::size_t index)
+    {
+        out << "RailNode" << index;
+    }
+}
+
+NetworkTopology ScenarioGenerator::parseTopology(const std::string& name)
+{
+    for (NetworkTopology topology : {NetworkTopology::Grid, NetworkTopology::HubAndSpoke,
+                                     NetworkTopology::ScaleFree, NetworkTopology::Corridor})
+    {
+        if (name == topologyName(topology))
+        {
+            return topology;
+        }
+    }
+    throw std::runtime_error("Unknown topology: '" + name + "' (must be grid, hub, scale-free or corridor)");
+}
+
+const char* ScenarioGenerator::topologyName(NetworkTopology topology)
+{
+    switch (topology)
+    {
+        case NetworkTopology::Grid:        return "grid";
+        case NetworkTopology::HubAndSpoke: return "hub";
+        case NetworkTopology::ScaleFree:   return "scale-free";
+        case NetworkTopology::Corridor:    return "corridor";
+    }
+    return "unknown";
+}
+
+ScenarioGenerator::ScenarioGenerator(const GeneratorSpec& spec)
+    : _spec(spec)
+{
+    // Scale-free picks line ends with IRng::getInt: four per station.
+    const std::size_t maxStations = static_cast<std::size_t>(std::numeric_limits<int>::max()) / 4;
+
+    if (_spec.stations < 2 || _spec.stations > maxStations)
+    {
+        throw std::runtime_error("Generator needs between 2 and " + std::to_string(maxStations) + " stations");
+    }
+    if (_spec.junctions > MAX_JUNCTIONS)
+    {
+        throw std::runtime_error("Generator allows at most " + std::to_string(MAX_JUNCTIONS) + " junctions per line");
+    }
+    if (_spec.trains == 0)
+    {
+        throw std::runtime_error("Generator needs at least one train");
+    }
+}
+
+ScenarioGenerator::Summary ScenarioGenerator::write(std::ostream& network, std::ostream& trains) const
+{
+    const auto        stations = static_cast<std::uint32_t>(_spec.stations);
+    const std::size_t chain    = _spec.junctions;
+    const std::string origin   = std::string("# railway_sim generate --topology=") + topologyName(_spec.topology)
+                               + " --stations=" + std::to_string(_spec.stations)
+                               + " --junctions=" + std::to_string(_spec.junctions)
+                               + " --trains=" + std::to_string(_spec.trains)
+                               + " --seed=" + std::to_string(_spec.seed) + "\n";
+
+    SeededRNG topologyRng(streamSeed(_spec.seed, 1));
+    SeededRNG railRng(streamSeed(_spec.seed, 2));
+    SeededRNG trainRng(streamSeed(_spec.seed, 3));
+
+    std::vector<Line> lines;
+    switch (_spec.topology)
+    {
+        case NetworkTopology::Grid:        lines = gridLines(stations);                   break;
+        case NetworkTopology::HubAndSpoke: lines = hubLines(stations);                    break;
+        case NetworkTopology::ScaleFree:   lines = scaleFreeLines(stations, topologyRng); break;
+        case NetworkTopology::Corridor:    lines = corridorLines(stations);               break;
+    }
+
+    Summary summary;
+    summary.stations  = stations;
+    summary.junctions = lines.size() * chain;
+    summary.rails     = lines.size() * (chain + 1);
+    summary.trains    = _spec.trains;
+
+    // Nodes first: rails may only name declared nodes.  Line l owns
+    // junctions l * chain .. l * chain + chain - 1, in order from a to b.
+    network << origin;
+    for (std::uint32_t station = 0; station < stations; ++station)
+    {
+        network << "Node City" << station << '\n';
+    }
+    for (std::size_t junction = 0; junction < summary.junctions; ++junction)
+    {
+        network << "Node ";
+        writeJunction(network, junction);
+        network << '\n';
+    }
+
+    char number[32];
+    for (std::size_t l = 0; l < lines.size(); ++l)
+    {
+        const Line&  line   = lines[l];
+        const double length = line.express ? railRng.getDouble(40.0, 120.0) : railRng.getDouble(8.0, 40.0);
+        const int    speed  = line.express ? railRng.getInt(20, 30) * 10 : railRng.getInt(8, 20) * 10;
+
+        std::snprintf(number, sizeof(number), "%.2f", length / static_cast<double>(chain + 1));
+
+        for (std::size_t k = 0; k <= chain; ++k)
+        {
+            network << "Rail ";
+            if (k == 0)
+            {
+                network << "City" << line.a;
+            }
+            else
+            {
+                writeJunction(network, l * chain + k - 1);
+            }
+            network << ' ';
+            if (k == chain)
+            {
+                network << "City" << line.b;
+            }
+            else
+            {
+                writeJunction(network, l * chain + k);
+            }
+            network << ' ' << number << ' ' << speed << '\n';
+        }
+    }
+
+    // Each train walks a few lines from its departure, so a route exists
+    // and journeys stay short whatever the network size.
+    const Adjacency adjacency = adjacencyOf(lines, stations);
+
+    trains << origin;
+    for (std::size_t train = 0; train < _spec.trains; ++train)
+    {
+        const auto    from = static_cast<std::uint32_t>(trainRng.getInt(0, static_cast<int>(stations) - 1));
+        const int     hops = trainRng.getInt(MIN_HOPS, MAX_HOPS);
+        std::uint32_t to   = from;
+        for (int hop = 0; hop < hops; ++hop)
+        {
+            to = randomNeighbour(adjacency, to, trainRng);
+        }
+        if (to == from)
+        {
+            to = randomNeighbour(adjacency, from, trainRng);
+        }
+
+        const int mass      = trainRng.getInt(60, 200);
+        const int friction  = trainRng.getInt(3, 8);
+        const int accel     = trainRng.getInt(20, 50) * 10;
+        const int brake     = trainRng.getInt(30, 60);
+        const int departure = trainRng.getInt(5 * 60, 22 * 60);
+        const int stop      = trainRng.getInt(1, 10);
+
+        std::snprintf(number, sizeof(number), "0.%02d", friction);
+        trains << "Train" << train << ' ' << mass << ' ' << number << ' ' << accel << ".0 " << brake << ".0"
+               << " City" << from << " City" << to << ' '
+               << Time(departure / 60, departure % 60).toString() << ' ' << Time(0, stop).toString() << '\n';
+    }
+
+    return summary;
+}
+
+ScenarioGenerator::Summary ScenarioGenerator::writeFiles(const std::string& networkFile,
+                                                         const std::string& trainFile) const
+{
+    std::ofstream network(networkFile, std::ios::trunc);
+    if (!network.is_open())
+    {
+        throw std::runtime_error("Cannot open output file: " + networkFile);
+    }
+    std::ofstream trains(trainFile, std::ios::trunc);
+    if (!trains.is_open())
+    {
+        throw std::runtime_error("Cannot open output file: " + trainFile);
+    }
+
+    const Summary summary = write(network, trains);
+
+    network.flush();
+    trains.flush();
+    if (!network)
+    {
+        throw std::runtime_error("Failed to write file: " + networkFile);
+    }
+    if (!trains)
+    {
+        throw std::runtime_error("Failed to write file: " + trainFile);
+    }
+    return summary;
+}
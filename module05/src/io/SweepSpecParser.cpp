@@ -0,0 +1,107 @@
+#include "io/SweepSpecParser.hpp"
+#include "utils/StringUtils.hpp"
+#include <array>
+#include <stdexcept>
+
+SweepSpecParser::SweepSpecParser(const std::string& filepath)
+    : FileParser(filepath)
+{
+}
+
+SweepSpec SweepSpecParser::parse()
+{
+    SweepSpec        spec;
+    std::string_view line;
+
+    while (nextLine(line))
+    {
+        try
+        {
+            parseLine(line, spec);
+        }
+        catch (const std::exception& e)
+        {
+            throwLineError(e.what(), line);
+        }
+    }
+
+    if (spec.getParameters().empty())
+    {
+        throw std::runtime_error("Sweep file declares no parameters: " + _filepath);
+    }
+
+    if (spec.getDesign() == SweepSpec::Design::LatinHypercube && spec.getSamples() == 0)
+    {
+        throw std::runtime_error("Latin hypercube sweep requires 'samples <N>': " + _filepath);
+    }
+
+    return spec;
+}
+
+void SweepSpecParser::parseLine(std::string_view line, SweepSpec& spec)
+{
+    std::array<std::string_view, 5> tokens;
+    std::size_t                     count   = StringUtils::splitTokens(line, tokens);
+    const std::string               keyword(tokens[0]);
+
+    if (keyword == "design")
+    {
+        if (count != 2 || (tokens[1] != "grid" && tokens[1] != "lhs"))
+        {
+            throw std::runtime_error("Invalid design. Expected: design grid|lhs");
+        }
+        spec.setDesign(tokens[1] == "lhs" ? SweepSpec::Design::LatinHypercube
+                                          : SweepSpec::Design::Grid);
+    }
+    else if (keyword == "samples" || keyword == "runs")
+    {
+        if (count != 2)
+        {
+            throw std::runtime_error("Invalid format. Expected: " + keyword + " <N>");
+        }
+
+        unsigned int count = parseCount(tokens[1], keyword);
+        if (keyword == "samples")
+        {
+            spec.setSamples(count);
+        }
+        else
+        {
+            spec.setRunsPerPoint(count);
+        }
+    }
+    else if (keyword == "param")
+    {
+        if (count != 4 && count != 5)
+        {
+            throw std::runtime_error("Invalid param format. Expected: param <name> <min> <max> [levels]");
+        }
+
+        SweepParameter parameter;
+        parameter.name   = std::string(tokens[1]);
+        parameter.min    = StringUtils::parseDouble(tokens[2], "min");
+        parameter.max    = StringUtils::parseDouble(tokens[3], "max");
+        parameter.levels = (count == 5) ? parseCount(tokens[4], "levels") : 2;
+
+        if (parameter.min == parameter.max)
+        {
+            parameter.levels = 1;
+        }
+
+        spec.addParameter(parameter);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown keyword '" + keyword + "' (expected design, samples, runs or param)");
+    }
+}
+
+unsigned int SweepSpecParser::parseCount(std::string_view token, const std::string& fieldName) const
+{
+    double value = StringUtils::parseDouble(token, fieldName);
+    if (value < 1.0 || value > 1e9 || value != static_cast<double>(static_cast<unsigned int>(value)))
+    {
+        throw std::runtime_error("'" + fieldName + "' must be a positive integer: '" + std::string(token) + "'");
+    }
+    return static_cast<unsigned int>(value);
+}
@@ -0,0 +1,473 @@
+#include "io/TraceFile.hpp"
+#include "io/AsyncResultSink.hpp"
+#include "utils/BinaryCodec.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char        MAGIC[8]       = {'R', 'S', 'I', 'M', 'T', 'R', 'C', '1'};
+    constexpr char        END_MAGIC[8]   = {'R', 'S', 'I', 'M', 'T', 'R', 'C', 'E'};
+    constexpr std::size_t HEADER_SIZE    = sizeof(MAGIC) + 4 + 4;
+    constexpr std::size_t TRAILER_SIZE   = 8 + sizeof(END_MAGIC);
+    constexpr std::size_t CHUNK_HEADER   = 4 + 4;
+    constexpr std::uint8_t KIND_TEXT     = 1;
+    constexpr std::uint8_t KIND_SNAPSHOT = 2;
+}
+
+// ----------------------------------------------------------------------------
+// TraceWriter
+// ----------------------------------------------------------------------------
+
+TraceWriter::TraceWriter(const std::string& path)
+    : _path(path),
+      _fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+      _offset(0),
+      _chunkRecords(0)
+{
+    if (_fd < 0)
+    {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    BinaryCodec::put(header, VERSION);
+    BinaryCodec::put(header, static_cast<std::uint32_t>(0));
+
+    try
+    {
+        writeAll(header.data(), header.size());
+    }
+    catch (...)
+    {
+        ::close(_fd);
+        throw;
+    }
+
+    _chunk.reserve(CHUNK_BYTES + 4096);
+}
+
+TraceWriter::~TraceWriter()
+{
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+    }
+}
+
+void TraceWriter::prepare(const std::string&)
+{
+    // Nothing per train: the trace file was created up front.
+}
+
+void TraceWriter::open(std::uint32_t file, const std::string& path)
+{
+    if (file >= _trains.size())
+    {
+        _trains.resize(file + 1);
+    }
+    _trains[file].path = path;
+}
+
+void TraceWriter::text(std::uint32_t file, const std::string& text)
+{
+    appendRecord(KIND_TEXT, file, text);
+}
+
+void TraceWriter::snapshot(std::uint32_t file, const ResultSnapshot& snapshot)
+{
+    TrainState& state = train(file);
+
+    // First snapshot of this train in the chunk: deltas start from zero.
+    const std::uint32_t chunk = static_cast<std::uint32_t>(_chunkOffsets.size());
+    if (state.deltaChunk != chunk)
+    {
+        state.deltaChunk = chunk;
+        state.time = state.remaining = state.velocity = 0;
+    }
+
+    _body.clear();
+    BinaryCodec::putDelta(_body, snapshot.timeSeconds, state.time);
+    BinaryCodec::putVarint(_body, snapshot.from ? intern(*snapshot.from) + 1u : 0u);
+    BinaryCodec::putVarint(_body, snapshot.to   ? intern(*snapshot.to)   + 1u : 0u);
+    BinaryCodec::putDelta(_body, snapshot.remainingKm, state.remaining);
+    BinaryCodec::putDelta(_body, snapshot.velocityKmh, state.velocity);
+    BinaryCodec::putVarint(_body, intern(std::string_view(snapshot.status, ::strnlen(snapshot.status, sizeof(snapshot.status)))));
+    BinaryCodec::putSigned(_body, snapshot.cellCount);
+    BinaryCodec::putSigned(_body, snapshot.trainCell);
+    BinaryCodec::putSigned(_body, snapshot.otherCount);
+
+    const std::int32_t others = std::min<std::int32_t>(std::max(snapshot.otherCount, 0),
+                                                       static_cast<std::int32_t>(ResultSnapshot::MAX_OTHERS));
+    for (std::int32_t i = 0; i < others; ++i)
+    {
+        BinaryCodec::putSigned(_body, snapshot.otherCells[i]);
+    }
+
+    appendRecord(KIND_SNAPSHOT, file, _body);
+}
+
+void TraceWriter::close(std::uint32_t file)
+{
+    train(file);  // Nothing to release; only checks the handle
+}
+
+void TraceWriter::flush()
+{
+    sealChunk();
+}
+
+void TraceWriter::finish()
+{
+    if (_fd < 0)
+    {
+        return;
+    }
+
+    sealChunk();
+
+    std::string footer;
+
+    BinaryCodec::put(footer, static_cast<std::uint32_t>(_strings.size()));
+    for (const std::string& text : _strings)
+    {
+        BinaryCodec::put(footer, static_cast<std::uint32_t>(text.size()));
+        footer += text;
+    }
+
+    BinaryCodec::put(footer, static_cast<std::uint32_t>(_chunkOffsets.size()));
+    for (std::uint64_t offset : _chunkOffsets)
+    {
+        BinaryCodec::put(footer, offset);
+    }
+
+    BinaryCodec::put(footer, static_cast<std::uint32_t>(_trains.size()));
+    for (const TrainState& state : _trains)
+    {
+        BinaryCodec::put(footer, static_cast<std::uint32_t>(state.path.size()));
+        footer += state.path;
+        BinaryCodec::put(footer, state.records);
+        BinaryCodec::put(footer, static_cast<std::uint32_t>(state.chunks.size()));
+        for (std::uint32_t chunk : state.chunks)
+        {
+            BinaryCodec::put(footer, chunk);
+        }
+    }
+
+    BinaryCodec::put(footer, _offset);
+    footer.append(END_MAGIC, sizeof(END_MAGIC));
+
+    writeAll(footer.data(), footer.size());
+
+    ::close(_fd);
+    _fd = -1;
+}
+
+TraceWriter::TrainState& TraceWriter::train(std::uint32_t file)
+{
+    if (file >= _trains.size())
+    {
+        throw std::runtime_error("Unknown trace train handle " + std::to_string(file));
+    }
+    return _trains[file];
+}
+
+std::uint32_t TraceWriter::intern(std::string_view text)
+{
+    _lookup.assign(text.data(), text.size());
+
+    auto it = _stringIds.find(_lookup);
+    if (it != _stringIds.end())
+    {
+        return it->second;
+    }
+
+    const std::uint32_t id = static_cast<std::uint32_t>(_strings.size());
+    _stringIds.emplace(_lookup, id);
+    _strings.push_back(_lookup);
+    return id;
+}
+
+void TraceWriter::appendRecord(std::uint8_t kind, std::uint32_t file, std::string_view body)
+{
+    TrainState&         state = train(file);
+    const std::uint32_t chunk = static_cast<std::uint32_t>(_chunkOffsets.size());
+
+    if (state.lastChunk != chunk)
+    {
+        state.lastChunk = chunk;
+        state.chunks.push_back(chunk);
+    }
+    ++state.records;
+
+    _chunk += static_cast<char>(kind);
+    BinaryCodec::putVarint(_chunk, file);
+    BinaryCodec::putVarint(_chunk, body.size());
+    _chunk.append(body.data(), body.size());
+    ++_chunkRecords;
+
+    if (_chunk.size() >= CHUNK_BYTES)
+    {
+        sealChunk();
+    }
+}
+
+void TraceWriter::sealChunk()
+{
+    if (_chunkRecords == 0)
+    {
+        return;
+    }
+
+    std::string header;
+    BinaryCodec::put(header, static_cast<std::uint32_t>(_chunk.size()));
+    BinaryCodec::put(header, _chunkRecords);
+
+    _chunkOffsets.push_back(_offset);
+    writeAll(header.data(), header.size());
+    writeAll(_chunk.data(), _chunk.size());
+
+    _chunk.clear();
+    _chunkRecords = 0;
+}
+
+void TraceWriter::writeAll(const char* data, std::size_t size)
+{
+    _offset += size;
+
+    while (size > 0)
+    {
+        const ssize_t written = ::write(_fd, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("Failed to write trace file: " + _path);
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// TraceReader
+// ----------------------------------------------------------------------------
+
+TraceReader::TraceReader(const std::string& path)
+    : _file(path),
+      _path(path)
+{
+    const std::string_view bytes = _file.view();
+
+    try
+    {
+        if (!isTrace(bytes) || bytes.size() < HEADER_SIZE + TRAILER_SIZE)
+        {
+            throw std::runtime_error("not a trace file");
+        }
+
+        BinaryCodec::Reader header(bytes.substr(sizeof(MAGIC), HEADER_SIZE - sizeof(MAGIC)));
+        const std::uint32_t version = header.get<std::uint32_t>();
+        if (version != TraceWriter::VERSION)
+        {
+            throw std::runtime_error("unsupported version " + std::to_string(version) +
+                                     " (expected " + std::to_string(TraceWriter::VERSION) + ")");
+        }
+
+        const std::string_view trailer = bytes.substr(bytes.size() - TRAILER_SIZE);
+        if (std::memcmp(trailer.data() + 8, END_MAGIC, sizeof(END_MAGIC)) != 0)
+        {
+            throw std::runtime_error("missing index footer (the run did not finish)");
+        }
+
+        std::uint64_t footerOffset;
+        std::memcpy(&footerOffset, trailer.data(), sizeof(footerOffset));
+        if (footerOffset < HEADER_SIZE || footerOffset > bytes.size() - TRAILER_SIZE)
+        {
+            throw std::runtime_error("bad footer offset");
+        }
+
+        BinaryCodec::Reader footer(bytes.substr(footerOffset, bytes.size() - TRAILER_SIZE - footerOffset));
+
+        const std::uint32_t stringCount = footer.get<std::uint32_t>();
+        for (std::uint32_t i = 0; i < stringCount; ++i)
+        {
+            _strings.push_back(footer.string());
+        }
+
+        const std::uint32_t chunkCount = footer.get<std::uint32_t>();
+        for (std::uint32_t i = 0; i < chunkCount; ++i)
+        {
+            const std::uint64_t offset = footer.get<std::uint64_t>();
+            if (offset < HEADER_SIZE || offset > footerOffset - CHUNK_HEADER)
+            {
+                throw std::runtime_error("bad chunk offset");
+            }
+
+            BinaryCodec::Reader chunk(bytes.substr(offset, footerOffset - offset));
+            const std::uint32_t size = chunk.get<std::uint32_t>();
+            chunk.get<std::uint32_t>();
+            _chunks.push_back(chunk.take(size));
+        }
+
+        const std::uint32_t trainCount = footer.get<std::uint32_t>();
+        for (std::uint32_t i = 0; i < trainCount; ++i)
+        {
+            Train train;
+            train.path    = std::string(footer.string());
+            train.records = footer.get<std::uint32_t>();
+
+            const std::uint32_t chunks = footer.get<std::uint32_t>();
+            for (std::uint32_t c = 0; c < chunks; ++c)
+            {
+                const std::uint32_t chunk = footer.get<std::uint32_t>();
+                if (chunk >= _chunks.size())
+                {
+                    throw std::runtime_error("bad chunk index");
+                }
+                train.chunks.push_back(chunk);
+            }
+
+            const std::size_t slash = train.path.find_last_of('/');
+            train.label = train.path.substr(slash == std::string::npos ? 0 : slash + 1);
+            if (train.label.size() > 7 && train.label.compare(train.label.size() - 7, 7, ".result") == 0)
+            {
+                train.label.resize(train.label.size() - 7);
+            }
+
+            _trains.push_back(std::move(train));
+        }
+
+        if (!footer.atEnd())
+        {
+            throw std::runtime_error("trailing footer bytes");
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        corrupt(e.what());
+    }
+}
+
+bool TraceReader::isTrace(std::string_view bytes)
+{
+    return bytes.size() >= sizeof(MAGIC) && std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+const std::vector<TraceReader::Train>& TraceReader::getTrains() const
+{
+    return _trains;
+}
+
+std::vector<std::size_t> TraceReader::findTrains(const std::string& query) const
+{
+    std::vector<std::size_t> matches;
+
+    for (std::size_t i = 0; i < _trains.size(); ++i)
+    {
+        const std::string& label = _trains[i].label;
+
+        // <name>_<HHhMM>
+        const bool byName = label.size() == query.size() + 6
+                         && label[query.size()] == '_'
+                         && label.compare(0, query.size(), query) == 0;
+
+        if (label == query || byName)
+        {
+            matches.push_back(i);
+        }
+    }
+
+    return matches;
+}
+
+void TraceReader::render(std::size_t train, std::string& out) const
+{
+    const Train& entry = _trains.at(train);
+
+    try
+    {
+        for (std::uint32_t chunk : entry.chunks)
+        {
+            BinaryCodec::Reader records(_chunks[chunk]);
+            std::uint64_t       time      = 0;
+            std::uint64_t       remaining = 0;
+            std::uint64_t       velocity  = 0;
+
+            while (!records.atEnd())
+            {
+                const std::uint8_t     kind = records.get<std::uint8_t>();
+                const std::uint64_t    file = records.varint();
+                const std::string_view body = records.take(records.varint());
+
+                if (file != train)
+                {
+                    continue;
+                }
+
+                if (kind == KIND_TEXT)
+                {
+                    out.append(body.data(), body.size());
+                    continue;
+                }
+                if (kind != KIND_SNAPSHOT)
+                {
+                    throw std::runtime_error("unknown record kind " + std::to_string(kind));
+                }
+
+                BinaryCodec::Reader fields(body);
+                ResultSnapshot      snapshot;
+
+                snapshot.timeSeconds = fields.delta(time);
+                const std::uint64_t from = fields.varint();
+                const std::uint64_t to   = fields.varint();
+                snapshot.remainingKm = fields.delta(remaining);
+                snapshot.velocityKmh = fields.delta(velocity);
+
+                const std::string_view status = string(fields.varint());
+                status.copy(snapshot.status, std::min(status.size(), sizeof(snapshot.status) - 1));
+
+                snapshot.cellCount  = fields.signedVarint();
+                snapshot.trainCell  = fields.signedVarint();
+                snapshot.otherCount = fields.signedVarint();
+
+                const std::int32_t others = std::min<std::int32_t>(std::max(snapshot.otherCount, 0),
+                                                                   static_cast<std::int32_t>(ResultSnapshot::MAX_OTHERS));
+                for (std::int32_t i = 0; i < others; ++i)
+                {
+                    snapshot.otherCells[i] = fields.signedVarint();
+                }
+
+                AsyncResultSink::appendSnapshot(out, snapshot,
+                                                from ? string(from - 1) : std::string_view(),
+                                                to   ? string(to - 1)   : std::string_view());
+            }
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        corrupt(e.what());
+    }
+}
+
+void TraceReader::corrupt(const std::string& reason) const
+{
+    throw std::runtime_error("Corrupt trace file '" + _path + "': " + reason);
+}
+
+std::string_view TraceReader::string(std::uint64_t id) const
+{
+    if (id >= _strings.size())
+    {
+        throw std::runtime_error("bad string id");
+    }
+    return _strings[id];
+}
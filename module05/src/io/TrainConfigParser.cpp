@@ -1,27 +1,82 @@
 #include "io/TrainConfigParser.hpp"
+#include "io/CompiledScenario.hpp"
 #include "utils/StringUtils.hpp"
 #include "utils/Time.hpp"
-#include <sstream>
+#include <array>
 #include <stdexcept>
-#include <set>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+namespace
+{
+    // One line-aligned slice of the train file and what its worker produced.
+    struct Chunk
+    {
+        std::string_view                      text;
+        int                                   lines     = 0;  // Physical lines in text
+        int                                   firstLine = 0;  // Lines before text
+        std::size_t                           count     = 0;  // Train lines in text
+        std::size_t                           offset    = 0;  // First result index
+        std::vector<std::vector<std::size_t>> shards;         // Result indices by name-hash shard
+        std::string                           error;          // First parse error, formatted
+    };
+
+    // Runs task(0 .. count-1), one std::thread per index.
+    void runParallel(unsigned int count, const std::function<void(unsigned int)>& task)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            workers.emplace_back(task, i);
+        }
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
 
 TrainConfigParser::TrainConfigParser(const std::string& filepath)
-    : FileParser(filepath)
+    : FileParser(filepath),
+      _threads(std::max(std::thread::hardware_concurrency(), 1u))
 {
 }
 
+void TrainConfigParser::setThreads(unsigned int threads)
+{
+    _threads = std::max(threads, 1u);
+}
+
 std::vector<TrainConfig> TrainConfigParser::parse()
 {
+    if (CompiledScenario::isCompiled(_file.view()))
+    {
+        return parseCompiled();
+    }
+
+    if (_threads > 1 && _file.size() >= PARALLEL_MIN_BYTES)
+    {
+        return parseParallel(_threads);
+    }
+
     std::vector<TrainConfig> configs;
-    std::vector<std::string> lines = readLines();
+    std::string_view         line;
 
-    for (const auto& line : lines)
+    // One line per train: size the result once instead of regrowing it.
+    const std::string_view text = _file.view();
+    configs.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+
+    while (nextLine(line))
     {
-        _lineNumber++;
         try
         {
-            TrainConfig config = parseLine(line);
-            configs.push_back(config);
+            configs.push_back(parseLine(line));
         }
         catch (const std::exception& e)
         {
@@ -34,9 +89,144 @@ std::vector<TrainConfig> TrainConfigParser::parse()
     return configs;
 }
 
+// Three passes, each spread over all workers:
+//   1. every chunk counts its train lines, fixing each chunk's offset in the
+//      result and its first line number;
+//   2. every chunk parses straight into its slice of the result, bucketing
+//      each name's index by hash;
+//   3. every hash shard checks its own names for duplicates.
+// The first parse error and the first repeated name, in file order, are
+// reported exactly as the sequential parse would report them.
+std::vector<TrainConfig> TrainConfigParser::parseParallel(unsigned int chunkCount)
+{
+    const std::string_view text = _file.view();
+    std::vector<Chunk>     chunks(chunkCount);
+
+    std::size_t begin = 0;
+    for (unsigned int c = 0; c < chunkCount; ++c)
+    {
+        std::size_t end = (c + 1 == chunkCount) ? text.size() : text.size() / chunkCount * (c + 1);
+
+        if (end < begin)
+        {
+            end = begin;
+        }
+        if (end < text.size())
+        {
+            const std::size_t newline = text.find('\n', end);
+            end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+        }
+
+        chunks[c].text = text.substr(begin, end - begin);
+        begin          = end;
+    }
+
+    runParallel(chunkCount, [&](unsigned int c)
+    {
+        std::size_t      cursor = 0;
+        std::string_view line;
+
+        while (nextLine(chunks[c].text, cursor, chunks[c].lines, line))
+        {
+            ++chunks[c].count;
+        }
+    });
+
+    for (unsigned int c = 1; c < chunkCount; ++c)
+    {
+        chunks[c].offset    = chunks[c - 1].offset + chunks[c - 1].count;
+        chunks[c].firstLine = chunks[c - 1].firstLine + chunks[c - 1].lines;
+    }
+
+    std::vector<TrainConfig> configs(chunks.back().offset + chunks.back().count);
+
+    runParallel(chunkCount, [&](unsigned int c)
+    {
+        Chunk&                      chunk  = chunks[c];
+        std::hash<std::string_view> hasher;
+        std::size_t                 cursor = 0;
+        int                         lineNo = chunk.firstLine;
+        std::size_t                 index  = chunk.offset;
+        std::string_view            line;
+
+        chunk.shards.resize(chunkCount);
+
+        while (nextLine(chunk.text, cursor, lineNo, line))
+        {
+            try
+            {
+                configs[index] = parseLine(line);
+            }
+            catch (const std::exception& e)
+            {
+                chunk.error = formatLineError(lineNo, e.what(), line);
+                return;
+            }
+
+            chunk.shards[hasher(configs[index].name) % chunkCount].push_back(index);
+            ++index;
+        }
+    });
+
+    for (const Chunk& chunk : chunks)
+    {
+        if (!chunk.error.empty())
+        {
+            throw std::runtime_error(chunk.error);
+        }
+    }
+
+    // Each shard owns a disjoint set of names, so its first repeat (scanning
+    // chunks in order) is its earliest; the global first is the smallest.
+    std::vector<std::size_t> firstRepeat(chunkCount, configs.size());
+
+    runParallel(chunkCount, [&](unsigned int shard)
+    {
+        std::unordered_set<std::string_view> seen;
+        seen.reserve(configs.size() / chunkCount + 1);
+
+        for (const Chunk& chunk : chunks)
+        {
+            for (std::size_t index : chunk.shards[shard])
+            {
+                if (!seen.insert(configs[index].name).second)
+                {
+                    firstRepeat[shard] = index;
+                    return;
+                }
+            }
+        }
+    });
+
+    const std::size_t repeat = *std::min_element(firstRepeat.begin(), firstRepeat.end());
+    if (repeat < configs.size())
+    {
+        throw std::runtime_error(
+            "Duplicate train name detected: '" + configs[repeat].name + "'");
+    }
+
+    return configs;
+}
+
+std::vector<TrainConfig> TrainConfigParser::parseCompiled()
+{
+    CompiledScenario compiled(_file.view(), _filepath);
+
+    const CompiledScenario::Source& source = compiled.getTrainSource();
+    if (CompiledScenario::isStale(source))
+    {
+        _staleSource = source.path;
+        return TrainConfigParser(source.path).parse();
+    }
+
+    return compiled.buildTrains();
+}
+
 void TrainConfigParser::validateUniqueNames(const std::vector<TrainConfig>& configs) const
 {
-    std::set<std::string> seenNames;
+    // Views into configs: no per-name copy.
+    std::unordered_set<std::string_view> seenNames;
+    seenNames.reserve(configs.size());
 
     for (const auto& config : configs)
     {
@@ -48,11 +238,11 @@ void TrainConfigParser::validateUniqueNames(const std::vector<TrainConfig>& conf
     }
 }
 
-TrainConfig TrainConfigParser::parseLine(const std::string& line)
+TrainConfig TrainConfigParser::parseLine(std::string_view line)
 {
-    auto tokens = StringUtils::splitTokens(line);
+    std::array<std::string_view, 9> tokens;
 
-    if (tokens.size() != 9)
+    if (StringUtils::splitTokens(line, tokens) != 9)
     {
         throw std::runtime_error(
             "Invalid train format. Expected 9 fields: "
@@ -62,7 +252,7 @@ TrainConfig TrainConfigParser::parseLine(const std::string& line)
 
     TrainConfig config;
 
-    config.name = tokens[0];
+    config.name = std::string(tokens[0]);
 
     try
     {
@@ -96,8 +286,8 @@ TrainConfig TrainConfigParser::parseLine(const std::string& line)
         throw std::runtime_error("Maximum brake force must be positive");
     }
 
-    config.departureStation = tokens[5];
-    config.arrivalStation   = tokens[6];
+    config.departureStation = std::string(tokens[5]);
+    config.arrivalStation   = std::string(tokens[6]);
 
     if (config.departureStation.empty() || config.arrivalStation.empty())
     {
@@ -113,7 +303,7 @@ TrainConfig TrainConfigParser::parseLine(const std::string& line)
     if (!config.departureTime.isValid())
     {
         throw std::runtime_error(
-            "Invalid departure time format '" + tokens[7] +
+            "Invalid departure time format '" + std::string(tokens[7]) +
             "'. Expected HHhMM (e.g., 14h10)");
     }
 
@@ -121,7 +311,7 @@ TrainConfig TrainConfigParser::parseLine(const std::string& line)
     if (!config.stopDuration.isValid())
     {
         throw std::runtime_error(
-            "Invalid stop duration format '" + tokens[8] +
+            "Invalid stop duration format '" + std::string(tokens[8]) +
             "'. Expected HHhMM (e.g., 00h10)");
     }
 
@@ -0,0 +1,364 @@
+#include "patterns/behavioral/command/CommandLog.hpp"
+#include "patterns/behavioral/command/CommandManager.hpp"
+#include "utils/BinaryCodec.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char         MAGIC[8]      = {'R', 'S', 'I', 'M', 'C', 'M', 'D', '1'};
+    constexpr char         END_MAGIC[8]  = {'R', 'S', 'I', 'M', 'C', 'M', 'D', 'E'};
+    constexpr std::size_t  HEADER_SIZE   = sizeof(MAGIC) + 4 + 4;
+    constexpr std::size_t  CHUNK_HEADER  = 4 + 4;
+    constexpr std::uint8_t KIND_STRING   = 0;
+    constexpr std::uint8_t KIND_KEYFRAME = 5;
+
+    std::string_view lookup(const std::vector<std::string_view>& strings, std::uint32_t id)
+    {
+        if (id >= strings.size())
+        {
+            throw std::runtime_error("bad string id " + std::to_string(id));
+        }
+        return strings[id];
+    }
+}
+
+// ----------------------------------------------------------------------------
+// CommandLogWriter
+// ----------------------------------------------------------------------------
+
+CommandLogWriter::CommandLogWriter(const std::string& path)
+    : _path(path),
+      _fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+      _chunkRecords(0),
+      _commands(0),
+      _lastTime(0)
+{
+    if (_fd < 0)
+    {
+        throw std::runtime_error("Failed to open command log: " + path);
+    }
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    BinaryCodec::put(header, VERSION);
+    BinaryCodec::put(header, static_cast<std::uint32_t>(0));
+
+    try
+    {
+        writeAll(header.data(), header.size());
+    }
+    catch (...)
+    {
+        ::close(_fd);
+        throw;
+    }
+
+    _stringIds.emplace("", 0);
+    _chunk.reserve(CHUNK_BYTES + 4096);
+}
+
+CommandLogWriter::~CommandLogWriter()
+{
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+    }
+}
+
+void CommandLogWriter::append(const CommandRecord& record)
+{
+    std::uint32_t ids[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        ids[i] = intern(record.text[i]);
+    }
+
+    _chunk += static_cast<char>(record.kind);
+    BinaryCodec::putDelta(_chunk, record.timestamp, _lastTime);
+    BinaryCodec::put(_chunk, ids[0]);
+    BinaryCodec::put(_chunk, ids[1]);
+    BinaryCodec::put(_chunk, ids[2]);
+    BinaryCodec::put(_chunk, record.index);
+
+    ++_commands;
+    endRecord();
+}
+
+void CommandLogWriter::append(const ReplayKeyframe& keyframe)
+{
+    for (const TrainKeyframe& train : keyframe.trains)
+    {
+        intern(train.name);
+        intern(train.state);
+        intern(train.departureStation);
+    }
+
+    _chunk += static_cast<char>(KIND_KEYFRAME);
+    BinaryCodec::put(_chunk, keyframe.time);
+    BinaryCodec::putVarint(_chunk, keyframe.trains.size());
+
+    for (const TrainKeyframe& train : keyframe.trains)
+    {
+        BinaryCodec::put(_chunk, intern(train.name));
+        BinaryCodec::put(_chunk, intern(train.state));
+        BinaryCodec::put(_chunk, intern(train.departureStation));
+        BinaryCodec::put(_chunk, static_cast<std::uint32_t>(train.railIndex));
+        BinaryCodec::put(_chunk, train.position);
+        BinaryCodec::put(_chunk, train.velocity);
+        BinaryCodec::put(_chunk, train.stopSeconds);
+        BinaryCodec::put(_chunk, static_cast<std::uint8_t>(train.finished ? 1 : 0));
+    }
+
+    endRecord();
+}
+
+void CommandLogWriter::finish(const RecordingMetadata& meta)
+{
+    if (_fd < 0)
+    {
+        return;
+    }
+
+    sealChunk();
+
+    std::string tail;
+    BinaryCodec::put(tail, static_cast<std::uint32_t>(0));
+    BinaryCodec::putString(tail, meta.networkFile);
+    BinaryCodec::putString(tail, meta.trainFile);
+    BinaryCodec::put(tail, static_cast<std::uint32_t>(meta.seed));
+    BinaryCodec::put(tail, meta.stopTime);
+    BinaryCodec::put(tail, _commands);
+    tail.append(END_MAGIC, sizeof(END_MAGIC));
+    writeAll(tail.data(), tail.size());
+
+    const int fd = _fd;
+    _fd = -1;
+    if (::close(fd) != 0)
+    {
+        throw std::runtime_error("Failed to write command log: " + _path);
+    }
+}
+
+const std::string& CommandLogWriter::getPath() const
+{
+    return _path;
+}
+
+std::uint64_t CommandLogWriter::commandCount() const
+{
+    return _commands;
+}
+
+std::uint32_t CommandLogWriter::intern(std::string_view text)
+{
+    _lookup.assign(text.data(), text.size());
+
+    auto it = _stringIds.find(_lookup);
+    if (it != _stringIds.end())
+    {
+        return it->second;
+    }
+
+    // Defined in the stream just ahead of the record that first uses it.
+    const std::uint32_t id = static_cast<std::uint32_t>(_stringIds.size());
+    _stringIds.emplace(_lookup, id);
+
+    _chunk += static_cast<char>(KIND_STRING);
+    BinaryCodec::putVarint(_chunk, text.size());
+    _chunk.append(text.data(), text.size());
+    ++_chunkRecords;
+    return id;
+}
+
+void CommandLogWriter::endRecord()
+{
+    ++_chunkRecords;
+
+    if (_chunk.size() >= CHUNK_BYTES)
+    {
+        sealChunk();
+    }
+}
+
+void CommandLogWriter::sealChunk()
+{
+    if (_chunkRecords == 0)
+    {
+        return;
+    }
+
+    std::string header;
+    BinaryCodec::put(header, static_cast<std::uint32_t>(_chunk.size()));
+    BinaryCodec::put(header, _chunkRecords);
+
+    writeAll(header.data(), header.size());
+    writeAll(_chunk.data(), _chunk.size());
+
+    _chunk.clear();
+    _chunkRecords = 0;
+}
+
+void CommandLogWriter::writeAll(const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t written = ::write(_fd, data, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("Failed to write command log: " + _path);
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// CommandLogReader
+// ----------------------------------------------------------------------------
+
+CommandLogReader::CommandLogReader(const std::string& path)
+    : _file(path),
+      _path(path)
+{
+    const std::string_view bytes = _file.view();
+
+    try
+    {
+        if (!isCommandLog(bytes))
+        {
+            throw std::runtime_error("not a command log");
+        }
+
+        BinaryCodec::Reader cursor(bytes.substr(sizeof(MAGIC)));
+        const std::uint32_t version = cursor.get<std::uint32_t>();
+        cursor.get<std::uint32_t>();
+
+        if (version != CommandLogWriter::VERSION)
+        {
+            throw std::runtime_error("unsupported version " + std::to_string(version));
+        }
+
+        for (;;)
+        {
+            const std::uint32_t size = cursor.get<std::uint32_t>();
+            if (size == 0)
+            {
+                break;
+            }
+
+            cursor.get<std::uint32_t>();
+            _chunks.push_back(cursor.take(size));
+        }
+
+        // Metadata, then the end marker and nothing after it.
+        const std::size_t start = sizeof(MAGIC) + cursor.position();
+        cursor.string();
+        cursor.string();
+        cursor.take(4 + 8 + 8);
+        _metadata = bytes.substr(start, sizeof(MAGIC) + cursor.position() - start);
+
+        if (std::memcmp(cursor.take(sizeof(END_MAGIC)).data(), END_MAGIC, sizeof(END_MAGIC)) != 0 ||
+            !cursor.atEnd())
+        {
+            throw std::runtime_error("bad end marker");
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        corrupt(e.what());
+    }
+}
+
+bool CommandLogReader::isCommandLog(std::string_view bytes)
+{
+    return bytes.size() >= HEADER_SIZE && bytes.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void CommandLogReader::read(RecordingMetadata&                                meta,
+                            const std::function<void(const CommandRecord&)>&  onCommand,
+                            const std::function<void(const ReplayKeyframe&)>& onKeyframe) const
+{
+    try
+    {
+        BinaryCodec::Reader tail(_metadata);
+        meta.networkFile = std::string(tail.string());
+        meta.trainFile   = std::string(tail.string());
+        meta.seed        = tail.get<std::uint32_t>();
+        meta.stopTime    = tail.get<double>();
+
+        std::vector<std::string_view> strings{std::string_view()};
+        std::uint64_t                 lastTime = 0;
+        CommandRecord                 record;
+        ReplayKeyframe                keyframe;
+
+        for (std::string_view chunk : _chunks)
+        {
+            BinaryCodec::Reader cursor(chunk);
+
+            while (!cursor.atEnd())
+            {
+                const std::uint8_t kind = cursor.get<std::uint8_t>();
+
+                if (kind == KIND_STRING)
+                {
+                    strings.push_back(cursor.take(cursor.varint()));
+                }
+                else if (kind >= static_cast<std::uint8_t>(CommandRecord::Kind::Departure) &&
+                         kind <= static_cast<std::uint8_t>(CommandRecord::Kind::Event))
+                {
+                    record.kind      = static_cast<CommandRecord::Kind>(kind);
+                    record.timestamp = cursor.delta(lastTime);
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        record.text[i] = lookup(strings, cursor.get<std::uint32_t>());
+                    }
+                    record.index = cursor.get<std::uint32_t>();
+                    onCommand(record);
+                }
+                else if (kind == KIND_KEYFRAME)
+                {
+                    keyframe.time = cursor.get<double>();
+                    keyframe.trains.clear();
+
+                    const std::uint64_t count = cursor.varint();
+                    for (std::uint64_t i = 0; i < count; ++i)
+                    {
+                        TrainKeyframe train;
+                        train.name             = std::string(lookup(strings, cursor.get<std::uint32_t>()));
+                        train.state            = std::string(lookup(strings, cursor.get<std::uint32_t>()));
+                        train.departureStation = std::string(lookup(strings, cursor.get<std::uint32_t>()));
+                        train.railIndex        = cursor.get<std::uint32_t>();
+                        train.position         = cursor.get<double>();
+                        train.velocity         = cursor.get<double>();
+                        train.stopSeconds      = cursor.get<double>();
+                        train.finished         = cursor.get<std::uint8_t>() != 0;
+                        keyframe.trains.push_back(train);
+                    }
+                    onKeyframe(keyframe);
+                }
+                else
+                {
+                    throw std::runtime_error("unknown record kind " + std::to_string(kind));
+                }
+            }
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        corrupt(e.what());
+    }
+}
+
+void CommandLogReader::corrupt(const std::string& reason) const
+{
+    throw std::runtime_error("Corrupt command log '" + _path + "': " + reason);
+}
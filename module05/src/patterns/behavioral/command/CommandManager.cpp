@@ -1,10 +1,14 @@
 #include "patterns/behavioral/command/CommandManager.hpp"
+#include "patterns/behavioral/command/CommandLog.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
 #include "patterns/behavioral/command/ICommand.hpp"
 #include "patterns/behavioral/command/TrainDepartureCommand.hpp"
 #include "patterns/behavioral/command/TrainStateChangeCommand.hpp"
 #include "patterns/behavioral/command/TrainAdvanceRailCommand.hpp"
 #include "patterns/behavioral/command/SimEventCommand.hpp"
+#include "utils/MemoryUsage.hpp"
 #include "utils/StringUtils.hpp"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -14,7 +18,8 @@
 // =============================================================================
 
 CommandManager::CommandManager()
-    : _recording(false),
+    : _cursor(0),
+      _recording(false),
       _replaying(false)
 {
 }
@@ -23,7 +28,7 @@ CommandManager::~CommandManager()
 {
     for (ICommand* cmd : _commands)
     {
-        delete cmd;
+        _pool.release(cmd);
     }
 }
 
@@ -42,6 +47,25 @@ bool CommandManager::isRecording() const
     return _recording;
 }
 
+void CommandManager::startRecording(const std::string& logPath)
+{
+    _log.reset(new CommandLogWriter(logPath));
+    startRecording();
+}
+
+bool CommandManager::isStreaming() const
+{
+    return _log != nullptr;
+}
+
+void CommandManager::finishRecording(const RecordingMetadata& meta)
+{
+    if (_log)
+    {
+        _log->finish(meta);
+    }
+}
+
 void CommandManager::record(ICommand* cmd)
 {
     if (!cmd)
@@ -50,7 +74,43 @@ void CommandManager::record(ICommand* cmd)
     }
 
     cmd->execute();
-    _commands.push_back(cmd);
+
+    if (!_log)
+    {
+        _commands.push_back(cmd);
+        return;
+    }
+
+    // Reloads have no binary form; like the JSON loader, replay skips them.
+    CommandRecord record;
+    if (cmd->toRecord(record))
+    {
+        _log->append(record);
+    }
+    _pool.release(cmd);
+}
+
+void CommandManager::addKeyframe(const ReplayKeyframe& keyframe)
+{
+    if (_log)
+    {
+        _log->append(keyframe);
+        return;
+    }
+
+    auto later = std::upper_bound(_keyframes.begin(), _keyframes.end(), keyframe.time,
+                                  [](double time, const ReplayKeyframe& k) { return time < k.time; });
+    _keyframes.insert(later, keyframe);
+}
+
+CommandPool& CommandManager::pool()
+{
+    return _pool;
+}
+
+const CommandPool& CommandManager::pool() const
+{
+    return _pool;
 }
 
 // =============================================================================
@@ -61,6 +121,15 @@ void CommandManager::startReplay()
 {
     _recording = false;
     _replaying = true;
+
+    // Recordings are almost always in order already; stable keeps ties as recorded.
+    _commands.erase(std::remove(_commands.begin(), _commands.end(), nullptr), _commands.end());
+    std::stable_sort(_commands.begin(), _commands.end(),
+                     [](const ICommand* a, const ICommand* b)
+                     {
+                         return a->getTimestamp() < b->getTimestamp();
+                     });
+    _cursor = 0;
 }
 
 bool CommandManager::isReplaying() const
@@ -68,28 +137,18 @@ bool CommandManager::isReplaying() const
     return _replaying;
 }
 
-std::vector<ICommand*> CommandManager::getCommandsForTime(
-    double startTime,
-    double endTime) const
+void CommandManager::seek(double time)
 {
-    std::vector<ICommand*> result;
-
-    for (ICommand* cmd : _commands)
-    {
-        if (!cmd)
-        {
-            continue;
-        }
-
-        double t = cmd->getTimestamp();
-
-        if (t >= startTime && t < endTime)
-        {
-            result.push_back(cmd);
-        }
-    }
+    auto first = std::lower_bound(_commands.begin(), _commands.end(), time,
+                                  [](const ICommand* cmd, double t) { return cmd->getTimestamp() < t; });
+    _cursor = static_cast<std::size_t>(first - _commands.begin());
+}
 
-    return result;
+const ReplayKeyframe* CommandManager::keyframeAtOrBefore(double time) const
+{
+    auto later = std::upper_bound(_keyframes.begin(), _keyframes.end(), time,
+                                  [](double t, const ReplayKeyframe& k) { return t < k.time; });
+    return (later == _keyframes.begin()) ? nullptr : &*(later - 1);
 }
 
 // =============================================================================
@@ -98,7 +157,29 @@ std::vector<ICommand*> CommandManager::getCommandsForTime(
 
 std::size_t CommandManager::commandCount() const
 {
-    return _commands.size();
+    return _log ? static_cast<std::size_t>(_log->commandCount()) : _commands.size();
+}
+
+std::size_t CommandManager::keyframeCount() const
+{
+    return _keyframes.size();
+}
+
+std::size_t CommandManager::getMemoryUsage() const
+{
+    std::size_t bytes = sizeof(*this) + _pool.stats().reservedBytes
+                      + MemoryUsage::heapBytes(_commands) + MemoryUsage::heapBytes(_keyframes);
+
+    for (const ReplayKeyframe& keyframe : _keyframes)
+    {
+        bytes += MemoryUsage::heapBytes(keyframe.trains);
+        for (const TrainKeyframe& train : keyframe.trains)
+        {
+            bytes += MemoryUsage::heapBytes(train.name) + MemoryUsage::heapBytes(train.state)
+                   + MemoryUsage::heapBytes(train.departureStation);
+        }
+    }
+    return bytes;
 }
 
 // =============================================================================
@@ -109,6 +190,11 @@ bool CommandManager::saveToFile(
     const std::string&      path,
     const RecordingMetadata& meta) const
 {
+    if (_log)
+    {
+        return false;
+    }
+
     std::ofstream f(path);
     if (!f.is_open())
     {
@@ -139,6 +225,21 @@ bool CommandManager::saveToFile(
         f << "\n";
     }
 
+    f << "],\n";
+    f << "\"keyframes\":[\n";
+
+    for (std::size_t i = 0; i < _keyframes.size(); ++i)
+    {
+        f << serializeKeyframe(_keyframes[i]);
+
+        if (i + 1 < _keyframes.size())
+        {
+            f << ",";
+        }
+
+        f << "\n";
+    }
+
     f << "]\n";
     f << "}\n";
 
@@ -159,6 +260,15 @@ bool CommandManager::loadFromFile(
         return false;
     }
 
+    char magic[16] = {};
+    f.read(magic, sizeof(magic));
+    if (CommandLogReader::isCommandLog(std::string_view(magic, static_cast<std::size_t>(f.gcount()))))
+    {
+        return loadCommandLog(path, outMeta);
+    }
+    f.clear();
+    f.seekg(0);
+
     // Read entire file into a string.
     std::string content(
         (std::istreambuf_iterator<char>(f)),
@@ -173,19 +283,82 @@ bool CommandManager::loadFromFile(
 
     outMeta.stopTime    = extractDouble(content, "stop_time");
 
-    // Find the commands array.
-    std::size_t arrayStart = content.find("\"commands\":[");
-    if (arrayStart == std::string::npos)
+    const bool hasCommands = forEachArrayObject(content, "commands",
+        [this](const std::string& json)
+        {
+            ICommand* cmd = deserializeCommand(json);
+
+            if (cmd)
+            {
+                _commands.push_back(cmd);
+            }
+        });
+
+    if (!hasCommands)
     {
         return false;
     }
 
-    arrayStart = content.find('[', arrayStart);
+    // Older recordings have no keyframes; a seek then starts from 00:00.
+    forEachArrayObject(content, "keyframes",
+        [this](const std::string& json)
+        {
+            ReplayKeyframe keyframe;
+
+            if (deserializeKeyframe(json, keyframe))
+            {
+                addKeyframe(keyframe);
+            }
+        });
+
+    return true;
+}
+
+bool CommandManager::loadCommandLog(
+    const std::string& path,
+    RecordingMetadata& outMeta)
+{
+    try
+    {
+        const CommandLogReader reader(path);
+
+        reader.read(outMeta,
+            [this](const CommandRecord& record)
+            {
+                ICommand* cmd = deserializeRecord(record);
+
+                if (cmd)
+                {
+                    _commands.push_back(cmd);
+                }
+            },
+            [this](const ReplayKeyframe& keyframe)
+            {
+                addKeyframe(keyframe);
+            });
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+template <typename Callback>
+bool CommandManager::forEachArrayObject(
+    const std::string& content,
+    const std::string& key,
+    Callback&&         onObject)
+{
+    std::size_t arrayStart = content.find("\"" + key + "\":[");
     if (arrayStart == std::string::npos)
     {
         return false;
     }
 
+    arrayStart = content.find('[', arrayStart);
+
     // Walk through JSON objects in the array.
     std::size_t pos = arrayStart + 1;
 
@@ -234,14 +407,7 @@ bool CommandManager::loadFromFile(
             ++end;
         }
 
-        std::string json = content.substr(pos, end - pos);
-        ICommand*   cmd  = deserializeCommand(json);
-
-        if (cmd)
-        {
-            _commands.push_back(cmd);
-        }
-
+        onObject(content.substr(pos, end - pos));
         pos = end;
     }
 
@@ -268,7 +434,7 @@ ICommand* CommandManager::deserializeCommand(const std::string& json)
         std::string train = extractString(json, "train");
         std::string from  = extractString(json, "from");
         std::string to    = extractString(json, "to");
-        return new TrainStateChangeCommand(t, train, from, to);
+        return _pool.create<TrainStateChangeCommand>(t, train, from, to);
     }
 
     if (type == "ADVANCE_RAIL")
@@ -279,7 +445,7 @@ ICommand* CommandManager::deserializeCommand(const std::string& json)
         {
             return nullptr;
         }
-        return new TrainAdvanceRailCommand(
+        return _pool.create<TrainAdvanceRailCommand>(
             t, train, static_cast<std::size_t>(railIndex));
     }
 
@@ -287,13 +453,107 @@ ICommand* CommandManager::deserializeCommand(const std::string& json)
     {
         std::string eventType = StringUtils::unescapeJson(extractString(json, "event_type"));
         std::string desc      = StringUtils::unescapeJson(extractString(json, "desc"));
-        return new SimEventCommand(t, eventType, desc);
+        return _pool.create<SimEventCommand>(t, eventType, desc);
     }
 
     // "RELOAD" and unknown types are intentionally skipped.
     return nullptr;
 }
 
+// =============================================================================
+// Deserialization — one command from a binary log record
+// =============================================================================
+
+ICommand* CommandManager::deserializeRecord(const CommandRecord& record)
+{
+    const std::string subject(record.text[0]);  // Train name, or event type
+
+    switch (record.kind)
+    {
+        case CommandRecord::Kind::Departure:
+            return new TrainDepartureCommand(record.timestamp, subject);
+        case CommandRecord::Kind::StateChange:
+            return _pool.create<TrainStateChangeCommand>(
+                record.timestamp, subject, std::string(record.text[1]), std::string(record.text[2]));
+        case CommandRecord::Kind::AdvanceRail:
+            return _pool.create<TrainAdvanceRailCommand>(
+                record.timestamp, subject, static_cast<std::size_t>(record.index));
+        case CommandRecord::Kind::Event:
+            return _pool.create<SimEventCommand>(record.timestamp, subject, std::string(record.text[1]));
+    }
+
+    return nullptr;
+}
+
+// =============================================================================
+// Keyframes
+// =============================================================================
+
+std::string CommandManager::serializeKeyframe(const ReplayKeyframe& keyframe)
+{
+    // Shortest round-trip digits: a restored keyframe must be bit-exact.
+    std::string out = "{\"t\":";
+    StringUtils::appendShortest(out, keyframe.time);
+    out += ",\"trains\":[";
+
+    for (std::size_t i = 0; i < keyframe.trains.size(); ++i)
+    {
+        const TrainKeyframe& train = keyframe.trains[i];
+
+        out += (i > 0) ? ",{\"train\":\"" : "{\"train\":\"";
+        out += StringUtils::escapeJson(train.name);
+        out += "\",\"state\":\"";
+        out += StringUtils::escapeJson(train.state);
+        out += "\",\"dep\":\"";
+        out += StringUtils::escapeJson(train.departureStation);
+        out += "\",\"rail\":";
+        out += std::to_string(train.railIndex);
+        out += ",\"pos\":";
+        StringUtils::appendShortest(out, train.position);
+        out += ",\"vel\":";
+        StringUtils::appendShortest(out, train.velocity);
+        out += ",\"stop\":";
+        StringUtils::appendShortest(out, train.stopSeconds);
+        out += ",\"fin\":";
+        out += train.finished ? '1' : '0';
+        out += '}';
+    }
+
+    out += "]}";
+    return out;
+}
+
+bool CommandManager::deserializeKeyframe(const std::string& json, ReplayKeyframe& out)
+{
+    out.time = extractDouble(json, "t");
+
+    bool valid = true;
+    forEachArrayObject(json, "trains",
+        [&](const std::string& object)
+        {
+            TrainKeyframe train;
+            train.name             = StringUtils::unescapeJson(extractString(object, "train"));
+            train.state            = StringUtils::unescapeJson(extractString(object, "state"));
+            train.departureStation = StringUtils::unescapeJson(extractString(object, "dep"));
+
+            const long long railIndex = extractInt(object, "rail");
+            if (train.name.empty() || railIndex < 0)
+            {
+                valid = false;
+                return;
+            }
+
+            train.railIndex   = static_cast<std::size_t>(railIndex);
+            train.position    = extractDouble(object, "pos");
+            train.velocity    = extractDouble(object, "vel");
+            train.stopSeconds = extractDouble(object, "stop");
+            train.finished    = extractInt(object, "fin") == 1;
+            out.trains.push_back(train);
+        });
+
+    return valid;
+}
+
 // =============================================================================
 // Minimal JSON helpers
 // =============================================================================
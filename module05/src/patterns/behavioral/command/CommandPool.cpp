@@ -0,0 +1,41 @@
+#include "patterns/behavioral/command/CommandPool.hpp"
+
+void CommandPool::release(ICommand* cmd)
+{
+    if (!cmd)
+    {
+        return;
+    }
+
+    // The pools are told apart by address alone: the most-derived object
+    // starts its slot, and each slot only ever holds its pool's type.
+    const void* object = dynamic_cast<const void*>(cmd);
+
+    if (_stateChanges.owns(object))
+    {
+        _stateChanges.destroy(static_cast<TrainStateChangeCommand*>(cmd));
+        return;
+    }
+    if (_railAdvances.owns(object))
+    {
+        _railAdvances.destroy(static_cast<TrainAdvanceRailCommand*>(cmd));
+        return;
+    }
+    if (_simEvents.owns(object))
+    {
+        _simEvents.destroy(static_cast<SimEventCommand*>(cmd));
+        return;
+    }
+
+    // Not pool-allocated.
+    delete cmd;
+}
+
+PoolStats CommandPool::stats() const
+{
+    PoolStats total;
+    total += _stateChanges.stats();
+    total += _railAdvances.stats();
+    total += _simEvents.stats();
+    return total;
+}
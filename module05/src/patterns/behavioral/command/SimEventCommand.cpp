@@ -1,4 +1,5 @@
 #include "patterns/behavioral/command/SimEventCommand.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
 #include "utils/StringUtils.hpp"
 
 SimEventCommand::SimEventCommand(double             timestamp,
@@ -25,6 +26,15 @@ double SimEventCommand::getTimestamp() const
     return _timestamp;
 }
 
+bool SimEventCommand::toRecord(CommandRecord& out) const
+{
+    out.kind      = CommandRecord::Kind::Event;
+    out.timestamp = _timestamp;
+    out.text[0]   = _eventType;
+    out.text[1]   = _description;
+    return true;
+}
+
 std::string SimEventCommand::serialize() const
 {
     return StringUtils::serializeHeader(_timestamp)
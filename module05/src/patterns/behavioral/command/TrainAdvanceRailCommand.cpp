@@ -1,4 +1,5 @@
 #include "patterns/behavioral/command/TrainAdvanceRailCommand.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
 #include "simulation/interfaces/IReplayTarget.hpp"
 #include "utils/StringUtils.hpp"
 #include "core/Train.hpp"
@@ -35,6 +36,15 @@ double TrainAdvanceRailCommand::getTimestamp() const
     return _timestamp;
 }
 
+bool TrainAdvanceRailCommand::toRecord(CommandRecord& out) const
+{
+    out.kind      = CommandRecord::Kind::AdvanceRail;
+    out.timestamp = _timestamp;
+    out.text[0]   = _trainName;
+    out.index     = static_cast<std::uint32_t>(_railIndex);
+    return true;
+}
+
 void TrainAdvanceRailCommand::applyReplay(IReplayTarget* target)
 {
     if (!target)
@@ -1,4 +1,5 @@
 #include "patterns/behavioral/command/TrainDepartureCommand.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
 #include "utils/StringUtils.hpp"
 #include "simulation/interfaces/IReplayTarget.hpp"
 #include "simulation/core/SimulationContext.hpp"
@@ -34,6 +35,14 @@ double TrainDepartureCommand::getTimestamp() const
     return _timestamp;
 }
 
+bool TrainDepartureCommand::toRecord(CommandRecord& out) const
+{
+    out.kind      = CommandRecord::Kind::Departure;
+    out.timestamp = _timestamp;
+    out.text[0]   = _trainName;
+    return true;
+}
+
 void TrainDepartureCommand::applyReplay(IReplayTarget* target)
 {
     if (!target)
@@ -1,4 +1,5 @@
 #include "patterns/behavioral/command/TrainStateChangeCommand.hpp"
+#include "patterns/behavioral/command/CommandRecord.hpp"
 #include "utils/StringUtils.hpp"
 #include "simulation/interfaces/IReplayTarget.hpp"
 #include "simulation/core/SimulationContext.hpp"
@@ -40,6 +41,16 @@ double TrainStateChangeCommand::getTimestamp() const
     return _timestamp;
 }
 
+bool TrainStateChangeCommand::toRecord(CommandRecord& out) const
+{
+    out.kind      = CommandRecord::Kind::StateChange;
+    out.timestamp = _timestamp;
+    out.text[0]   = _trainName;
+    out.text[1]   = _fromState;
+    out.text[2]   = _toState;
+    return true;
+}
+
 void TrainStateChangeCommand::applyReplay(IReplayTarget* target)
 {
     if (!target)
@@ -8,7 +8,7 @@
 #include "simulation/physics/SafetyConstants.hpp"
 #include "simulation/physics/RiskData.hpp"
 
-void AcceleratingState::update(Train* train, double dt)
+void AcceleratingState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
     if (!train)
     {
@@ -21,12 +21,15 @@ void AcceleratingState::update(Train* train, double dt)
         return;
     }
 
-    double accelForceN = PhysicsSystem::kNtoN(train->getMaxAccelForce());
-    double netForce    = PhysicsSystem::calculateNetForce(train, accelForceN);
+    double extraFriction = physics ? physics->getCurrentRailFrictionIncrease(train) : 0.0;
+    double accelForceN   = PhysicsSystem::kNtoN(train->getMaxAccelForce());
+    double netForce      = PhysicsSystem::calculateNetForce(train, accelForceN, extraFriction);
 
     PhysicsSystem::updateVelocity(train, netForce, dt);
 
-    double speedLimitMs = PhysicsSystem::kmhToMs(currentRail->getSpeedLimit());
+    double speedLimitMs = physics
+        ? physics->getCurrentRailSpeedLimit(train)
+        : PhysicsSystem::kmhToMs(currentRail->getSpeedLimit());
     if (train->getVelocity() > speedLimitMs)
     {
         train->setVelocity(speedLimitMs);
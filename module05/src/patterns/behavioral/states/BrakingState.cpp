@@ -7,15 +7,16 @@
 #include "simulation/systems/PhysicsSystem.hpp"
 #include "simulation/physics/RiskData.hpp"
 
-void BrakingState::update(Train* train, double dt)
+void BrakingState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
 	if (!train)
 	{
 		return;
 	}
 	
+	double extraFriction = physics ? physics->getCurrentRailFrictionIncrease(train) : 0.0;
 	double brakeForceN = PhysicsSystem::kNtoN(train->getMaxBrakeForce());
-	double frictionForce = PhysicsSystem::calculateFriction(train);
+	double frictionForce = PhysicsSystem::calculateFriction(train, extraFriction);
 	
 	double netForce = -(brakeForceN + frictionForce);
 	
@@ -8,7 +8,7 @@
 #include "simulation/physics/SafetyConstants.hpp"
 #include "simulation/physics/RiskData.hpp"
 
-void CruisingState::update(Train* train, double dt)
+void CruisingState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
     if (!train)
     {
@@ -21,20 +21,23 @@ void CruisingState::update(Train* train, double dt)
         return;
     }
 
-    double speedLimitMs    = PhysicsSystem::kmhToMs(currentRail->getSpeedLimit());
+    double speedLimitMs    = physics
+        ? physics->getCurrentRailSpeedLimit(train)
+        : PhysicsSystem::kmhToMs(currentRail->getSpeedLimit());
+    double extraFriction   = physics ? physics->getCurrentRailFrictionIncrease(train) : 0.0;
     double currentVelocity = train->getVelocity();
 
     if (currentVelocity > speedLimitMs)
     {
         // Exceeding limit — apply light braking.
-        double netForce = -PhysicsSystem::calculateFriction(train);
+        double netForce = -PhysicsSystem::calculateFriction(train, extraFriction);
         PhysicsSystem::updateVelocity(train, netForce, dt);
     }
     else if (currentVelocity < speedLimitMs * 0.95)
     {
         // Below limit — re-accelerate.
         double accelForceN = PhysicsSystem::kNtoN(train->getMaxAccelForce());
-        double netForce    = PhysicsSystem::calculateNetForce(train, accelForceN);
+        double netForce    = PhysicsSystem::calculateNetForce(train, accelForceN, extraFriction);
         PhysicsSystem::updateVelocity(train, netForce, dt);
 
         if (train->getVelocity() > speedLimitMs)
@@ -6,15 +6,16 @@
 #include "simulation/physics/SafetyConstants.hpp"
 #include "simulation/physics/RiskData.hpp"
 
-void EmergencyState::update(Train* train, double dt)
+void EmergencyState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
 	if (!train)
 	{
 		return;
 	}
 	
+	double extraFriction = physics ? physics->getCurrentRailFrictionIncrease(train) : 0.0;
 	double brakeForceN = PhysicsSystem::kNtoN(train->getMaxBrakeForce());
-	double frictionForce = PhysicsSystem::calculateFriction(train);
+	double frictionForce = PhysicsSystem::calculateFriction(train, extraFriction);
 	
 	double netForce = -(brakeForceN + frictionForce);
 	
@@ -3,8 +3,9 @@
 #include "simulation/core/SimulationContext.hpp"
 #include "patterns/behavioral/states/StateRegistry.hpp"
 
-void IdleState::update(Train* train, double dt)
+void IdleState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
+	(void)physics;
 	(void)dt;
 
 	if (!train)
@@ -5,8 +5,9 @@
 #include "core/Rail.hpp"
 #include "simulation/core/SimulationContext.hpp"
 
-void StoppedState::update(Train* train, double dt)
+void StoppedState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
+    (void)physics;
     (void)dt;
 
     if (!train)
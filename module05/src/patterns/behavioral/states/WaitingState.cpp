@@ -4,8 +4,9 @@
 #include "core/Train.hpp"
 #include "simulation/core/SimulationContext.hpp"
 
-void WaitingState::update(Train* train, double dt)
+void WaitingState::update(Train* train, const IPhysicsQueries* physics, double dt)
 {
+    (void)physics;
     (void)dt;
 
     if (!train)
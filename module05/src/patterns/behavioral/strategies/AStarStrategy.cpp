@@ -2,6 +2,7 @@
 #include "core/Graph.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 #include "core/Train.hpp"
 #include <map>
 #include <queue>
@@ -9,7 +10,8 @@
 #include <limits>
 #include <algorithm>
 
-IPathfindingStrategy::Path AStarStrategy::findPath(const Graph* graph, Node* start, Node* end) const
+IPathfindingStrategy::Path AStarStrategy::findPath(const Graph* graph, Node* start, Node* end,
+                                                    const RailAttributeOverlay* railAttributes) const
 {
 	if (!graph || !start || !end)
 	{
@@ -73,7 +75,8 @@ IPathfindingStrategy::Path AStarStrategy::findPath(const Graph* graph, Node* sta
 			}
 			
 			// Calculate cost: travel time = distance / speed
-			double edgeCost = rail->getLength() / rail->getSpeedLimit();
+			double speedLimit = railAttributes ? railAttributes->getSpeedLimit(rail) : rail->getSpeedLimit();
+			double edgeCost = rail->getLength() / speedLimit;
 			double tentativeGScore = gScore[current] + edgeCost;
 			
 			// Found better path to neighbor
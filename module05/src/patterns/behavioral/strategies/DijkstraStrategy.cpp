@@ -2,6 +2,7 @@
 #include "core/Graph.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 #include "core/Train.hpp"
 #include <map>
 #include <queue>
@@ -9,7 +10,8 @@
 #include <limits>
 #include <algorithm>
 
-IPathfindingStrategy::Path DijkstraStrategy::findPath(const Graph* graph, Node* start, Node* end) const
+IPathfindingStrategy::Path DijkstraStrategy::findPath(const Graph* graph, Node* start, Node* end,
+                                                      const RailAttributeOverlay* railAttributes) const
 {
 	if (!graph || !start || !end)
 	{
@@ -68,7 +70,8 @@ IPathfindingStrategy::Path DijkstraStrategy::findPath(const Graph* graph, Node*
 			}
 			
 			// Calculate cost: travel time = distance / speed
-			double cost = rail->getLength() / rail->getSpeedLimit();
+			double speedLimit = railAttributes ? railAttributes->getSpeedLimit(rail) : rail->getSpeedLimit();
+			double cost = rail->getLength() / speedLimit;
 			double newDist = currentDist + cost;
 			
 			if (newDist < distance[neighbor])
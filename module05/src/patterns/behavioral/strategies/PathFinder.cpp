@@ -20,12 +20,13 @@ IPathfindingStrategy* PathFinder::getStrategy() const
 	return _strategy;
 }
 
-PathFinder::Path PathFinder::findPath(const Graph* graph, Node* start, Node* end) const
+PathFinder::Path PathFinder::findPath(const Graph* graph, Node* start, Node* end,
+                                      const RailAttributeOverlay* railAttributes) const
 {
 	if (!_strategy)
 	{
 		return {};
 	}
 	
-	return _strategy->findPath(graph, start, end);
+	return _strategy->findPath(graph, start, end, railAttributes);
 }
\ No newline at end of file
@@ -6,55 +6,99 @@
 #include "events/TrackMaintenanceEvent.hpp"
 #include "events/SignalFailureEvent.hpp"
 #include "events/WeatherEvent.hpp"
+#include "event_system/EventPool.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include <utility>
 #include <vector>
 
-const EventConfig EventFactory::CONFIG_STATION_DELAY     = {0.03,  15,  45};
-const EventConfig EventFactory::CONFIG_TRACK_MAINTENANCE  = {0.015, 60, 180};
-const EventConfig EventFactory::CONFIG_SIGNAL_FAILURE    = {0.01,   5,  20};
-const EventConfig EventFactory::CONFIG_WEATHER           = {0.005, 120, 300};
+EventFactory::EventFactory(IRng& rng, const INetworkQuery* network, IEventScheduler* eventScheduler,
+                           RailAttributeOverlay* railAttributes, EventPool* eventPool,
+                           RailFootprintIndex* footprints)
+    : _shared{&rng}, _streams(nullptr),
+      _network(network), _eventManager(eventScheduler),
+      _railAttributes(railAttributes), _eventPool(eventPool),
+      _weatherFootprints(footprints)
+{
+    if (!_weatherFootprints)
+    {
+        _ownedFootprints.reset(new RailFootprintIndex(network));
+        _weatherFootprints = _ownedFootprints.get();
+    }
+}
 
-EventFactory::EventFactory(IRng& rng, const INetworkQuery* network, IEventScheduler* eventScheduler)
-    : _rng(rng), _network(network), _eventManager(eventScheduler)
+EventFactory::EventFactory(EventRngStreams& streams, const INetworkQuery* network, IEventScheduler* eventScheduler,
+                           RailAttributeOverlay* railAttributes, EventPool* eventPool,
+                           RailFootprintIndex* footprints)
+    : _shared{nullptr}, _streams(&streams),
+      _network(network), _eventManager(eventScheduler),
+      _railAttributes(railAttributes), _eventPool(eventPool),
+      _weatherFootprints(footprints)
 {
+    if (!_weatherFootprints)
+    {
+        _ownedFootprints.reset(new RailFootprintIndex(network));
+        _weatherFootprints = _ownedFootprints.get();
+    }
+}
+
+template <typename T, typename... Args>
+T* EventFactory::allocate(Args&&... args)
+{
+    if (_eventPool)
+    {
+        return _eventPool->create<T>(std::forward<Args>(args)...);
+    }
+
+    return new T(std::forward<Args>(args)...);
 }
 
 std::vector<Event*> EventFactory::tryGenerateEvents(const Time& currentTime, double timestepSeconds)
 {
     (void)timestepSeconds;
+
+    if (_streams)
+    {
+        return generate(*_streams, currentTime);
+    }
+    return generate(_shared, currentTime);
+}
+
+template <typename Sites>
+std::vector<Event*> EventFactory::generate(Sites& sites, const Time& currentTime)
+{
     std::vector<Event*> newEvents;
 
-    if (_rng.getBool(CONFIG_STATION_DELAY.probabilityPerTimestep))
+    if (sites[EventRngSite::StationDelayTrigger].getBool(_parameters.stationDelay.probabilityPerTimestep))
     {
-        Event* ev = createStationDelay(currentTime);
+        Event* ev = createStationDelay(sites, currentTime);
         if (ev)
         {
             newEvents.push_back(ev);
         }
     }
 
-    if (_rng.getBool(CONFIG_TRACK_MAINTENANCE.probabilityPerTimestep))
+    if (sites[EventRngSite::MaintenanceTrigger].getBool(_parameters.trackMaintenance.probabilityPerTimestep))
     {
-        Event* ev = createTrackMaintenance(currentTime);
+        Event* ev = createTrackMaintenance(sites, currentTime);
         if (ev)
         {
             newEvents.push_back(ev);
         }
     }
 
-    if (_rng.getBool(CONFIG_SIGNAL_FAILURE.probabilityPerTimestep))
+    if (sites[EventRngSite::SignalFailureTrigger].getBool(_parameters.signalFailure.probabilityPerTimestep))
     {
-        Event* ev = createSignalFailure(currentTime);
+        Event* ev = createSignalFailure(sites, currentTime);
         if (ev)
         {
             newEvents.push_back(ev);
         }
     }
 
-    if (_rng.getBool(CONFIG_WEATHER.probabilityPerTimestep))
+    if (sites[EventRngSite::WeatherTrigger].getBool(_parameters.weather.probabilityPerTimestep))
     {
-        Event* ev = createWeather(currentTime);
+        Event* ev = createWeather(sites, currentTime);
         if (ev)
         {
             newEvents.push_back(ev);
@@ -64,7 +108,8 @@ std::vector<Event*> EventFactory::tryGenerateEvents(const Time& currentTime, dou
     return newEvents;
 }
 
-Event* EventFactory::createStationDelay(const Time& currentTime)
+template <typename Sites>
+Event* EventFactory::createStationDelay(Sites& sites, const Time& currentTime)
 {
     if (!_network)
     {
@@ -87,21 +132,23 @@ Event* EventFactory::createStationDelay(const Time& currentTime)
         return nullptr;
     }
 
-    Node* station = cityNodes[_rng.getInt(0, static_cast<int>(cityNodes.size()) - 1)];
+    Node* station = cityNodes[sites[EventRngSite::StationDelayTarget].getInt(0, static_cast<int>(cityNodes.size()) - 1)];
 
     if (!canCreateStationDelay(station))
     {
         return nullptr;
     }
 
-    Time duration = generateDuration(CONFIG_STATION_DELAY);
-    int  delayMin = _rng.getInt(CONFIG_STATION_DELAY.minDurationMinutes, CONFIG_STATION_DELAY.maxDurationMinutes);
+    auto& magnitude = sites[EventRngSite::StationDelayMagnitude];
+    Time  duration  = generateDuration(_parameters.stationDelay, magnitude);
+    int   delayMin  = magnitude.getInt(_parameters.stationDelay.minDurationMinutes, _parameters.stationDelay.maxDurationMinutes);
     Time extraDelay(0, delayMin);
 
-    return new StationDelayEvent(station, currentTime, duration, extraDelay);
+    return allocate<StationDelayEvent>(station, currentTime, duration, extraDelay);
 }
 
-Event* EventFactory::createTrackMaintenance(const Time& currentTime)
+template <typename Sites>
+Event* EventFactory::createTrackMaintenance(Sites& sites, const Time& currentTime)
 {
     if (!_network)
     {
@@ -115,20 +162,22 @@ Event* EventFactory::createTrackMaintenance(const Time& currentTime)
         return nullptr;
     }
 
-    Rail* rail = rails[_rng.getInt(0, static_cast<int>(rails.size()) - 1)];
+    Rail* rail = rails[sites[EventRngSite::MaintenanceTarget].getInt(0, static_cast<int>(rails.size()) - 1)];
 
     if (!canCreateTrackMaintenance(rail))
     {
         return nullptr;
     }
 
-    Time   duration       = generateDuration(CONFIG_TRACK_MAINTENANCE);
-    double speedReduction = _rng.getDouble(0.4, 0.7);
+    auto&  magnitude      = sites[EventRngSite::MaintenanceMagnitude];
+    Time   duration       = generateDuration(_parameters.trackMaintenance, magnitude);
+    double speedReduction = magnitude.getDouble(0.4, 0.7);
 
-    return new TrackMaintenanceEvent(rail, currentTime, duration, speedReduction);
+    return allocate<TrackMaintenanceEvent>(rail, currentTime, duration, speedReduction, _railAttributes);
 }
 
-Event* EventFactory::createSignalFailure(const Time& currentTime)
+template <typename Sites>
+Event* EventFactory::createSignalFailure(Sites& sites, const Time& currentTime)
 {
     if (!_network)
     {
@@ -142,21 +191,23 @@ Event* EventFactory::createSignalFailure(const Time& currentTime)
         return nullptr;
     }
 
-    Node* node = nodes[_rng.getInt(0, static_cast<int>(nodes.size()) - 1)];
+    Node* node = nodes[sites[EventRngSite::SignalFailureTarget].getInt(0, static_cast<int>(nodes.size()) - 1)];
 
     if (!canCreateSignalFailure(node))
     {
         return nullptr;
     }
 
-    Time duration = generateDuration(CONFIG_SIGNAL_FAILURE);
-    int  stopMin  = _rng.getInt(CONFIG_SIGNAL_FAILURE.minDurationMinutes, CONFIG_SIGNAL_FAILURE.maxDurationMinutes);
+    auto& magnitude = sites[EventRngSite::SignalFailureMagnitude];
+    Time  duration  = generateDuration(_parameters.signalFailure, magnitude);
+    int   stopMin   = magnitude.getInt(_parameters.signalFailure.minDurationMinutes, _parameters.signalFailure.maxDurationMinutes);
     Time stopDur(0, stopMin);
 
-    return new SignalFailureEvent(node, currentTime, duration, stopDur);
+    return allocate<SignalFailureEvent>(node, currentTime, duration, stopDur);
 }
 
-Event* EventFactory::createWeather(const Time& currentTime)
+template <typename Sites>
+Event* EventFactory::createWeather(Sites& sites, const Time& currentTime)
 {
     if (!_network || !canCreateWeather())
     {
@@ -170,36 +221,29 @@ Event* EventFactory::createWeather(const Time& currentTime)
         return nullptr;
     }
 
-    Node*  center       = nodes[_rng.getInt(0, static_cast<int>(nodes.size()) - 1)];
-    Time   duration     = generateDuration(CONFIG_WEATHER);
-    double radius       = _rng.getDouble(20.0, 50.0);
-    double speedReduce  = _rng.getDouble(0.5, 0.8);
-    double frictionInc  = _rng.getDouble(0.01, 0.03);
+    auto&  magnitude    = sites[EventRngSite::WeatherMagnitude];
+    Node*  center       = nodes[sites[EventRngSite::WeatherTarget].getInt(0, static_cast<int>(nodes.size()) - 1)];
+    Time   duration     = generateDuration(_parameters.weather, magnitude);
+    double radius       = magnitude.getDouble(20.0, 50.0);
+    double speedReduce  = magnitude.getDouble(0.5, 0.8);
+    double frictionInc  = magnitude.getDouble(0.01, 0.03);
 
     const char* types[] = {"Heavy Rain", "Storm", "Snow", "Fog"};
 
-    WeatherEvent* event = new WeatherEvent(types[_rng.getInt(0, 3)], center,
-                                           currentTime, duration, radius,
-                                           speedReduce, frictionInc);
-
-    std::vector<Rail*> affected;
+    WeatherEvent* event = allocate<WeatherEvent>(types[magnitude.getInt(0, 3)], center,
+                                                 currentTime, duration, radius,
+                                                 speedReduce, frictionInc, _railAttributes);
 
-    for (Rail* rail : _network->getRails())
-    {
-        if (rail && (rail->getNodeA() == center || rail->getNodeB() == center || rail->getLength() <= radius))
-        {
-            affected.push_back(rail);
-        }
-    }
-
-    event->setAffectedRails(affected);
+    // Rails within the storm radius by graph distance from the centre.
+    event->setAffectedRails(_weatherFootprints->railsWithin(center, radius));
 
     return event;
 }
 
-Time EventFactory::generateDuration(const EventConfig& config)
+template <typename Rng>
+Time EventFactory::generateDuration(const EventConfig& config, Rng& rng)
 {
-    int minutes = _rng.getInt(config.minDurationMinutes, config.maxDurationMinutes);
+    int minutes = rng.getInt(config.minDurationMinutes, config.maxDurationMinutes);
     return Time(minutes / 60, minutes % 60);
 }
 
@@ -303,5 +347,14 @@ bool EventFactory::canCreateWeather() const
 
 unsigned int EventFactory::getSeed() const
 {
-    return _rng.getSeed();
-}
\ No newline at end of file
+    return _streams ? _streams->getSeed() : _shared.rng->getSeed();
+}
+void EventFactory::setParameters(const EventParameters& parameters)
+{
+    _parameters = parameters;
+}
+
+const EventParameters& EventFactory::getParameters() const
+{
+    return _parameters;
+}
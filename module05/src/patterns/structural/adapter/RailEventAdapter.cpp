@@ -16,7 +16,7 @@ void RailEventAdapter::onNotify(Event* event)
 
     // Speed limit modification logic for rail events belongs here.
     // Currently a no-op — TrackMaintenanceEvent and WeatherEvent apply
-    // speed changes directly via Rail::setSpeedLimit in their activate().
+    // speed changes to the run's RailAttributeOverlay in their activate().
 }
 
 Rail* RailEventAdapter::getRail() const
@@ -1,8 +1,11 @@
 #include "simulation/core/SimulationBuilder.hpp"
 #include "io/RailNetworkParser.hpp"
 #include "io/TrainConfigParser.hpp"
+#include "io/AsyncResultSink.hpp"
 #include "io/FileOutputWriter.hpp"
 #include "io/IOutputWriter.hpp"
+#include "io/LiveTrainFeed.hpp"
+#include "io/TraceFile.hpp"
 #include "patterns/creational/factories/TrainFactory.hpp"
 #include "patterns/creational/factories/TrainValidator.hpp"
 #include "patterns/behavioral/strategies/IPathfindingStrategy.hpp"
@@ -12,7 +15,75 @@
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
 #include "core/Train.hpp"
+#include "simulation/core/SimulationCheckpoint.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
+#include "utils/FileSystemUtils.hpp"
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    bool sameConfig(const TrainConfig& a, const TrainConfig& b)
+    {
+        return a.name == b.name && a.mass == b.mass && a.frictionCoef == b.frictionCoef &&
+               a.maxAccelForce == b.maxAccelForce && a.maxBrakeForce == b.maxBrakeForce &&
+               a.departureStation == b.departureStation && a.arrivalStation == b.arrivalStation &&
+               a.departureTime == b.departureTime && a.stopDuration == b.stopDuration;
+    }
+
+    // What identifies a rail across two parses of a network file.
+    using RailKey = std::tuple<std::string, std::string, double, double>;
+
+    RailKey railKey(const Rail* rail)
+    {
+        std::string a = rail->getNodeA()->getName();
+        std::string b = rail->getNodeB()->getName();
+        if (b < a)
+        {
+            std::swap(a, b);
+        }
+        return RailKey(a, b, rail->getLength(), rail->getSpeedLimit());
+    }
+
+    std::set<std::string> nodeNames(const Graph* graph)
+    {
+        std::set<std::string> names;
+        for (const Node* node : graph->getNodes())
+        {
+            names.insert(node->getName());
+        }
+        return names;
+    }
+
+    // Old rail -> identical rail of the new network; rails edited or
+    // removed are absent.  Duplicate rails pair up in file order.
+    std::unordered_map<const Rail*, Rail*> matchRails(const Graph* from, const Graph* to)
+    {
+        std::multimap<RailKey, Rail*> candidates;
+        for (Rail* rail : to->getRails())
+        {
+            candidates.emplace(railKey(rail), rail);
+        }
+
+        std::unordered_map<const Rail*, Rail*> matched;
+        for (const Rail* rail : from->getRails())
+        {
+            auto it = candidates.find(railKey(rail));
+            if (it != candidates.end())
+            {
+                matched[rail] = it->second;
+                candidates.erase(it);
+            }
+        }
+        return matched;
+    }
+}
 
 SimulationBuilder::SimulationBuilder(IOutputWriter* logger, const std::string& pathfindingAlgo)
     : _logger(logger),
@@ -20,6 +91,11 @@ SimulationBuilder::SimulationBuilder(IOutputWriter* logger, const std::string& p
 {
 }
 
+void SimulationBuilder::setTraceFile(const std::string& path)
+{
+    _traceFile = path;
+}
+
 SimulationBundle SimulationBuilder::build(
     const std::string& netFile,
     const std::string& trainFile)
@@ -34,12 +110,289 @@ SimulationBundle SimulationBuilder::build(
     std::vector<TrainValidationResult> results =
         validateTrainConfigs(configs, bundle.graph, strategy.get());
 
-    bundle.trains  = _buildTrains(results, bundle.graph);
-    bundle.writers = _createOutputWriters(bundle.trains);
+    _buildTrains(results, bundle);
+
+    if (_traceFile.empty())
+    {
+        bundle.sink = new AsyncResultSink();
+    }
+    else
+    {
+        FileSystemUtils::ensureOutputDirectoryExists();
+        bundle.sink = new AsyncResultSink(std::unique_ptr<IResultStore>(new TraceWriter(_traceFile)));
+    }
+
+    bundle.writers = _createOutputWriters(bundle.trains, *bundle.sink);
 
     return bundle;
 }
 
+ReloadSummary SimulationBuilder::reload(
+    const std::string& netFile,
+    const std::string& trainFile,
+    SimulationBundle&  bundle,
+    SimulationManager& sim)
+{
+    ReloadSummary summary;
+
+    std::unique_ptr<Graph>                parsed(_parseNetwork(netFile));
+    std::vector<TrainConfig>              configs  = _parseTrains(trainFile);
+    std::unique_ptr<IPathfindingStrategy> strategy = _createStrategy();
+
+    // An unchanged network keeps the running graph, and every pointer into it.
+    Graph* const                           oldGraph = bundle.graph;
+    std::unordered_map<const Rail*, Rail*> railMap  = matchRails(oldGraph, parsed.get());
+    summary.networkChanged = railMap.size() != oldGraph->getRailCount() ||
+                             parsed->getRailCount() != oldGraph->getRailCount() ||
+                             nodeNames(parsed.get()) != nodeNames(oldGraph);
+    Graph* const graph = summary.networkChanged ? parsed.get() : oldGraph;
+
+    // Current leg and everything travelled on the new network's rails; the
+    // route ahead is kept where it survives and recomputed where it does not.
+    // Returns false when the train cannot continue where it is.
+    auto remapPath = [&](Train* train, Train::Path& path)
+    {
+        const Train::Path& old = train->getPath();
+        if (old.empty())
+        {
+            return false;
+        }
+        const std::size_t current = std::min(train->getCurrentRailIndex(), old.size() - 1);
+
+        for (std::size_t i = 0; i < old.size(); ++i)
+        {
+            auto it = railMap.find(old[i].rail);
+            if (it == railMap.end())
+            {
+                if (i <= current)
+                {
+                    return false;
+                }
+
+                Node* destination = graph->getNode(train->getArrivalStation());
+                Train::Path ahead = destination ? strategy->findPath(graph, path.back().to, destination)
+                                                : Train::Path();
+                if (ahead.empty() && path.back().to != destination)
+                {
+                    return false;
+                }
+                path.insert(path.end(), ahead.begin(), ahead.end());
+                ++summary.rerouted;
+                return true;
+            }
+            path.push_back({it->second, graph->getNode(old[i].from->getName()),
+                            graph->getNode(old[i].to->getName())});
+        }
+        return true;
+    };
+
+    std::unordered_map<std::string, std::size_t> oldByName;
+    for (std::size_t i = 0; i < bundle.trains.size(); ++i)
+    {
+        oldByName[bundle.configs[i].name] = i;
+    }
+
+    // Match the new file against the running trains, in file order.
+    std::vector<Train*>        trains;
+    std::vector<TrainConfig>   builtConfigs;
+    std::vector<Train::Path>   keptPaths;  // Per train: its path on the new network
+    std::vector<bool>          keep(bundle.trains.size(), false);
+    std::vector<bool>          replaced(bundle.trains.size(), false);
+    std::unordered_set<Train*> created;
+
+    for (const TrainConfig& config : configs)
+    {
+        auto old = oldByName.find(config.name);
+        const bool known = old != oldByName.end() && !keep[old->second] && !replaced[old->second];
+        if (known && sameConfig(bundle.configs[old->second], config))
+        {
+            Train*      train = bundle.trains[old->second];
+            Train::Path path;
+            if (!summary.networkChanged || remapPath(train, path))
+            {
+                keep[old->second] = true;
+                trains.push_back(train);
+                builtConfigs.push_back(config);
+                keptPaths.push_back(std::move(path));
+                ++summary.kept;
+                continue;
+            }
+        }
+
+        std::vector<TrainValidationResult> result = validateTrainConfigs({config}, graph, strategy.get());
+        Train* train = _buildTrain(result.front(), graph);
+        if (!train)
+        {
+            continue;
+        }
+
+        if (known)
+        {
+            replaced[old->second] = true;
+            ++summary.modified;
+        }
+        else
+        {
+            ++summary.added;
+        }
+        created.insert(train);
+        trains.push_back(train);
+        builtConfigs.push_back(config);
+        keptPaths.emplace_back();
+    }
+
+    std::vector<Train*> dropped;
+    for (std::size_t i = 0; i < bundle.trains.size(); ++i)
+    {
+        if (!keep[i])
+        {
+            dropped.push_back(bundle.trains[i]);
+        }
+    }
+    summary.removed = dropped.size() - summary.modified;
+
+    // The checkpoint is taken on the old network and, when that changes,
+    // moved onto the new one: events at removed nodes or on removed rails
+    // end, and the overlay is rebuilt from the events still active.
+    SimulationCheckpoint checkpoint = sim.checkpoint();
+    checkpoint.trains.erase(
+        std::remove_if(checkpoint.trains.begin(), checkpoint.trains.end(),
+                       [&](const TrainCheckpoint& entry)
+                       {
+                           auto old = oldByName.find(entry.name);
+                           return old == oldByName.end() || !keep[old->second];
+                       }),
+        checkpoint.trains.end());
+
+    if (summary.networkChanged)
+    {
+        std::vector<Rail*> railsById(oldGraph->getRailCount(), nullptr);
+        for (Rail* rail : oldGraph->getRails())
+        {
+            auto it = railMap.find(rail);
+            railsById[rail->getID()] = (it != railMap.end()) ? it->second : nullptr;
+        }
+        auto mapRail = [&railsById](std::size_t id) -> Rail*
+        {
+            return id < railsById.size() ? railsById[id] : nullptr;
+        };
+
+        RailAttributeOverlay overlay(graph->getRailCount());
+        for (std::vector<EventCheckpoint>* events : {&checkpoint.scheduledEvents, &checkpoint.activeEvents})
+        {
+            std::vector<EventCheckpoint> kept;
+            for (EventCheckpoint& entry : *events)
+            {
+                if (entry.type == EventType::TRACK_MAINTENANCE)
+                {
+                    Rail* rail = mapRail(entry.rail);
+                    if (!rail)
+                    {
+                        continue;
+                    }
+                    entry.rail = rail->getID();
+                    if (entry.active)
+                    {
+                        overlay.applyModifier(rail, entry.speedFactor, 0.0);
+                    }
+                }
+                else if (!graph->hasNode(entry.node))
+                {
+                    continue;
+                }
+
+                std::vector<std::size_t> affected;
+                for (std::size_t id : entry.affectedRails)
+                {
+                    if (Rail* rail = mapRail(id))
+                    {
+                        affected.push_back(rail->getID());
+                        if (entry.active)
+                        {
+                            overlay.applyModifier(rail, entry.speedFactor, entry.friction);
+                        }
+                    }
+                }
+                entry.affectedRails = std::move(affected);
+                kept.push_back(std::move(entry));
+            }
+            *events = std::move(kept);
+        }
+        checkpoint.railAttributes = overlay.getModifiers();
+    }
+
+    // Writers of trains going away are closed before their replacements
+    // open the same output file.
+    std::vector<FileOutputWriter*> droppedWriters;
+    std::unordered_map<Train*, FileOutputWriter*> writers;
+    for (std::size_t i = 0; i < bundle.trains.size(); ++i)
+    {
+        if (keep[i])
+        {
+            writers[bundle.trains[i]] = bundle.writers[i];
+        }
+        else
+        {
+            bundle.writers[i]->close();
+            droppedWriters.push_back(bundle.writers[i]);
+        }
+    }
+
+    std::vector<Train*> createdInOrder;
+    for (Train* train : trains)
+    {
+        if (created.count(train))
+        {
+            createdInOrder.push_back(train);
+        }
+    }
+    std::vector<FileOutputWriter*> newWriters = _createOutputWriters(createdInOrder, *bundle.sink);
+    for (std::size_t i = 0; i < createdInOrder.size(); ++i)
+    {
+        writers[createdInOrder[i]] = newWriters[i];
+    }
+
+    for (std::size_t i = 0; i < trains.size(); ++i)
+    {
+        if (summary.networkChanged && !created.count(trains[i]))
+        {
+            trains[i]->setPath(keptPaths[i]);
+        }
+    }
+
+    sim.reload(graph, trains, checkpoint);
+    for (Train* train : createdInOrder)
+    {
+        sim.registerOutputWriter(train, writers[train]);
+    }
+
+    // Queued output may still refer to what is deleted below.
+    bundle.sink->flush();
+    for (FileOutputWriter* writer : droppedWriters)
+    {
+        delete writer;
+    }
+    for (Train* train : dropped)
+    {
+        delete train;
+    }
+    if (summary.networkChanged)
+    {
+        delete oldGraph;
+        bundle.graph = parsed.release();
+    }
+
+    bundle.trains  = trains;
+    bundle.configs = builtConfigs;
+    bundle.writers.clear();
+    for (Train* train : trains)
+    {
+        bundle.writers.push_back(writers[train]);
+    }
+
+    return summary;
+}
+
 std::vector<TrainValidationResult> SimulationBuilder::validateTrainConfigs(
     const std::vector<TrainConfig>& configs,
     Graph*                          graph,
@@ -88,6 +441,10 @@ Graph* SimulationBuilder::_parseNetwork(const std::string& netFile)
     _logger->writeProgress("Parsing network file...");
     RailNetworkParser parser(netFile);
     Graph*            graph = parser.parse();
+    if (parser.wasStale())
+    {
+        _logger->writeError(parser.getStaleWarning());
+    }
     _logger->writeGraphDetails(graph->getNodes(), graph->getRails());
     _logger->writeNetworkSummary(graph->getNodeCount(), graph->getRailCount());
     return graph;
@@ -98,6 +455,10 @@ std::vector<TrainConfig> SimulationBuilder::_parseTrains(const std::string& trai
     _logger->writeProgress("Parsing train file...");
     TrainConfigParser        parser(trainFile);
     std::vector<TrainConfig> configs = parser.parse();
+    if (parser.wasStale())
+    {
+        _logger->writeError(parser.getStaleWarning());
+    }
     _logger->writeProgress(std::to_string(configs.size()) + " trains parsed");
     return configs;
 }
@@ -113,74 +474,93 @@ std::unique_ptr<IPathfindingStrategy> SimulationBuilder::_createStrategy() const
     return std::make_unique<DijkstraStrategy>();
 }
 
-std::vector<Train*> SimulationBuilder::_buildTrains(
+Train* SimulationBuilder::_buildTrain(const TrainValidationResult& result, Graph* graph)
+{
+    if (result.status == TrainValidationResult::Status::InvalidConfig)
+    {
+        _logger->writeError(result.error);
+        return nullptr;
+    }
+
+    if (result.status == TrainValidationResult::Status::NoPath)
+    {
+        _logger->writeError(
+            "No path found for train " + result.config.name +
+            " from " + result.config.departureStation +
+            " to "   + result.config.arrivalStation);
+        return nullptr;
+    }
+
+    Train* train = TrainFactory::create(result.config, graph);
+    if (!train)
+    {
+        _logger->writeError("Failed to create train: " + result.config.name);
+        return nullptr;
+    }
+
+    train->setPath(result.path);
+    _logger->writePathDebug(train);
+    _logger->writeTrainCreated(
+        train->getName(), train->getID(),
+        result.config.departureStation, result.config.arrivalStation,
+        static_cast<int>(result.path.size()));
+    return train;
+}
+
+void SimulationBuilder::_buildTrains(
     const std::vector<TrainValidationResult>& results,
-    Graph*                                    graph)
+    SimulationBundle&                         bundle)
 {
     _logger->writeProgress("Creating trains and finding paths...");
-    std::vector<Train*> trains;
 
     for (const TrainValidationResult& result : results)
     {
-        if (result.status == TrainValidationResult::Status::InvalidConfig)
-        {
-            _logger->writeError(result.error);
-            continue;
-        }
-
-        if (result.status == TrainValidationResult::Status::NoPath)
+        if (Train* train = _buildTrain(result, bundle.graph))
         {
-            _logger->writeError(
-                "No path found for train " + result.config.name +
-                " from " + result.config.departureStation +
-                " to "   + result.config.arrivalStation);
-            continue;
-        }
-
-        Train* train = TrainFactory::create(result.config, graph);
-        if (!train)
-        {
-            _logger->writeError("Failed to create train: " + result.config.name);
-            continue;
+            bundle.trains.push_back(train);
+            bundle.configs.push_back(result.config);
         }
-
-        train->setPath(result.path);
-        _logger->writePathDebug(train);
-        trains.push_back(train);
-        _logger->writeTrainCreated(
-            train->getName(), train->getID(),
-            result.config.departureStation, result.config.arrivalStation,
-            static_cast<int>(result.path.size()));
     }
-
-    return trains;
 }
 
 std::vector<FileOutputWriter*> SimulationBuilder::_createOutputWriters(
-    const std::vector<Train*>& trains)
+    const std::vector<Train*>& trains,
+    AsyncResultSink&           sink)
 {
     _logger->writeProgress("Creating output files...");
     std::vector<FileOutputWriter*> writers;
 
     for (Train* train : trains)
     {
-        double estMinutes = _estimateJourneyMinutes(train);
-
-        std::unique_ptr<FileOutputWriter> writer(new FileOutputWriter(train));
-        writer->open();
-        writer->writeHeader(estMinutes);
-        writer->writePathInfo();
-        writers.push_back(writer.release());
-
-        _logger->writeProgress(
-            "Created: output/" + train->getName() + "_" +
-            train->getDepartureTime().toString() + ".result" +
-            " (estimated: " + std::to_string(static_cast<int>(estMinutes)) + " min)");
+        writers.push_back(createOutputWriter(train, sink));
     }
 
     return writers;
 }
 
+FileOutputWriter* SimulationBuilder::createOutputWriter(Train* train, AsyncResultSink& sink)
+{
+    double estMinutes = _estimateJourneyMinutes(train);
+
+    std::unique_ptr<FileOutputWriter> writer(new FileOutputWriter(train, sink));
+    writer->open();
+    writer->writeHeader(estMinutes);
+    writer->writePathInfo();
+
+    const std::string label = train->getName() + "_" + train->getDepartureTime().toString();
+    _logger->writeProgress(
+        (_traceFile.empty() ? "Created: output/" + label + ".result"
+                            : "Tracing: " + label + " -> " + _traceFile) +
+        " (estimated: " + std::to_string(static_cast<int>(estMinutes)) + " min)");
+
+    return writer.release();
+}
+
+std::unique_ptr<LiveTrainFeed> SimulationBuilder::createLiveFeed(const std::string& source, Graph* network) const
+{
+    return std::make_unique<LiveTrainFeed>(source, network, _createStrategy());
+}
+
 double SimulationBuilder::_estimateJourneyMinutes(const Train* train)
 {
     double estMinutes = 0.0;
@@ -0,0 +1,261 @@
+#include "simulation/core/SimulationCheckpoint.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr char         MAGIC[8]   = {'R', 'S', 'I', 'M', 'C', 'K', 'P', '1'};
+    constexpr std::uint8_t MAX_EVENT  = static_cast<std::uint8_t>(EventType::WEATHER);
+
+    template <typename T>
+    void put(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(std::string& out, const std::string& text)
+    {
+        put(out, static_cast<std::uint32_t>(text.size()));
+        out += text;
+    }
+
+    void putTime(std::string& out, const Time& time)
+    {
+        put(out, static_cast<std::int32_t>(time.getHours()));
+        put(out, static_cast<std::int32_t>(time.getMinutes()));
+    }
+
+    void putEvent(std::string& out, const EventCheckpoint& event)
+    {
+        put(out, static_cast<std::uint8_t>(event.type));
+        putTime(out, event.start);
+        putTime(out, event.duration);
+        put(out, static_cast<std::uint8_t>(event.active));
+        putString(out, event.node);
+        put(out, static_cast<std::uint64_t>(event.rail));
+        putTime(out, event.extra);
+        put(out, event.speedFactor);
+        put(out, event.friction);
+        put(out, event.radiusKm);
+        putString(out, event.weatherType);
+        put(out, static_cast<std::uint32_t>(event.affectedRails.size()));
+        for (std::size_t rail : event.affectedRails)
+        {
+            put(out, static_cast<std::uint64_t>(rail));
+        }
+    }
+
+    // Bounds-checked cursor; any overrun means the checkpoint is corrupt.
+    class Cursor
+    {
+    public:
+        explicit Cursor(std::string_view bytes) : _bytes(bytes), _pos(0) {}
+
+        template <typename T>
+        T get()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        std::string_view take(std::size_t count)
+        {
+            if (count > _bytes.size() - _pos)
+            {
+                throw std::runtime_error("truncated data");
+            }
+
+            std::string_view slice = _bytes.substr(_pos, count);
+            _pos += count;
+            return slice;
+        }
+
+        std::string string() { return std::string(take(get<std::uint32_t>())); }
+        bool        flag()   { return get<std::uint8_t>() != 0; }
+
+        Time time()
+        {
+            const std::int32_t hours = get<std::int32_t>();
+            return Time(hours, get<std::int32_t>());
+        }
+
+        // Element count, checked against the bytes left (every element takes
+        // at least eight) so a corrupt count cannot trigger a huge allocation.
+        std::uint32_t count()
+        {
+            const std::uint32_t value = get<std::uint32_t>();
+            if (value > (_bytes.size() - _pos) / 8)
+            {
+                throw std::runtime_error("bad element count");
+            }
+            return value;
+        }
+
+        bool atEnd() const { return _pos == _bytes.size(); }
+
+    private:
+        std::string_view _bytes;
+        std::size_t      _pos;
+    };
+
+    EventCheckpoint getEvent(Cursor& in)
+    {
+        EventCheckpoint event;
+
+        const std::uint8_t type = in.get<std::uint8_t>();
+        if (type > MAX_EVENT)
+        {
+            throw std::runtime_error("bad event type " + std::to_string(type));
+        }
+        event.type        = static_cast<EventType>(type);
+        event.start       = in.time();
+        event.duration    = in.time();
+        event.active      = in.flag();
+        event.node        = in.string();
+        event.rail        = static_cast<std::size_t>(in.get<std::uint64_t>());
+        event.extra       = in.time();
+        event.speedFactor = in.get<double>();
+        event.friction    = in.get<double>();
+        event.radiusKm    = in.get<double>();
+        event.weatherType = in.string();
+
+        event.affectedRails.resize(in.count());
+        for (std::size_t& rail : event.affectedRails)
+        {
+            rail = static_cast<std::size_t>(in.get<std::uint64_t>());
+        }
+        return event;
+    }
+}
+
+std::string SimulationCheckpoint::serialize() const
+{
+    std::string out(MAGIC, sizeof(MAGIC));
+
+    put(out, currentTime);
+    put(out, lastEventGenerationTime);
+    put(out, nextKeyframeTime);
+    put(out, static_cast<std::int32_t>(lastSnapshotMinute));
+    put(out, static_cast<std::int32_t>(lastDashboardMinute));
+
+    put(out, static_cast<std::uint32_t>(seed));
+    put(out, static_cast<std::uint8_t>(rngStreams));
+    put(out, static_cast<std::uint8_t>(antithetic));
+    putString(out, rngState);
+    for (std::uint64_t position : streamPositions)
+    {
+        put(out, position);
+    }
+    put(out, static_cast<std::int32_t>(totalEventsGenerated));
+
+    put(out, static_cast<std::uint32_t>(trains.size()));
+    for (const TrainCheckpoint& train : trains)
+    {
+        putString(out, train.name);
+        putString(out, train.state);
+        putString(out, train.departureStation);
+        put(out, static_cast<std::uint64_t>(train.railIndex));
+        put(out, train.position);
+        put(out, train.velocity);
+        put(out, train.stopSeconds);
+        put(out, static_cast<std::uint8_t>(train.finished));
+        putTime(out, train.departureTime);
+        putString(out, train.previousState);
+        put(out, static_cast<std::uint8_t>(train.stopTimer));
+    }
+
+    for (const std::vector<EventCheckpoint>* events : {&scheduledEvents, &activeEvents})
+    {
+        put(out, static_cast<std::uint32_t>(events->size()));
+        for (const EventCheckpoint& event : *events)
+        {
+            putEvent(out, event);
+        }
+    }
+
+    put(out, static_cast<std::uint32_t>(railAttributes.size()));
+    for (const RailAttributeOverlay::Modifier& modifier : railAttributes)
+    {
+        put(out, modifier.speedFactor);
+        put(out, modifier.frictionIncrease);
+        put(out, static_cast<std::int32_t>(modifier.activeCount));
+    }
+
+    return out;
+}
+
+SimulationCheckpoint SimulationCheckpoint::deserialize(std::string_view bytes)
+{
+    SimulationCheckpoint checkpoint;
+
+    try
+    {
+        Cursor in(bytes);
+        if (in.take(sizeof(MAGIC)) != std::string_view(MAGIC, sizeof(MAGIC)))
+        {
+            throw std::runtime_error("bad magic");
+        }
+
+        checkpoint.currentTime             = in.get<double>();
+        checkpoint.lastEventGenerationTime = in.get<double>();
+        checkpoint.nextKeyframeTime        = in.get<double>();
+        checkpoint.lastSnapshotMinute      = in.get<std::int32_t>();
+        checkpoint.lastDashboardMinute     = in.get<std::int32_t>();
+
+        checkpoint.seed       = in.get<std::uint32_t>();
+        checkpoint.rngStreams = in.flag();
+        checkpoint.antithetic = in.flag();
+        checkpoint.rngState   = in.string();
+        for (std::uint64_t& position : checkpoint.streamPositions)
+        {
+            position = in.get<std::uint64_t>();
+        }
+        checkpoint.totalEventsGenerated = in.get<std::int32_t>();
+
+        checkpoint.trains.resize(in.count());
+        for (TrainCheckpoint& train : checkpoint.trains)
+        {
+            train.name             = in.string();
+            train.state            = in.string();
+            train.departureStation = in.string();
+            train.railIndex        = static_cast<std::size_t>(in.get<std::uint64_t>());
+            train.position         = in.get<double>();
+            train.velocity         = in.get<double>();
+            train.stopSeconds      = in.get<double>();
+            train.finished         = in.flag();
+            train.departureTime    = in.time();
+            train.previousState    = in.string();
+            train.stopTimer        = in.flag();
+        }
+
+        for (std::vector<EventCheckpoint>* events : {&checkpoint.scheduledEvents, &checkpoint.activeEvents})
+        {
+            const std::uint32_t count = in.count();
+            events->reserve(count);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                events->push_back(getEvent(in));
+            }
+        }
+
+        checkpoint.railAttributes.resize(in.count());
+        for (RailAttributeOverlay::Modifier& modifier : checkpoint.railAttributes)
+        {
+            modifier.speedFactor      = in.get<double>();
+            modifier.frictionIncrease = in.get<double>();
+            modifier.activeCount      = in.get<std::int32_t>();
+        }
+
+        if (!in.atEnd())
+        {
+            throw std::runtime_error("trailing bytes");
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        throw std::runtime_error(std::string("Corrupt simulation checkpoint: ") + e.what());
+    }
+
+    return checkpoint;
+}
@@ -9,6 +9,7 @@
 #include "core/Node.hpp"
 #include "core/Graph.hpp"
 #include <iostream>
+#include <iterator>
 
 SimulationContext::SimulationContext(Graph*                     network,
                                      ICollisionAvoidance*        collisionSystem,
@@ -18,7 +19,9 @@ SimulationContext::SimulationContext(Graph*                     network,
       _collisionSystem(collisionSystem),
       _trafficController(trafficController),
       _trains(trains),
-      _states()
+      _states(),
+      _railAttributes(network ? network->getRailCount() : 0),
+      _riskRefresh(0)
 {
 }
 
@@ -61,7 +64,7 @@ const RiskData& SimulationContext::getRisk(const Train* train) const
         return sentinel;
     }
 
-    return it->second;
+    return it->second.data;
 }
 
 void SimulationContext::refreshAllRiskData()
@@ -71,15 +74,24 @@ void SimulationContext::refreshAllRiskData()
         return;
     }
 
-    _riskMap.clear();
+    // Entries are overwritten in place and only trains that left the rails
+    // are erased, so a steady set of running trains allocates nothing.
+    ++_riskRefresh;
 
     for (Train* train : *_trains)
     {
         if (train && train->getCurrentRail())
         {
-            _riskMap[train] = _collisionSystem->assessRisk(train, *_trains);
+            RiskEntry& entry = _riskMap[train];
+            entry.data       = _collisionSystem->assessRisk(train, *_trains, &_railAttributes);
+            entry.refresh    = _riskRefresh;
         }
     }
+
+    for (auto it = _riskMap.begin(); it != _riskMap.end();)
+    {
+        it = (it->second.refresh == _riskRefresh) ? std::next(it) : _riskMap.erase(it);
+    }
 }
 
 double SimulationContext::getCurrentRailSpeedLimit(const Train* train) const
@@ -89,7 +101,17 @@ double SimulationContext::getCurrentRailSpeedLimit(const Train* train) const
         return 0.0;
     }
 
-    return PhysicsSystem::kmhToMs(train->getCurrentRail()->getSpeedLimit());
+    return PhysicsSystem::kmhToMs(_railAttributes.getSpeedLimit(train->getCurrentRail()));
+}
+
+double SimulationContext::getCurrentRailFrictionIncrease(const Train* train) const
+{
+    if (!train || !train->getCurrentRail())
+    {
+        return 0.0;
+    }
+
+    return _railAttributes.getFrictionIncrease(train->getCurrentRail());
 }
 
 double SimulationContext::getCurrentRailLength(const Train* train) const
@@ -104,7 +126,9 @@ double SimulationContext::getCurrentRailLength(const Train* train) const
 
 double SimulationContext::getBrakingDistance(const Train* train) const
 {
-    return train ? PhysicsSystem::calculateBrakingDistance(train) : 0.0;
+    return train
+        ? PhysicsSystem::calculateBrakingDistance(train, getCurrentRailFrictionIncrease(train))
+        : 0.0;
 }
 
 double SimulationContext::getDistanceToRailEnd(const Train* train) const
@@ -172,6 +196,11 @@ void SimulationContext::clearStopDuration(Train* train)
     _stopDurations.erase(train);
 }
 
+bool SimulationContext::hasStopDuration(const Train* train) const
+{
+    return _stopDurations.count(const_cast<Train*>(train)) != 0;
+}
+
 StateRegistry& SimulationContext::states()
 {
     return _states;
@@ -182,6 +211,16 @@ const StateRegistry& SimulationContext::states() const
     return _states;
 }
 
+RailAttributeOverlay& SimulationContext::railAttributes()
+{
+    return _railAttributes;
+}
+
+const RailAttributeOverlay& SimulationContext::railAttributes() const
+{
+    return _railAttributes;
+}
+
 ITrainController* SimulationContext::getTrafficController() const
 {
     return _trafficController;
@@ -194,7 +233,7 @@ void SimulationContext::applyForce(Train* train, double force, double dt)
         return;
     }
 
-    double netForce = PhysicsSystem::calculateNetForce(train, force);
+    double netForce = PhysicsSystem::calculateNetForce(train, force, getCurrentRailFrictionIncrease(train));
     PhysicsSystem::updateVelocity(train, netForce, dt);
     PhysicsSystem::updatePosition(train, dt);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "simulation/core/SimulationConfig.hpp"
 #include "simulation/core/SimulationContext.hpp"
 #include "simulation/services/NetworkServicesFactory.hpp"
+#include "simulation/systems/RailFootprintIndex.hpp"
 #include "patterns/behavioral/mediator/TrafficController.hpp"
 #include "patterns/creational/factories/EventFactory.hpp"
 #include "core/Train.hpp"
@@ -16,38 +17,121 @@
 #include "event_system/EventDispatcher.hpp"
 #include "event_system/EventScheduler.hpp"
 #include "events/Event.hpp"
+#include "events/StationDelayEvent.hpp"
+#include "events/TrackMaintenanceEvent.hpp"
+#include "events/SignalFailureEvent.hpp"
+#include "events/WeatherEvent.hpp"
 #include "analysis/StatsCollector.hpp"
 #include "patterns/behavioral/command/CommandManager.hpp"
 #include "patterns/behavioral/command/ICommand.hpp"
+#include "patterns/behavioral/command/ReplayKeyframe.hpp"
+#include "simulation/core/SimulationCheckpoint.hpp"
 #include "rendering/core/IRenderer.hpp"
+#include "utils/MemoryUsage.hpp"
+#include "utils/TickProfiler.hpp"
 #include <chrono>
 #include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace
+{
+    TrainKeyframe keyframeOf(const Train& train, const SimulationContext* context)
+    {
+        TrainKeyframe entry;
+        entry.name             = train.getName();
+        entry.state            = train.getCurrentState() ? train.getCurrentState()->getName() : "";
+        entry.departureStation = train.getDepartureStation();
+        entry.railIndex        = train.getCurrentRailIndex();
+        entry.position         = train.getPosition();
+        entry.velocity         = train.getVelocity();
+        entry.stopSeconds      = context ? context->getStopDuration(&train) : 0.0;
+        entry.finished         = train.isFinished();
+        return entry;
+    }
+
+    EventCheckpoint checkpointOf(const Event& event)
+    {
+        EventCheckpoint entry;
+        entry.type     = event.getType();
+        entry.start    = event.getStartTime();
+        entry.duration = event.getDuration();
+        entry.active   = event.isActive();
+
+        switch (event.getType())
+        {
+            case EventType::STATION_DELAY:
+            {
+                const StationDelayEvent& delay = static_cast<const StationDelayEvent&>(event);
+                entry.node  = delay.getStation()->getName();
+                entry.extra = delay.getAdditionalDelay();
+                break;
+            }
+            case EventType::TRACK_MAINTENANCE:
+            {
+                const TrackMaintenanceEvent& maintenance = static_cast<const TrackMaintenanceEvent&>(event);
+                entry.rail        = maintenance.getRail()->getID();
+                entry.speedFactor = maintenance.getSpeedReductionFactor();
+                break;
+            }
+            case EventType::SIGNAL_FAILURE:
+            {
+                const SignalFailureEvent& failure = static_cast<const SignalFailureEvent&>(event);
+                entry.node  = failure.getNode()->getName();
+                entry.extra = failure.getStopDuration();
+                break;
+            }
+            case EventType::WEATHER:
+            {
+                const WeatherEvent& weather = static_cast<const WeatherEvent&>(event);
+                entry.node        = weather.getCenterNode()->getName();
+                entry.weatherType = weather.getWeatherType();
+                entry.radiusKm    = weather.getRadiusKm();
+                entry.speedFactor = weather.getSpeedReductionFactor();
+                entry.friction    = weather.getFrictionIncrease();
+                for (const Rail* rail : weather.getAffectedRails())
+                {
+                    entry.affectedRails.push_back(rail->getID());
+                }
+                break;
+            }
+        }
+
+        return entry;
+    }
+}
 
 SimulationManager::SimulationManager()
     : SimulationManager(nullptr)
 {
     _ownedCollision  = std::unique_ptr<ICollisionAvoidance>(new CollisionAvoidance());
     _collisionSystem = _ownedCollision.get();
-    _networkServicesFactory = NetworkServicesFactory(_collisionSystem, &_trains);
+    _networkServicesFactory = NetworkServicesFactory(_collisionSystem, &_trains, &_eventPool);
 }
 
 SimulationManager::SimulationManager(ICollisionAvoidance* collision)
-    : _eventScheduler(_eventDispatcher),
+    : _eventScheduler(_eventDispatcher, &_eventPool),
       _rng(0),
-      _networkServicesFactory(collision, &_trains),
+      _useRngStreams(false),
+      _networkServicesFactory(collision, &_trains, &_eventPool),
       _observerManager(_eventDispatcher),
       _ownedCollision(nullptr),
       _collisionSystem(collision),
       _trafficController(nullptr),
       _context(nullptr),
       _eventFactory(nullptr),
+      _sharedFootprints(nullptr),
+      _ownedFootprints(nullptr),
+      _footprints(nullptr),
       _network(nullptr),
       _currentTime(0.0),
       _timestep(SimConfig::BASE_TIMESTEP_SECONDS),
       _simulationSpeed(SimConfig::DEFAULT_SPEED),
       _running(false),
       _roundTripEnabled(false),
+      _awaitingTrains(false),
       _lastEventGenerationTime(-60.0),
+      _nextKeyframeTime(SimConfig::REPLAY_KEYFRAME_INTERVAL_SECONDS),
       _simulationWriter(nullptr),
       _statsCollector(nullptr),
       _commandManager(nullptr),
@@ -83,12 +167,26 @@ void SimulationManager::record(ICommand* cmd)
     {
         _commandManager->record(cmd);
     }
+    else if (_commandManager)
+    {
+        _commandManager->pool().release(cmd);
+    }
     else
     {
         delete cmd;
     }
 }
 
+bool SimulationManager::isRecording() const
+{
+    return _commandManager && _commandManager->isRecording();
+}
+
+CommandPool* SimulationManager::commandPool()
+{
+    return _commandManager ? &_commandManager->pool() : nullptr;
+}
+
 void SimulationManager::resetNetworkServices()
 {
     _trafficController.reset();
@@ -96,6 +194,21 @@ void SimulationManager::resetNetworkServices()
     _eventFactory.reset();
 }
 
+RailFootprintIndex* SimulationManager::footprintsFor(Graph* network)
+{
+    const INetworkQuery* query = network;
+
+    if (_sharedFootprints && _sharedFootprints->getNetwork() == query)
+    {
+        return _sharedFootprints;
+    }
+    if (!_ownedFootprints || _ownedFootprints->getNetwork() != query)
+    {
+        _ownedFootprints.reset(new RailFootprintIndex(query));
+    }
+    return _ownedFootprints.get();
+}
+
 void SimulationManager::setNetwork(Graph* network)
 {
     _network = network;
@@ -103,11 +216,18 @@ void SimulationManager::setNetwork(Graph* network)
     resetNetworkServices();
     _rng.reseed(_rng.getSeed());
 
-    NetworkServices svc = _networkServicesFactory.build(_network, _rng, &_eventScheduler);
+    _rngStreams.reseed(_rngStreams.getSeed(), _rngStreams.isAntithetic());
+
+    _footprints = footprintsFor(_network);
+
+    NetworkServices svc = _networkServicesFactory.build(_network, _rng, &_eventScheduler,
+                                                        _useRngStreams ? &_rngStreams : nullptr,
+                                                        _footprints);
 
     _trafficController.reset(svc.trafficController);
     _context.reset(svc.context);
     _eventFactory.reset(svc.eventFactory);
+    _eventFactory->setParameters(_eventParameters);
 }
 
 void SimulationManager::addTrain(Train* train)
@@ -123,6 +243,13 @@ void SimulationManager::addTrain(Train* train)
     }
 
     _trains.push_back(train);
+    _trainsByName.emplace(train->getName(), train);
+
+    // start() wired the trains it had; a later one gets its own adapter.
+    if (_running)
+    {
+        _observerManager.wire({train}, nullptr);
+    }
 }
 
 void SimulationManager::setTimestep(double timestep)
@@ -136,14 +263,39 @@ void SimulationManager::setTimestep(double timestep)
 void SimulationManager::setEventSeed(unsigned int seed)
 {
     _rng.reseed(seed);
+    _rngStreams.reseed(seed, _rngStreams.isAntithetic());
 
     if (_network)
     {
+        RailAttributeOverlay* railAttributes = _context ? &_context->railAttributes() : nullptr;
         _eventFactory.reset(
-            _networkServicesFactory.buildEventFactory(_network, _rng, &_eventScheduler));
+            _networkServicesFactory.buildEventFactory(_network, _rng, &_eventScheduler, railAttributes,
+                                                      _useRngStreams ? &_rngStreams : nullptr,
+                                                      _footprints));
+        _eventFactory->setParameters(_eventParameters);
+    }
+}
+
+void SimulationManager::setEventSampling(bool rngStreams, bool antithetic)
+{
+    _useRngStreams = rngStreams;
+    _rngStreams.reseed(_rngStreams.getSeed(), rngStreams && antithetic);
+}
+
+void SimulationManager::setEventParameters(const EventParameters& parameters)
+{
+    _eventParameters = parameters;
+    if (_eventFactory)
+    {
+        _eventFactory->setParameters(_eventParameters);
     }
 }
 
+void SimulationManager::setFootprintIndex(RailFootprintIndex* footprints)
+{
+    _sharedFootprints = footprints;
+}
+
 void SimulationManager::setSimulationWriter(ISimulationOutput* writer)
 {
     _simulationWriter = writer;
@@ -154,6 +306,11 @@ void SimulationManager::setRoundTripMode(bool enabled)
     _roundTripEnabled = enabled;
 }
 
+void SimulationManager::setAwaitingTrains(bool awaiting)
+{
+    _awaitingTrains = awaiting;
+}
+
 void SimulationManager::registerOutputWriter(Train* train, FileOutputWriter* writer)
 {
     if (train && writer)
@@ -169,6 +326,9 @@ void SimulationManager::setStatsCollector(StatsCollector* stats)
 
 void SimulationManager::configure(const SimulationConfig& config)
 {
+    setEventSampling(config.rngStreams, config.antithetic);
+    setEventParameters(config.events);
+    setFootprintIndex(config.footprints);
     setNetwork(config.network);
     setEventSeed(config.seed);
     setRoundTripMode(config.roundTrip);
@@ -193,6 +353,11 @@ void SimulationManager::start()
 
     _observerManager.wire(_trains, _network);
     refreshSimulationState();
+
+    if (_commandManager && _commandManager->isReplaying())
+    {
+        _replayOrigin.reset(new SimulationCheckpoint(checkpoint()));
+    }
 }
 
 void SimulationManager::stop()
@@ -211,30 +376,59 @@ void SimulationManager::step()
     tick(false, true);
 }
 
-void SimulationManager::tick(bool replayMode, bool advanceTime)
+void SimulationManager::tick(bool replayMode, bool advanceTime, bool report)
 {
-    _lifecycle.checkDepartures();
-    refreshSimulationState();
+    PROFILE_PHASE(TickPhase::Tick);
 
-    if (replayMode && _commandManager)
+    if (isRecording() && _currentTime >= _nextKeyframeTime)
     {
-        applyReplayCommands();
+        captureKeyframe();
     }
-    else
+
     {
-        _lifecycle.handleStateTransitions();
+        PROFILE_PHASE(TickPhase::CheckDepartures);
+        _lifecycle.checkDepartures();
+    }
+    {
+        PROFILE_PHASE(TickPhase::RefreshState);
+        refreshSimulationState();
+    }
+    {
+        PROFILE_PHASE(TickPhase::StateTransitions);
+        if (replayMode && _commandManager)
+        {
+            applyReplayCommands();
+        }
+        else
+        {
+            _lifecycle.handleStateTransitions();
+        }
+    }
+    {
+        PROFILE_PHASE(TickPhase::UpdateTrainStates);
+        _lifecycle.updateTrainStates(_timestep);
+    }
+    {
+        PROFILE_PHASE(TickPhase::EventPipeline);
+        _eventPipeline.update();
     }
-
-    _lifecycle.updateTrainStates(_timestep);
-    _eventPipeline.update();
 
     if (advanceTime)
     {
         _currentTime += _timestep;
     }
 
-    _reporting.writeSnapshots();
-    _reporting.updateDashboard();
+    if (report)
+    {
+        {
+            PROFILE_PHASE(TickPhase::WriteSnapshots);
+            _reporting.writeSnapshots();
+        }
+        {
+            PROFILE_PHASE(TickPhase::UpdateDashboard);
+            _reporting.updateDashboard();
+        }
+    }
 }
 
 void SimulationManager::run(double maxTime,
@@ -245,7 +439,10 @@ void SimulationManager::run(double maxTime,
 {
     using clock = std::chrono::steady_clock;
 
-    start();
+    if (!_running)
+    {
+        start();
+    }
 
     if (renderMode && renderer)
     {
@@ -306,21 +503,423 @@ void SimulationManager::simulationTick(bool replayMode)
 
 void SimulationManager::applyReplayCommands()
 {
-    std::vector<ICommand*> commands =
-        _commandManager->getCommandsForTime(_currentTime, _currentTime + _timestep);
+    _commandManager->consumeUntil(_currentTime + _timestep,
+                                  [this](ICommand* command)
+                                  {
+                                      command->applyReplay(static_cast<IReplayTarget*>(this));
+                                  });
+}
 
-    for (ICommand* command : commands)
+void SimulationManager::captureKeyframe()
+{
+    ReplayKeyframe keyframe;
+    keyframe.time = _currentTime;
+    keyframe.trains.reserve(_trains.size());
+
+    for (const Train* train : _trains)
     {
-        if (command)
+        keyframe.trains.push_back(keyframeOf(*train, _context.get()));
+    }
+
+    _commandManager->addKeyframe(keyframe);
+
+    while (_nextKeyframeTime <= _currentTime)
+    {
+        _nextKeyframeTime += SimConfig::REPLAY_KEYFRAME_INTERVAL_SECONDS;
+    }
+}
+
+void SimulationManager::restoreTrain(Train& train, const TrainKeyframe& entry, const Time& departureTime)
+{
+    StateRegistry& states = _context->states();
+
+    // Rewind the current leg, then replay the journey shape.
+    const Train::Path path = train.getPath();
+    train.resetJourney(path, departureTime);
+    if (train.getDepartureStation() != entry.departureStation)
+    {
+        train.reverseJourney();
+    }
+    while (train.getCurrentRailIndex() < entry.railIndex &&
+           train.getCurrentRailIndex() < train.getPath().size())
+    {
+        train.advanceToNextRail();
+    }
+
+    train.setPosition(entry.position);
+    train.setVelocity(entry.velocity);
+
+    ITrainState* state = states.fromName(entry.state);
+    train.setState(state ? state : states.idle());
+    if (entry.finished)
+    {
+        train.markFinished();
+    }
+}
+
+void SimulationManager::restoreKeyframe(const ReplayKeyframe& keyframe)
+{
+    for (const TrainKeyframe& entry : keyframe.trains)
+    {
+        Train* train = findTrain(entry.name);
+        if (!train)
+        {
+            continue;
+        }
+
+        restoreTrain(*train, entry, train->getDepartureTime());
+
+        if (entry.stopSeconds > 0.0)
+        {
+            _context->setStopDuration(train, entry.stopSeconds);
+        }
+        else
+        {
+            _context->clearStopDuration(train);
+        }
+
+        _previousStates[train] = train->getCurrentState();
+    }
+}
+
+SimulationCheckpoint SimulationManager::checkpoint() const
+{
+    if (!_context)
+    {
+        throw std::logic_error("checkpoint needs a network");
+    }
+
+    SimulationCheckpoint checkpoint;
+    checkpoint.currentTime             = _currentTime;
+    checkpoint.lastEventGenerationTime = _lastEventGenerationTime;
+    checkpoint.nextKeyframeTime        = _nextKeyframeTime;
+    checkpoint.lastSnapshotMinute      = _lastSnapshotMinute;
+    checkpoint.lastDashboardMinute     = _lastDashboardMinute;
+
+    checkpoint.seed       = _rng.getSeed();
+    checkpoint.rngStreams = _useRngStreams;
+    checkpoint.antithetic = _rngStreams.isAntithetic();
+    checkpoint.rngState   = _rng.saveState();
+    for (std::size_t site = 0; site < EventRngStreams::SITE_COUNT; ++site)
+    {
+        checkpoint.streamPositions[site] = _rngStreams[static_cast<EventRngSite>(site)].position();
+    }
+    checkpoint.totalEventsGenerated = _eventScheduler.getTotalEventsGenerated();
+
+    checkpoint.trains.reserve(_trains.size());
+    for (Train* train : _trains)
+    {
+        TrainCheckpoint entry;
+        static_cast<TrainKeyframe&>(entry) = keyframeOf(*train, _context.get());
+        entry.departureTime = train->getDepartureTime();
+        entry.stopTimer     = _context->hasStopDuration(train);
+
+        auto previous = _previousStates.find(train);
+        if (previous != _previousStates.end() && previous->second)
         {
-            command->applyReplay(static_cast<IReplayTarget*>(this));
+            entry.previousState = previous->second->getName();
         }
+        checkpoint.trains.push_back(entry);
+    }
+
+    for (const Event* event : _eventScheduler.getScheduledEvents())
+    {
+        checkpoint.scheduledEvents.push_back(checkpointOf(*event));
     }
+    for (const Event* event : _eventScheduler.getActiveEvents())
+    {
+        checkpoint.activeEvents.push_back(checkpointOf(*event));
+    }
+    checkpoint.railAttributes = _context->railAttributes().getModifiers();
+
+    return checkpoint;
+}
+
+void SimulationManager::restoreEvents(const SimulationCheckpoint& checkpoint)
+{
+    RailAttributeOverlay* railAttributes = &_context->railAttributes();
+
+    std::vector<Rail*> railsById(railAttributes->size(), nullptr);
+    for (Rail* rail : _network->getRails())
+    {
+        if (rail->getID() < railsById.size())
+        {
+            railsById[rail->getID()] = rail;
+        }
+    }
+
+    auto node = [this](const std::string& name)
+    {
+        Node* found = _network->getNode(name);
+        if (!found)
+        {
+            throw std::runtime_error("Checkpoint does not match the network: no node '" + name + "'");
+        }
+        return found;
+    };
+    auto rail = [&railsById](std::size_t id)
+    {
+        if (id >= railsById.size() || !railsById[id])
+        {
+            throw std::runtime_error("Checkpoint does not match the network: no rail " + std::to_string(id));
+        }
+        return railsById[id];
+    };
+
+    // Rebuilt from constructor arguments; the overlay they had applied is
+    // restored as a whole below, so no event is activated again.
+    auto rebuild = [&](const EventCheckpoint& entry) -> Event*
+    {
+        Event* event = nullptr;
+
+        switch (entry.type)
+        {
+            case EventType::STATION_DELAY:
+                event = _eventPool.create<StationDelayEvent>(node(entry.node), entry.start,
+                                                             entry.duration, entry.extra);
+                break;
+            case EventType::TRACK_MAINTENANCE:
+                event = _eventPool.create<TrackMaintenanceEvent>(rail(entry.rail), entry.start, entry.duration,
+                                                                 entry.speedFactor, railAttributes);
+                break;
+            case EventType::SIGNAL_FAILURE:
+                event = _eventPool.create<SignalFailureEvent>(node(entry.node), entry.start,
+                                                              entry.duration, entry.extra);
+                break;
+            case EventType::WEATHER:
+            {
+                WeatherEvent* weather = _eventPool.create<WeatherEvent>(
+                    entry.weatherType, node(entry.node), entry.start, entry.duration,
+                    entry.radiusKm, entry.speedFactor, entry.friction, railAttributes);
+
+                std::vector<Rail*> affected;
+                for (std::size_t id : entry.affectedRails)
+                {
+                    affected.push_back(rail(id));
+                }
+                weather->setAffectedRails(affected);
+                event = weather;
+                break;
+            }
+        }
+
+        event->restoreActive(entry.active);
+        return event;
+    };
+
+    std::vector<Event*> scheduled;
+    std::vector<Event*> active;
+    try
+    {
+        for (const EventCheckpoint& entry : checkpoint.scheduledEvents)
+        {
+            scheduled.push_back(rebuild(entry));
+        }
+        for (const EventCheckpoint& entry : checkpoint.activeEvents)
+        {
+            active.push_back(rebuild(entry));
+        }
+    }
+    catch (...)
+    {
+        for (Event* event : scheduled)
+        {
+            _eventPool.release(event);
+        }
+        for (Event* event : active)
+        {
+            _eventPool.release(event);
+        }
+        throw;
+    }
+
+    _eventScheduler.restore(scheduled, active, checkpoint.totalEventsGenerated);
+    railAttributes->setModifiers(checkpoint.railAttributes);
+}
+
+void SimulationManager::restore(const SimulationCheckpoint& checkpoint)
+{
+    if (!_network || !_context)
+    {
+        throw std::logic_error("restore needs a network");
+    }
+    if (checkpoint.railAttributes.size() != _context->railAttributes().size())
+    {
+        throw std::runtime_error("Checkpoint does not match the network: rail count differs");
+    }
+    for (const TrainCheckpoint& entry : checkpoint.trains)
+    {
+        if (!findTrain(entry.name))
+        {
+            throw std::runtime_error("Checkpoint does not match the trains: no train '" + entry.name + "'");
+        }
+    }
+
+    if (!_running)
+    {
+        start();
+    }
+
+    // Rebuilds the event factory on the restored generators.
+    setEventSampling(checkpoint.rngStreams, checkpoint.antithetic);
+    setEventSeed(checkpoint.seed);
+    _rng.loadState(checkpoint.rngState);
+    for (std::size_t site = 0; site < EventRngStreams::SITE_COUNT; ++site)
+    {
+        _rngStreams[static_cast<EventRngSite>(site)].seek(checkpoint.streamPositions[site]);
+    }
+
+    restoreEvents(checkpoint);
+
+    StateRegistry& states = _context->states();
+    for (const TrainCheckpoint& entry : checkpoint.trains)
+    {
+        Train* train = findTrain(entry.name);
+        restoreTrain(*train, entry, entry.departureTime);
+
+        if (entry.stopTimer)
+        {
+            _context->setStopDuration(train, entry.stopSeconds);
+        }
+        else
+        {
+            _context->clearStopDuration(train);
+        }
+
+        ITrainState* previous = states.fromName(entry.previousState);
+        if (previous)
+        {
+            _previousStates[train] = previous;
+        }
+        else
+        {
+            _previousStates.erase(train);
+        }
+    }
+
+    _currentTime             = checkpoint.currentTime;
+    _lastEventGenerationTime = checkpoint.lastEventGenerationTime;
+    _nextKeyframeTime        = checkpoint.nextKeyframeTime;
+    _lastSnapshotMinute      = checkpoint.lastSnapshotMinute;
+    _lastDashboardMinute     = checkpoint.lastDashboardMinute;
+
+    refreshSimulationState();
+}
+
+SimulationFork::SimulationFork()                                 = default;
+SimulationFork::SimulationFork(SimulationFork&&)                 = default;
+SimulationFork& SimulationFork::operator=(SimulationFork&&)      = default;
+SimulationFork::~SimulationFork()                                = default;
+
+SimulationFork SimulationManager::fork() const
+{
+    if (!_network || !_context)
+    {
+        throw std::logic_error("fork needs a network");
+    }
+
+    SimulationFork branch;
+    branch.simulation.reset(new SimulationManager());
+
+    SimulationManager& child = *branch.simulation;
+    child.setTimestep(_timestep);
+    child.setEventParameters(_eventParameters);
+    child.setRoundTripMode(_roundTripEnabled);
+    child.setSimulationSpeed(_simulationSpeed);
+    child.setNetwork(_network);
+
+    branch.trains.reserve(_trains.size());
+    for (const Train* train : _trains)
+    {
+        branch.trains.push_back(train->clone());
+        child.addTrain(branch.trains.back().get());
+    }
+
+    child.restore(checkpoint());
+    return branch;
+}
+
+void SimulationManager::reload(Graph* network, const TrainList& trains, const SimulationCheckpoint& checkpoint)
+{
+    const std::unordered_set<Train*> listed(trains.begin(), trains.end());
+
+    for (auto it = _outputWriters.begin(); it != _outputWriters.end();)
+    {
+        it = listed.count(it->first) ? std::next(it) : _outputWriters.erase(it);
+    }
+    for (auto it = _previousStates.begin(); it != _previousStates.end();)
+    {
+        it = listed.count(it->first) ? std::next(it) : _previousStates.erase(it);
+    }
+
+    // Events and observers point into the old network; restore() rebuilds
+    // the events and setNetwork() every network-bound service.
+    _observerManager.clear();
+    _eventScheduler.clear();
+    _trains.clear();
+    _trainsByName.clear();
+    _running = false;  // addTrain() below must not wire trains one by one
+
+    // The new network may sit where the old one was freed: never reuse its footprints.
+    _ownedFootprints.reset();
+    setNetwork(network);
+    for (Train* train : trains)
+    {
+        addTrain(train);
+    }
+    _observerManager.wire(_trains, _network);
+
+    _running = true;
+    restore(checkpoint);
+}
+
+double SimulationManager::seekReplay(double time)
+{
+    if (!_commandManager || !_context)
+    {
+        throw std::logic_error("seekReplay needs a replay command manager and a network");
+    }
+    if (time < _currentTime)
+    {
+        if (!_replayOrigin)
+        {
+            throw std::logic_error("seekReplay backwards needs the replay command manager set before start()");
+        }
+        restore(*_replayOrigin);
+    }
+
+    double                from     = _currentTime;
+    const ReplayKeyframe* keyframe = _commandManager->keyframeAtOrBefore(time);
+
+    if (keyframe && keyframe->time > _currentTime)
+    {
+        // No train ticks, so this writes nothing: only the event scheduler
+        // and the rail overlays move forward, then every train is set from
+        // the keyframe.
+        while (_currentTime < keyframe->time)
+        {
+            _eventPipeline.update();
+            _currentTime += _timestep;
+        }
+
+        restoreKeyframe(*keyframe);
+        from = keyframe->time;
+    }
+
+    _commandManager->seek(_currentTime);
+
+    while (_currentTime < time)
+    {
+        tick(true, true, false);
+    }
+
+    refreshSimulationState();
+    return from;
 }
 
 bool SimulationManager::shouldStopEarly(bool replayMode)
 {
-    if (_roundTripEnabled || replayMode)
+    if (_roundTripEnabled || _awaitingTrains || replayMode)
     {
         return false;
     }
@@ -400,15 +999,8 @@ void SimulationManager::setSimulationSpeed(double speed)
 
 Train* SimulationManager::findTrain(const std::string& name) const
 {
-    for (Train* train : _trains)
-    {
-        if (train && train->getName() == name)
-        {
-            return train;
-        }
-    }
-
-    return nullptr;
+    auto it = _trainsByName.find(name);
+    return (it != _trainsByName.end()) ? it->second : nullptr;
 }
 
 SimulationContext* SimulationManager::getContext() const
@@ -416,16 +1008,49 @@ SimulationContext* SimulationManager::getContext() const
     return _context.get();
 }
 
+const EventPool& SimulationManager::getEventPool() const
+{
+    return _eventPool;
+}
+
+MemoryReport SimulationManager::getMemoryReport() const
+{
+    MemoryReport report;
+    report.graph = _network ? _network->getMemoryUsage() : 0;
+
+    report.trains = MemoryUsage::heapBytes(_trains) + MemoryUsage::heapBytes(_previousStates);
+    for (const Train* train : _trains)
+    {
+        report.trains += train->getMemoryUsage();
+    }
+
+    report.events = _eventPool.stats().reservedBytes
+                  + MemoryUsage::heapBytes(_eventScheduler.getScheduledEvents())
+                  + MemoryUsage::heapBytes(_eventScheduler.getActiveEvents());
+
+    report.commandLog = _commandManager ? _commandManager->getMemoryUsage() : 0;
+
+    report.outputBuffers = MemoryUsage::heapBytes(_outputWriters);
+    for (const auto& entry : _outputWriters)
+    {
+        report.outputBuffers += entry.second->getMemoryUsage();
+    }
+    return report;
+}
+
 void SimulationManager::reset()
 {
     cleanupOutputWriters();
     _trains.clear();
+    _trainsByName.clear();
     _previousStates.clear();
     _currentTime             = 0.0;
     _running                 = false;
+    _awaitingTrains          = false;
     _lastSnapshotMinute      = -1;
     _lastDashboardMinute     = -1;
     _lastEventGenerationTime = -60.0;
+    _nextKeyframeTime        = SimConfig::REPLAY_KEYFRAME_INTERVAL_SECONDS;
     _statsCollector          = nullptr;
     _commandManager          = nullptr;
 
@@ -433,6 +1058,12 @@ void SimulationManager::reset()
     _observerManager.clear();
 
     resetNetworkServices();
-
-    _network = nullptr;
+    setEventSampling(false, false);
+    _eventParameters = EventParameters();
+
+    // The next network may be allocated where this one was.
+    _sharedFootprints = nullptr;
+    _ownedFootprints.reset();
+    _footprints       = nullptr;
+    _network          = nullptr;
 }
\ No newline at end of file
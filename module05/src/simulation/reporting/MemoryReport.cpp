@@ -0,0 +1,19 @@
+#include "simulation/reporting/MemoryReport.hpp"
+#include <cstdio>
+
+namespace
+{
+    std::string kib(std::size_t bytes)
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.1f KiB", static_cast<double>(bytes) / 1024.0);
+        return text;
+    }
+}
+
+std::string MemoryReport::toString() const
+{
+    return "graph " + kib(graph) + ", trains " + kib(trains) + ", events " + kib(events)
+         + ", command log " + kib(commandLog) + ", output buffers " + kib(outputBuffers)
+         + " (total " + kib(total()) + ")";
+}
@@ -9,12 +9,14 @@
 #include "simulation/interfaces/IEventScheduler.hpp"
 
 NetworkServicesFactory::NetworkServicesFactory(ICollisionAvoidance*       collisionSystem,
-                                               const std::vector<Train*>* trains)
-    : _collisionSystem(collisionSystem), _trains(trains)
+                                               const std::vector<Train*>* trains,
+                                               EventPool*                 eventPool)
+    : _collisionSystem(collisionSystem), _trains(trains), _eventPool(eventPool)
 {
 }
 
-NetworkServices NetworkServicesFactory::build(Graph* network, IRng& rng, IEventScheduler* eventScheduler) const
+NetworkServices NetworkServicesFactory::build(Graph* network, IRng& rng, IEventScheduler* eventScheduler,
+                                              EventRngStreams* streams, RailFootprintIndex* footprints) const
 {
     NetworkServices services;
 
@@ -23,12 +25,23 @@ NetworkServices NetworkServicesFactory::build(Graph* network, IRng& rng, IEventS
     services.context = new SimulationContext(network, _collisionSystem,
                                              _trains, services.trafficController);
 
-    services.eventFactory = new EventFactory(rng, static_cast<const INetworkQuery*>(network), eventScheduler);
+    services.eventFactory = buildEventFactory(network, rng, eventScheduler,
+                                              &services.context->railAttributes(), streams, footprints);
 
     return services;
 }
 
-EventFactory* NetworkServicesFactory::buildEventFactory(Graph* network, IRng& rng, IEventScheduler* eventScheduler) const
+EventFactory* NetworkServicesFactory::buildEventFactory(Graph* network, IRng& rng, IEventScheduler* eventScheduler,
+                                                       RailAttributeOverlay* railAttributes,
+                                                       EventRngStreams* streams,
+                                                       RailFootprintIndex* footprints) const
 {
-    return new EventFactory(rng, static_cast<const INetworkQuery*>(network), eventScheduler);
+    if (streams)
+    {
+        return new EventFactory(*streams, static_cast<const INetworkQuery*>(network), eventScheduler,
+                                railAttributes, _eventPool, footprints);
+    }
+
+    return new EventFactory(rng, static_cast<const INetworkQuery*>(network), eventScheduler,
+                            railAttributes, _eventPool, footprints);
 }
\ No newline at end of file
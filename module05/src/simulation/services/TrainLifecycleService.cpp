@@ -86,8 +86,7 @@ void TrainLifecycleService::checkDepartures()
 
             if (_recorder)
             {
-                _recorder->record(
-                    new TrainDepartureCommand(_currentTime, train->getName()));
+                _recorder->emplace<TrainDepartureCommand>(_currentTime, train->getName());
             }
         }
     }
@@ -118,14 +117,13 @@ void TrainLifecycleService::handleStateTransitions()
 
         train->setState(newState);
 
-        if (_recorder)
+        if (_recorder && _recorder->isRecording())
         {
-            _recorder->record(
-                new TrainStateChangeCommand(
-                    _currentTime,
-                    train->getName(),
-                    prevStateName,
-                    newState->getName()));
+            _recorder->emplace<TrainStateChangeCommand>(
+                _currentTime,
+                train->getName(),
+                prevStateName,
+                newState->getName());
         }
     }
 }
@@ -151,7 +149,7 @@ void TrainLifecycleService::updateTrainStates(double dt)
             continue;
         }
 
-        train->update(dt);
+        train->update(dt, _context.get());
 
         if (train->getCurrentState() == _context->states().stopped())
         {
@@ -189,11 +187,10 @@ void TrainLifecycleService::updateTrainStates(double dt)
         MovementSystem::resolveProgress(train, _context.get(), activeEvents);
         std::size_t newRailIndex = train->getCurrentRailIndex();
 
-        if (newRailIndex != prevRailIndex && _recorder)
+        if (newRailIndex != prevRailIndex && _recorder && _recorder->isRecording())
         {
-            _recorder->record(
-                new TrainAdvanceRailCommand(
-                    _currentTime, train->getName(), newRailIndex));
+            _recorder->emplace<TrainAdvanceRailCommand>(
+                _currentTime, train->getName(), newRailIndex);
         }
     }
 }
\ No newline at end of file
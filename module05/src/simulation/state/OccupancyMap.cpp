@@ -83,12 +83,12 @@ void OccupancyMap::clearAll(const std::vector<Rail*>& rails)
     {
         if (rail)
         {
-            auto it = _map.find(rail);
-
-            if (it != _map.end())
+            std::vector<Train*>& occupants = _map[rail];
+            occupants.clear();
+            if (occupants.capacity() == 0)
             {
-                it->second.clear();
+                occupants.reserve(1);
             }
         }
     }
-}
\ No newline at end of file
+}
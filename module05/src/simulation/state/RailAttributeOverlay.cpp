@@ -0,0 +1,115 @@
+#include "simulation/state/RailAttributeOverlay.hpp"
+#include "core/Rail.hpp"
+
+RailAttributeOverlay::RailAttributeOverlay(std::size_t railCount)
+    : _modifiers(railCount)
+{
+}
+
+void RailAttributeOverlay::reset(std::size_t railCount)
+{
+    _modifiers.assign(railCount, Modifier());
+}
+
+std::size_t RailAttributeOverlay::size() const
+{
+    return _modifiers.size();
+}
+
+const RailAttributeOverlay::Modifier* RailAttributeOverlay::find(const Rail* rail) const
+{
+    if (!rail || rail->getID() >= _modifiers.size())
+    {
+        return nullptr;
+    }
+
+    return &_modifiers[rail->getID()];
+}
+
+RailAttributeOverlay::Modifier* RailAttributeOverlay::find(const Rail* rail)
+{
+    if (!rail || rail->getID() >= _modifiers.size())
+    {
+        return nullptr;
+    }
+
+    return &_modifiers[rail->getID()];
+}
+
+void RailAttributeOverlay::applyModifier(const Rail* rail, double speedFactor, double frictionIncrease)
+{
+    Modifier* entry = find(rail);
+
+    if (!entry)
+    {
+        return;
+    }
+
+    entry->speedFactor      *= speedFactor;
+    entry->frictionIncrease += frictionIncrease;
+    ++entry->activeCount;
+}
+
+void RailAttributeOverlay::removeModifier(const Rail* rail, double speedFactor, double frictionIncrease)
+{
+    Modifier* entry = find(rail);
+
+    if (!entry || entry->activeCount == 0)
+    {
+        return;
+    }
+
+    --entry->activeCount;
+
+    // Snap back to exact base values once nothing is applied so that
+    // floating-point residue from multiply/divide never accumulates.
+    if (entry->activeCount == 0)
+    {
+        *entry = Modifier();
+        return;
+    }
+
+    if (speedFactor > 0.0)
+    {
+        entry->speedFactor /= speedFactor;
+    }
+    entry->frictionIncrease -= frictionIncrease;
+}
+
+double RailAttributeOverlay::getSpeedLimit(const Rail* rail) const
+{
+    if (!rail)
+    {
+        return 0.0;
+    }
+
+    return rail->getSpeedLimit() * getSpeedFactor(rail);
+}
+
+double RailAttributeOverlay::getSpeedFactor(const Rail* rail) const
+{
+    const Modifier* entry = find(rail);
+    return entry ? entry->speedFactor : 1.0;
+}
+
+double RailAttributeOverlay::getFrictionIncrease(const Rail* rail) const
+{
+    const Modifier* entry = find(rail);
+    return entry ? entry->frictionIncrease : 0.0;
+}
+
+bool RailAttributeOverlay::isModified(const Rail* rail) const
+{
+    const Modifier* entry = find(rail);
+    return entry && entry->activeCount > 0;
+}
+
+const std::vector<RailAttributeOverlay::Modifier>& RailAttributeOverlay::getModifiers() const
+{
+    return _modifiers;
+}
+
+void RailAttributeOverlay::setModifiers(const std::vector<Modifier>& modifiers)
+{
+    _modifiers = modifiers;
+}
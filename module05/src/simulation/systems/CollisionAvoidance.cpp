@@ -1,5 +1,6 @@
 #include "simulation/systems/CollisionAvoidance.hpp"
 #include "simulation/state/OccupancyMap.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 #include "simulation/physics/RiskData.hpp"
 #include "core/Train.hpp"
 #include "core/Rail.hpp"
@@ -32,7 +33,8 @@ void CollisionAvoidance::refreshRailOccupancy(const std::vector<Train*>& trains,
     }
 }
 
-RiskData CollisionAvoidance::assessRisk(const Train* train, const std::vector<Train*>& allTrains) const
+RiskData CollisionAvoidance::assessRisk(const Train* train, const std::vector<Train*>& allTrains,
+                                        const RailAttributeOverlay* railAttributes) const
 {
 	RiskData data;
 	
@@ -51,13 +53,18 @@ RiskData CollisionAvoidance::assessRisk(const Train* train, const std::vector<Tr
 		data.closingSpeed = calculateClosingSpeed(train, data.leader);
 	}
 	
-	// Physical constraints
-	data.brakingDistance = calculateBrakingDistance(train);
-	data.safeDistance = calculateSafeDistance(train);
+	// Physical constraints (rail friction increase from the overlay, if any)
+	double extraFriction = 0.0;
+	if (railAttributes && train->getCurrentRail())
+	{
+		extraFriction = railAttributes->getFrictionIncrease(train->getCurrentRail());
+	}
+	data.brakingDistance = calculateBrakingDistance(train, extraFriction);
+	data.safeDistance = calculateSafeDistance(train, data.brakingDistance);
 	
 	// Rail constraints
-	data.currentSpeedLimit = getCurrentSpeedLimit(train);
-	data.nextSpeedLimit = getNextSpeedLimit(train);
+	data.currentSpeedLimit = getCurrentSpeedLimit(train, railAttributes);
+	data.nextSpeedLimit = getNextSpeedLimit(train, railAttributes);
 	
 	return data;
 }
@@ -229,17 +236,17 @@ double CollisionAvoidance::calculateClosingSpeed(const Train* train, const Train
 	return train->getVelocity() - leader->getVelocity();
 }
 
-double CollisionAvoidance::calculateBrakingDistance(const Train* train) const
+double CollisionAvoidance::calculateBrakingDistance(const Train* train, double extraFrictionCoef) const
 {
 	if (!train)
 	{
 		return 0.0;
 	}
 	
-	return PhysicsSystem::calculateBrakingDistance(train);
+	return PhysicsSystem::calculateBrakingDistance(train, extraFrictionCoef);
 }
 
-double CollisionAvoidance::calculateSafeDistance(const Train* train) const
+double CollisionAvoidance::calculateSafeDistance(const Train* train, double brakingDistance) const
 {
 	if (!train)
 	{
@@ -251,7 +258,7 @@ double CollisionAvoidance::calculateSafeDistance(const Train* train) const
 	double speedBasedMargin = train->getVelocity() * timeHeadway;
 	
 	// Add braking distance buffer
-	double brakingMargin = calculateBrakingDistance(train);
+	double brakingMargin = brakingDistance;
 	
 	// Minimum clearance
 	double minClearance = 50.0;  // meters
@@ -259,7 +266,7 @@ double CollisionAvoidance::calculateSafeDistance(const Train* train) const
 	return minClearance + speedBasedMargin + brakingMargin;
 }
 
-double CollisionAvoidance::getCurrentSpeedLimit(const Train* train) const
+double CollisionAvoidance::getCurrentSpeedLimit(const Train* train, const RailAttributeOverlay* attrs) const
 {
 	if (!train)
 	{
@@ -272,10 +279,10 @@ double CollisionAvoidance::getCurrentSpeedLimit(const Train* train) const
 		return 0.0;
 	}
 	
-	return PhysicsSystem::kmhToMs(rail->getSpeedLimit());
+	return PhysicsSystem::kmhToMs(attrs ? attrs->getSpeedLimit(rail) : rail->getSpeedLimit());
 }
 
-double CollisionAvoidance::getNextSpeedLimit(const Train* train) const
+double CollisionAvoidance::getNextSpeedLimit(const Train* train, const RailAttributeOverlay* attrs) const
 {
 	if (!train)
 	{
@@ -289,5 +296,5 @@ double CollisionAvoidance::getNextSpeedLimit(const Train* train) const
 	}
 	
 	Rail* nextRail = train->getPath()[nextIndex].rail;
-	return PhysicsSystem::kmhToMs(nextRail->getSpeedLimit());
+	return PhysicsSystem::kmhToMs(attrs ? attrs->getSpeedLimit(nextRail) : nextRail->getSpeedLimit());
 }
\ No newline at end of file
@@ -11,8 +11,21 @@
 #include "analysis/StatsCollector.hpp"
 #include "core/Train.hpp"
 #include "utils/Time.hpp"
+#include <algorithm>
+#include <iterator>
 #include <map>
 
+namespace
+{
+    // Ended events are logged by type name, in alphabetical order.
+    constexpr EventType ENDED_ORDER[] = {
+        EventType::SIGNAL_FAILURE,
+        EventType::STATION_DELAY,
+        EventType::TRACK_MAINTENANCE,
+        EventType::WEATHER
+    };
+}
+
 EventPipeline::EventPipeline(
     std::unique_ptr<EventFactory>&           eventFactory,
     EventScheduler&                          eventScheduler,
@@ -50,37 +63,29 @@ void EventPipeline::update()
 
     Time currentTimeFormatted = Time::fromSeconds(_currentTime);
 
-    const std::vector<Event*>& previousActive = _eventScheduler.getActiveEvents();
-    std::map<std::string, int> preCounts;
-    for (Event* e : previousActive)
+    // Counted per type and snapshotted into a reused vector: the steady
+    // tick allocates nothing here.
+    auto countByType = [](const std::vector<Event*>& events)
     {
-        preCounts[Event::typeToString(e->getType())]++;
-    }
+        TypeCounts counts{};
+        for (Event* e : events)
+        {
+            ++counts[static_cast<std::size_t>(e->getType())];
+        }
+        return counts;
+    };
 
-    std::vector<Event*> prevActiveSnapshot = previousActive;
+    const std::vector<Event*>& previousActive = _eventScheduler.getActiveEvents();
+    const TypeCounts           preCounts      = countByType(previousActive);
+    _previousActive.assign(previousActive.begin(), previousActive.end());
 
     _eventScheduler.update(currentTimeFormatted);
     const std::vector<Event*>& currentActive = _eventScheduler.getActiveEvents();
-
-    std::map<std::string, int> postCounts;
-    for (Event* e : currentActive)
-    {
-        postCounts[Event::typeToString(e->getType())]++;
-    }
+    const TypeCounts           postCounts    = countByType(currentActive);
 
     for (Event* event : currentActive)
     {
-        bool isNew = true;
-        for (Event* prev : prevActiveSnapshot)
-        {
-            if (prev == event)
-            {
-                isNew = false;
-                break;
-            }
-        }
-
-        if (isNew)
+        if (std::find(_previousActive.begin(), _previousActive.end(), event) == _previousActive.end())
         {
             notifyNewEvent(event);
         }
@@ -113,13 +118,12 @@ void EventPipeline::notifyNewEvent(Event* event)
 
     logEventForAffectedTrains(event, "ACTIVATED");
 
-    if (_recorder)
+    if (_recorder && _recorder->isRecording())
     {
-        _recorder->record(
-            new SimEventCommand(
-                _currentTime,
-                eventTypeStr,
-                event->getDescription()));
+        _recorder->emplace<SimEventCommand>(
+            _currentTime,
+            eventTypeStr,
+            event->getDescription());
     }
 
     if (_simulationWriter && _context && _context->hasAnyActiveTrain())
@@ -129,10 +133,10 @@ void EventPipeline::notifyNewEvent(Event* event)
     }
 }
 
-void EventPipeline::notifyEndedEvents(
-    const std::map<std::string, int>& preCounts,
-    const std::map<std::string, int>& postCounts)
+void EventPipeline::notifyEndedEvents(const TypeCounts& preCounts, const TypeCounts& postCounts)
 {
+    static_assert(std::size(ENDED_ORDER) == std::tuple_size<TypeCounts>::value, "one count per EventType");
+
     if (!_simulationWriter)
     {
         return;
@@ -140,19 +144,16 @@ void EventPipeline::notifyEndedEvents(
 
     Time t = Time::fromSeconds(_currentTime);
 
-    for (const auto& kv : preCounts)
+    for (EventType type : ENDED_ORDER)
     {
-        const std::string& typeStr   = kv.first;
-        int                prevCount = kv.second;
-        int                currCount = 0;
-
-        auto it = postCounts.find(typeStr);
-        if (it != postCounts.end())
+        const std::size_t index = static_cast<std::size_t>(type);
+        if (preCounts[index] <= postCounts[index])
         {
-            currCount = it->second;
+            continue;
         }
 
-        for (int i = 0; i < prevCount - currCount; ++i)
+        const std::string typeStr = Event::typeToString(type);
+        for (int i = 0; i < preCounts[index] - postCounts[index]; ++i)
         {
             _simulationWriter->writeEventEnded(t, typeStr);
         }
@@ -42,7 +42,7 @@ double PhysicsSystem::mToKm(double meters)
 // Force calculations
 // -------------------------------------------------------------------------
 
-double PhysicsSystem::calculateFriction(const Train* train)
+double PhysicsSystem::calculateFriction(const Train* train, double extraFrictionCoef)
 {
     if (!train)
     {
@@ -50,25 +50,26 @@ double PhysicsSystem::calculateFriction(const Train* train)
     }
 
     double massKg        = tonsToKg(train->getMass());
-    double frictionForce = train->getFrictionCoef() * massKg * PhysicsConstants::GRAVITY;
+    double frictionCoef  = train->getFrictionCoef() + extraFrictionCoef;
+    double frictionForce = frictionCoef * massKg * PhysicsConstants::GRAVITY;
 
     return frictionForce;  // Newtons
 }
 
-double PhysicsSystem::calculateNetForce(const Train* train, double appliedForce)
+double PhysicsSystem::calculateNetForce(const Train* train, double appliedForce, double extraFrictionCoef)
 {
     if (!train)
     {
         return 0.0;
     }
 
-    double frictionForce = calculateFriction(train);
+    double frictionForce = calculateFriction(train, extraFrictionCoef);
     double netForce      = appliedForce - frictionForce;
 
     return netForce;  // Newtons
 }
 
-double PhysicsSystem::calculateBrakingDeceleration(const Train* train)
+double PhysicsSystem::calculateBrakingDeceleration(const Train* train, double extraFrictionCoef)
 {
     if (!train)
     {
@@ -77,7 +78,7 @@ double PhysicsSystem::calculateBrakingDeceleration(const Train* train)
 
     double massKg        = tonsToKg(train->getMass());
     double brakeForceN   = kNtoN(train->getMaxBrakeForce());
-    double frictionForce = calculateFriction(train);
+    double frictionForce = calculateFriction(train, extraFrictionCoef);
 
     // Both brake force and friction oppose motion.
     double totalForce   = brakeForceN + frictionForce;
@@ -86,7 +87,7 @@ double PhysicsSystem::calculateBrakingDeceleration(const Train* train)
     return deceleration;  // m/s² (positive value)
 }
 
-double PhysicsSystem::calculateBrakingDistance(const Train* train)
+double PhysicsSystem::calculateBrakingDistance(const Train* train, double extraFrictionCoef)
 {
     if (!train)
     {
@@ -100,7 +101,7 @@ double PhysicsSystem::calculateBrakingDistance(const Train* train)
         return 0.0;
     }
 
-    double deceleration = calculateBrakingDeceleration(train);
+    double deceleration = calculateBrakingDeceleration(train, extraFrictionCoef);
 
     if (deceleration <= 0.0)
     {
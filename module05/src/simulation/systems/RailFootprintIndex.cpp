@@ -0,0 +1,156 @@
+#include "simulation/systems/RailFootprintIndex.hpp"
+#include "core/INetworkQuery.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+RailFootprintIndex::RailFootprintIndex(const INetworkQuery* network)
+    : _network(network)
+{
+}
+
+std::vector<Rail*> RailFootprintIndex::railsWithin(Node* center, double radiusKm)
+{
+    std::vector<Rail*> result;
+
+    if (!_network || !center)
+    {
+        return result;
+    }
+
+    int bucket = static_cast<int>(std::ceil(std::max(radiusKm, 0.0) / BUCKET_KM));
+    Key key(center, bucket);
+
+    const std::vector<Reach>* footprint = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _cache.find(key);
+        if (it != _cache.end())
+        {
+            footprint = &it->second;
+        }
+    }
+
+    // Searched outside the lock; when two threads race on a new footprint
+    // the first one stored wins and both results are identical.
+    if (!footprint)
+    {
+        std::vector<Reach> computed = computeFootprint(center, bucket * BUCKET_KM);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        footprint = &_cache.emplace(key, std::move(computed)).first->second;
+    }
+
+    for (const Reach& entry : *footprint)
+    {
+        if (entry.reachKm > radiusKm)
+        {
+            break;
+        }
+        result.push_back(entry.rail);
+    }
+
+    std::stable_sort(result.begin(), result.end(),
+                     [](const Rail* a, const Rail* b) { return a->getID() < b->getID(); });
+
+    return result;
+}
+
+std::vector<RailFootprintIndex::Reach> RailFootprintIndex::computeFootprint(Node* center, double boundKm) const
+{
+    using QueueEntry = std::pair<double, Node*>;
+
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> frontier;
+    std::unordered_map<Node*, double> distance;
+    std::unordered_map<Rail*, double> railReach;
+
+    distance[center] = 0.0;
+    frontier.push({0.0, center});
+
+    while (!frontier.empty())
+    {
+        QueueEntry top = frontier.top();
+        frontier.pop();
+
+        double nodeDist = top.first;
+        Node*  node     = top.second;
+
+        if (nodeDist > distance[node])
+        {
+            continue;
+        }
+
+        for (Rail* rail : _network->getRailsFromNode(node))
+        {
+            Node* neighbor = rail ? rail->getOtherNode(node) : nullptr;
+            if (!neighbor)
+            {
+                continue;
+            }
+
+            // Rails touching the epicentre are always in the storm.
+            double reach = (node == center) ? 0.0 : nodeDist + rail->getLength();
+
+            auto known = railReach.find(rail);
+            if (reach <= boundKm && (known == railReach.end() || reach < known->second))
+            {
+                railReach[rail] = reach;
+            }
+
+            double neighborDist = nodeDist + rail->getLength();
+            if (neighborDist > boundKm)
+            {
+                continue;
+            }
+
+            auto seen = distance.find(neighbor);
+            if (seen == distance.end() || neighborDist < seen->second)
+            {
+                distance[neighbor] = neighborDist;
+                frontier.push({neighborDist, neighbor});
+            }
+        }
+    }
+
+    std::vector<Reach> footprint;
+    footprint.reserve(railReach.size());
+
+    for (const auto& entry : railReach)
+    {
+        footprint.push_back({entry.second, entry.first});
+    }
+
+    // Deterministic order independent of hash iteration: by reach, then id.
+    std::sort(footprint.begin(), footprint.end(),
+              [](const Reach& a, const Reach& b)
+              {
+                  if (a.reachKm != b.reachKm)
+                  {
+                      return a.reachKm < b.reachKm;
+                  }
+                  return a.rail->getID() < b.rail->getID();
+              });
+
+    return footprint;
+}
+
+const INetworkQuery* RailFootprintIndex::getNetwork() const
+{
+    return _network;
+}
+
+std::size_t RailFootprintIndex::cachedFootprints() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cache.size();
+}
+
+void RailFootprintIndex::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache.clear();
+}
@@ -0,0 +1,106 @@
+// Replacement global operator new/delete feeding AllocationTracker.  Not
+// part of the core library: linked into an executable only (always for the
+// tests and benchmarks, for railway_sim with RAILWAY_ALLOC_TRACKING=ON).
+#include "utils/AllocationTracker.hpp"
+#include <malloc.h>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    struct Installer
+    {
+        Installer() { AllocationTracker::install(); }
+    } g_installer;
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        if (size == 0)
+        {
+            size = 1;
+        }
+
+        void* block = nullptr;
+        if (alignment <= DEFAULT_ALIGNMENT)
+        {
+            block = std::malloc(size);
+        }
+        else if (::posix_memalign(&block, alignment, size) != 0)
+        {
+            block = nullptr;
+        }
+
+        if (block)
+        {
+            AllocationTracker::onAllocate(size, ::malloc_usable_size(block));
+        }
+        return block;
+    }
+
+    void* allocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        while (true)
+        {
+            if (void* block = allocate(size, alignment))
+            {
+                return block;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void release(void* block)
+    {
+        if (block)
+        {
+            AllocationTracker::onFree(::malloc_usable_size(block));
+            std::free(block);
+        }
+    }
+}
+
+void* operator new(std::size_t size)                                   { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](std::size_t size)                                 { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept   { return allocate(size, DEFAULT_ALIGNMENT); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, DEFAULT_ALIGNMENT); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* block) noexcept                                               { release(block); }
+void operator delete[](void* block) noexcept                                             { release(block); }
+void operator delete(void* block, std::size_t) noexcept                                  { release(block); }
+void operator delete[](void* block, std::size_t) noexcept                                { release(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept                        { release(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept                      { release(block); }
+void operator delete(void* block, std::align_val_t) noexcept                             { release(block); }
+void operator delete[](void* block, std::align_val_t) noexcept                           { release(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept                { release(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept              { release(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept      { release(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept    { release(block); }
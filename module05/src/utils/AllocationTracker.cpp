@@ -0,0 +1,75 @@
+#include "utils/AllocationTracker.hpp"
+#include <atomic>
+
+namespace
+{
+    constexpr std::size_t TAGS = static_cast<std::size_t>(TickPhase::COUNT) + 1;
+
+    // Plain atomics only: this runs inside operator new.
+    std::atomic<bool>          g_installed{false};
+    std::atomic<std::uint64_t> g_allocations[TAGS];
+    std::atomic<std::uint64_t> g_bytes[TAGS];
+    std::atomic<std::uint64_t> g_liveBytes{0};
+
+    thread_local TickPhase t_tag = TickPhase::COUNT;
+}
+
+bool AllocationTracker::isInstalled()
+{
+    return g_installed.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Counters AllocationTracker::total()
+{
+    Counters counters;
+    for (std::size_t i = 0; i < TAGS; ++i)
+    {
+        counters.allocations += g_allocations[i].load(std::memory_order_relaxed);
+        counters.bytes       += g_bytes[i].load(std::memory_order_relaxed);
+    }
+    return counters;
+}
+
+std::uint64_t AllocationTracker::liveBytes()
+{
+    return g_liveBytes.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Counters AllocationTracker::phase(TickPhase phase)
+{
+    const std::size_t tag = static_cast<std::size_t>(phase);
+
+    Counters counters;
+    counters.allocations = g_allocations[tag].load(std::memory_order_relaxed);
+    counters.bytes       = g_bytes[tag].load(std::memory_order_relaxed);
+    return counters;
+}
+
+void AllocationTracker::install()
+{
+    g_installed.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracker::onAllocate(std::size_t bytes, std::size_t usable)
+{
+    const std::size_t tag = static_cast<std::size_t>(t_tag);
+    g_allocations[tag].fetch_add(1, std::memory_order_relaxed);
+    g_bytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+    g_liveBytes.fetch_add(usable, std::memory_order_relaxed);
+}
+
+void AllocationTracker::onFree(std::size_t usable)
+{
+    g_liveBytes.fetch_sub(usable, std::memory_order_relaxed);
+}
+
+AllocationTracker::TagScope::TagScope(TickPhase phase)
+    : _previous(t_tag)
+{
+    t_tag = phase;
+}
+
+AllocationTracker::TagScope::~TagScope()
+{
+    t_tag = _previous;
+}
@@ -1,18 +1,52 @@
 #include "utils/FileWatcher.hpp"
+#include <sys/inotify.h>
 #include <sys/stat.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
 
-FileWatcher::FileWatcher(std::vector<std::string> files, Callback callback, int pollIntervalMs)
+namespace
+{
+    // IN_IGNORED and IN_Q_OVERFLOW arrive whatever the mask.
+    constexpr std::uint32_t WATCH_MASK = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB;
+
+    std::string directoryOf(const std::string& path)
+    {
+        const std::string parent = std::filesystem::path(path).parent_path().string();
+        return parent.empty() ? "." : parent;
+    }
+
+    std::string nameOf(const std::string& path)
+    {
+        return std::filesystem::path(path).filename().string();
+    }
+}
+
+bool FileWatcher::Stamp::operator==(const Stamp& other) const
+{
+    return seconds == other.seconds && nanoseconds == other.nanoseconds &&
+           size == other.size && inode == other.inode;
+}
+
+FileWatcher::FileWatcher(std::vector<std::string> files, Callback callback, int pollIntervalMs,
+                         int debounceMs, Backend backend)
     : _files(std::move(files)),
       _callback(std::move(callback)),
-      _pollIntervalMs(pollIntervalMs),
+      _pollIntervalMs(std::max(1, pollIntervalMs)),
+      _debounceMs(std::max(0, debounceMs)),
+      _backend(backend),
       _running(false),
-      _lastPollTimeMs(0)
+      _stopPipe{-1, -1},
+      _inotifyFd(-1)
 {
-    for (const auto& file : _files)
-    {
-        _lastModTimes[file] = getModTime(file);
-    }
 }
 
 FileWatcher::~FileWatcher()
@@ -22,19 +56,63 @@ FileWatcher::~FileWatcher()
 
 void FileWatcher::start()
 {
+    if (_running)
+    {
+        return;
+    }
+
+    if (::pipe2(_stopPipe, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        throw std::runtime_error(std::string("FileWatcher: pipe failed: ") + std::strerror(errno));
+    }
+
+    Backend resolved = Backend::Polling;
+    if (_backend != Backend::Polling)
+    {
+        if (openInotify())
+        {
+            resolved = Backend::Inotify;
+        }
+        else if (_backend == Backend::Inotify)
+        {
+            const std::string reason = std::strerror(errno);
+            closeFds();
+            throw std::runtime_error("FileWatcher: inotify unavailable: " + reason);
+        }
+    }
+    _backend = resolved;
+
+    _stamps.clear();
+    for (const std::string& file : _files)
+    {
+        _stamps.push_back(stamp(file));
+    }
+    _dueMs.assign(_files.size(), -1);
+
     _running = true;
-    _lastPollTimeMs = nowMs();
+    _thread  = std::thread(&FileWatcher::run, this);
 }
 
 void FileWatcher::stop()
 {
+    if (!_running)
+    {
+        return;
+    }
+
     _running = false;
-}
 
-long long FileWatcher::nowMs() const
-{
-    const auto now = std::chrono::steady_clock::now().time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+    const char wake = 1;
+    while (::write(_stopPipe[1], &wake, 1) < 0 && errno == EINTR)
+    {
+    }
+    _thread.join();
+    closeFds();
+
+    std::size_t discarded;
+    while (_changes.tryPop(discarded))
+    {
+    }
 }
 
 void FileWatcher::poll()
@@ -44,41 +122,271 @@ void FileWatcher::poll()
         return;
     }
 
-    const long long currentTime = nowMs();
-    if (currentTime - _lastPollTimeMs < _pollIntervalMs)
+    std::size_t index;
+    while (_changes.tryPop(index))
+    {
+        if (_callback)
+        {
+            _callback(_files[index]);
+        }
+    }
+}
+
+FileWatcher::Backend FileWatcher::getBackend() const
+{
+    return _backend;
+}
+
+bool FileWatcher::openInotify()
+{
+    _inotifyFd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (_inotifyFd < 0)
+    {
+        return false;
+    }
+
+    // One watch per directory: a saved file is often a new inode renamed
+    // over the old one, which a watch on the file itself would lose.
+    _watches.clear();
+    for (const std::string& file : _files)
+    {
+        const int watch = ::inotify_add_watch(_inotifyFd, directoryOf(file).c_str(), WATCH_MASK);
+        if (watch < 0)
+        {
+            const int error = errno;
+            ::close(_inotifyFd);
+            _inotifyFd = -1;
+            errno      = error;
+            return false;
+        }
+        _watches.push_back(watch);
+    }
+    return true;
+}
+
+void FileWatcher::closeFds()
+{
+    for (int* fd : {&_inotifyFd, &_stopPipe[0], &_stopPipe[1]})
+    {
+        if (*fd >= 0)
+        {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void FileWatcher::run()
+{
+    long long nextScan = nowMs() + _pollIntervalMs;
+
+    while (true)
+    {
+        pollfd fds[2];
+        fds[0] = {_stopPipe[0], POLLIN, 0};
+        fds[1] = {_inotifyFd, POLLIN, 0};
+        const nfds_t count = (_backend == Backend::Inotify) ? 2 : 1;
+
+        const int ready = ::poll(fds, count, waitMs(nowMs(), nextScan));
+        if (ready < 0 && errno != EINTR)
+        {
+            return;
+        }
+        if (fds[0].revents != 0)
+        {
+            return;
+        }
+
+        if (_backend == Backend::Inotify && count == 2 && (fds[1].revents & POLLIN))
+        {
+            readInotify();
+        }
+        if ((_backend == Backend::Polling || hasLostWatch()) && nowMs() >= nextScan)
+        {
+            restoreWatches();
+            scan();
+            nextScan = nowMs() + _pollIntervalMs;
+        }
+
+        publishDue(nowMs());
+    }
+}
+
+void FileWatcher::readInotify()
+{
+    alignas(inotify_event) char buffer[4096];
+    const long long             now = nowMs();
+
+    ssize_t length;
+    while ((length = ::read(_inotifyFd, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* at = buffer; at < buffer + length;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+            at += sizeof(inotify_event) + event->len;
+
+            // Events were dropped: any file may have changed.
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                std::fill(_dueMs.begin(), _dueMs.end(), now + _debounceMs);
+                continue;
+            }
+
+            // The directory was deleted, moved away or unmounted.  Its files
+            // are polled until the watch can be added again.
+            if (event->mask & IN_IGNORED)
+            {
+                for (std::size_t i = 0; i < _files.size(); ++i)
+                {
+                    if (_watches[i] == event->wd)
+                    {
+                        _watches[i] = -1;
+                        _stamps[i]  = stamp(_files[i]);
+                    }
+                }
+                restoreWatches();
+                continue;
+            }
+
+            if (event->len == 0)
+            {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < _files.size(); ++i)
+            {
+                if (_watches[i] == event->wd && nameOf(_files[i]) == event->name)
+                {
+                    _dueMs[i] = now + _debounceMs;
+                }
+            }
+        }
+    }
+}
+
+void FileWatcher::restoreWatches()
+{
+    if (_backend != Backend::Inotify)
     {
         return;
     }
 
-    _lastPollTimeMs = currentTime;
+    const long long now = nowMs();
 
-    for (const auto& file : _files)
+    for (std::size_t i = 0; i < _files.size(); ++i)
     {
-        long long currentMod = getModTime(file);
-        long long lastMod    = _lastModTimes.at(file);
+        if (_watches[i] >= 0)
+        {
+            continue;
+        }
 
-        if (currentMod == -1LL || currentMod == lastMod)
+        const int watch = ::inotify_add_watch(_inotifyFd, directoryOf(_files[i]).c_str(), WATCH_MASK);
+        if (watch < 0)
         {
             continue;
         }
+        _watches[i] = watch;
 
-        _lastModTimes[file] = currentMod;
+        // Whatever happened while the directory was unwatched.
+        const Stamp current = stamp(_files[i]);
+        if (!(current == _stamps[i]))
+        {
+            _stamps[i] = current;
+            _dueMs[i]  = now + _debounceMs;
+        }
+    }
+}
 
-        if (_callback)
+bool FileWatcher::hasLostWatch() const
+{
+    return _backend == Backend::Inotify && std::find(_watches.begin(), _watches.end(), -1) != _watches.end();
+}
+
+// Polling backend: every file.  Inotify backend: the files whose directory
+// watch is lost.
+void FileWatcher::scan()
+{
+    const long long now = nowMs();
+
+    for (std::size_t i = 0; i < _files.size(); ++i)
+    {
+        if (_backend == Backend::Inotify && _watches[i] >= 0)
         {
-            _callback(file);
+            continue;
+        }
+
+        const Stamp current = stamp(_files[i]);
+        if (current.seconds == -1 || current == _stamps[i])
+        {
+            continue;
+        }
+
+        _stamps[i] = current;
+        _dueMs[i]  = now + _debounceMs;
+    }
+}
+
+void FileWatcher::publishDue(long long now)
+{
+    for (std::size_t i = 0; i < _files.size(); ++i)
+    {
+        if (_dueMs[i] < 0 || _dueMs[i] > now)
+        {
+            continue;
+        }
+
+        // A deleted file is not a change; it is reported once it is back.
+        // A full queue is retried on the next wake-up.
+        if (stamp(_files[i]).seconds == -1)
+        {
+            _dueMs[i] = -1;
+            continue;
+        }
+
+        if (_changes.tryPush(i))
+        {
+            _dueMs[i] = -1;
         }
     }
 }
 
-long long FileWatcher::getModTime(const std::string& path) const
+int FileWatcher::waitMs(long long now, long long nextScan) const
+{
+    long long until = (_backend == Backend::Polling || hasLostWatch()) ? nextScan : LLONG_MAX;
+
+    for (long long due : _dueMs)
+    {
+        if (due >= 0)
+        {
+            until = std::min(until, std::max(due, now + 1));
+        }
+    }
+
+    if (until == LLONG_MAX)
+    {
+        return -1;  // Idle: sleep until inotify or stop() wakes the thread
+    }
+    return static_cast<int>(std::min<long long>(std::max(0LL, until - now), INT_MAX));
+}
+
+FileWatcher::Stamp FileWatcher::stamp(const std::string& path) const
 {
     struct stat st;
+    Stamp       result;
 
-    if (stat(path.c_str(), &st) == 0)
+    if (::stat(path.c_str(), &st) == 0)
     {
-        return static_cast<long long>(st.st_mtime);
+        result.seconds     = static_cast<long long>(st.st_mtim.tv_sec);
+        result.nanoseconds = static_cast<long long>(st.st_mtim.tv_nsec);
+        result.size        = static_cast<long long>(st.st_size);
+        result.inode       = static_cast<unsigned long>(st.st_ino);
     }
 
-    return -1LL;
+    return result;
+}
+
+long long FileWatcher::nowMs() const
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
 }
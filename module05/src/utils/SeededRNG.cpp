@@ -1,4 +1,6 @@
 #include "utils/SeededRNG.hpp"
+#include <sstream>
+#include <stdexcept>
 
 SeededRNG::SeededRNG(unsigned int seed)
 	: _generator(seed), _seed(seed)
@@ -32,4 +34,22 @@ void SeededRNG::reseed(unsigned int seed)
 {
 	_seed = seed;
 	_generator.seed(seed);
-}
\ No newline at end of file
+}
+std::string SeededRNG::saveState() const
+{
+	std::ostringstream out;
+	out << _generator;
+	return out.str();
+}
+
+void SeededRNG::loadState(const std::string& state)
+{
+	std::istringstream in(state);
+	std::mt19937       generator;
+	in >> generator;
+	if (!in)
+	{
+		throw std::runtime_error("Invalid random generator state");
+	}
+	_generator = generator;
+}
@@ -0,0 +1,299 @@
+#include "utils/TickProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(TickPhase::COUNT);
+
+    // Bucket of a duration: exact below 4 ns, then four buckets per power
+    // of two (two mantissa bits), so a bucket spans at most 25% of its value.
+    std::size_t bucketOf(std::uint64_t ns)
+    {
+        if (ns < 4)
+        {
+            return static_cast<std::size_t>(ns);
+        }
+
+        int exponent = 63;
+        while ((ns >> exponent) == 0)
+        {
+            --exponent;
+        }
+        return static_cast<std::size_t>((exponent - 1) * 4) + static_cast<std::size_t>((ns >> (exponent - 2)) & 3);
+    }
+
+    std::uint64_t bucketLow(std::size_t bucket)
+    {
+        if (bucket < 4)
+        {
+            return bucket;
+        }
+        const std::size_t exponent = bucket / 4 + 1;
+        return static_cast<std::uint64_t>(4 + bucket % 4) << (exponent - 2);
+    }
+
+    std::uint64_t bucketWidth(std::size_t bucket)
+    {
+        return (bucket < 4) ? 1 : std::uint64_t{1} << (bucket / 4 - 1);
+    }
+
+    double micros(std::uint64_t ns)
+    {
+        return static_cast<double>(ns) / 1000.0;
+    }
+}
+
+std::atomic<TickProfiler*> TickProfiler::_active{nullptr};
+std::atomic<unsigned>      TickProfiler::_generation{0};
+
+thread_local TickProfiler::ThreadBuffer* TickProfiler::_threadBuffer     = nullptr;
+thread_local unsigned                    TickProfiler::_threadGeneration = 0;
+
+const char* tickPhaseName(TickPhase phase)
+{
+    switch (phase)
+    {
+        case TickPhase::Tick:              return "tick";
+        case TickPhase::CheckDepartures:   return "checkDepartures";
+        case TickPhase::RefreshState:      return "refreshSimulationState";
+        case TickPhase::StateTransitions:  return "handleStateTransitions";
+        case TickPhase::UpdateTrainStates: return "updateTrainStates";
+        case TickPhase::EventPipeline:     return "eventPipeline";
+        case TickPhase::WriteSnapshots:    return "writeSnapshots";
+        case TickPhase::UpdateDashboard:   return "updateDashboard";
+        case TickPhase::COUNT:             break;
+    }
+    return "unknown";
+}
+
+// ===== PhaseSummary =====
+
+void TickProfiler::PhaseSummary::add(std::uint64_t ns)
+{
+    ++count;
+    totalNs += ns;
+    minNs    = std::min(minNs, ns);
+    maxNs    = std::max(maxNs, ns);
+    ++buckets[bucketOf(ns)];
+}
+
+void TickProfiler::PhaseSummary::merge(const PhaseSummary& other)
+{
+    count   += other.count;
+    totalNs += other.totalNs;
+    minNs    = std::min(minNs, other.minNs);
+    maxNs    = std::max(maxNs, other.maxNs);
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+std::uint64_t TickProfiler::PhaseSummary::quantileNs(double q) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const double        clamped = std::min(1.0, std::max(0.0, q));
+    const std::uint64_t rank    = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(
+        std::ceil(clamped * static_cast<double>(count))));
+
+    // The extremes are known exactly.
+    if (rank == 1)
+    {
+        return minNs;
+    }
+    if (rank >= count)
+    {
+        return maxNs;
+    }
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            const std::uint64_t mid = bucketLow(i) + bucketWidth(i) / 2;
+            return std::min(maxNs, std::max(minNs, mid));
+        }
+    }
+    return maxNs;
+}
+
+// ===== TickProfiler =====
+
+TickProfiler::TickProfiler()
+    : _originNs(nowNs())
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    stop();
+}
+
+void TickProfiler::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _threads.clear();
+        _originNs = nowNs();
+    }
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+    _active.store(this, std::memory_order_release);
+}
+
+void TickProfiler::stop()
+{
+    TickProfiler* self = this;
+    _active.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+}
+
+void TickProfiler::record(TickPhase phase, std::uint64_t startNs, std::uint64_t endNs)
+{
+    TickProfiler* profiler = _active.load(std::memory_order_acquire);
+    if (!profiler)
+    {
+        return;
+    }
+
+    const unsigned generation = _generation.load(std::memory_order_acquire);
+    if (!_threadBuffer || _threadGeneration != generation)
+    {
+        _threadBuffer     = profiler->registerThread();
+        _threadGeneration = generation;
+    }
+
+    ThreadBuffer&       buffer   = *_threadBuffer;
+    const std::uint64_t duration = (endNs > startNs) ? endNs - startNs : 0;
+
+    Span& span      = buffer.ring[buffer.recorded % RING_CAPACITY];
+    span.startNs    = startNs;
+    span.durationNs = static_cast<std::uint32_t>(std::min<std::uint64_t>(duration, UINT32_MAX));
+    span.phase      = phase;
+    ++buffer.recorded;
+
+    buffer.phases[static_cast<std::size_t>(phase)].add(duration);
+}
+
+TickProfiler::ThreadBuffer* TickProfiler::registerThread()
+{
+    // Allocated once per thread and session, outside every phase's count.
+#ifdef RAILWAY_ALLOC_TRACKING
+    AllocationTracker::TagScope untagged(TickPhase::COUNT);
+#endif
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->ring.resize(RING_CAPACITY);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    buffer->id = static_cast<int>(_threads.size()) + 1;
+    _threads.push_back(std::move(buffer));
+    return _threads.back().get();
+}
+
+std::size_t TickProfiler::threadCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _threads.size();
+}
+
+TickProfiler::Summary TickProfiler::summarize() const
+{
+    Summary summary;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& thread : _threads)
+    {
+        for (std::size_t i = 0; i < PHASE_COUNT; ++i)
+        {
+            summary[i].merge(thread->phases[i]);
+        }
+    }
+    return summary;
+}
+
+void TickProfiler::writeChromeTrace(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Cannot open profile output: " + path);
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool                        first = true;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& thread : _threads)
+    {
+        file << (first ? "\n" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id
+             << ",\"args\":{\"name\":\"simulation " << thread->id << "\"}}";
+        first = false;
+
+        // Oldest span first once the ring has wrapped.
+        const std::uint64_t kept  = std::min<std::uint64_t>(thread->recorded, RING_CAPACITY);
+        const std::uint64_t begin = thread->recorded - kept;
+        for (std::uint64_t i = begin; i < thread->recorded; ++i)
+        {
+            const Span&         span  = thread->ring[i % RING_CAPACITY];
+            const std::uint64_t start = (span.startNs > _originNs) ? span.startNs - _originNs : 0;
+
+            file << ",\n{\"name\":\"" << tickPhaseName(span.phase)
+                 << "\",\"cat\":\"tick\",\"ph\":\"X\",\"ts\":" << micros(start)
+                 << ",\"dur\":" << micros(span.durationNs)
+                 << ",\"pid\":1,\"tid\":" << thread->id << "}";
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write profile output: " + path);
+    }
+}
+
+void TickProfiler::writeSummaryCsv(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Cannot open profile summary: " + path);
+    }
+
+    const Summary       summary = summarize();
+    const std::uint64_t tickNs  = summary[static_cast<std::size_t>(TickPhase::Tick)].totalNs;
+
+    file << "phase,count,total_ms,mean_us,min_us,p50_us,p90_us,p99_us,max_us,tick_share_pct\n";
+    file << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < PHASE_COUNT; ++i)
+    {
+        const PhaseSummary& phase = summary[i];
+        const bool          empty = (phase.count == 0);
+
+        file << tickPhaseName(static_cast<TickPhase>(i)) << ','
+             << phase.count << ','
+             << static_cast<double>(phase.totalNs) / 1e6 << ','
+             << (empty ? 0.0 : micros(phase.totalNs) / static_cast<double>(phase.count)) << ','
+             << (empty ? 0.0 : micros(phase.minNs)) << ','
+             << micros(phase.quantileNs(0.50)) << ','
+             << micros(phase.quantileNs(0.90)) << ','
+             << micros(phase.quantileNs(0.99)) << ','
+             << micros(phase.maxNs) << ','
+             << (tickNs == 0 ? 0.0 : 100.0 * static_cast<double>(phase.totalNs) / static_cast<double>(tickNs))
+             << '\n';
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write profile summary: " + path);
+    }
+}
@@ -1,4 +1,5 @@
 #include "utils/Time.hpp"
+#include <charconv>
 #include <sstream>
 #include <iomanip>
 
@@ -12,16 +13,58 @@ Time::Time(int hours, int minutes) : _hours(hours), _minutes(minutes)
 {
 }
 
-// Parse "HHhMM" format (e.g., "14h10")
-Time::Time(const std::string& timeStr) : _hours(0), _minutes(0)
+namespace
 {
-    std::istringstream iss(timeStr);
-    char delimiter;
+    // Reads an optionally space-prefixed integer at pos, like operator>>.
+    bool readInt(std::string_view text, std::size_t& pos, int& value)
+    {
+        pos = text.find_first_not_of(" \t", pos);
+        if (pos == std::string_view::npos)
+        {
+            return false;
+        }
+
+        if (text[pos] == '+')
+        {
+            ++pos;
+        }
+
+        const char* begin = text.data() + pos;
+        std::from_chars_result result = std::from_chars(begin, text.data() + text.size(), value);
+        if (result.ec != std::errc())
+        {
+            return false;
+        }
+
+        pos += static_cast<std::size_t>(result.ptr - begin);
+        return true;
+    }
+}
+
+// Parse "HHhMM" format (e.g., "14h10").  Hand-rolled: timetables hold
+// millions of times and a stream per value dominated load time.
+Time::Time(std::string_view timeStr) : _hours(0), _minutes(0)
+{
+    std::size_t pos     = 0;
+    int         hours   = 0;
+    int         minutes = 0;
+
+    if (!readInt(timeStr, pos, hours))
+    {
+        return;
+    }
+
+    pos = timeStr.find_first_not_of(" \t", pos);
+    if (pos == std::string_view::npos || timeStr[pos] != 'h')
+    {
+        return;
+    }
+    ++pos;
 
-    if (!(iss >> _hours >> delimiter >> _minutes) || delimiter != 'h')
+    if (readInt(timeStr, pos, minutes))
     {
-        _hours   = 0;
-        _minutes = 0;
+        _hours   = hours;
+        _minutes = minutes;
     }
 }
 
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "app/RunSession.hpp"
+#include "core/Graph.hpp"
+#include "core/Train.hpp"
+#include "io/CLI.hpp"
+#include "io/ConsoleOutputWriter.hpp"
+#include "patterns/behavioral/states/ITrainState.hpp"
+#include "simulation/core/SimulationBuilder.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include "simulation/systems/CollisionAvoidance.hpp"
+
+namespace
+{
+	std::string tempPath(const std::string& name)
+	{
+		return (std::filesystem::temp_directory_path()
+			/ (name + "_" + std::to_string(::getpid()) + ".txt")).string();
+	}
+
+	void writeFile(const std::string& path, const std::string& contents)
+	{
+		std::ofstream out(path, std::ios::trunc);
+		out << contents;
+	}
+
+	const char* NETWORK =
+		"Node CityA\n"
+		"Node CityB\n"
+		"Node CityC\n"
+		"Node CityD\n"
+		"Rail CityA CityB 15 160\n"
+		"Rail CityB CityC 12 140\n"
+		"Rail CityC CityD 10 120\n"
+		"Rail CityA CityD 40 100\n";
+
+	const char* TRAINS =
+		"Express 80 0.005 356 500 CityA CityD 06h00 00h02\n"
+		"Local 60 0.006 300 450 CityD CityB 06h05 00h01\n"
+		"Cargo 200 0.008 250 600 CityB CityD 06h10 00h03\n";
+
+	std::string describe(const SimulationManager& sim)
+	{
+		std::string line = std::to_string(sim.getCurrentTime()) + " events="
+			+ std::to_string(sim.getActiveEvents().size()) + "/"
+			+ std::to_string(sim.getTotalEventsGenerated());
+
+		for (const Train* train : sim.getTrains())
+		{
+			char kinematics[96];
+			std::snprintf(kinematics, sizeof(kinematics), " %zu:%a:%a:", train->getCurrentRailIndex(),
+			              train->getPosition(), train->getVelocity());
+			line += " " + train->getName() + kinematics
+				+ (train->getCurrentState() ? train->getCurrentState()->getName() : "-")
+				+ (train->isFinished() ? "!" : "");
+		}
+		return line;
+	}
+
+	bool allFinished(const SimulationManager& sim)
+	{
+		for (const Train* train : sim.getTrains())
+		{
+			if (!train->isFinished())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<std::string> runToEnd(SimulationManager& sim)
+	{
+		std::vector<std::string> trace;
+		for (int step = 0; step < 20000 && !allFinished(sim); ++step)
+		{
+			sim.step();
+			trace.push_back(describe(sim));
+		}
+		return trace;
+	}
+
+	class IncrementalReloadTest : public ::testing::Test
+	{
+	protected:
+		std::string                 _networkFile = tempPath("reload_network_test");
+		std::string                 _trainFile   = tempPath("reload_train_test");
+		std::string                 _traceFile   = tempPath("reload_trace_test");
+		std::vector<std::string>    _args;
+		std::vector<char*>          _argv;
+		ConsoleOutputWriter         _writer;
+		CollisionAvoidance          _collision;
+		SimulationManager           _sim{&_collision};
+		SimulationBuilder           _builder{&_writer, "dijkstra"};
+		std::unique_ptr<CLI>        _cli;
+		std::unique_ptr<RunSession> _session;
+		SimulationBundle            _bundle;
+
+		void SetUp() override
+		{
+			writeFile(_networkFile, NETWORK);
+			writeFile(_trainFile, TRAINS);
+
+			_args = {"railway_sim", _networkFile, _trainFile, "--seed=7"};
+			for (std::string& arg : _args)
+			{
+				_argv.push_back(&arg[0]);
+			}
+			_cli.reset(new CLI(static_cast<int>(_argv.size()), _argv.data()));
+			_session.reset(new RunSession(*_cli, _writer, _sim, _builder));
+
+			_builder.setTraceFile(_traceFile);
+			ASSERT_TRUE(_session->buildSimulation(_networkFile, _trainFile, _bundle));
+			_sim.start();
+		}
+
+		void TearDown() override
+		{
+			_session->teardownSimulation(_bundle);
+			std::remove(_networkFile.c_str());
+			std::remove(_trainFile.c_str());
+			std::remove(_traceFile.c_str());
+		}
+
+		void runUntil(double time)
+		{
+			while (_sim.getCurrentTime() < time)
+			{
+				_sim.step();
+			}
+		}
+
+		Train* train(const std::string& name) const
+		{
+			for (Train* candidate : _bundle.trains)
+			{
+				if (candidate->getName() == name)
+				{
+					return candidate;
+				}
+			}
+			return nullptr;
+		}
+	};
+}
+
+TEST_F(IncrementalReloadTest, UnchangedFilesContinueExactlyLikeAFork)
+{
+	runUntil(6 * 3600 + 20 * 60);
+	SimulationFork twin = _sim.fork();
+
+	const std::vector<Train*> before = _bundle.trains;
+	Graph* const graph = _bundle.graph;
+	const std::string state = describe(_sim);
+
+	const ReloadSummary summary = _builder.reload(_networkFile, _trainFile, _bundle, _sim);
+	EXPECT_FALSE(summary.networkChanged);
+	EXPECT_EQ(summary.kept, 3u);
+	EXPECT_EQ(summary.added + summary.modified + summary.removed + summary.rerouted, 0u);
+
+	EXPECT_EQ(_bundle.trains, before);
+	EXPECT_EQ(_bundle.graph, graph);
+	EXPECT_EQ(describe(_sim), state);
+
+	const std::vector<std::string> expected = runToEnd(*twin.simulation);
+	ASSERT_GT(expected.size(), 100u);
+	EXPECT_EQ(runToEnd(_sim), expected);
+}
+
+TEST_F(IncrementalReloadTest, TrainEditsRebuildOnlyTheTrainsTheyTouch)
+{
+	runUntil(6 * 3600 + 8 * 60);
+	Train* const express  = train("Express");
+	Train* const local    = train("Local");
+	const double position = express->getPosition();
+
+	writeFile(_trainFile,
+		"Express 80 0.005 356 500 CityA CityD 06h00 00h02\n"
+		"Local 70 0.006 300 450 CityD CityB 06h05 00h01\n"
+		"Night 90 0.005 300 500 CityC CityA 06h30 00h01\n");
+
+	const ReloadSummary summary = _builder.reload(_networkFile, _trainFile, _bundle, _sim);
+	EXPECT_FALSE(summary.networkChanged);
+	EXPECT_EQ(summary.kept, 1u);
+	EXPECT_EQ(summary.modified, 1u);
+	EXPECT_EQ(summary.added, 1u);
+	EXPECT_EQ(summary.removed, 1u);
+
+	ASSERT_EQ(_bundle.trains.size(), 3u);
+	EXPECT_EQ(_bundle.trains[0], express);
+	EXPECT_EQ(express->getPosition(), position);
+	EXPECT_NE(train("Local"), local);
+	EXPECT_EQ(train("Local")->getPosition(), 0.0);
+	EXPECT_EQ(_bundle.trains[2]->getName(), "Night");
+	EXPECT_EQ(_bundle.writers.size(), 3u);
+	EXPECT_EQ(_sim.getTrains(), _bundle.trains);
+
+	runToEnd(_sim);
+	EXPECT_TRUE(allFinished(_sim));
+}
+
+TEST_F(IncrementalReloadTest, NetworkEditReroutesOnlyTheRouteAhead)
+{
+	runUntil(6 * 3600 + 3 * 60);
+	Train* const express = train("Express");
+	ASSERT_EQ(express->getCurrentRailIndex(), 0u);
+	const double position = express->getPosition();
+
+	// CityC-CityD is on Express's and Cargo's route ahead and is where
+	// Local, not yet departed, starts.
+	writeFile(_networkFile,
+		"Node CityA\n"
+		"Node CityB\n"
+		"Node CityC\n"
+		"Node CityD\n"
+		"Rail CityA CityB 15 160\n"
+		"Rail CityB CityC 12 140\n"
+		"Rail CityC CityD 10 110\n"
+		"Rail CityA CityD 40 100\n");
+
+	Graph* const oldGraph = _bundle.graph;
+	const ReloadSummary summary = _builder.reload(_networkFile, _trainFile, _bundle, _sim);
+	EXPECT_TRUE(summary.networkChanged);
+	EXPECT_EQ(summary.kept, 2u);
+	EXPECT_EQ(summary.rerouted, 2u);
+	EXPECT_EQ(summary.modified, 1u);
+	EXPECT_EQ(summary.removed, 0u);
+	EXPECT_NE(_bundle.graph, oldGraph);
+
+	EXPECT_EQ(train("Express"), express);
+	EXPECT_EQ(express->getCurrentRailIndex(), 0u);
+	EXPECT_EQ(express->getPosition(), position);
+
+	const Graph::RailList rails = _bundle.graph->getRails();
+	for (const Train* running : _bundle.trains)
+	{
+		for (const PathSegment& segment : running->getPath())
+		{
+			EXPECT_NE(std::find(rails.begin(), rails.end(), segment.rail), rails.end()) << running->getName();
+		}
+		EXPECT_EQ(running->getPath().back().to->getName(), running->getArrivalStation());
+	}
+
+	runToEnd(_sim);
+	EXPECT_TRUE(allFinished(_sim));
+}
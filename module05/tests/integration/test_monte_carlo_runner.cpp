@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "analysis/MonteCarloRunner.hpp"
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "analysis/SweepRunner.hpp"
+#include "core/Train.hpp"
+
+namespace
+{
+	std::string writeTempFile(const std::string& prefix, const std::string& contents)
+	{
+		const auto path = std::filesystem::temp_directory_path()
+			/ std::filesystem::path(prefix + "_" + std::to_string(::getpid()) + "_" + std::to_string(std::rand()) + ".txt");
+		std::ofstream out(path);
+		out << contents;
+		out.close();
+		return path.string();
+	}
+
+	std::string readFile(const std::string& path)
+	{
+		std::ifstream in(path);
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		return buffer.str();
+	}
+
+	const char* NETWORK =
+		"Node CityA\n"
+		"Node CityB\n"
+		"Node CityC\n"
+		"Node CityD\n"
+		"Rail CityA CityB 15 160\n"
+		"Rail CityB CityC 12 140\n"
+		"Rail CityC CityD 10 120\n"
+		"Rail CityA CityD 40 100\n";
+
+	const char* TRAINS =
+		"Express 80 0.005 356 500 CityA CityD 06h00 00h02\n"
+		"Local 60 0.006 300 450 CityD CityB 06h05 00h01\n"
+		"Cargo 200 0.008 250 600 CityB CityD 06h10 00h03\n";
+}
+
+TEST(MonteCarloRunnerTest, ResultsAreIndependentOfThreadCount)
+{
+	const std::string networkFile     = writeTempFile("mc_network_test", NETWORK);
+	const std::string trainFile       = writeTempFile("mc_train_test", TRAINS);
+	const std::string serialCsv       = writeTempFile("mc_serial_csv", "");
+	const std::string parallelCsv     = writeTempFile("mc_parallel_csv", "");
+	const std::string serialSummary   = writeTempFile("mc_serial_summary", "");
+	const std::string parallelSummary = writeTempFile("mc_parallel_summary", "");
+
+	MonteCarloRunner serial(networkFile, trainFile, 7, 6, "dijkstra");
+	serial.setRunsCSV(serialCsv);
+	serial.runAll();
+	serial.writeSummaryCSV(serialSummary);
+
+	MonteCarloRunner parallel(networkFile, trainFile, 7, 6, "dijkstra");
+	parallel.setThreads(3);
+	parallel.setRunsCSV(parallelCsv);
+	parallel.runAll();
+	parallel.writeSummaryCSV(parallelSummary);
+
+	EXPECT_EQ(parallel.getAggregate().getRunCount(), 6u);
+	EXPECT_EQ(parallel.getAggregate().getTrains().size(), 3u);
+
+	const std::string rows = readFile(serialCsv);
+	EXPECT_EQ(std::count(rows.begin(), rows.end(), '\n'), 7);
+	EXPECT_EQ(rows, readFile(parallelCsv));
+	EXPECT_EQ(readFile(serialSummary), readFile(parallelSummary));
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+	std::remove(serialCsv.c_str());
+	std::remove(parallelCsv.c_str());
+	std::remove(serialSummary.c_str());
+	std::remove(parallelSummary.c_str());
+}
+
+TEST(MonteCarloRunnerTest, ThreadCountIsClampedToAtLeastOne)
+{
+	MonteCarloRunner runner("unused_network.txt", "unused_trains.txt", 1, 1, "dijkstra");
+	runner.setThreads(0);
+	EXPECT_EQ(runner.getThreads(), 1u);
+}
+
+TEST(MonteCarloRunnerTest, ScenarioIsRoutedOnceAndPoolReusesTrains)
+{
+	const std::string networkFile = writeTempFile("mc_network_test", NETWORK);
+	const std::string trainFile   = writeTempFile("mc_train_test", TRAINS);
+
+	PreparedScenario scenario(networkFile, trainFile, "dijkstra");
+	ASSERT_NE(scenario.getNetwork(), nullptr);
+	ASSERT_EQ(scenario.getTrains().size(), 3u);
+	EXPECT_GT(scenario.getTrains()[0].estimatedSeconds, 0.0);
+
+	ScenarioTrainPool pool(scenario);
+	std::vector<Train*> first = pool.acquire();
+	ASSERT_EQ(first.size(), 3u);
+
+	first[0]->advanceToNextRail();
+	first[0]->setVelocity(30.0);
+
+	const std::vector<Train*>& second = pool.acquire();
+	EXPECT_EQ(second, first);
+	EXPECT_EQ(second[0]->getCurrentRailIndex(), 0u);
+	EXPECT_EQ(second[0]->getVelocity(), 0.0);
+	EXPECT_EQ(second[0]->getPath().size(), scenario.getTrains()[0].path.size());
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+}
+
+TEST(MonteCarloRunnerTest, ConvergenceStopsAtSameRunForAnyThreadCount)
+{
+	const std::string networkFile = writeTempFile("mc_network_test", NETWORK);
+	const std::string trainFile   = writeTempFile("mc_train_test", TRAINS);
+
+	ConvergenceCriteria criteria;
+	criteria.metrics           = {"totalDuration"};
+	criteria.relativeTolerance = 0.5;
+	criteria.minRuns           = 4;
+	criteria.checkInterval     = 2;
+
+	MonteCarloRunner serial(networkFile, trainFile, 7, 40, "dijkstra");
+	serial.setConvergence(criteria);
+	serial.runAll();
+
+	MonteCarloRunner parallel(networkFile, trainFile, 7, 40, "dijkstra");
+	parallel.setThreads(3);
+	parallel.setConvergence(criteria);
+	parallel.runAll();
+
+	const ConvergenceReport& report = serial.getConvergenceReport();
+	EXPECT_TRUE(report.converged);
+	EXPECT_EQ(report.stopReason, "converged");
+	EXPECT_LT(report.runs, 40u);
+	EXPECT_EQ(serial.getAggregate().getRunCount(), report.runs);
+	EXPECT_EQ(parallel.getConvergenceReport().runs, report.runs);
+	EXPECT_EQ(parallel.getAggregate().getRunCount(), report.runs);
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+}
+
+TEST(MonteCarloRunnerTest, AntitheticModeAggregatesPairs)
+{
+	const std::string networkFile = writeTempFile("mc_network_test", NETWORK);
+	const std::string trainFile   = writeTempFile("mc_train_test", TRAINS);
+
+	MonteCarloRunner runner(networkFile, trainFile, 3, 6, "dijkstra");
+	runner.setSampling(SamplingMode::Antithetic);
+	runner.setThreads(2);
+	runner.runAll();
+
+	EXPECT_EQ(runner.getAggregate().getRunCount(), 6u);
+	EXPECT_EQ(runner.getPairAggregate().getRunCount(), 3u);
+	EXPECT_NEAR(runner.getPairAggregate().getTotalDuration().moments.mean(),
+	            runner.getAggregate().getTotalDuration().moments.mean(), 1e-6);
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+}
+
+TEST(SweepRunnerTest, RunsEveryPointAndSeedIndependentOfThreadCount)
+{
+	const std::string networkFile = writeTempFile("sweep_network_test", NETWORK);
+	const std::string trainFile   = writeTempFile("sweep_train_test", TRAINS);
+	const std::string serialCsv   = writeTempFile("sweep_serial_csv", "");
+	const std::string parallelCsv = writeTempFile("sweep_parallel_csv", "");
+
+	SweepSpec spec;
+	spec.setRunsPerPoint(3);
+	spec.addParameter({"stationDelay.probability", 0.0, 0.5, 2});
+	spec.addParameter({"train.massScale", 1.0, 1.5, 2});
+
+	SweepRunner serial(networkFile, trainFile, spec, 11, "dijkstra");
+	serial.setResultsCSV(serialCsv);
+	serial.runAll();
+
+	SweepRunner parallel(networkFile, trainFile, spec, 11, "dijkstra");
+	parallel.setThreads(3);
+	parallel.setResultsCSV(parallelCsv);
+	parallel.runAll();
+
+	ASSERT_EQ(parallel.getPoints().size(), 4u);
+	for (std::size_t p = 0; p < 4; ++p)
+	{
+		EXPECT_EQ(parallel.getPointAggregate(p).getRunCount(), 3u);
+	}
+
+	// Header plus one row per (point, seed, train).
+	const std::string rows = readFile(serialCsv);
+	EXPECT_EQ(std::count(rows.begin(), rows.end(), '\n'), 1 + 4 * 3 * 3);
+	EXPECT_EQ(rows, readFile(parallelCsv));
+	EXPECT_EQ(rows.compare(0, 44, "point,stationDelay.probability,train.massSca"), 0);
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+	std::remove(serialCsv.c_str());
+	std::remove(parallelCsv.c_str());
+}
+
+TEST(SweepRunnerTest, EventProbabilityReachesTheSimulation)
+{
+	const std::string networkFile = writeTempFile("sweep_network_test", NETWORK);
+	const std::string trainFile   = writeTempFile("sweep_train_test", TRAINS);
+
+	SweepSpec spec;
+	spec.setRunsPerPoint(4);
+	spec.addParameter({"stationDelay.probability", 0.0, 1.0, 2});
+	spec.addParameter({"trackMaintenance.probability", 0.0, 0.0, 1});
+	spec.addParameter({"signalFailure.probability", 0.0, 0.0, 1});
+	spec.addParameter({"weather.probability", 0.0, 0.0, 1});
+
+	SweepRunner runner(networkFile, trainFile, spec, 3, "dijkstra");
+	runner.runAll();
+
+	double quiet = 0.0;
+	double busy  = 0.0;
+	for (const auto& kv : runner.getPointAggregate(0).getTrains())
+	{
+		quiet += kv.second.eventsAffecting.mean();
+	}
+	for (const auto& kv : runner.getPointAggregate(1).getTrains())
+	{
+		busy += kv.second.eventsAffecting.mean();
+	}
+
+	// Every other event type is off, so only the swept point sees events.
+	EXPECT_DOUBLE_EQ(quiet, 0.0);
+	EXPECT_GT(busy, 0.0);
+
+	std::remove(networkFile.c_str());
+	std::remove(trainFile.c_str());
+}
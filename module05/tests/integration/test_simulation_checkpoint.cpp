@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "core/Train.hpp"
+#include "events/Event.hpp"
+#include "patterns/behavioral/command/CommandManager.hpp"
+#include "patterns/behavioral/states/ITrainState.hpp"
+#include "simulation/core/SimulationCheckpoint.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationContext.hpp"
+#include "simulation/core/SimulationManager.hpp"
+
+namespace
+{
+	std::string writeTempFile(const std::string& name, const std::string& contents)
+	{
+		const auto path = std::filesystem::temp_directory_path()
+			/ (name + "_" + std::to_string(::getpid()) + ".txt");
+		std::ofstream out(path);
+		out << contents;
+		return path.string();
+	}
+
+	const char* NETWORK =
+		"Node CityA\n"
+		"Node CityB\n"
+		"Node CityC\n"
+		"Node CityD\n"
+		"Rail CityA CityB 15 160\n"
+		"Rail CityB CityC 12 140\n"
+		"Rail CityC CityD 10 120\n"
+		"Rail CityA CityD 40 100\n";
+
+	const char* TRAINS =
+		"Express 80 0.005 356 500 CityA CityD 06h00 00h02\n"
+		"Local 60 0.006 300 450 CityD CityB 06h05 00h01\n"
+		"Cargo 200 0.008 250 600 CityB CityD 06h10 00h03\n";
+
+	// Frequent events so every type is scheduled, active and expiring
+	// around the checkpoint.
+	SimulationConfig stormyConfig(const PreparedScenario& scenario, bool rngStreams)
+	{
+		SimulationConfig config;
+		config.network                       = scenario.getNetwork();
+		config.seed                          = 11;
+		config.rngStreams                    = rngStreams;
+		config.events.stationDelay           = {0.3, 5, 20};
+		config.events.trackMaintenance       = {0.2, 10, 40};
+		config.events.signalFailure          = {0.2, 5, 15};
+		config.events.weather                = {0.2, 10, 30};
+		return config;
+	}
+
+	std::string describe(const SimulationManager& sim)
+	{
+		std::string line = std::to_string(sim.getCurrentTime()) + " events="
+			+ std::to_string(sim.getActiveEvents().size()) + "/"
+			+ std::to_string(sim.getTotalEventsGenerated());
+
+		for (const Train* train : sim.getTrains())
+		{
+			char kinematics[96];
+			std::snprintf(kinematics, sizeof(kinematics), " %zu:%a:%a:", train->getCurrentRailIndex(),
+			              train->getPosition(), train->getVelocity());
+			line += " " + train->getName() + kinematics
+				+ (train->getCurrentState() ? train->getCurrentState()->getName() : "-")
+				+ (train->isFinished() ? "!" : "");
+		}
+		return line;
+	}
+
+	// Per-step trace until every train has arrived (or a step cap).
+	std::vector<std::string> runToEnd(SimulationManager& sim)
+	{
+		std::vector<std::string> trace;
+		for (int step = 0; step < 20000; ++step)
+		{
+			sim.step();
+			trace.push_back(describe(sim));
+
+			bool done = true;
+			for (const Train* train : sim.getTrains())
+			{
+				done = done && train->isFinished();
+			}
+			if (done)
+			{
+				break;
+			}
+		}
+		return trace;
+	}
+
+	class SimulationCheckpointTest : public ::testing::TestWithParam<bool>
+	{
+	protected:
+		std::string _networkFile;
+		std::string _trainFile;
+
+		void SetUp() override
+		{
+			_networkFile = writeTempFile("checkpoint_network_test", NETWORK);
+			_trainFile   = writeTempFile("checkpoint_train_test", TRAINS);
+		}
+
+		void TearDown() override
+		{
+			std::remove(_networkFile.c_str());
+			std::remove(_trainFile.c_str());
+		}
+
+		static void setUp(SimulationManager& sim, const PreparedScenario& scenario,
+		                  const std::vector<Train*>& trains, bool rngStreams)
+		{
+			sim.configure(stormyConfig(scenario, rngStreams));
+			for (Train* train : trains)
+			{
+				sim.addTrain(train);
+			}
+			sim.start();
+		}
+
+		static void runUntil(SimulationManager& sim, double time)
+		{
+			while (sim.getCurrentTime() < time)
+			{
+				sim.step();
+			}
+		}
+	};
+}
+
+TEST_P(SimulationCheckpointTest, ForkAndRestoreContinueExactlyLikeTheOriginal)
+{
+	PreparedScenario scenario(_networkFile, _trainFile, "dijkstra");
+	ScenarioTrainPool originalTrains(scenario);
+	ScenarioTrainPool restoredTrains(scenario);
+
+	SimulationManager original;
+	setUp(original, scenario, originalTrains.acquire(), GetParam());
+	runUntil(original, 6 * 3600 + 25 * 60);
+
+	// Mid-journey, with events in flight.
+	const SimulationCheckpoint checkpoint = original.checkpoint();
+	ASSERT_FALSE(checkpoint.activeEvents.empty());
+	ASSERT_FALSE(checkpoint.scheduledEvents.empty() && checkpoint.totalEventsGenerated == 0);
+
+	SimulationFork branch = original.fork();
+	EXPECT_EQ(describe(*branch.simulation), describe(original));
+
+	SimulationManager restored;
+	setUp(restored, scenario, restoredTrains.acquire(), false);
+	restored.restore(SimulationCheckpoint::deserialize(checkpoint.serialize()));
+	EXPECT_EQ(describe(restored), describe(original));
+
+	const std::vector<std::string> expected = runToEnd(original);
+	ASSERT_GT(expected.size(), 100u);
+	EXPECT_EQ(runToEnd(*branch.simulation), expected);
+	EXPECT_EQ(runToEnd(restored), expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sampling, SimulationCheckpointTest, ::testing::Values(false, true));
+
+TEST_F(SimulationCheckpointTest, ForkIsIndependentAndReseedingBranches)
+{
+	PreparedScenario scenario(_networkFile, _trainFile, "dijkstra");
+	ScenarioTrainPool trains(scenario);
+
+	SimulationManager original;
+	setUp(original, scenario, trains.acquire(), false);
+	runUntil(original, 6 * 3600);
+
+	SimulationFork same    = original.fork();
+	SimulationFork reseeded = original.fork();
+	reseeded.simulation->setEventSeed(12345);
+
+	// Stepping a branch leaves the original and its trains untouched.
+	const std::string before = describe(original);
+	runToEnd(*same.simulation);
+	EXPECT_EQ(describe(original), before);
+	EXPECT_NE(same.trains[0].get(), original.getTrains()[0]);
+	EXPECT_EQ(same.trains[0]->getID(), original.getTrains()[0]->getID());
+
+	EXPECT_NE(runToEnd(*reseeded.simulation), runToEnd(original));
+}
+
+TEST_F(SimulationCheckpointTest, RejectsMismatchedOrCorruptCheckpoints)
+{
+	PreparedScenario scenario(_networkFile, _trainFile, "dijkstra");
+	ScenarioTrainPool trains(scenario);
+
+	SimulationManager original;
+	setUp(original, scenario, trains.acquire(), false);
+	runUntil(original, 6 * 3600 + 10 * 60);
+
+	SimulationCheckpoint checkpoint = original.checkpoint();
+	const std::string    bytes      = checkpoint.serialize();
+
+	EXPECT_THROW(SimulationCheckpoint::deserialize(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+	EXPECT_THROW(SimulationCheckpoint::deserialize("RSIMCKP0" + bytes.substr(8)), std::runtime_error);
+
+	checkpoint.trains[0].name = "Ghost";
+	SimulationFork branch = original.fork();
+	EXPECT_THROW(branch.simulation->restore(checkpoint), std::runtime_error);
+}
+
+TEST_F(SimulationCheckpointTest, SeekReplayBackwardsMatchesAFreshSeek)
+{
+	PreparedScenario  scenario(_networkFile, _trainFile, "dijkstra");
+	ScenarioTrainPool recordedTrains(scenario);
+	ScenarioTrainPool seekingTrains(scenario);
+	ScenarioTrainPool freshTrains(scenario);
+
+	CommandManager recording;
+	recording.startRecording();
+	{
+		SimulationManager recorder;
+		recorder.setCommandManager(&recording);
+		setUp(recorder, scenario, recordedTrains.acquire(), false);
+		runUntil(recorder, 7 * 3600);
+	}
+	recording.startReplay();
+	ASSERT_GT(recording.keyframeCount(), 2u);
+
+	SimulationManager seeking;
+	seeking.setCommandManager(&recording);
+	setUp(seeking, scenario, seekingTrains.acquire(), false);
+	seeking.seekReplay(6 * 3600 + 50 * 60);
+	seeking.seekReplay(6 * 3600 + 20 * 60);
+
+	SimulationManager fresh;
+	fresh.setCommandManager(&recording);
+	setUp(fresh, scenario, freshTrains.acquire(), false);
+	fresh.seekReplay(6 * 3600 + 20 * 60);
+
+	EXPECT_EQ(seeking.getCurrentTime(), 6 * 3600 + 20 * 60);
+	EXPECT_EQ(describe(seeking), describe(fresh));
+
+	// Both continue alike.
+	seeking.seekReplay(6 * 3600 + 40 * 60);
+	fresh.seekReplay(6 * 3600 + 40 * 60);
+	EXPECT_EQ(describe(seeking), describe(fresh));
+}
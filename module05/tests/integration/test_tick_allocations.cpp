@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "analysis/PreparedScenario.hpp"
+#include "analysis/ScenarioTrainPool.hpp"
+#include "core/Train.hpp"
+#include "patterns/behavioral/command/CommandManager.hpp"
+#include "patterns/behavioral/states/ITrainState.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include "utils/AllocationTracker.hpp"
+
+namespace
+{
+	std::string writeTempFile(const std::string& prefix, const std::string& contents)
+	{
+		const auto path = std::filesystem::temp_directory_path()
+			/ (prefix + "_" + std::to_string(::getpid()) + ".txt");
+		std::ofstream out(path);
+		out << contents;
+		return path.string();
+	}
+
+	const char* NETWORK =
+		"Node CityA\n"
+		"Node CityB\n"
+		"Node CityC\n"
+		"Node CityD\n"
+		"Rail CityA CityB 15 160\n"
+		"Rail CityB CityC 12 140\n"
+		"Rail CityC CityD 10 120\n"
+		"Rail CityA CityD 40 100\n";
+
+	const char* TRAINS =
+		"Express 80 0.005 356 500 CityA CityD 06h00 00h02\n"
+		"Local 60 0.006 300 450 CityD CityB 06h05 00h01\n"
+		"Cargo 200 0.008 250 600 CityB CityD 06h10 00h03\n";
+
+	class TickAllocationTest : public ::testing::Test
+	{
+	protected:
+		std::string                        _networkFile;
+		std::string                        _trainFile;
+		std::unique_ptr<PreparedScenario>  _scenario;
+		std::unique_ptr<ScenarioTrainPool> _pool;
+
+		void SetUp() override
+		{
+			_networkFile = writeTempFile("alloc_network_test", NETWORK);
+			_trainFile   = writeTempFile("alloc_train_test", TRAINS);
+			_scenario.reset(new PreparedScenario(_networkFile, _trainFile, "dijkstra"));
+			_pool.reset(new ScenarioTrainPool(*_scenario));
+		}
+
+		void TearDown() override
+		{
+			std::remove(_networkFile.c_str());
+			std::remove(_trainFile.c_str());
+		}
+
+		void addTrains(SimulationManager& sim)
+		{
+			for (Train* train : _pool->acquire())
+			{
+				sim.addTrain(train);
+			}
+		}
+	};
+
+	std::vector<ITrainState*> statesOf(const SimulationManager& sim)
+	{
+		std::vector<ITrainState*> states;
+		for (const Train* train : sim.getTrains())
+		{
+			states.push_back(train->getCurrentState());
+		}
+		return states;
+	}
+
+	// Some train is cruising and every other one cruises, waits to depart
+	// or has arrived.
+	bool onlyCruising(const SimulationManager& sim)
+	{
+		bool cruising = false;
+		for (const Train* train : sim.getTrains())
+		{
+			const std::string state = train->getCurrentState() ? train->getCurrentState()->getName() : "";
+			cruising = cruising || state == "Cruising";
+			if (state != "Cruising" && state != "Idle" && !train->isFinished())
+			{
+				return false;
+			}
+		}
+		return cruising;
+	}
+}
+
+TEST_F(TickAllocationTest, CruisingTicksDoNotAllocate)
+{
+	ASSERT_TRUE(AllocationTracker::isInstalled());
+
+	SimulationConfig config;
+	config.network = _scenario->getNetwork();
+	config.seed    = 7;
+	config.events.stationDelay.probabilityPerTimestep     = 0.0;
+	config.events.trackMaintenance.probabilityPerTimestep = 0.0;
+	config.events.signalFailure.probabilityPerTimestep    = 0.0;
+	config.events.weather.probabilityPerTimestep          = 0.0;
+
+	SimulationManager sim;
+	sim.configure(config);
+	addTrains(sim);
+	sim.start();
+
+	// Every tick in which no train changes state while they cruise.
+	std::vector<ITrainState*> before      = statesOf(sim);
+	int                       steadyTicks = 0;
+
+	while (sim.getCurrentTime() < 8 * 3600)
+	{
+		const AllocationTracker::Counters start = AllocationTracker::total();
+		sim.step();
+		const AllocationTracker::Counters end = AllocationTracker::total();
+
+		const std::vector<ITrainState*> after = statesOf(sim);
+		if (after == before && onlyCruising(sim))
+		{
+			EXPECT_EQ(end.allocations - start.allocations, 0u) << "at t=" << sim.getCurrentTime();
+			++steadyTicks;
+		}
+		before = after;
+	}
+
+	EXPECT_GE(steadyTicks, 500);
+}
+
+TEST_F(TickAllocationTest, TagsAttributeAllocationsToTheInnermostPhase)
+{
+	ASSERT_TRUE(AllocationTracker::isInstalled());
+
+	const AllocationTracker::Counters events   = AllocationTracker::phase(TickPhase::EventPipeline);
+	const AllocationTracker::Counters snapshot = AllocationTracker::phase(TickPhase::WriteSnapshots);
+	const std::uint64_t               live     = AllocationTracker::liveBytes();
+
+	std::vector<char>* outer = nullptr;
+	std::vector<char>* inner = nullptr;
+	{
+		AllocationTracker::TagScope eventTag(TickPhase::EventPipeline);
+		outer = new std::vector<char>(1000);
+		{
+			AllocationTracker::TagScope snapshotTag(TickPhase::WriteSnapshots);
+			inner = new std::vector<char>(100);
+		}
+		// Back to the outer tag.
+		outer->resize(5000);
+	}
+	EXPECT_GE(AllocationTracker::liveBytes(), live + 5000 + 100);
+
+	// Two vectors and their buffers, one of them resized.
+	EXPECT_EQ(AllocationTracker::phase(TickPhase::EventPipeline).allocations - events.allocations, 3u);
+	EXPECT_EQ(AllocationTracker::phase(TickPhase::WriteSnapshots).allocations - snapshot.allocations, 2u);
+	EXPECT_EQ(AllocationTracker::phase(TickPhase::WriteSnapshots).bytes - snapshot.bytes,
+	          sizeof(std::vector<char>) + 100);
+
+	delete outer;
+	delete inner;
+	EXPECT_EQ(AllocationTracker::liveBytes(), live);
+}
+
+TEST_F(TickAllocationTest, MemoryReportCoversEverySubsystem)
+{
+	CommandManager commands;
+	commands.startRecording();
+
+	SimulationConfig config;
+	config.network = _scenario->getNetwork();
+	config.seed    = 7;
+
+	SimulationManager sim;
+	sim.configure(config);
+	sim.setCommandManager(&commands);
+	addTrains(sim);
+	sim.start();
+	while (sim.getCurrentTime() < 8 * 3600)
+	{
+		sim.step();
+	}
+
+	const MemoryReport report = sim.getMemoryReport();
+	EXPECT_GT(report.graph, 4 * sizeof(void*));
+	EXPECT_GT(report.trains, 3 * sizeof(Train));
+	EXPECT_GT(report.events, 0u);
+	EXPECT_GE(report.commandLog, commands.pool().stats().reservedBytes);
+	EXPECT_GT(commands.pool().stats().reservedBytes, 0u);
+	EXPECT_EQ(report.outputBuffers, 0u);
+	EXPECT_EQ(report.total(), report.graph + report.trains + report.events + report.commandLog);
+	EXPECT_NE(report.toString().find("command log "), std::string::npos);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "io/AsyncResultSink.hpp"
+
+namespace
+{
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream      in(path, std::ios::binary);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    class AsyncResultSinkTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("async_result_sink_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        std::string path(const std::string& name) const
+        {
+            return (_dir / name).string();
+        }
+    };
+}
+
+TEST(AsyncResultSinkFormatTest, SnapshotMatchesStreamFormatting)
+{
+    const std::string from = "CityB";
+    const std::string to   = "RailNodeF2";
+
+    ResultSnapshot snapshot;
+    snapshot.timeSeconds = 6 * 3600 + 16 * 60 + 30;
+    snapshot.from        = &from;
+    snapshot.to          = &to;
+    snapshot.remainingKm = 72.375;
+    snapshot.velocityKmh = 190.6;
+    std::string("Accelerating").copy(snapshot.status, sizeof(snapshot.status) - 1);
+    snapshot.cellCount     = 6;
+    snapshot.trainCell     = 1;
+    snapshot.otherCount    = 2;
+    snapshot.otherCells[0] = 4;
+    snapshot.otherCells[1] = 1;  // Same cell as this train: not marked
+
+    // The layout FileOutputWriter used to produce through a stream left
+    // with fill '0' by the header.
+    std::ostringstream expected;
+    expected << std::setfill('0');
+    expected << "[06h16] - [" << "CityB     " << "][" << "RailNodeF2" << "] - ["
+             << std::fixed << std::setprecision(2) << 72.375 << "km] - ["
+             << "Accelerating" << "] - ["
+             << std::setw(6) << std::right << std::setprecision(0) << 190.6 << "km/h] - "
+             << "[ ][x][ ][ ][O][ ]" << "\n";
+
+    std::string line;
+    AsyncResultSink::appendSnapshot(line, snapshot, from, to);
+    EXPECT_EQ(line, expected.str());
+
+    ResultSnapshot arrived;
+    std::string("Stopped").copy(arrived.status, sizeof(arrived.status) - 1);
+    line.clear();
+    AsyncResultSink::appendSnapshot(line, arrived, "CityE", "");
+    EXPECT_EQ(line, "[00h00] - [CityE     ][          ] - [0.00km] - [Stopped  ] - [000000km/h] - [ ]\n");
+}
+
+TEST_F(AsyncResultSinkTest, KeepsPerFileOrderWithFewDescriptors)
+{
+    AsyncResultSink sink(2);  // Fewer descriptors than files: forces LRU eviction
+
+    std::vector<std::uint32_t> files;
+    std::vector<std::string>   expected(5);
+
+    for (int f = 0; f < 5; ++f)
+    {
+        files.push_back(sink.open(path("train" + std::to_string(f) + ".result")));
+    }
+
+    for (int line = 0; line < 3000; ++line)
+    {
+        for (int f = 0; f < 5; ++f)
+        {
+            const std::string text = "file " + std::to_string(f) + " line " + std::to_string(line) + "\n";
+            expected[f] += text;
+            sink.write(files[f], text);
+        }
+    }
+
+    sink.flush();
+
+    for (int f = 0; f < 5; ++f)
+    {
+        EXPECT_EQ(readFile(path("train" + std::to_string(f) + ".result")), expected[f]);
+    }
+
+    sink.close(files[0]);
+    sink.shutdown();
+}
+
+TEST_F(AsyncResultSinkTest, OpenTruncatesAndReportsBadPath)
+{
+    {
+        std::ofstream stale(path("old.result"));
+        stale << "previous run\n";
+    }
+
+    AsyncResultSink sink;
+    sink.open(path("old.result"));
+    EXPECT_EQ(readFile(path("old.result")), "");
+
+    EXPECT_THROW(sink.open(path("missing/dir/x.result")), std::runtime_error);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "utils/BinaryCodec.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+TEST(BinaryCodecTest, FixedWidthFieldsAndStringsRoundTrip)
+{
+    std::string out;
+    BinaryCodec::put(out, static_cast<std::uint32_t>(0xDEADBEEF));
+    BinaryCodec::put(out, -2.5);
+    BinaryCodec::put(out, static_cast<std::uint8_t>(7));
+    BinaryCodec::putString(out, "CityA");
+    BinaryCodec::putString(out, "");
+
+    EXPECT_EQ(out.size(), 4u + 8u + 1u + (4u + 5u) + 4u);
+
+    BinaryCodec::Reader in(out);
+    EXPECT_EQ(in.get<std::uint32_t>(), 0xDEADBEEFu);
+    EXPECT_EQ(in.get<double>(), -2.5);
+    EXPECT_EQ(in.get<std::uint8_t>(), 7);
+    EXPECT_EQ(in.string(), "CityA");
+    EXPECT_EQ(in.position(), out.size() - 4);
+    EXPECT_EQ(in.string(), "");
+    EXPECT_TRUE(in.atEnd());
+    EXPECT_EQ(in.remaining(), 0u);
+}
+
+TEST(BinaryCodecTest, VarintsUseSevenBitsPerByte)
+{
+    const std::uint64_t values[] = {0, 127, 128, 16383, 16384, std::numeric_limits<std::uint64_t>::max()};
+    const std::size_t   sizes[]  = {1, 1, 2, 2, 3, 10};
+
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        std::string out;
+        BinaryCodec::putVarint(out, values[i]);
+        EXPECT_EQ(out.size(), sizes[i]) << values[i];
+
+        BinaryCodec::Reader in(out);
+        EXPECT_EQ(in.varint(), values[i]);
+        EXPECT_TRUE(in.atEnd());
+    }
+
+    for (std::int32_t value : {0, -1, 1, -64, 63, std::numeric_limits<std::int32_t>::min(),
+                               std::numeric_limits<std::int32_t>::max()})
+    {
+        std::string out;
+        BinaryCodec::putSigned(out, value);
+        EXPECT_EQ(BinaryCodec::Reader(out).signedVarint(), value);
+    }
+
+    std::string small;
+    BinaryCodec::putSigned(small, -1);
+    EXPECT_EQ(small.size(), 1u);
+}
+
+TEST(BinaryCodecTest, DeltasAreExactAndRepeatsCostOneByte)
+{
+    const double  values[] = {0.0, 360.0, 360.0, 420.0, -0.0, 1e-300, 12.345678901234};
+    std::string   out;
+    std::uint64_t previous = 0;
+
+    for (double value : values)
+    {
+        BinaryCodec::putDelta(out, value, previous);
+    }
+
+    // The repeated 360.0 is a single SAME_BITS marker.
+    std::string   repeat;
+    std::uint64_t bits = 0;
+    BinaryCodec::putDelta(repeat, 360.0, bits);
+    const std::size_t first = repeat.size();
+    BinaryCodec::putDelta(repeat, 360.0, bits);
+    EXPECT_EQ(repeat.size(), first + 1);
+    EXPECT_EQ(repeat.back(), static_cast<char>(BinaryCodec::SAME_BITS));
+
+    BinaryCodec::Reader in(out);
+    std::uint64_t       decoded = 0;
+    for (double value : values)
+    {
+        const double read = in.delta(decoded);
+        EXPECT_EQ(std::memcmp(&read, &value, sizeof(read)), 0) << value;
+    }
+    EXPECT_TRUE(in.atEnd());
+}
+
+TEST(BinaryCodecTest, ReaderRejectsTruncatedAndMalformedInput)
+{
+    std::string out;
+    BinaryCodec::putString(out, "Express");
+    out.pop_back();
+    EXPECT_THROW(BinaryCodec::Reader(out).string(), std::runtime_error);
+
+    EXPECT_THROW(BinaryCodec::Reader("\x01\x02").get<std::uint32_t>(), std::runtime_error);
+
+    const std::string endless(11, static_cast<char>(0x80));
+    EXPECT_THROW(BinaryCodec::Reader(endless).varint(), std::runtime_error);
+
+    std::uint64_t previous = 0;
+    EXPECT_THROW(BinaryCodec::Reader("\x41").delta(previous), std::runtime_error);
+}
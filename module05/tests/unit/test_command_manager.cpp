@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "patterns/behavioral/command/CommandLog.hpp"
+#include "patterns/behavioral/command/CommandManager.hpp"
+#include "patterns/behavioral/command/TrainDepartureCommand.hpp"
+#include "patterns/behavioral/command/ReplayKeyframe.hpp"
+
+namespace
+{
+    class CommandManagerTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("command_manager_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        std::string path(const std::string& name) const
+        {
+            return (_dir / name).string();
+        }
+
+        static void recordEvent(CommandManager& manager, double time, const std::string& description)
+        {
+            manager.record(manager.pool().create<SimEventCommand>(time, "SIGNAL FAILURE", description));
+        }
+
+        static std::vector<double> drain(CommandManager& manager, double endTime)
+        {
+            std::vector<double> times;
+            manager.consumeUntil(endTime, [&times](ICommand* command)
+                                 {
+                                     times.push_back(command->getTimestamp());
+                                 });
+            return times;
+        }
+    };
+}
+
+TEST_F(CommandManagerTest, CursorVisitsCommandsOnceInTimeOrder)
+{
+    CommandManager manager;
+    manager.startRecording();
+    recordEvent(manager, 30.0, "c");
+    recordEvent(manager, 10.0, "a");
+    recordEvent(manager, 20.0, "b");
+    recordEvent(manager, 10.0, "a2");
+
+    manager.startReplay();
+
+    EXPECT_EQ(drain(manager, 10.0), std::vector<double>{});
+    EXPECT_EQ(drain(manager, 11.0), (std::vector<double>{10.0, 10.0}));
+    EXPECT_EQ(drain(manager, 11.0), std::vector<double>{});
+    EXPECT_EQ(drain(manager, 1e9), (std::vector<double>{20.0, 30.0}));
+
+    // Seeking lands on the first command at or after the time.
+    manager.seek(20.0);
+    EXPECT_EQ(drain(manager, 1e9), (std::vector<double>{20.0, 30.0}));
+    manager.seek(0.0);
+    EXPECT_EQ(drain(manager, 1e9).size(), 4u);
+}
+
+TEST_F(CommandManagerTest, KeyframesRoundTripThroughReplayFile)
+{
+    CommandManager recorder;
+    recorder.startRecording();
+    recordEvent(recorder, 5.0, "only");
+
+    ReplayKeyframe late;
+    late.time = 1800.0;
+    recorder.addKeyframe(late);
+
+    ReplayKeyframe early;
+    early.time = 900.0;
+
+    TrainKeyframe train;
+    train.name             = "Express";
+    train.state            = "Braking";
+    train.departureStation = "CityB";
+    train.railIndex        = 3;
+    train.position         = 0.1 + 0.2;  // Not representable in few digits
+    train.velocity         = 1.0 / 3.0;
+    train.stopSeconds      = 1e-300;
+    train.finished         = true;
+    early.trains.push_back(train);
+    recorder.addKeyframe(early);
+
+    RecordingMetadata meta;
+    meta.networkFile = "net.txt";
+    meta.trainFile   = "trains.txt";
+    meta.seed        = 7;
+    ASSERT_TRUE(recorder.saveToFile(path("replay.json"), meta));
+
+    CommandManager    player;
+    RecordingMetadata loaded;
+    ASSERT_TRUE(player.loadFromFile(path("replay.json"), loaded));
+    EXPECT_EQ(player.commandCount(), 1u);
+    ASSERT_EQ(player.keyframeCount(), 2u);
+
+    EXPECT_EQ(player.keyframeAtOrBefore(899.0), nullptr);
+    EXPECT_EQ(player.keyframeAtOrBefore(1799.0)->time, 900.0);
+    EXPECT_EQ(player.keyframeAtOrBefore(5000.0)->time, 1800.0);
+
+    const ReplayKeyframe* restored = player.keyframeAtOrBefore(900.0);
+    ASSERT_EQ(restored->trains.size(), 1u);
+
+    const TrainKeyframe& back = restored->trains[0];
+    EXPECT_EQ(back.name, train.name);
+    EXPECT_EQ(back.state, train.state);
+    EXPECT_EQ(back.departureStation, train.departureStation);
+    EXPECT_EQ(back.railIndex, train.railIndex);
+    EXPECT_EQ(back.position, train.position);
+    EXPECT_EQ(back.velocity, train.velocity);
+    EXPECT_EQ(back.stopSeconds, train.stopSeconds);
+    EXPECT_TRUE(back.finished);
+}
+
+TEST_F(CommandManagerTest, LoadsRecordingsWithoutKeyframes)
+{
+    {
+        std::ofstream out(path("old.json"));
+        out << "{\n\"network_file\":\"n.txt\",\n\"train_file\":\"t.txt\",\n\"seed\":3,\n\"stop_time\":60,\n"
+            << "\"commands\":[\n"
+            << "{\"t\":12.000000,\"type\":\"EVENT\",\"event_type\":\"STATION DELAY\",\"desc\":\"x\"}\n"
+            << "]\n}\n";
+    }
+
+    CommandManager    player;
+    RecordingMetadata meta;
+    ASSERT_TRUE(player.loadFromFile(path("old.json"), meta));
+    EXPECT_EQ(player.commandCount(), 1u);
+    EXPECT_EQ(player.keyframeCount(), 0u);
+    EXPECT_EQ(meta.seed, 3u);
+}
+
+TEST_F(CommandManagerTest, BinaryLogStreamsAndLoadsLikeJson)
+{
+    const std::string names[] = {"Express", "Cargo_Night", "Regional"};
+
+    CommandManager json;
+    CommandManager binary;
+    json.startRecording();
+    binary.startRecording(path("replay.rlog"));
+    EXPECT_TRUE(binary.isStreaming());
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const double       time  = step * 0.1 * 3;  // Not exact in six decimals
+        const std::string& train = names[step % 3];
+
+        for (CommandManager* manager : {&json, &binary})
+        {
+            CommandPool& pool = manager->pool();
+            switch (step % 4)
+            {
+                case 0: manager->record(pool.create<TrainStateChangeCommand>(time, train, "Idle", "Accelerating")); break;
+                case 1: manager->record(pool.create<TrainAdvanceRailCommand>(time, train, static_cast<std::size_t>(step % 7))); break;
+                case 2: manager->record(pool.create<SimEventCommand>(time, "WEATHER", "Storm \"west\"")); break;
+                default: manager->record(new TrainDepartureCommand(time, train)); break;
+            }
+        }
+
+        if (step % 5000 == 0)
+        {
+            ReplayKeyframe keyframe;
+            keyframe.time = time;
+            keyframe.trains.push_back(TrainKeyframe{train, "Cruising", "CityA", 2, 0.1 + 0.2, 33.3, 0.0, false});
+            json.addKeyframe(keyframe);
+            binary.addKeyframe(keyframe);
+        }
+    }
+
+    // Streaming keeps nothing in memory, but still counts.
+    EXPECT_EQ(binary.commandCount(), 20000u);
+
+    RecordingMetadata meta;
+    meta.networkFile = "net.txt";
+    meta.trainFile   = "trains.txt";
+    meta.seed        = 42;
+    meta.stopTime    = 6000.5;
+    ASSERT_TRUE(json.saveToFile(path("replay.json"), meta));
+    binary.finishRecording(meta);
+
+    EXPECT_LT(std::filesystem::file_size(path("replay.rlog")) * 3,
+              std::filesystem::file_size(path("replay.json")));
+
+    CommandManager    fromJson;
+    CommandManager    fromBinary;
+    RecordingMetadata jsonMeta;
+    RecordingMetadata binaryMeta;
+    ASSERT_TRUE(fromJson.loadFromFile(path("replay.json"), jsonMeta));
+    ASSERT_TRUE(fromBinary.loadFromFile(path("replay.rlog"), binaryMeta));
+
+    EXPECT_EQ(binaryMeta.networkFile, "net.txt");
+    EXPECT_EQ(binaryMeta.trainFile, "trains.txt");
+    EXPECT_EQ(binaryMeta.seed, 42u);
+    EXPECT_EQ(binaryMeta.stopTime, 6000.5);
+    ASSERT_EQ(fromBinary.commandCount(), 20000u);
+    EXPECT_EQ(fromBinary.keyframeCount(), 4u);
+
+    // JSON keeps six decimals of time; binary timestamps are exact.
+    fromJson.startReplay();
+    fromBinary.startReplay();
+    std::vector<std::string> jsonLines;
+    std::vector<double>      binaryTimes;
+    fromJson.consumeUntil(1e9, [&](ICommand* c) { jsonLines.push_back(c->serialize()); });
+    fromBinary.consumeUntil(1e9, [&](ICommand* c)
+                            {
+                                binaryTimes.push_back(c->getTimestamp());
+                                EXPECT_EQ(c->serialize(), jsonLines[binaryTimes.size() - 1]);
+                            });
+    EXPECT_EQ(binaryTimes[9999], 9999 * 0.1 * 3);
+
+    EXPECT_EQ(fromBinary.keyframeAtOrBefore(1e9)->trains[0].position, 0.1 + 0.2);
+}
+
+TEST_F(CommandManagerTest, RejectsUnfinishedBinaryLog)
+{
+    {
+        CommandManager recorder;
+        recorder.startRecording(path("cut.rlog"));
+        recorder.record(recorder.pool().create<SimEventCommand>(1.0, "WEATHER", "Fog"));
+        // Destroyed without finishRecording(): no end marker.
+    }
+
+    EXPECT_THROW(CommandLogReader reader(path("cut.rlog")), std::runtime_error);
+
+    CommandManager    player;
+    RecordingMetadata meta;
+    EXPECT_FALSE(player.loadFromFile(path("cut.rlog"), meta));
+
+    EXPECT_THROW(CommandManager().startRecording(path("missing/dir/x.rlog")), std::runtime_error);
+}
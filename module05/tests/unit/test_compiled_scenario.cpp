@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "io/CompiledScenario.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "io/TrainConfigParser.hpp"
+
+namespace
+{
+    const char* NETWORK =
+        "Node CityA\n"
+        "Node RailNodeA\n"
+        "Node CityB\n"
+        "Rail CityA RailNodeA 15.5 250\n"
+        "Rail RailNodeA CityB 20 200\n";
+
+    const char* TRAINS =
+        "Express 80 0.005 356 500 CityA CityB 14h10 00h05\n"
+        "Regional 65 0.007 300 450 CityB CityA 08h30 00h02\n";
+
+    class CompiledScenarioTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+        std::string           _network;
+        std::string           _trains;
+        std::string           _compiled;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("compiled_scenario_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+
+            _network  = (_dir / "network.txt").string();
+            _trains   = (_dir / "trains.txt").string();
+            _compiled = (_dir / "scenario.rsim").string();
+
+            write(_network, NETWORK);
+            write(_trains, TRAINS);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        static void write(const std::string& path, const std::string& contents)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << contents;
+        }
+
+        void compile()
+        {
+            std::unique_ptr<Graph>   graph(RailNetworkParser(_network).parse());
+            std::vector<TrainConfig> configs = TrainConfigParser(_trains).parse();
+            CompiledScenario::write(_compiled, *graph, configs, _network, _trains);
+        }
+    };
+}
+
+TEST_F(CompiledScenarioTest, RoundTripsNetworkAndTrains)
+{
+    compile();
+
+    std::unique_ptr<Graph> graph(RailNetworkParser(_compiled).parse());
+
+    ASSERT_EQ(graph->getNodeCount(), 3u);
+    ASSERT_EQ(graph->getRailCount(), 2u);
+    EXPECT_EQ(graph->getNode("RailNodeA")->getType(), NodeType::JUNCTION);
+    EXPECT_EQ(graph->getNode("CityA")->getType(), NodeType::CITY);
+
+    const Rail* first = graph->getRails()[0];
+    EXPECT_EQ(first->getID(), 0u);
+    EXPECT_EQ(first->getNodeA()->getName(), "CityA");
+    EXPECT_EQ(first->getNodeB()->getName(), "RailNodeA");
+    EXPECT_DOUBLE_EQ(first->getLength(), 15.5);
+    EXPECT_DOUBLE_EQ(first->getSpeedLimit(), 250.0);
+
+    const std::vector<TrainConfig> configs = TrainConfigParser(_compiled).parse();
+
+    ASSERT_EQ(configs.size(), 2u);
+    EXPECT_EQ(configs[0].name, "Express");
+    EXPECT_DOUBLE_EQ(configs[0].frictionCoef, 0.005);
+    EXPECT_EQ(configs[0].departureStation, "CityA");
+    EXPECT_EQ(configs[0].departureTime.toString(), "14h10");
+    EXPECT_EQ(configs[1].arrivalStation, "CityA");
+    EXPECT_EQ(configs[1].stopDuration.toString(), "00h02");
+}
+
+TEST_F(CompiledScenarioTest, StaleSourceFallsBackToText)
+{
+    compile();
+
+    write(_trains, std::string(TRAINS) + "Night 90 0.004 320 480 CityA CityB 23h00 00h10\n");
+
+    TrainConfigParser trainParser(_compiled);
+    EXPECT_EQ(trainParser.parse().size(), 3u);
+    EXPECT_TRUE(trainParser.wasStale());
+    EXPECT_NE(trainParser.getStaleWarning().find(_trains), std::string::npos);
+
+    // The network source is untouched, so it still loads from the snapshot.
+    RailNetworkParser      networkParser(_compiled);
+    std::unique_ptr<Graph> graph(networkParser.parse());
+    EXPECT_EQ(graph->getRailCount(), 2u);
+    EXPECT_FALSE(networkParser.wasStale());
+    EXPECT_TRUE(networkParser.getStaleWarning().empty());
+}
+
+TEST_F(CompiledScenarioTest, LoadsWithoutSources)
+{
+    compile();
+
+    std::filesystem::remove(_network);
+    std::filesystem::remove(_trains);
+
+    std::unique_ptr<Graph> graph(RailNetworkParser(_compiled).parse());
+    EXPECT_EQ(graph->getNodeCount(), 3u);
+    EXPECT_EQ(TrainConfigParser(_compiled).parse().size(), 2u);
+}
+
+TEST_F(CompiledScenarioTest, ThrowsOnCorruptPayload)
+{
+    compile();
+
+    std::fstream file(_compiled, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-3, std::ios::end);
+    file.put('\x7f');
+    file.close();
+
+    EXPECT_THROW(TrainConfigParser(_compiled).parse(), std::runtime_error);
+    EXPECT_THROW(RailNetworkParser(_compiled).parse(), std::runtime_error);
+}
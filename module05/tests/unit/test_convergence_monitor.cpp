@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+
+#include "analysis/ConvergenceMonitor.hpp"
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/RunningStats.hpp"
+#include "analysis/StatsCollector.hpp"
+
+namespace
+{
+    SimulationMetrics makeRun(unsigned int seed, double duration)
+    {
+        SimulationMetrics run{};
+        run.seed          = seed;
+        run.totalDuration = duration;
+        return run;
+    }
+}
+
+TEST(ConvergenceMonitorTest, RejectsUnknownMetricAndBadTolerance)
+{
+    ConvergenceCriteria criteria;
+    criteria.metrics = {"notAMetric"};
+    EXPECT_THROW(ConvergenceMonitor monitor(criteria), std::invalid_argument);
+
+    criteria.metrics           = {"totalDuration"};
+    criteria.relativeTolerance = 0.0;
+    EXPECT_THROW(ConvergenceMonitor monitor(criteria), std::invalid_argument);
+}
+
+TEST(ConvergenceMonitorTest, RelativeHalfWidthUsesStandardError)
+{
+    RunningStats stats;
+    EXPECT_TRUE(std::isinf(ConvergenceMonitor::relativeHalfWidth(stats, 1.96)));
+
+    stats.add(90.0);
+    stats.add(110.0);
+    // mean 100, stddev sqrt(200), SE = 10
+    EXPECT_NEAR(ConvergenceMonitor::relativeHalfWidth(stats, 2.0), 0.2, 1e-12);
+
+    RunningStats zeros;
+    zeros.add(0.0);
+    zeros.add(0.0);
+    EXPECT_DOUBLE_EQ(ConvergenceMonitor::relativeHalfWidth(zeros, 1.96), 0.0);
+}
+
+TEST(ConvergenceMonitorTest, CheckpointsStartAtMinRunsOnInterval)
+{
+    ConvergenceCriteria criteria;
+    criteria.minRuns       = 10;
+    criteria.checkInterval = 5;
+    ConvergenceMonitor monitor(criteria);
+
+    EXPECT_FALSE(monitor.isCheckpoint(9));
+    EXPECT_TRUE(monitor.isCheckpoint(10));
+    EXPECT_FALSE(monitor.isCheckpoint(12));
+    EXPECT_TRUE(monitor.isCheckpoint(15));
+}
+
+TEST(ConvergenceMonitorTest, EvaluateReportsWorstMetric)
+{
+    ConvergenceCriteria criteria;
+    criteria.metrics           = {"totalDuration"};
+    criteria.relativeTolerance = 0.01;
+    ConvergenceMonitor monitor(criteria);
+
+    MonteCarloAggregator aggregate;
+    ConvergenceReport    report;
+
+    aggregate.add(makeRun(0, 100.0));
+    aggregate.add(makeRun(1, 140.0));
+    EXPECT_FALSE(monitor.evaluate(aggregate, report));
+    EXPECT_EQ(report.worstMetric, "totalDuration");
+
+    for (unsigned int i = 2; i < 2000; ++i)
+    {
+        aggregate.add(makeRun(i, (i % 2) ? 100.0 : 140.0));
+    }
+    EXPECT_TRUE(monitor.evaluate(aggregate, report));
+    EXPECT_LE(report.worstRelativeHalfWidth, 0.01);
+}
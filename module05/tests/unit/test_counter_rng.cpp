@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "utils/CounterRng.hpp"
+
+#include <set>
+
+TEST(CounterRngTest, SameStreamReproduces)
+{
+    CounterRng a(7, 2, 3);
+    CounterRng b(7, 2, 3);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(a.getInt(0, 1000), b.getInt(0, 1000));
+    }
+    EXPECT_EQ(a.getSeed(), 7u);
+}
+
+TEST(CounterRngTest, StreamsDifferBySeedRunAndSubsystem)
+{
+    std::set<std::uint64_t> firstDraws;
+
+    for (unsigned int seed = 0; seed < 4; ++seed)
+    {
+        for (std::uint64_t run = 0; run < 4; ++run)
+        {
+            for (std::uint64_t subsystem = 0; subsystem < 4; ++subsystem)
+            {
+                CounterRng rng(seed, run, subsystem);
+                firstDraws.insert(rng.nextBits());
+            }
+        }
+    }
+
+    EXPECT_EQ(firstDraws.size(), 64u);
+}
+
+TEST(CounterRngTest, SeekJumpsWithoutGeneratingIntermediateDraws)
+{
+    CounterRng sequential(42, 1, 9);
+    std::uint64_t expected = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected = sequential.nextBits();
+    }
+
+    CounterRng jumped(42, 1, 9);
+    jumped.seek(999);
+    EXPECT_EQ(jumped.nextBits(), expected);
+    EXPECT_EQ(jumped.position(), 1000u);
+}
+
+TEST(CounterRngTest, SplitLeavesParentUntouched)
+{
+    CounterRng parent(5);
+    CounterRng reference(5);
+    parent.nextBits();
+    reference.nextBits();
+
+    CounterRng childA = parent.split(1);
+    CounterRng childB = parent.split(1);
+    CounterRng other  = parent.split(2);
+
+    EXPECT_EQ(childA.nextBits(), childB.nextBits());
+    EXPECT_NE(childA.nextBits(), other.nextBits());
+    EXPECT_EQ(parent.nextBits(), reference.nextBits());
+}
+
+TEST(CounterRngTest, UniformStaysInRangeWithSaneMean)
+{
+    CounterRng rng(123);
+    double sum = 0.0;
+    const int draws = 20000;
+
+    for (int i = 0; i < draws; ++i)
+    {
+        double u = rng.nextUniform();
+        ASSERT_GE(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+    }
+
+    EXPECT_NEAR(sum / draws, 0.5, 0.01);
+}
+
+TEST(CounterRngTest, AntitheticTwinMirrorsEveryDraw)
+{
+    CounterRng base(11, 0, 0);
+    CounterRng twin(11, 0, 0);
+    twin.setAntithetic(true);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        double u = base.getDouble(0.0, 1.0);
+        double v = twin.getDouble(0.0, 1.0);
+        EXPECT_NEAR(u + v, 1.0, 1e-9);
+    }
+
+    base.reseed(11, 0, 1);
+    twin.reseed(11, 0, 1);
+    for (int i = 0; i < 200; ++i)
+    {
+        int a = base.getInt(1, 6);
+        int b = twin.getInt(1, 6);
+        EXPECT_GE(a, 1);
+        EXPECT_LE(a, 6);
+        EXPECT_EQ(a + b, 7);
+    }
+}
@@ -83,15 +83,31 @@ public:
 	std::vector<Node*> nodes;
 	std::vector<Rail*> rails;
 
-	std::vector<Node*> getNodes() const override
+	const std::vector<Node*>& getNodes() const override
 	{
 		return nodes;
 	}
 
-	std::vector<Rail*> getRails() const override
+	const std::vector<Rail*>& getRails() const override
 	{
 		return rails;
 	}
+
+	const std::vector<Rail*>& getRailsFromNode(Node* node) const override
+	{
+		_incident.clear();
+		for (Rail* rail : rails)
+		{
+			if (rail && (rail->getNodeA() == node || rail->getNodeB() == node))
+			{
+				_incident.push_back(rail);
+			}
+		}
+		return _incident;
+	}
+
+private:
+	mutable std::vector<Rail*> _incident;
 };
 
 class FakeEventScheduler : public IEventScheduler
@@ -5,6 +5,7 @@
 #include "events/WeatherEvent.hpp"
 #include "core/Node.hpp"
 #include "core/Rail.hpp"
+#include "simulation/state/RailAttributeOverlay.hpp"
 
 TEST(EventTest, TypeToStringCoversAllKnownTypes)
 {
@@ -19,19 +20,22 @@ TEST(EventTest, TrackMaintenanceLifecycleModifiesAndRestoresSpeedLimit)
 	Node a("CityA");
 	Node b("CityB");
 	Rail rail(&a, &b, 10.0, 200.0);
+	rail.setID(0);
+	RailAttributeOverlay overlay(1);
 
-	TrackMaintenanceEvent maintenance(&rail, Time("08h00"), Time("00h30"), 0.5);
+	TrackMaintenanceEvent maintenance(&rail, Time("08h00"), Time("00h30"), 0.5, &overlay);
 
 	EXPECT_FALSE(maintenance.isActive());
-	EXPECT_DOUBLE_EQ(rail.getSpeedLimit(), 200.0);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&rail), 200.0);
 
 	maintenance.update(Time("08h10"));
 	EXPECT_TRUE(maintenance.isActive());
-	EXPECT_DOUBLE_EQ(rail.getSpeedLimit(), 100.0);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&rail), 100.0);
+	EXPECT_DOUBLE_EQ(rail.getSpeedLimit(), 200.0);
 
 	maintenance.update(Time("08h31"));
 	EXPECT_FALSE(maintenance.isActive());
-	EXPECT_DOUBLE_EQ(rail.getSpeedLimit(), 200.0);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&rail), 200.0);
 }
 
 TEST(EventTest, WeatherLifecycleAffectsOnlyConfiguredRails)
@@ -42,16 +46,22 @@ TEST(EventTest, WeatherLifecycleAffectsOnlyConfiguredRails)
 
 	Rail railAB(&a, &b, 12.0, 160.0);
 	Rail railBC(&b, &c, 8.0, 120.0);
+	railAB.setID(0);
+	railBC.setID(1);
+	RailAttributeOverlay overlay(2);
 
-	WeatherEvent weather("Storm", &b, Time("10h00"), Time("01h00"), 20.0, 0.75, 0.02);
+	WeatherEvent weather("Storm", &b, Time("10h00"), Time("01h00"), 20.0, 0.75, 0.02, &overlay);
 	weather.setAffectedRails({&railAB});
 
 	weather.update(Time("10h05"));
 	EXPECT_TRUE(weather.isActive());
-	EXPECT_DOUBLE_EQ(railAB.getSpeedLimit(), 120.0);
-	EXPECT_DOUBLE_EQ(railBC.getSpeedLimit(), 120.0);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&railAB), 120.0);
+	EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(&railAB), 0.02);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&railBC), 120.0);
+	EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(&railBC), 0.0);
 
 	weather.update(Time("11h05"));
 	EXPECT_FALSE(weather.isActive());
-	EXPECT_DOUBLE_EQ(railAB.getSpeedLimit(), 160.0);
+	EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&railAB), 160.0);
+	EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(&railAB), 0.0);
 }
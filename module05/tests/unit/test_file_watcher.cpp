@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "utils/FileWatcher.hpp"
+
+namespace
+{
+    class FileWatcherTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path    _dir;
+        std::string              _net;
+        std::string              _trains;
+        std::vector<std::string> _changes;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("file_watcher_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+            _net    = (_dir / "net.txt").string();
+            _trains = (_dir / "trains.txt").string();
+            write(_net, "Node A\n");
+            write(_trains, "T 1\n");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        static void write(const std::string& path, const std::string& text)
+        {
+            std::ofstream out(path, std::ios::trunc);
+            out << text;
+        }
+
+        FileWatcher::Callback record()
+        {
+            return [this](const std::string& file) { _changes.push_back(file); };
+        }
+
+        // Drive poll() like the simulation loop until count changes arrive
+        // or timeoutMs passes; returns the elapsed milliseconds.
+        long long pollFor(FileWatcher& watcher, std::size_t count, int timeoutMs)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            auto elapsed = [&start]()
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            };
+
+            while (_changes.size() < count && elapsed() < timeoutMs)
+            {
+                watcher.poll();
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            return elapsed();
+        }
+    };
+}
+
+TEST_F(FileWatcherTest, InotifyDebouncesBurstsIntoOneChange)
+{
+    FileWatcher watcher({_net, _trains}, record(), 500, 30, FileWatcher::Backend::Inotify);
+    watcher.start();
+    EXPECT_EQ(watcher.getBackend(), FileWatcher::Backend::Inotify);
+
+    // Several saves within the same second, all inside one debounce window.
+    for (int i = 0; i < 5; ++i)
+    {
+        write(_net, "Node A\nNode B" + std::to_string(i) + "\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    const long long latency = pollFor(watcher, 1, 2000);
+    EXPECT_EQ(_changes, std::vector<std::string>{_net});
+    EXPECT_LT(latency, 400);
+
+    // Nothing else arrives afterwards.
+    pollFor(watcher, 2, 150);
+    EXPECT_EQ(_changes.size(), 1u);
+}
+
+TEST_F(FileWatcherTest, InotifySeesEditorStyleRenameOverTheFile)
+{
+    FileWatcher watcher({_net, _trains}, record(), 500, 10, FileWatcher::Backend::Inotify);
+    watcher.start();
+
+    const std::string temp = (_dir / ".trains.txt.swp").string();
+    write(temp, "T 2\n");
+    std::filesystem::rename(temp, _trains);
+
+    pollFor(watcher, 1, 2000);
+    ASSERT_EQ(_changes, std::vector<std::string>{_trains});
+
+    // The directory watch survives the inode change.
+    write(_trains, "T 3\n");
+    pollFor(watcher, 2, 2000);
+    EXPECT_EQ(_changes.size(), 2u);
+}
+
+TEST_F(FileWatcherTest, InotifyRewatchesARecreatedDirectory)
+{
+    FileWatcher watcher({_net, _trains}, record(), 20, 10, FileWatcher::Backend::Inotify);
+    watcher.start();
+
+    // Removing the directory drops its watch (IN_IGNORED).
+    std::filesystem::remove_all(_dir);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::filesystem::create_directories(_dir);
+    write(_net, "Node A\nNode B\n");
+
+    pollFor(watcher, 1, 2000);
+    ASSERT_EQ(_changes, std::vector<std::string>{_net});
+
+    // Watched again: later saves are still seen.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    write(_trains, "T 2\n");
+    pollFor(watcher, 2, 2000);
+    ASSERT_EQ(_changes.size(), 2u);
+    EXPECT_EQ(_changes[1], _trains);
+}
+
+TEST_F(FileWatcherTest, PollingFallbackSeesSubSecondChanges)
+{
+    FileWatcher watcher({_net, _trains}, record(), 10, 0, FileWatcher::Backend::Polling);
+    watcher.start();
+    EXPECT_EQ(watcher.getBackend(), FileWatcher::Backend::Polling);
+
+    write(_trains, "T 2\n");
+    pollFor(watcher, 1, 2000);
+    ASSERT_EQ(_changes, std::vector<std::string>{_trains});
+
+    // A second save in the same second as the first is still a change.
+    write(_trains, "T 3 longer\n");
+    pollFor(watcher, 2, 2000);
+    EXPECT_EQ(_changes.size(), 2u);
+}
+
+TEST_F(FileWatcherTest, CallbacksRunOnlyInsidePollWhileStarted)
+{
+    FileWatcher watcher({_net}, record(), 500, 0);
+    watcher.start();
+
+    write(_net, "Node C\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(_changes.empty());
+
+    watcher.stop();
+    watcher.poll();
+    EXPECT_TRUE(_changes.empty());
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "core/Train.hpp"
+#include "io/LiveTrainFeed.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationManager.hpp"
+
+namespace
+{
+    class LiveTrainFeedTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path  _dir;
+        std::string            _feed;
+        std::unique_ptr<Graph> _graph;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("live_train_feed_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+            _feed = (_dir / "feed").string();
+
+            const std::string network = (_dir / "network.txt").string();
+            write(network,
+                  "Node CityA\n"
+                  "Node CityB\n"
+                  "Node CityC\n"
+                  "Rail CityA CityB 15 160\n"
+                  "Rail CityB CityC 12 140\n");
+            _graph.reset(RailNetworkParser(network).parse());
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        static void write(const std::string& path, const std::string& text)
+        {
+            std::ofstream out(path, std::ios::trunc);
+            out << text;
+        }
+
+        std::unique_ptr<LiveTrainFeed> makeFeed()
+        {
+            return std::make_unique<LiveTrainFeed>(_feed, _graph.get(), std::make_unique<DijkstraStrategy>());
+        }
+
+        // Collect trains like the simulation loop until the feed ends.
+        static std::vector<LiveTrainFeed::Arrival> drain(LiveTrainFeed& feed)
+        {
+            std::vector<LiveTrainFeed::Arrival> arrivals;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+            while (!feed.isFinished() && std::chrono::steady_clock::now() < deadline)
+            {
+                LiveTrainFeed::Arrival arrival;
+                while (feed.next(arrival))
+                {
+                    arrivals.push_back(arrival);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return arrivals;
+        }
+
+        static std::string trainLine(const std::string& name, const std::string& from, const std::string& to)
+        {
+            return name + " 80 0.005 356 500 " + from + " " + to + " 06h00 00h02\n";
+        }
+    };
+}
+
+TEST_F(LiveTrainFeedTest, RoutesTrainsWrittenToAFifoAndReportsBadLines)
+{
+    ASSERT_EQ(::mkfifo(_feed.c_str(), 0600), 0);
+
+    std::unique_ptr<LiveTrainFeed> feed = makeFeed();
+    feed->start();
+
+    // The dispatcher connects after the feed is open, then hangs up.
+    std::thread dispatcher([this]()
+    {
+        std::ofstream out(_feed);
+        out << trainLine("First", "CityA", "CityC") << std::flush;
+        out << "Broken 80 0.005\n"
+            << "# comment\n"
+            << trainLine("Nowhere", "CityA", "CityZ")
+            << trainLine("Second", "CityA", "CityC");
+    });
+
+    const std::vector<LiveTrainFeed::Arrival> arrivals = drain(*feed);
+    dispatcher.join();
+    ASSERT_TRUE(feed->isFinished());
+
+    ASSERT_EQ(arrivals.size(), 2u);
+    EXPECT_EQ(arrivals[0].train->getName(), "First");
+    EXPECT_EQ(arrivals[1].config.name, "Second");
+    EXPECT_EQ(arrivals[0].train->getPath().size(), 2u);
+    EXPECT_EQ(arrivals[1].train->getPath().back().to->getName(), "CityC");
+
+    const std::vector<std::string> rejections = feed->takeRejections();
+    ASSERT_EQ(rejections.size(), 2u);
+    EXPECT_EQ(rejections[0].rfind("line 2: ", 0), 0u);
+    EXPECT_EQ(rejections[1].rfind("line 4: ", 0), 0u);
+    EXPECT_TRUE(feed->takeRejections().empty());
+
+    const LiveTrainFeed::Stats stats = feed->getStats();
+    EXPECT_EQ(stats.lines, 4u);
+    EXPECT_EQ(stats.delivered, 2u);
+    EXPECT_EQ(stats.rejected, 2u);
+    EXPECT_EQ(stats.routeCacheHits, 1u);
+
+    for (const LiveTrainFeed::Arrival& arrival : arrivals)
+    {
+        delete arrival.train;
+    }
+}
+
+TEST_F(LiveTrainFeedTest, FullQueueHoldsTheReaderBackWithoutDroppingTrains)
+{
+    const std::size_t total = LiveTrainFeed::QUEUE_CAPACITY + 36;
+    std::string       text;
+    for (std::size_t i = 0; i < total; ++i)
+    {
+        text += trainLine("T" + std::to_string(i), "CityC", "CityA");
+    }
+    write(_feed, text);
+
+    std::unique_ptr<LiveTrainFeed> feed = makeFeed();
+    feed->start();
+
+    // Nobody collects: the reader fills the queue and waits.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (feed->getStats().stalls == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    LiveTrainFeed::Stats stats = feed->getStats();
+    EXPECT_EQ(stats.stalls, 1u);
+    EXPECT_EQ(stats.queued, LiveTrainFeed::QUEUE_CAPACITY);
+    EXPECT_EQ(stats.peakDepth, LiveTrainFeed::QUEUE_CAPACITY);
+    EXPECT_FALSE(feed->isFinished());
+
+    const std::vector<LiveTrainFeed::Arrival> arrivals = drain(*feed);
+    ASSERT_EQ(arrivals.size(), total);
+    for (std::size_t i = 0; i < total; ++i)
+    {
+        EXPECT_EQ(arrivals[i].train->getName(), "T" + std::to_string(i));
+        delete arrivals[i].train;
+    }
+
+    stats = feed->getStats();
+    EXPECT_EQ(stats.delivered, total);
+    EXPECT_EQ(stats.rejected, 0u);
+    EXPECT_GT(stats.stalledMs, 0.0);
+}
+
+TEST_F(LiveTrainFeedTest, StreamedTrainsJoinARunningSimulation)
+{
+    write(_feed, trainLine("Streamed", "CityC", "CityA"));
+    std::unique_ptr<LiveTrainFeed> feed = makeFeed();
+    feed->start();
+
+    SimulationConfig config;
+    config.network = _graph.get();
+    config.seed    = 5;
+
+    SimulationManager sim;
+    sim.configure(config);
+    sim.start();
+    while (sim.getCurrentTime() < 6 * 3600 + 30 * 60)
+    {
+        sim.step();
+    }
+
+    const std::vector<LiveTrainFeed::Arrival> arrivals = drain(*feed);
+    ASSERT_EQ(arrivals.size(), 1u);
+    std::unique_ptr<Train> streamed(arrivals[0].train);
+    sim.addTrain(streamed.get());
+
+    // Dispatched after its 06h00 departure: it leaves straight away.
+    for (int step = 0; step < 20000 && !streamed->isFinished(); ++step)
+    {
+        sim.step();
+    }
+    EXPECT_TRUE(streamed->isFinished());
+    EXPECT_EQ(sim.findTrain("Streamed"), streamed.get());
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "utils/ObjectPool.hpp"
+#include "event_system/EventPool.hpp"
+#include "patterns/behavioral/command/CommandPool.hpp"
+#include "patterns/behavioral/command/TrainDepartureCommand.hpp"
+#include "core/Node.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(ObjectPoolTest, ReusesReleasedSlotsWithoutNewChunks)
+{
+	ObjectPool<std::string, 8> pool;
+
+	for (int round = 0; round < 100; ++round)
+	{
+		std::vector<std::string*> live;
+		for (int i = 0; i < 8; ++i)
+		{
+			live.push_back(pool.create("value"));
+		}
+		for (std::string* s : live)
+		{
+			pool.destroy(s);
+		}
+	}
+
+	EXPECT_EQ(pool.stats().chunkAllocations, 1u);
+	EXPECT_EQ(pool.stats().created, 800u);
+	EXPECT_EQ(pool.stats().live, 0u);
+	EXPECT_EQ(pool.stats().peakLive, 8u);
+}
+
+TEST(ObjectPoolTest, OwnsOnlyItsOwnObjects)
+{
+	ObjectPool<int> pool;
+	int* pooled = pool.create(42);
+	int  outside = 7;
+
+	EXPECT_EQ(*pooled, 42);
+	EXPECT_TRUE(pool.owns(pooled));
+	EXPECT_FALSE(pool.owns(&outside));
+
+	pool.destroy(pooled);
+}
+
+TEST(ObjectPoolTest, OwnershipHoldsAcrossManyChunks)
+{
+	ObjectPool<double, 4> pool;
+	std::vector<double*>  pooled;
+	std::vector<std::unique_ptr<double>> outside;
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		pooled.push_back(pool.create(i));
+		outside.push_back(std::make_unique<double>(i));
+	}
+
+	EXPECT_GT(pool.stats().chunkAllocations, 100u);
+	for (int i = 0; i < 10000; ++i)
+	{
+		ASSERT_TRUE(pool.owns(pooled[i]));
+		ASSERT_FALSE(pool.owns(outside[i].get()));
+	}
+	EXPECT_FALSE(pool.owns(nullptr));
+
+	for (double* value : pooled)
+	{
+		pool.destroy(value);
+	}
+	EXPECT_EQ(pool.stats().live, 0u);
+}
+
+TEST(ObjectPoolTest, EventPoolReleasesPooledAndForeignEvents)
+{
+	Node station("CityA");
+	EventPool pool;
+
+	Event* pooled  = pool.create<StationDelayEvent>(&station, Time("08h00"), Time("00h10"), Time("00h02"));
+	Event* foreign = new StationDelayEvent(&station, Time("08h00"), Time("00h10"), Time("00h02"));
+
+	EXPECT_EQ(pool.stats().live, 1u);
+	pool.release(pooled);
+	pool.release(foreign);
+	EXPECT_EQ(pool.stats().live, 0u);
+}
+
+TEST(ObjectPoolTest, CommandPoolFallsBackToHeapForUnpooledTypes)
+{
+	CommandPool pool;
+
+	ICommand* change    = pool.create<TrainStateChangeCommand>(1.0, "T1", "Idle", "Accelerating");
+	ICommand* departure = pool.create<TrainDepartureCommand>(1.0, "T1");
+
+	EXPECT_EQ(pool.stats().created, 1u);
+	pool.release(change);
+	pool.release(departure);
+	EXPECT_EQ(pool.stats().live, 0u);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "simulation/state/RailAttributeOverlay.hpp"
+#include "core/Graph.hpp"
+#include "core/Rail.hpp"
+#include "core/Node.hpp"
+
+TEST(RailAttributeOverlayTest, GraphAssignsDenseRailIds)
+{
+    Graph graph;
+    Node* a = new Node("CityA");
+    Node* b = new Node("CityB");
+    Node* c = new Node("CityC");
+    graph.addNode(a);
+    graph.addNode(b);
+    graph.addNode(c);
+
+    Rail* ab = new Rail(a, b, 10.0, 100.0);
+    Rail* bc = new Rail(b, c, 20.0, 150.0);
+    graph.addRail(ab);
+    graph.addRail(bc);
+
+    EXPECT_EQ(ab->getID(), 0u);
+    EXPECT_EQ(bc->getID(), 1u);
+}
+
+TEST(RailAttributeOverlayTest, DefaultsToBaseValues)
+{
+    Node a("CityA");
+    Node b("CityB");
+    Rail r(&a, &b, 10.0, 100.0);
+    r.setID(0);
+    RailAttributeOverlay overlay(1);
+
+    EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&r), 100.0);
+    EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(&r), 0.0);
+    EXPECT_FALSE(overlay.isModified(&r));
+}
+
+TEST(RailAttributeOverlayTest, StackedModifiersRestoreExactly)
+{
+    Node a("CityA");
+    Node b("CityB");
+    Rail r(&a, &b, 10.0, 100.0);
+    r.setID(0);
+    RailAttributeOverlay overlay(1);
+
+    overlay.applyModifier(&r, 0.5, 0.0);
+    overlay.applyModifier(&r, 0.7, 0.02);
+    EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&r), 35.0);
+    EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(&r), 0.02);
+
+    overlay.removeModifier(&r, 0.5, 0.0);
+    EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&r), 70.0);
+
+    overlay.removeModifier(&r, 0.7, 0.02);
+    EXPECT_EQ(overlay.getSpeedLimit(&r), 100.0);
+    EXPECT_EQ(overlay.getFrictionIncrease(&r), 0.0);
+    EXPECT_FALSE(overlay.isModified(&r));
+    EXPECT_DOUBLE_EQ(r.getSpeedLimit(), 100.0);
+}
+
+TEST(RailAttributeOverlayTest, UnregisteredRailIsIgnored)
+{
+    Node a("CityA");
+    Node b("CityB");
+    Rail r(&a, &b, 10.0, 100.0);
+    RailAttributeOverlay overlay(4);
+
+    overlay.applyModifier(&r, 0.5, 0.1);
+    EXPECT_DOUBLE_EQ(overlay.getSpeedLimit(&r), 100.0);
+    EXPECT_DOUBLE_EQ(overlay.getFrictionIncrease(nullptr), 0.0);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "simulation/systems/RailFootprintIndex.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include <algorithm>
+
+class RailFootprintIndexTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		a = new Node("CityA");
+		b = new Node("CityB");
+		c = new Node("CityC");
+		d = new Node("CityD");
+		e = new Node("CityE");
+		f = new Node("CityF");
+
+		for (Node* node : {a, b, c, d, e, f})
+		{
+			graph.addNode(node);
+		}
+
+		ab = new Rail(a, b, 10.0, 150.0);
+		bc = new Rail(b, c, 15.0, 150.0);
+		cd = new Rail(c, d, 40.0, 150.0);
+		ef = new Rail(e, f, 2.0, 150.0);
+
+		graph.addRail(ab);
+		graph.addRail(bc);
+		graph.addRail(cd);
+		graph.addRail(ef);
+	}
+
+	Graph graph;
+	Node *a, *b, *c, *d, *e, *f;
+	Rail *ab, *bc, *cd, *ef;
+};
+
+TEST_F(RailFootprintIndexTest, CollectsRailsByGraphDistance)
+{
+	RailFootprintIndex index(&graph);
+
+	std::vector<Rail*> rails = index.railsWithin(a, 30.0);
+
+	ASSERT_EQ(rails.size(), 2u);
+	EXPECT_EQ(rails[0], ab);
+	EXPECT_EQ(rails[1], bc);
+}
+
+TEST_F(RailFootprintIndexTest, IgnoresShortRailsOutsideTheRadius)
+{
+	RailFootprintIndex index(&graph);
+
+	std::vector<Rail*> rails = index.railsWithin(a, 50.0);
+
+	EXPECT_EQ(std::count(rails.begin(), rails.end(), ef), 0);
+	EXPECT_EQ(std::count(rails.begin(), rails.end(), cd), 0);
+}
+
+TEST_F(RailFootprintIndexTest, AlwaysIncludesRailsAtTheCentre)
+{
+	RailFootprintIndex index(&graph);
+
+	std::vector<Rail*> rails = index.railsWithin(d, 20.0);
+
+	ASSERT_EQ(rails.size(), 1u);
+	EXPECT_EQ(rails[0], cd);
+}
+
+TEST_F(RailFootprintIndexTest, MemoizesPerCentreAndBucket)
+{
+	RailFootprintIndex index(&graph);
+
+	index.railsWithin(a, 21.0);
+	index.railsWithin(a, 24.0);
+	EXPECT_EQ(index.cachedFootprints(), 1u);
+
+	// Same bucket, exact radius still respected.
+	EXPECT_EQ(index.railsWithin(a, 24.0).size(), 1u);
+	EXPECT_EQ(index.railsWithin(a, 25.0).size(), 2u);
+
+	index.railsWithin(b, 21.0);
+	EXPECT_EQ(index.cachedFootprints(), 2u);
+}
+
+TEST_F(RailFootprintIndexTest, RunsOnTheSameNetworkShareTheConfiguredIndex)
+{
+	RailFootprintIndex index(&graph);
+
+	SimulationConfig config;
+	config.network    = &graph;
+	config.seed       = 3;
+	config.footprints = &index;
+	config.events.stationDelay.probabilityPerTimestep     = 0.0;
+	config.events.trackMaintenance.probabilityPerTimestep = 0.0;
+	config.events.signalFailure.probabilityPerTimestep    = 0.0;
+	config.events.weather.probabilityPerTimestep          = 1.0;
+
+	auto runOneHour = [&config]()
+	{
+		SimulationManager sim;
+		sim.configure(config);
+		// Reseeding rebuilds the event factory, not the cache.
+		sim.setEventSeed(config.seed);
+		sim.start();
+		while (sim.getCurrentTime() < 3600.0)
+		{
+			sim.step();
+		}
+	};
+
+	runOneHour();
+	const std::size_t cached = index.cachedFootprints();
+	ASSERT_GT(cached, 0u);
+
+	// Same seed, same storms: every footprint comes from the first run.
+	runOneHour();
+	EXPECT_EQ(index.cachedFootprints(), cached);
+}
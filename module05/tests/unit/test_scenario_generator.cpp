@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "io/ScenarioGenerator.hpp"
+#include "io/TrainConfigParser.hpp"
+#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
+
+namespace
+{
+    class ScenarioGeneratorTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+        std::string           _network;
+        std::string           _trains;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("scenario_generator_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+            _network = (_dir / "network.txt").string();
+            _trains  = (_dir / "trains.txt").string();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+    };
+
+    struct Output
+    {
+        std::string network;
+        std::string trains;
+    };
+
+    Output generate(const GeneratorSpec& spec)
+    {
+        std::ostringstream network;
+        std::ostringstream trains;
+        ScenarioGenerator(spec).write(network, trains);
+        return {network.str(), trains.str()};
+    }
+
+    std::size_t reachableFrom(const Graph& graph, Node* start)
+    {
+        std::set<Node*>    seen = {start};
+        std::vector<Node*> open = {start};
+        while (!open.empty())
+        {
+            Node* node = open.back();
+            open.pop_back();
+            for (Node* next : graph.getNeighbors(node))
+            {
+                if (seen.insert(next).second)
+                {
+                    open.push_back(next);
+                }
+            }
+        }
+        return seen.size();
+    }
+}
+
+TEST_F(ScenarioGeneratorTest, EveryTopologyParsesConnectedAndRoutable)
+{
+    for (NetworkTopology topology : {NetworkTopology::Grid, NetworkTopology::HubAndSpoke,
+                                     NetworkTopology::ScaleFree, NetworkTopology::Corridor})
+    {
+        SCOPED_TRACE(ScenarioGenerator::topologyName(topology));
+
+        GeneratorSpec spec;
+        spec.topology  = topology;
+        spec.stations  = 150;
+        spec.junctions = 2;
+        spec.trains    = 40;
+        spec.seed      = 11;
+
+        const ScenarioGenerator::Summary summary = ScenarioGenerator(spec).writeFiles(_network, _trains);
+        EXPECT_EQ(summary.stations, 150u);
+        EXPECT_EQ(summary.junctions, 2 * summary.rails / 3);
+
+        std::unique_ptr<Graph>   graph(RailNetworkParser(_network).parse());
+        std::vector<TrainConfig> trains = TrainConfigParser(_trains).parse();
+
+        ASSERT_EQ(graph->getNodeCount(), summary.stations + summary.junctions);
+        ASSERT_EQ(graph->getRailCount(), summary.rails);
+        ASSERT_EQ(trains.size(), 40u);
+        EXPECT_EQ(graph->getNode("City0")->getType(), NodeType::CITY);
+        EXPECT_EQ(graph->getNode("RailNode0")->getType(), NodeType::JUNCTION);
+        EXPECT_EQ(reachableFrom(*graph, graph->getNode("City0")), graph->getNodeCount());
+
+        DijkstraStrategy dijkstra;
+        for (const TrainConfig& train : trains)
+        {
+            EXPECT_NE(train.departureStation, train.arrivalStation);
+            EXPECT_FALSE(dijkstra.findPath(graph.get(), graph->getNode(train.departureStation),
+                                           graph->getNode(train.arrivalStation)).empty()) << train.name;
+        }
+    }
+}
+
+TEST_F(ScenarioGeneratorTest, OutputDependsOnlyOnTheSpec)
+{
+    GeneratorSpec spec;
+    spec.topology = NetworkTopology::ScaleFree;
+    spec.stations = 500;
+    spec.trains   = 20;
+    spec.seed     = 3;
+
+    const Output first = generate(spec);
+    EXPECT_EQ(generate(spec).network, first.network);
+    EXPECT_EQ(generate(spec).trains, first.trains);
+
+    // More trains: the same network, and the first trains unchanged
+    // (the header line records the new count).
+    spec.trains = 50;
+    const Output      moreTrains = generate(spec);
+    const std::string firstBody  = first.trains.substr(first.trains.find('\n') + 1);
+    const std::string moreBody   = moreTrains.trains.substr(moreTrains.trains.find('\n') + 1);
+    EXPECT_EQ(moreTrains.network.substr(moreTrains.network.find('\n')),
+              first.network.substr(first.network.find('\n')));
+    EXPECT_EQ(moreBody.compare(0, firstBody.size(), firstBody), 0);
+
+    spec.trains = 20;
+    spec.seed   = 4;
+    EXPECT_NE(generate(spec).network, first.network);
+}
+
+TEST_F(ScenarioGeneratorTest, TopologiesHaveTheirShape)
+{
+    GeneratorSpec spec;
+    spec.stations  = 100;
+    spec.junctions = 0;
+
+    // 10 x 10 lattice: 2 * 10 * 9 lines.
+    spec.topology = NetworkTopology::Grid;
+    EXPECT_EQ(ScenarioGenerator(spec).writeFiles(_network, _trains).rails, 180u);
+
+    // 99 trunk lines and an express link every five stations.
+    spec.topology = NetworkTopology::Corridor;
+    EXPECT_EQ(ScenarioGenerator(spec).writeFiles(_network, _trains).rails, 99u + 19u);
+
+    // One spoke per station outside the ring of ten hubs.
+    spec.topology  = NetworkTopology::HubAndSpoke;
+    spec.junctions = 3;
+    const ScenarioGenerator::Summary hub = ScenarioGenerator(spec).writeFiles(_network, _trains);
+    EXPECT_EQ(hub.rails, (10u + 90u) * 4u);
+    EXPECT_EQ(hub.junctions, (10u + 90u) * 3u);
+}
+
+TEST_F(ScenarioGeneratorTest, RejectsSpecsItCannotBuild)
+{
+    EXPECT_EQ(ScenarioGenerator::parseTopology("scale-free"), NetworkTopology::ScaleFree);
+    EXPECT_EQ(ScenarioGenerator::parseTopology("hub"), NetworkTopology::HubAndSpoke);
+    EXPECT_THROW(ScenarioGenerator::parseTopology("ring"), std::runtime_error);
+
+    GeneratorSpec spec;
+    spec.stations = 1;
+    EXPECT_THROW(ScenarioGenerator{spec}, std::runtime_error);
+
+    spec.stations  = 10;
+    spec.junctions = 1000;
+    EXPECT_THROW(ScenarioGenerator{spec}, std::runtime_error);
+
+    spec.junctions = 1;
+    spec.trains    = 0;
+    EXPECT_THROW(ScenarioGenerator{spec}, std::runtime_error);
+
+    spec.trains = 1;
+    EXPECT_THROW(ScenarioGenerator(spec).writeFiles((_dir / "missing" / "net.txt").string(), _trains),
+                 std::runtime_error);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "utils/StreamRng.hpp"
+#include "event_system/EventRngStreams.hpp"
+#include "analysis/MonteCarloRunner.hpp"
+
+TEST(StreamRngTest, SameSeedAndKeyReproduces)
+{
+    StreamRng a;
+    StreamRng b;
+    a.reseed(7, 3, false);
+    b.reseed(7, 3, false);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(a.getInt(0, 1000), b.getInt(0, 1000));
+    }
+    EXPECT_EQ(a.getSeed(), 7u);
+}
+
+TEST(StreamRngTest, AntitheticTwinMirrorsEveryDraw)
+{
+    StreamRng base;
+    StreamRng twin;
+    base.reseed(11, 0, false);
+    twin.reseed(11, 0, true);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        double u = base.getDouble(0.0, 1.0);
+        double v = twin.getDouble(0.0, 1.0);
+        EXPECT_NEAR(u + v, 1.0, 1e-9);
+    }
+
+    base.reseed(11, 1, false);
+    twin.reseed(11, 1, true);
+    for (int i = 0; i < 200; ++i)
+    {
+        int a = base.getInt(1, 6);
+        int b = twin.getInt(1, 6);
+        EXPECT_GE(a, 1);
+        EXPECT_LE(a, 6);
+        EXPECT_EQ(a + b, 7);
+    }
+}
+
+TEST(StreamRngTest, SeekRestoresASavedPosition)
+{
+    StreamRng rng;
+    rng.reseed(3, 2, false);
+    rng.getInt(0, 1000);
+    rng.getInt(0, 1000);
+
+    std::uint64_t saved = rng.position();
+    int           next  = rng.getInt(0, 1000);
+    rng.getInt(0, 1000);
+
+    rng.seek(saved);
+    EXPECT_EQ(rng.getInt(0, 1000), next);
+}
+
+TEST(EventRngStreamsTest, SitesAreIndependentStreams)
+{
+    EventRngStreams streams;
+    streams.reseed(5, false);
+
+    EventRngStreams skipped;
+    skipped.reseed(5, false);
+
+    // Draws at one site must not shift another site's sequence.
+    for (int i = 0; i < 10; ++i)
+    {
+        skipped[EventRngSite::WeatherMagnitude].getDouble(0.0, 1.0);
+    }
+
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(streams[EventRngSite::StationDelayTarget].getInt(0, 1 << 20),
+                  skipped[EventRngSite::StationDelayTarget].getInt(0, 1 << 20));
+    }
+
+    EXPECT_NE(streams[EventRngSite::StationDelayTrigger].getInt(0, 1 << 30),
+              streams[EventRngSite::WeatherTrigger].getInt(0, 1 << 30));
+}
+
+TEST(MonteCarloSamplingTest, AntitheticRunsSharePairSeeds)
+{
+    MonteCarloRunner runner("unused_network.txt", "unused_trains.txt", 100, 4, "dijkstra");
+
+    EXPECT_EQ(runner.seedForRun(3), 103u);
+    EXPECT_FALSE(runner.isAntitheticRun(3));
+
+    runner.setSampling(SamplingMode::Antithetic);
+    EXPECT_EQ(runner.seedForRun(2), 102u);
+    EXPECT_EQ(runner.seedForRun(3), 102u);
+    EXPECT_FALSE(runner.isAntitheticRun(2));
+    EXPECT_TRUE(runner.isAntitheticRun(3));
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "analysis/RunningStats.hpp"
+#include "analysis/QuantileSketch.hpp"
+#include "analysis/MonteCarloAggregator.hpp"
+#include "analysis/StatsCollector.hpp"
+
+TEST(RunningStatsTest, MatchesTwoPassMoments)
+{
+    const std::vector<double> values = {4.0, 7.0, 13.0, 16.0, 2.5, 9.0};
+
+    RunningStats stats;
+    double       sum = 0.0;
+    for (double v : values)
+    {
+        stats.add(v);
+        sum += v;
+    }
+
+    double mean = sum / values.size();
+    double ss   = 0.0;
+    for (double v : values)
+    {
+        ss += (v - mean) * (v - mean);
+    }
+
+    EXPECT_EQ(stats.count(), values.size());
+    EXPECT_NEAR(stats.mean(), mean, 1e-12);
+    EXPECT_NEAR(stats.variance(), ss / (values.size() - 1), 1e-12);
+    EXPECT_DOUBLE_EQ(stats.min(), 2.5);
+    EXPECT_DOUBLE_EQ(stats.max(), 16.0);
+}
+
+TEST(RunningStatsTest, MergeEqualsSequentialAdd)
+{
+    RunningStats all;
+    RunningStats left;
+    RunningStats right;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        double v = std::sin(i) * 50.0 + i;
+        all.add(v);
+        (i < 37 ? left : right).add(v);
+    }
+
+    left.merge(right);
+    EXPECT_EQ(left.count(), all.count());
+    EXPECT_NEAR(left.mean(), all.mean(), 1e-9);
+    EXPECT_NEAR(left.variance(), all.variance(), 1e-9);
+    EXPECT_DOUBLE_EQ(left.min(), all.min());
+    EXPECT_DOUBLE_EQ(left.max(), all.max());
+}
+
+TEST(QuantileSketchTest, ApproximatesUniformQuantilesInBoundedMemory)
+{
+    QuantileSketch sketch(128);
+    const int n = 100000;
+
+    for (int i = 0; i < n; ++i)
+    {
+        // Deterministic permutation of 0..n-1.
+        sketch.add(static_cast<double>((static_cast<long long>(i) * 7919) % n));
+    }
+
+    EXPECT_EQ(sketch.count(), static_cast<std::uint64_t>(n));
+    EXPECT_LT(sketch.retained(), 1000u);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.0), 0.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), n - 1.0);
+    EXPECT_NEAR(sketch.quantile(0.5), n * 0.5, n * 0.03);
+    EXPECT_NEAR(sketch.quantile(0.95), n * 0.95, n * 0.03);
+}
+
+TEST(QuantileSketchTest, MergedSketchesCoverBothInputs)
+{
+    QuantileSketch low;
+    QuantileSketch high;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        low.add(i);
+        high.add(5000 + i);
+    }
+
+    low.merge(high);
+    EXPECT_EQ(low.count(), 10000u);
+    EXPECT_NEAR(low.quantile(0.25), 2500.0, 300.0);
+    EXPECT_NEAR(low.quantile(0.75), 7500.0, 300.0);
+}
+
+TEST(MonteCarloAggregatorTest, FoldsRunsPerTrain)
+{
+    MonteCarloAggregator aggregate;
+
+    for (unsigned int seed = 0; seed < 4; ++seed)
+    {
+        SimulationMetrics run{};
+        run.seed                          = seed;
+        run.totalDuration                 = 100.0 + seed;
+        run.collisionAvoidanceActivations = static_cast<int>(seed);
+
+        TrainMetrics tm{};
+        tm.actualTravelTime    = 60.0 + seed;
+        tm.estimatedTravelTime = 50.0;
+        tm.reachedDestination  = (seed != 3);
+        run.trainMetrics["Express"] = tm;
+
+        aggregate.add(run);
+    }
+
+    ASSERT_EQ(aggregate.getRunCount(), 4u);
+    EXPECT_DOUBLE_EQ(aggregate.getTotalDuration().moments.mean(), 101.5);
+    EXPECT_DOUBLE_EQ(aggregate.getCollisionAvoidances().moments.max(), 3.0);
+
+    const MonteCarloAggregator::TrainSummary& express = aggregate.getTrains().at("Express");
+    EXPECT_DOUBLE_EQ(express.reached.mean(), 0.75);
+    EXPECT_EQ(express.delay.moments.count(), 3u);
+    EXPECT_DOUBLE_EQ(express.delay.moments.mean(), 11.0);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "analysis/SweepSpec.hpp"
+#include "io/SweepSpecParser.hpp"
+
+namespace
+{
+    std::string writeTempFile(const std::string& contents)
+    {
+        const auto path = std::filesystem::temp_directory_path()
+            / std::filesystem::path("sweep_spec_test_" + std::to_string(::getpid()) + "_" + std::to_string(std::rand()) + ".txt");
+        std::ofstream out(path);
+        out << contents;
+        out.close();
+        return path.string();
+    }
+}
+
+TEST(SweepSpecTest, GridIsCartesianProductWithLastParameterFastest)
+{
+    SweepSpec spec;
+    spec.addParameter({"stationDelay.probability", 0.0, 0.04, 3});
+    spec.addParameter({"train.massScale", 1.0, 2.0, 2});
+
+    std::vector<SweepPoint> points = spec.expand(1);
+
+    ASSERT_EQ(points.size(), 6u);
+    EXPECT_DOUBLE_EQ(points[0].values[0], 0.0);
+    EXPECT_DOUBLE_EQ(points[0].values[1], 1.0);
+    EXPECT_DOUBLE_EQ(points[1].values[1], 2.0);
+    EXPECT_DOUBLE_EQ(points[2].values[0], 0.02);
+    EXPECT_DOUBLE_EQ(points[5].values[0], 0.04);
+
+    EXPECT_DOUBLE_EQ(points[5].events.stationDelay.probabilityPerTimestep, 0.04);
+    EXPECT_DOUBLE_EQ(points[5].physics.mass, 2.0);
+
+    // Unswept settings keep their defaults.
+    EXPECT_DOUBLE_EQ(points[5].events.weather.probabilityPerTimestep,
+                     EventParameters().weather.probabilityPerTimestep);
+    EXPECT_DOUBLE_EQ(points[5].physics.friction, 1.0);
+}
+
+TEST(SweepSpecTest, LatinHypercubeCoversEveryStratumOnceAndIsSeeded)
+{
+    SweepSpec spec;
+    spec.setDesign(SweepSpec::Design::LatinHypercube);
+    spec.setSamples(8);
+    spec.addParameter({"weather.probability", 0.0, 0.008, 1});
+    spec.addParameter({"train.brakeScale", 0.5, 1.5, 1});
+
+    std::vector<SweepPoint> points = spec.expand(99);
+    ASSERT_EQ(points.size(), 8u);
+
+    std::set<int> weatherStrata;
+    std::set<int> brakeStrata;
+    for (const SweepPoint& point : points)
+    {
+        weatherStrata.insert(static_cast<int>(point.values[0] / 0.001));
+        brakeStrata.insert(static_cast<int>((point.values[1] - 0.5) / 0.125));
+    }
+    EXPECT_EQ(weatherStrata.size(), 8u);
+    EXPECT_EQ(brakeStrata.size(), 8u);
+
+    std::vector<SweepPoint> again = spec.expand(99);
+    std::vector<SweepPoint> other = spec.expand(100);
+    EXPECT_EQ(again[3].values, points[3].values);
+    EXPECT_NE(other[3].values, points[3].values);
+}
+
+TEST(SweepSpecTest, MinutesAreRoundedAndRangesNeverInvert)
+{
+    SweepSpec spec;
+    spec.addParameter({"signalFailure.minMinutes", 29.6, 29.6, 1});
+
+    std::vector<SweepPoint> points = spec.expand(0);
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_EQ(points[0].events.signalFailure.minDurationMinutes, 30);
+    EXPECT_EQ(points[0].events.signalFailure.maxDurationMinutes, 30);
+}
+
+TEST(SweepSpecTest, RejectsInvalidParameters)
+{
+    SweepSpec spec;
+    EXPECT_THROW(spec.addParameter({"stationDelay.frequency", 0.0, 1.0, 2}), std::invalid_argument);
+    EXPECT_THROW(spec.addParameter({"weather.probability", 0.0, 1.5, 2}), std::invalid_argument);
+    EXPECT_THROW(spec.addParameter({"train.massScale", 0.0, 1.0, 2}), std::invalid_argument);
+    EXPECT_THROW(spec.addParameter({"train.massScale", 2.0, 1.0, 2}), std::invalid_argument);
+    EXPECT_THROW(spec.expand(0), std::invalid_argument);
+
+    spec.addParameter({"train.massScale", 1.0, 2.0, 2});
+    EXPECT_THROW(spec.addParameter({"train.massScale", 1.0, 2.0, 2}), std::invalid_argument);
+}
+
+TEST(SweepSpecParserTest, ParsesDesignRunsAndParameters)
+{
+    const std::string filepath = writeTempFile(
+        "# comment\n"
+        "design lhs\n"
+        "samples 12\n"
+        "runs 5\n"
+        "param trackMaintenance.probability 0.0 0.03\n"
+        "param train.accelScale 0.8 1.2   # inline comment\n");
+
+    SweepSpecParser parser(filepath);
+    SweepSpec       spec = parser.parse();
+
+    EXPECT_EQ(spec.getDesign(), SweepSpec::Design::LatinHypercube);
+    EXPECT_EQ(spec.getSamples(), 12u);
+    EXPECT_EQ(spec.getRunsPerPoint(), 5u);
+    ASSERT_EQ(spec.getParameters().size(), 2u);
+    EXPECT_EQ(spec.getParameters()[1].name, "train.accelScale");
+    EXPECT_EQ(spec.expand(1).size(), 12u);
+
+    std::filesystem::remove(filepath);
+}
+
+TEST(SweepSpecParserTest, ReportsBadLinesWithLineNumber)
+{
+    const std::string filepath = writeTempFile(
+        "runs 3\n"
+        "param weather.probability 0.0 abc\n");
+
+    SweepSpecParser parser(filepath);
+    try
+    {
+        parser.parse();
+        FAIL() << "Expected parse error";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("line 2"), std::string::npos);
+    }
+
+    std::filesystem::remove(filepath);
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+#include "core/Rail.hpp"
+#include "core/Train.hpp"
+#include "io/RailNetworkParser.hpp"
+#include "patterns/behavioral/strategies/DijkstraStrategy.hpp"
+#include "patterns/creational/factories/TrainFactory.hpp"
+#include "simulation/core/SimulationConfig.hpp"
+#include "simulation/core/SimulationManager.hpp"
+#include "utils/TickProfiler.hpp"
+
+namespace
+{
+    std::size_t index(TickPhase phase)
+    {
+        return static_cast<std::size_t>(phase);
+    }
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream     in(path);
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    std::size_t countOf(const std::string& text, const std::string& needle)
+    {
+        std::size_t count = 0;
+        for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    class TickProfilerTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("tick_profiler_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+    };
+}
+
+TEST_F(TickProfilerTest, TimesEveryPhaseOfEachTick)
+{
+#ifndef RAILWAY_PROFILING
+    GTEST_SKIP() << "built with RAILWAY_PROFILING=OFF";
+#else
+    const std::string network = (_dir / "network.txt").string();
+    {
+        std::ofstream out(network);
+        out << "Node CityA\nNode CityB\nRail CityA CityB 15 160\n";
+    }
+    std::unique_ptr<Graph> graph(RailNetworkParser(network).parse());
+
+    TrainConfig train;
+    train.name             = "Profiled";
+    train.mass             = 80.0;
+    train.frictionCoef     = 0.005;
+    train.maxAccelForce    = 356.0;
+    train.maxBrakeForce    = 500.0;
+    train.departureStation = "CityA";
+    train.arrivalStation   = "CityB";
+    train.departureTime    = Time(6, 0);
+    train.stopDuration     = Time(0, 2);
+
+    std::unique_ptr<Train> profiled(TrainFactory::create(train, graph.get()));
+    ASSERT_NE(profiled, nullptr);
+    DijkstraStrategy dijkstra;
+    profiled->setPath(dijkstra.findPath(graph.get(), graph->getNode("CityA"), graph->getNode("CityB")));
+
+    SimulationConfig config;
+    config.network = graph.get();
+    config.seed    = 3;
+
+    SimulationManager sim;
+    sim.configure(config);
+    sim.addTrain(profiled.get());
+    sim.start();
+
+    // Ticks before start() are not recorded.
+    sim.step();
+
+    TickProfiler profiler;
+    profiler.start();
+    const int steps = 500;
+    for (int i = 0; i < steps; ++i)
+    {
+        sim.step();
+    }
+    profiler.stop();
+    sim.step();
+
+    EXPECT_EQ(profiler.threadCount(), 1u);
+
+    const TickProfiler::Summary summary = profiler.summarize();
+    const std::uint64_t         tickNs  = summary[index(TickPhase::Tick)].totalNs;
+    std::uint64_t               phaseNs = 0;
+
+    for (TickPhase phase : {TickPhase::Tick, TickPhase::CheckDepartures, TickPhase::RefreshState,
+                            TickPhase::StateTransitions, TickPhase::UpdateTrainStates,
+                            TickPhase::EventPipeline, TickPhase::WriteSnapshots, TickPhase::UpdateDashboard})
+    {
+        const TickProfiler::PhaseSummary& timed = summary[index(phase)];
+        EXPECT_EQ(timed.count, static_cast<std::uint64_t>(steps)) << tickPhaseName(phase);
+        EXPECT_LE(timed.minNs, timed.quantileNs(0.5));
+        EXPECT_LE(timed.quantileNs(0.5), timed.quantileNs(0.99));
+        EXPECT_LE(timed.quantileNs(0.99), timed.maxNs);
+        if (phase != TickPhase::Tick)
+        {
+            phaseNs += timed.totalNs;
+        }
+    }
+
+    // Phases nest inside the tick.
+    EXPECT_GT(tickNs, 0u);
+    EXPECT_LE(phaseNs, tickNs);
+#endif
+}
+
+TEST_F(TickProfilerTest, HistogramQuantilesStayWithinABucket)
+{
+    TickProfiler profiler;
+    profiler.start();
+
+    // 1..1000 us: the true quantiles are q * 1000 us.
+    for (std::uint64_t us = 1; us <= 1000; ++us)
+    {
+        TickProfiler::record(TickPhase::EventPipeline, 1000, 1000 + us * 1000);
+    }
+    profiler.stop();
+
+    // Not recorded once stopped.
+    TickProfiler::record(TickPhase::EventPipeline, 0, 1);
+
+    const TickProfiler::PhaseSummary phase = profiler.summarize()[index(TickPhase::EventPipeline)];
+    EXPECT_EQ(phase.count, 1000u);
+    EXPECT_EQ(phase.minNs, 1000u);
+    EXPECT_EQ(phase.maxNs, 1000000u);
+    EXPECT_EQ(phase.totalNs, 500500000u);
+
+    for (double q : {0.5, 0.9, 0.99})
+    {
+        const double expected = q * 1e6;
+        EXPECT_NEAR(static_cast<double>(phase.quantileNs(q)), expected, expected * 0.125) << q;
+    }
+    EXPECT_EQ(phase.quantileNs(1.0), phase.maxNs);
+}
+
+TEST_F(TickProfilerTest, ThreadsRecordIntoTheirOwnBuffers)
+{
+    TickProfiler profiler;
+    profiler.start();
+
+    auto work = [](std::size_t spans)
+    {
+        for (std::size_t i = 0; i < spans; ++i)
+        {
+            const std::uint64_t start = TickProfiler::nowNs();
+            TickProfiler::record(TickPhase::Tick, start, start + 50);
+        }
+    };
+
+    // The ring keeps the newest spans; the histogram sees all of them.
+    const std::size_t overflow = TickProfiler::RING_CAPACITY + 10;
+    std::thread       first(work, overflow);
+    std::thread       second(work, 10);
+    first.join();
+    second.join();
+    profiler.stop();
+
+    EXPECT_EQ(profiler.threadCount(), 2u);
+    EXPECT_EQ(profiler.summarize()[index(TickPhase::Tick)].count, overflow + 10);
+
+    const std::string trace = (_dir / "profile.json").string();
+    const std::string csv   = (_dir / "profile.csv").string();
+    profiler.writeChromeTrace(trace);
+    profiler.writeSummaryCsv(csv);
+
+    const std::string json = readFile(trace);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(countOf(json, "\"ph\":\"X\""), TickProfiler::RING_CAPACITY + 10);
+    EXPECT_EQ(countOf(json, "\"ph\":\"M\""), 2u);
+    EXPECT_NE(json.find("\"tid\":2"), std::string::npos);
+
+    const std::string summary = readFile(csv);
+    EXPECT_EQ(summary.rfind("phase,count,total_ms,mean_us,min_us,p50_us,p90_us,p99_us,max_us,tick_share_pct\n", 0), 0u);
+    EXPECT_NE(summary.find("\ntick," + std::to_string(overflow + 10) + ","), std::string::npos);
+    EXPECT_NE(summary.find("\nupdateDashboard,0,"), std::string::npos);
+    EXPECT_EQ(countOf(summary, "\n"), static_cast<std::size_t>(TickPhase::COUNT) + 1);
+
+    // A restarted profiler starts empty.
+    profiler.start();
+    profiler.stop();
+    EXPECT_EQ(profiler.threadCount(), 0u);
+}
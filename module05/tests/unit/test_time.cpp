@@ -45,6 +45,18 @@ TEST(TimeTest, ParseInvalidString)
 	EXPECT_EQ(t.getMinutes(), 0);
 }
 
+TEST(TimeTest, ParseRejectsMissingSeparatorOrMinutes)
+{
+	Time noSeparator("14x10");
+	Time noMinutes("14h");
+	EXPECT_EQ(noSeparator.toMinutes(), 0);
+	EXPECT_EQ(noMinutes.toMinutes(), 0);
+
+	Time spaced(" 7h05");
+	EXPECT_EQ(spaced.getHours(), 7);
+	EXPECT_EQ(spaced.getMinutes(), 5);
+}
+
 TEST(TimeTest, ToMinutesConversion)
 {
 	Time t1(0, 0);
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "io/AsyncResultSink.hpp"
+#include "io/TraceFile.hpp"
+
+namespace
+{
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream      in(path, std::ios::binary);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    class TraceFileTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path _dir;
+        std::string           _trace;
+
+        void SetUp() override
+        {
+            _dir = std::filesystem::temp_directory_path()
+                 / ("trace_file_test_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(_dir);
+            _trace = (_dir / "run.rtrace").string();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_dir);
+        }
+
+        std::string path(const std::string& name) const
+        {
+            return (_dir / name).string();
+        }
+
+        // The same output a three-train run would produce, fed to any sink.
+        void feed(AsyncResultSink& sink, const std::string& from, const std::string& to) const
+        {
+            const char* names[] = {"Express_06h00", "Cargo_06h10", "Cargo_Night_22h30"};
+            std::uint32_t files[3];
+
+            for (int t = 0; t < 3; ++t)
+            {
+                files[t] = sink.open(path(std::string(names[t]) + ".result"));
+                sink.write(files[t], std::string("Train : ") + names[t] + "\n\n");
+            }
+
+            for (int step = 0; step < 4000; ++step)
+            {
+                for (int t = 0; t < 3; ++t)
+                {
+                    ResultSnapshot snapshot;
+                    snapshot.timeSeconds = 6 * 3600 + step * 60.0;
+                    snapshot.from        = (step % 7 == 0) ? &to : &from;
+                    snapshot.to          = (t == 2 && step % 5 == 0) ? nullptr : &to;
+                    snapshot.remainingKm = 500.0 - step * 0.1234567 * (t + 1);
+                    snapshot.velocityKmh = (step % 50) * 3.7 - (t == 1 ? 0.2 : 0.0);
+                    std::string(step % 3 ? "Cruising" : "Braking").copy(snapshot.status, 15);
+                    snapshot.cellCount     = (step % 11 == 0) ? 0 : 1 + step % 9;
+                    snapshot.trainCell     = step % 4;
+                    snapshot.otherCount    = step % 3;
+                    snapshot.otherCells[0] = 2;
+                    snapshot.otherCells[1] = -1;
+                    sink.writeSnapshot(files[t], snapshot);
+                }
+
+                if (step % 1000 == 0)
+                {
+                    sink.write(files[step / 1000 % 3], "[06h30] - Event: signal failure\n");
+                }
+            }
+
+            sink.close(files[0]);
+            sink.shutdown();
+        }
+    };
+}
+
+TEST_F(TraceFileTest, RendersSameTextAsResultFiles)
+{
+    const std::string from = "CityA";
+    const std::string to   = "RailNodeB";
+
+    {
+        AsyncResultSink files;
+        feed(files, from, to);
+    }
+    {
+        AsyncResultSink trace(std::unique_ptr<IResultStore>(new TraceWriter(_trace)));
+        feed(trace, from, to);
+    }
+
+    const TraceReader reader(_trace);
+    ASSERT_EQ(reader.getTrains().size(), 3u);
+
+    std::size_t textBytes = 0;
+    for (std::size_t t = 0; t < 3; ++t)
+    {
+        const TraceReader::Train& train = reader.getTrains()[t];
+        EXPECT_GT(train.chunks.size(), 1u);
+
+        std::string text;
+        reader.render(t, text);
+        EXPECT_EQ(text, readFile(train.path)) << train.label;
+        textBytes += text.size();
+    }
+
+    // Deltas and interned names keep the trace well under the text size.
+    EXPECT_LT(std::filesystem::file_size(_trace) * 2, textBytes);
+}
+
+TEST_F(TraceFileTest, FindsTrainsByLabelOrName)
+{
+    const std::string from = "CityA";
+    const std::string to   = "CityB";
+
+    AsyncResultSink trace(std::unique_ptr<IResultStore>(new TraceWriter(_trace)));
+    feed(trace, from, to);
+
+    const TraceReader reader(_trace);
+    EXPECT_EQ(reader.getTrains()[1].label, "Cargo_06h10");
+
+    EXPECT_EQ(reader.findTrains("Express"), std::vector<std::size_t>{0});
+    EXPECT_EQ(reader.findTrains("Cargo_06h10"), std::vector<std::size_t>{1});
+    EXPECT_EQ(reader.findTrains("Cargo_Night"), std::vector<std::size_t>{2});
+    EXPECT_TRUE(reader.findTrains("Cargo_06").empty());
+    EXPECT_TRUE(reader.findTrains("Missing").empty());
+}
+
+TEST_F(TraceFileTest, RejectsUnfinishedOrCorruptTrace)
+{
+    {
+        TraceWriter writer(_trace);
+        writer.open(0, "output/A_06h00.result");
+        writer.text(0, "header\n");
+        writer.flush();  // Chunk on disk, but no footer
+    }
+    EXPECT_THROW(TraceReader reader(_trace), std::runtime_error);
+
+    {
+        TraceWriter writer(_trace);
+        writer.open(0, "output/A_06h00.result");
+        writer.text(0, "header\n");
+        writer.finish();
+    }
+    EXPECT_NO_THROW(TraceReader reader(_trace));
+
+    // Point the footer past the end of the file.
+    std::fstream file(_trace, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-16, std::ios::end);
+    file.put('\x7f');
+    file.close();
+
+    EXPECT_THROW(TraceReader reader(_trace), std::runtime_error);
+}
@@ -125,6 +125,39 @@ TEST_F(TrainTest, AdvanceToNextRail)
 	EXPECT_EQ(t.getCurrentRailIndex(), 2);
 }
 
+TEST_F(TrainTest, ResetJourneyRestoresPreDepartureState)
+{
+	Time depTime("10h00");
+	Time stopDur("00h05");
+	Train t("Express", 80.0, 0.005, 356.0, 500.0, "A", "C", depTime, stopDur);
+	
+	Node a("A"), b("B"), c("C");
+	Rail r1(&a, &b, 10.0, 100.0);
+	Rail r2(&b, &c, 15.0, 120.0);
+	
+	std::vector<PathSegment> path;
+	path.push_back({&r1, &a, &b});
+	path.push_back({&r2, &b, &c});
+	t.setPath(path);
+	
+	t.advanceToNextRail();
+	t.setVelocity(20.0);
+	t.setPosition(500.0);
+	t.markFinished();
+	t.reverseJourney();
+	t.setDepartureTime(Time("18h00"));
+	
+	t.resetJourney(path, depTime);
+	EXPECT_FALSE(t.isFinished());
+	EXPECT_EQ(t.getVelocity(), 0.0);
+	EXPECT_EQ(t.getPosition(), 0.0);
+	EXPECT_EQ(t.getCurrentRail(), &r1);
+	EXPECT_EQ(t.getCurrentState(), nullptr);
+	EXPECT_EQ(t.getDepartureStation(), "A");
+	EXPECT_EQ(t.getArrivalStation(), "C");
+	EXPECT_EQ(t.getDepartureTime().toString(), "10h00");
+}
+
 TEST_F(TrainTest, ValidationEmptyName)
 {
 	Time depTime("10h00");
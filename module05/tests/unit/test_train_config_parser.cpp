@@ -3,6 +3,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
 
@@ -19,6 +20,37 @@ namespace
 		out.close();
 		return path.string();
 	}
+
+	// Timetable past TrainConfigParser::PARALLEL_MIN_BYTES, with comment and
+	// blank lines mixed in so chunk boundaries land on all kinds of lines.
+	// Returns the physical line number of each train by index.
+	std::string largeTimetable(std::size_t trains, std::vector<int>& lineOf)
+	{
+		std::string text;
+		int         line = 0;
+
+		for (std::size_t i = 0; i < trains; ++i)
+		{
+			if (i % 7 == 0)
+			{
+				text += "# block " + std::to_string(i) + "\n";
+				++line;
+			}
+			if (i % 11 == 0)
+			{
+				text += "\n";
+				++line;
+			}
+
+			const int minutes = static_cast<int>(i % 1440);
+			char      time[8];
+			std::snprintf(time, sizeof(time), "%02dh%02d", minutes / 60, minutes % 60);
+			text += "Train" + std::to_string(i) + " 80 0.005 356 500 CityA CityB " + time + " 00h05\n";
+			lineOf.push_back(++line);
+		}
+
+		return text;
+	}
 }
 
 TEST(TrainConfigParserTest, ParsesMultipleValidTrainConfigs)
@@ -86,3 +118,126 @@ TEST(TrainConfigParserTest, ThrowsOnInvalidTimeFormat)
 
 	std::filesystem::remove(filepath);
 }
+
+TEST(TrainConfigParserTest, ErrorsReportPhysicalLineNumbers)
+{
+	const std::string filepath = writeTempFile(
+		"# timetable\n"
+		"\n"
+		"Express 80 0.005 356 500 CityA CityB 14h10 00h05\n"
+		"   # indented comment\n"
+		"Broken 80 abc 356 500 CityA CityB 14h10 00h05\n");
+
+	TrainConfigParser parser(filepath);
+	try
+	{
+		parser.parse();
+		FAIL() << "Expected parse error";
+	}
+	catch (const std::runtime_error& e)
+	{
+		EXPECT_NE(std::string(e.what()).find("Error at line 5:"), std::string::npos);
+		EXPECT_NE(std::string(e.what()).find("Content: Broken 80 abc"), std::string::npos);
+	}
+
+	std::filesystem::remove(filepath);
+}
+
+TEST(TrainConfigParserTest, AcceptsCrlfAndMissingFinalNewline)
+{
+	const std::string filepath = writeTempFile(
+		"Express 80 0.005 356 500 CityA CityB 14h10 00h05   # inline\r\n"
+		"Regional 65 0.007 300 450 CityB CityC 08h30 00h02");
+
+	TrainConfigParser parser(filepath);
+	const std::vector<TrainConfig> configs = parser.parse();
+
+	ASSERT_EQ(configs.size(), 2);
+	EXPECT_EQ(configs[0].stopDuration.toString(), "00h05");
+	EXPECT_EQ(configs[1].name, "Regional");
+	EXPECT_DOUBLE_EQ(configs[1].frictionCoef, 0.007);
+
+	std::filesystem::remove(filepath);
+}
+
+TEST(TrainConfigParserTest, ParsesEmptyFile)
+{
+	const std::string filepath = writeTempFile("");
+
+	TrainConfigParser parser(filepath);
+	EXPECT_TRUE(parser.parse().empty());
+
+	std::filesystem::remove(filepath);
+}
+
+TEST(TrainConfigParserTest, ParallelParseMatchesSequentialOrder)
+{
+	std::vector<int>  lineOf;
+	const std::string filepath = writeTempFile(largeTimetable(30000, lineOf));
+
+	TrainConfigParser sequential(filepath);
+	TrainConfigParser parallel(filepath);
+	sequential.setThreads(1);
+	parallel.setThreads(4);
+
+	const std::vector<TrainConfig> expected = sequential.parse();
+	const std::vector<TrainConfig> actual   = parallel.parse();
+
+	ASSERT_EQ(actual.size(), expected.size());
+	for (std::size_t i = 0; i < actual.size(); ++i)
+	{
+		ASSERT_EQ(actual[i].name, expected[i].name);
+		ASSERT_EQ(actual[i].departureTime, expected[i].departureTime);
+	}
+
+	std::filesystem::remove(filepath);
+}
+
+TEST(TrainConfigParserTest, ParallelParseReportsExactLineNumber)
+{
+	std::vector<int> lineOf;
+	std::string      text   = largeTimetable(30000, lineOf);
+	const std::string bad   = "Train21377 80 0.005 356 500 CityA CityB";
+	const std::size_t where = text.find("Train21377 ");
+	text.replace(where, text.find('\n', where) - where, bad);
+
+	const std::string filepath = writeTempFile(text);
+	TrainConfigParser parser(filepath);
+	parser.setThreads(4);
+
+	try
+	{
+		parser.parse();
+		FAIL() << "Expected parse error";
+	}
+	catch (const std::runtime_error& e)
+	{
+		const std::string expected = "Error at line " + std::to_string(lineOf[21377]) + ":";
+		EXPECT_NE(std::string(e.what()).find(expected), std::string::npos) << e.what();
+		EXPECT_NE(std::string(e.what()).find("Content: " + bad), std::string::npos);
+	}
+
+	std::filesystem::remove(filepath);
+}
+
+TEST(TrainConfigParserTest, ParallelParseDetectsDuplicateAcrossChunks)
+{
+	std::vector<int>  lineOf;
+	const std::string filepath = writeTempFile(
+		largeTimetable(30000, lineOf) + "Train3 70 0.005 320 480 CityB CityA 15h10 00h04\n");
+
+	TrainConfigParser parser(filepath);
+	parser.setThreads(4);
+
+	try
+	{
+		parser.parse();
+		FAIL() << "Expected duplicate name error";
+	}
+	catch (const std::runtime_error& e)
+	{
+		EXPECT_NE(std::string(e.what()).find("'Train3'"), std::string::npos) << e.what();
+	}
+
+	std::filesystem::remove(filepath);
+}
@@ -65,7 +65,7 @@ TEST_F(TrainStateTest, IdleStateKeepsVelocityZero)
 	IdleState idleState;
 	
 	train->setVelocity(0.0);
-	idleState.update(train, 1.0);
+	idleState.update(train, context, 1.0);
 	
 	EXPECT_DOUBLE_EQ(train->getVelocity(), 0.0);
 }
@@ -77,7 +77,7 @@ TEST_F(TrainStateTest, AcceleratingStateIncreasesVelocity)
 	train->setVelocity(10.0);
 	double initialVel = train->getVelocity();
 	
-	accelState.update(train, 1.0);
+	accelState.update(train, context, 1.0);
 	
 	EXPECT_GT(train->getVelocity(), initialVel);
 }
@@ -87,7 +87,7 @@ TEST_F(TrainStateTest, StoppedStateKeepsVelocityZero)
 	StoppedState stoppedState;
 	
 	train->setVelocity(0.0);
-	stoppedState.update(train, 1.0);
+	stoppedState.update(train, context, 1.0);
 	
 	EXPECT_DOUBLE_EQ(train->getVelocity(), 0.0);
 }